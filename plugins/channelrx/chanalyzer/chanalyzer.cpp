@@ -96,10 +96,16 @@ void ChannelAnalyzer::feed(const SampleVector::const_iterator& begin, const Samp
 
 	m_settingsMutex.lock();
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++;
 
 		if (m_useInterpolator)
 		{
@@ -225,6 +225,8 @@ private:
 	bool m_useInterpolator;
 
 	NCOF m_nco;
+
+	std::vector<Complex> m_mixBuffer; //!< NCO mixed samples of current block
 	PhaseLockComplex m_pll;
 	FreqLockComplex m_fll;
     Interpolator m_interpolator;
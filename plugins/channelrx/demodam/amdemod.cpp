@@ -108,10 +108,16 @@ void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector
 
 	m_settingsMutex.lock();
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++;
 
 		if (m_interpolatorDistance < 1.0f) // interpolate
 		{
@@ -136,7 +142,7 @@ void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector
 
 	if (m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if (res != m_audioBufferFill)
 		{
@@ -263,7 +269,7 @@ void AMDemod::processOneSample(Complex &ci)
 
     if (m_audioBufferFill >= m_audioBuffer.size())
     {
-        uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+        uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
         if (res != m_audioBufferFill)
         {
@@ -125,10 +125,16 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_settingsMutex.lock();
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
-		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++ / SDR_RX_SCALEF;
 
 		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
 
@@ -246,7 +252,7 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 				if (m_audioBufferFill >= m_audioBuffer.size())
 				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 					if(res != m_audioBufferFill) {
 						qDebug("BFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
@@ -262,7 +268,7 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	if (m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if (res != m_audioBufferFill) {
 			qDebug("BFMDemod::feed: %u/%u tail samples written", res, m_audioBufferFill);
@@ -216,6 +216,8 @@ private:
     quint32 m_audioSampleRate;
 
 	NCO m_nco;
+
+	std::vector<Complex> m_mixBuffer; //!< NCO mixed samples of current block
 	Interpolator m_interpolator; //!< Interpolator between fixed demod bandwidth and audio bandwidth (rational)
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
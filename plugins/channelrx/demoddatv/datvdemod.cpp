@@ -37,6 +37,7 @@ MESSAGE_CLASS_DEFINITION(DATVDemod::MsgConfigureChannelizer, Message)
 
 DATVDemod::DATVDemod(DeviceSourceAPI *deviceAPI) :
     ChannelSinkAPI(m_channelIdURI),
+    m_objPipeline(0),
     m_blnNeedConfigUpdate(false),
     m_deviceAPI(deviceAPI),
     m_objRegisteredTVScreen(0),
@@ -238,12 +239,18 @@ void DATVDemod::InitDATVParameters(int intMsps,
 
 void DATVDemod::CleanUpDATVFramework(bool blnRelease)
 {
+    if((blnRelease==false) && (m_objPipeline!=NULL))
+    {
+        // stage threads must not keep running on a dropped graph
+        delete m_objPipeline;
+    }
+
     if(blnRelease==true)
     {
-        if(m_objScheduler!=NULL)
+        if(m_objPipeline!=NULL)
         {
-            m_objScheduler->shutdown();
-            delete m_objScheduler;
+            m_objPipeline->shutdown();
+            delete m_objPipeline;
         }
 
         // NOTCH FILTER
@@ -329,6 +336,7 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
     }
 
     m_objScheduler=NULL;
+    m_objPipeline=NULL;
 
     // INPUT
 
@@ -361,6 +369,7 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
     ncoeffs_sampler=0;
 
     p_symbols = NULL;
+    p_symbols_fec = NULL;
     p_freq = NULL;
     p_ss = NULL;
     p_mer = NULL;
@@ -392,6 +401,7 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
 
     // DEINTERLEAVING
     p_rspackets = NULL;
+    p_rspackets_rs = NULL;
     r_deinter = NULL;
 
     p_vbitcount = NULL;
@@ -532,7 +542,12 @@ void DATVDemod::InitDATVFramework()
 
     m_lngExpectedReadIQ  = BUF_BASEBAND;
 
-    m_objScheduler = new leansdr::scheduler();
+    // Pipeline stages: 0: demodulation in the channel thread, 1: deconvolution (Viterbi),
+    // MPEG sync and deinterleaving, 2: Reed-Solomon decoding, derandomization and output
+    m_objPipeline = new leansdr::mtscheduler(3);
+    m_objScheduler = m_objPipeline->stage(0);
+    leansdr::scheduler *objFECStage = m_objPipeline->stage(1);
+    leansdr::scheduler *objRSStage = m_objPipeline->stage(2);
 
     //***************
     p_rawiq = new leansdr::pipebuf<leansdr::cf32>(m_objScheduler, "rawiq", BUF_BASEBAND);
@@ -688,7 +703,8 @@ void DATVDemod::InitDATVFramework()
 
     // DECONVOLUTION AND SYNCHRONIZATION
 
-    p_bytes = new leansdr::pipebuf<leansdr::u8>(m_objScheduler, "bytes", BUF_BYTES);
+    p_symbols_fec = m_objPipeline->bridge(0, *p_symbols, 1, 4*BUF_SYMBOLS);
+    p_bytes = new leansdr::pipebuf<leansdr::u8>(objFECStage, "bytes", BUF_BYTES);
 
     r_deconv = NULL;
 
@@ -702,7 +718,7 @@ void DATVDemod::InitDATVFramework()
       }
 
       //To uncomment -> Linking Problem : undefined symbol: _ZN7leansdr21viterbi_dec_interfaceIhhiiE6updateEPiS2_
-      r = new leansdr::viterbi_sync(m_objScheduler, (*p_symbols), (*p_bytes), m_objDemodulator->cstln, m_objCfg.fec);
+      r = new leansdr::viterbi_sync(objFECStage, (*p_symbols_fec), (*p_bytes), m_objDemodulator->cstln, m_objCfg.fec);
 
       if ( m_objCfg.fastlock )
       {
@@ -711,31 +727,32 @@ void DATVDemod::InitDATVFramework()
     }
     else
     {
-        r_deconv = make_deconvol_sync_simple(m_objScheduler, (*p_symbols), (*p_bytes), m_objCfg.fec);
+        r_deconv = make_deconvol_sync_simple(objFECStage, (*p_symbols_fec), (*p_bytes), m_objCfg.fec);
         r_deconv->fastlock = m_objCfg.fastlock;
     }
 
     //******* -> if ( m_objCfg.hdlc )
 
-    p_mpegbytes = new leansdr::pipebuf<leansdr::u8> (m_objScheduler, "mpegbytes", BUF_MPEGBYTES);
-    p_lock = new leansdr::pipebuf<int> (m_objScheduler, "lock", BUF_SLOW);
-    p_locktime = new leansdr::pipebuf<leansdr::u32> (m_objScheduler, "locktime", BUF_PACKETS);
+    p_mpegbytes = new leansdr::pipebuf<leansdr::u8> (objFECStage, "mpegbytes", BUF_MPEGBYTES);
+    p_lock = new leansdr::pipebuf<int> (objFECStage, "lock", BUF_SLOW);
+    p_locktime = new leansdr::pipebuf<leansdr::u32> (objFECStage, "locktime", BUF_PACKETS);
 
-    r_sync_mpeg = new leansdr::mpeg_sync<leansdr::u8, 0>(m_objScheduler, *p_bytes, *p_mpegbytes, r_deconv, p_lock, p_locktime);
+    r_sync_mpeg = new leansdr::mpeg_sync<leansdr::u8, 0>(objFECStage, *p_bytes, *p_mpegbytes, r_deconv, p_lock, p_locktime);
     r_sync_mpeg->fastlock = m_objCfg.fastlock;
 
     // DEINTERLEAVING
 
-    p_rspackets = new leansdr::pipebuf< leansdr::rspacket<leansdr::u8> >(m_objScheduler, "RS-enc packets", BUF_PACKETS);
-    r_deinter = new leansdr::deinterleaver<leansdr::u8>(m_objScheduler, *p_mpegbytes, *p_rspackets);
+    p_rspackets = new leansdr::pipebuf< leansdr::rspacket<leansdr::u8> >(objFECStage, "RS-enc packets", BUF_PACKETS);
+    r_deinter = new leansdr::deinterleaver<leansdr::u8>(objFECStage, *p_mpegbytes, *p_rspackets);
 
 
     // REED-SOLOMON
 
-    p_vbitcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_PACKETS);
-    p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_PACKETS);
-    p_rtspackets = new leansdr::pipebuf<leansdr::tspacket>(m_objScheduler, "rand TS packets", BUF_PACKETS);
-    r_rsdec = new leansdr::rs_decoder<leansdr::u8, 0> (m_objScheduler, *p_rspackets, *p_rtspackets, p_vbitcount, p_verrcount);
+    p_rspackets_rs = m_objPipeline->bridge(1, *p_rspackets, 2, 64*BUF_PACKETS);
+    p_vbitcount = new leansdr::pipebuf<int>(objRSStage, "Bits processed", BUF_PACKETS);
+    p_verrcount = new leansdr::pipebuf<int>(objRSStage, "Bits corrected", BUF_PACKETS);
+    p_rtspackets = new leansdr::pipebuf<leansdr::tspacket>(objRSStage, "rand TS packets", BUF_PACKETS);
+    r_rsdec = new leansdr::rs_decoder<leansdr::u8, 0> (objRSStage, *p_rspackets_rs, *p_rtspackets, p_vbitcount, p_verrcount);
 
 
     // BER ESTIMATION
@@ -754,12 +771,14 @@ void DATVDemod::InitDATVFramework()
 
     // DERANDOMIZATION
 
-    p_tspackets = new leansdr::pipebuf<leansdr::tspacket>(m_objScheduler, "TS packets", BUF_PACKETS);
-    r_derand = new leansdr::derandomizer(m_objScheduler, *p_rtspackets, *p_tspackets);
+    p_tspackets = new leansdr::pipebuf<leansdr::tspacket>(objRSStage, "TS packets", BUF_PACKETS);
+    r_derand = new leansdr::derandomizer(objRSStage, *p_rtspackets, *p_tspackets);
 
 
     // OUTPUT
-    r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets,m_objVideoStream);
+    r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(objRSStage, *p_tspackets,m_objVideoStream);
+
+    m_objPipeline->start();
 
     m_blnDVBInitialized=true;
 }
@@ -850,7 +869,7 @@ void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
                 //Leave +1 by safety
                 if((m_lngReadIQ+1)>=p_rawiq_writer->writable())
                 {
-                    m_objScheduler->step();
+                    m_objPipeline->step();
 
                     m_lngReadIQ=0;
                     delete p_rawiq_writer;
@@ -31,6 +31,7 @@ class DownChannelizer;
 //LeanSDR
 
 #include "leansdr/framework.h"
+#include "leansdr/mtscheduler.h"
 #include "leansdr/generic.h"
 #include "leansdr/dsp.h"
 #include "leansdr/sdr.h"
@@ -338,7 +339,8 @@ private:
 
     //************** LEANDBV Scheduler ***************
 
-    leansdr::scheduler * m_objScheduler;
+    leansdr::scheduler * m_objScheduler;      //!< first stage of m_objPipeline run in the channel thread
+    leansdr::mtscheduler * m_objPipeline;     //!< demodulation, FEC decoding and RS decoding stages
     struct config m_objCfg;
 
     bool m_blnDVBInitialized;
@@ -375,6 +377,7 @@ private:
     int ncoeffs_sampler;
 
     leansdr::pipebuf<leansdr::softsymbol> *p_symbols;
+    leansdr::pipebuf<leansdr::softsymbol> *p_symbols_fec; //!< p_symbols in the FEC decoding stage (owned by m_objPipeline)
     leansdr::pipebuf<leansdr::f32> *p_freq;
     leansdr::pipebuf<leansdr::f32> *p_ss;
     leansdr::pipebuf<leansdr::f32> *p_mer;
@@ -408,6 +411,7 @@ private:
 
     // DEINTERLEAVING
     leansdr::pipebuf<leansdr::rspacket<leansdr::u8> > *p_rspackets;
+    leansdr::pipebuf<leansdr::rspacket<leansdr::u8> > *p_rspackets_rs; //!< p_rspackets in the RS decoding stage (owned by m_objPipeline)
     leansdr::deinterleaver<leansdr::u8> *r_deinter;
 
     // REED-SOLOMON
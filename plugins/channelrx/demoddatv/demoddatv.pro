@@ -46,6 +46,7 @@ HEADERS += datvdemod.h\
     leansdr/hdlc.h \
     leansdr/iess.h \
     leansdr/math.h \
+    leansdr/mtscheduler.h \
     leansdr/rs.h \
     leansdr/sdr.h \
     leansdr/viterbi.h \
@@ -1414,37 +1414,44 @@ struct viterbi_sync: runnable
     // 1/2: 6 bits of state, 1 bit in, 2 bits out
     typedef bitpath<uint32_t, TUS, 1, 32> path_12;
     typedef trellis<TS, 64, TUS, 2, 4> trellis_12;
-    typedef viterbi_dec<TS, 64, TUS, 2, TCS, 4, TBM, TPM, path_12> dvb_dec_12;
+    typedef trellis_tables<TS, 64, TUS, 2, 4> tables_12;
+    typedef viterbi_dec_simd<TS, 64, TUS, 2, TCS, 4, TBM, TPM, path_12> dvb_dec_12;
 
     // 2/3: 6 bits of state, 2 bits in, 3 bits out
     typedef bitpath<uint64_t, TUS, 3, 21> path_23;
     typedef trellis<TS, 64, TUS, 4, 8> trellis_23;
-    typedef viterbi_dec<TS, 64, TUS, 4, TCS, 8, TBM, TPM, path_23> dvb_dec_23;
+    typedef trellis_tables<TS, 64, TUS, 4, 8> tables_23;
+    typedef viterbi_dec_simd<TS, 64, TUS, 4, TCS, 8, TBM, TPM, path_23> dvb_dec_23;
 
     // 4/6: 6 bits of state, 4 bits in, 6 bits out
     typedef bitpath<uint64_t, TUS, 4, 16> path_46;
     typedef trellis<TS, 64, TUS, 16, 64> trellis_46;
-    typedef viterbi_dec<TS, 64, TUS, 16, TCS, 64, TBM, TPM, path_46> dvb_dec_46;
+    typedef trellis_tables<TS, 64, TUS, 16, 64> tables_46;
+    typedef viterbi_dec_simd<TS, 64, TUS, 16, TCS, 64, TBM, TPM, path_46> dvb_dec_46;
 
     // 3/4: 6 bits of state, 3 bits in, 4 bits out
     typedef bitpath<uint64_t, TUS, 3, 21> path_34;
     typedef trellis<TS, 64, TUS, 8, 16> trellis_34;
-    typedef viterbi_dec<TS, 64, TUS, 8, TCS, 16, TBM, TPM, path_34> dvb_dec_34;
+    typedef trellis_tables<TS, 64, TUS, 8, 16> tables_34;
+    typedef viterbi_dec_simd<TS, 64, TUS, 8, TCS, 16, TBM, TPM, path_34> dvb_dec_34;
 
     // 4/5: 6 bits of state, 4 bits in, 5 bits out (non-standard)
     typedef bitpath<uint64_t, TUS, 4, 16> path_45;
     typedef trellis<TS, 64, TUS, 16, 32> trellis_45;
-    typedef viterbi_dec<TS, 64, TUS, 16, TCS, 32, TBM, TPM, path_45> dvb_dec_45;
+    typedef trellis_tables<TS, 64, TUS, 16, 32> tables_45;
+    typedef viterbi_dec_simd<TS, 64, TUS, 16, TCS, 32, TBM, TPM, path_45> dvb_dec_45;
 
     // 5/6: 6 bits of state, 5 bits in, 6 bits out
     typedef bitpath<uint64_t, TUS, 5, 12> path_56;
     typedef trellis<TS, 64, TUS, 32, 64> trellis_56;
-    typedef viterbi_dec<TS, 64, TUS, 32, TCS, 64, TBM, TPM, path_56> dvb_dec_56;
+    typedef trellis_tables<TS, 64, TUS, 32, 64> tables_56;
+    typedef viterbi_dec_simd<TS, 64, TUS, 32, TCS, 64, TBM, TPM, path_56> dvb_dec_56;
 
     // QPSK 7/8: 6 bits of state, 7 bits in, 8 bits out
     typedef bitpath<uint64_t, TUS, 7, 9> path_78;
     typedef trellis<TS, 64, TUS, 128, 256> trellis_78;
-    typedef viterbi_dec<TS, 64, TUS, 128, TCS, 256, TBM, TPM, path_78> dvb_dec_78;
+    typedef trellis_tables<TS, 64, TUS, 128, 256> tables_78;
+    typedef viterbi_dec_simd<TS, 64, TUS, 128, TCS, 256, TBM, TPM, path_78> dvb_dec_78;
 
 private:
     pipereader<softsymbol> in;
@@ -1541,50 +1548,57 @@ public:
         {
             trellis_12 *trell = new trellis_12();
             trell->init_convolutional(fec->polys);
+            tables_12 *tables = new tables_12(trell);
             for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_12(trell);
+                syncs[s].dec = new dvb_dec_12(trell, tables);
         }
         else if (cr == FEC23)
         {
             trellis_23 *trell = new trellis_23();
             trell->init_convolutional(fec->polys);
+            tables_23 *tables = new tables_23(trell);
             for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_23(trell);
+                syncs[s].dec = new dvb_dec_23(trell, tables);
         }
         else if (cr == FEC46)
         {
             trellis_46 *trell = new trellis_46();
             trell->init_convolutional(fec->polys);
+            tables_46 *tables = new tables_46(trell);
             for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_46(trell);
+                syncs[s].dec = new dvb_dec_46(trell, tables);
         }
         else if (cr == FEC34)
         {
             trellis_34 *trell = new trellis_34();
             trell->init_convolutional(fec->polys);
+            tables_34 *tables = new tables_34(trell);
             for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_34(trell);
+                syncs[s].dec = new dvb_dec_34(trell, tables);
         }
         else if (cr == FEC45)
         {
             trellis_45 *trell = new trellis_45();
             trell->init_convolutional(fec->polys);
+            tables_45 *tables = new tables_45(trell);
             for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_45(trell);
+                syncs[s].dec = new dvb_dec_45(trell, tables);
         }
         else if (cr == FEC56)
         {
             trellis_56 *trell = new trellis_56();
             trell->init_convolutional(fec->polys);
+            tables_56 *tables = new tables_56(trell);
             for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_56(trell);
+                syncs[s].dec = new dvb_dec_56(trell, tables);
         }
         else if (cr == FEC78)
         {
             trellis_78 *trell = new trellis_78();
             trell->init_convolutional(fec->polys);
+            tables_78 *tables = new tables_78(trell);
             for (int s = 0; s < nsyncs; ++s)
-                syncs[s].dec = new dvb_dec_78(trell);
+                syncs[s].dec = new dvb_dec_78(trell, tables);
         }
         else
         {
@@ -0,0 +1,277 @@
+#ifndef LEANSDR_MTSCHEDULER_H
+#define LEANSDR_MTSCHEDULER_H
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+
+#include "leansdr/framework.h"
+
+namespace leansdr
+{
+
+//////////////////////////////////////////////////////////////////////
+// Multithreaded pipeline
+//////////////////////////////////////////////////////////////////////
+
+// [mtscheduler] splits a graph into stages. Each stage is a plain
+// [scheduler] with its own [pipebufs] and [runnables]. Stage 0 is run
+// by the caller as before and the other stages run on their own thread.
+// [pipebridge] connects a [pipebuf] of one stage to a [pipebuf] of a
+// later stage through a lock-free single producer single consumer ring.
+// Within a stage nothing changes: [pipebufs] are not thread-safe and
+// are only accessed from the thread of their stage.
+
+struct scheduler_thread
+{
+    scheduler sch;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned long events;  // incremented each time input data is available
+    bool running;
+
+    scheduler_thread() :
+            events(0), running(false)
+    {
+    }
+
+    ~scheduler_thread()
+    {
+        stop();
+    }
+
+    void start()
+    {
+        running = true;
+        thread = std::thread(&scheduler_thread::loop, this);
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+            cv.notify_one();
+        }
+
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    void notify()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++events;
+        cv.notify_one();
+    }
+
+    void loop()
+    {
+        unsigned long seen = 0;
+
+        while (1)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                // timeout in case a downstream pipe was full at last run
+                cv.wait_for(lock, std::chrono::milliseconds(100), [&] { return !running || (events != seen); });
+
+                if (!running) {
+                    break;
+                }
+
+                seen = events;
+            }
+
+            sch.run();
+        }
+    }
+};
+
+struct pipebridge_common
+{
+    virtual ~pipebridge_common()
+    {
+    }
+};
+
+template<typename T>
+struct pipebridge: pipebridge_common
+{
+    // Producer side: runs in the upstream stage
+    struct sender: runnable
+    {
+        sender(scheduler *sch, pipebridge<T> &_bridge, pipebuf<T> &_in) :
+                runnable(sch, _in.name), bridge(_bridge), in(_in)
+        {
+        }
+
+        void run()
+        {
+            unsigned long count = in.readable();
+
+            if (count == 0) {
+                return;
+            }
+
+            unsigned long tail = bridge.tail.load(std::memory_order_relaxed);
+            unsigned long head = bridge.head.load(std::memory_order_acquire);
+            unsigned long space = bridge.size - (tail - head);
+            unsigned long n = min(count, space);
+            T *pin = in.rd();
+
+            for (unsigned long i = 0; i < n; ++i) {
+                bridge.buf[(tail + i) % bridge.size] = pin[i];
+            }
+
+            bridge.tail.store(tail + n, std::memory_order_release);
+
+            // the stage must not stall when the next stage cannot keep up
+            if (n < count) {
+                bridge.ndropped += count - n;
+            }
+
+            in.read(count);
+
+            if (n && bridge.downstream_thread) {
+                bridge.downstream_thread->notify();
+            }
+        }
+
+        pipebridge<T> &bridge;
+        pipereader<T> in;
+    };
+
+    // Consumer side: runs in the downstream stage
+    struct receiver: runnable
+    {
+        receiver(scheduler *sch, pipebridge<T> &_bridge, pipebuf<T> &_out) :
+                runnable(sch, _out.name), bridge(_bridge), out(_out)
+        {
+        }
+
+        void run()
+        {
+            unsigned long head = bridge.head.load(std::memory_order_relaxed);
+            unsigned long tail = bridge.tail.load(std::memory_order_acquire);
+            unsigned long n = min(tail - head, out.writable());
+            T *pout = out.wr();
+
+            for (unsigned long i = 0; i < n; ++i) {
+                pout[i] = bridge.buf[(head + i) % bridge.size];
+            }
+
+            out.written(n);
+            bridge.head.store(head + n, std::memory_order_release);
+        }
+
+        pipebridge<T> &bridge;
+        pipewriter<T> out;
+    };
+
+    pipebridge(scheduler *upstream, pipebuf<T> &in, scheduler *downstream, scheduler_thread *_downstream_thread, unsigned long _size) :
+            buf(new T[_size]),
+            size(_size),
+            head(0),
+            tail(0),
+            ndropped(0),
+            downstream_thread(_downstream_thread),
+            out(downstream, in.name, _size),
+            tx(upstream, *this, in),
+            rx(downstream, *this, out)
+    {
+    }
+
+    ~pipebridge()
+    {
+        delete[] buf;
+    }
+
+    T *buf;
+    unsigned long size;
+    std::atomic<unsigned long> head;  // written by the consumer only
+    std::atomic<unsigned long> tail;  // written by the producer only
+    unsigned long ndropped;           // items lost because the ring was full
+    scheduler_thread *downstream_thread;
+    pipebuf<T> out;                   // copy of the input pipe in the downstream stage
+    sender tx;
+    receiver rx;
+};
+
+struct mtscheduler
+{
+    std::vector<scheduler_thread*> stages;  // stages[0] is not run as a thread
+    std::vector<pipebridge_common*> bridges;
+
+    mtscheduler(int nstages)
+    {
+        for (int i = 0; i < nstages; ++i) {
+            stages.push_back(new scheduler_thread());
+        }
+    }
+
+    ~mtscheduler()
+    {
+        stop();
+
+        for (unsigned int i = 0; i < bridges.size(); ++i) {
+            delete bridges[i];
+        }
+
+        for (unsigned int i = 0; i < stages.size(); ++i) {
+            delete stages[i];
+        }
+    }
+
+    scheduler *stage(int i)
+    {
+        return &stages[i]->sch;
+    }
+
+    // Make the data of [in] (written in stage [from]) available in stage [to]
+    template<typename T>
+    pipebuf<T> *bridge(int from, pipebuf<T> &in, int to, unsigned long size)
+    {
+        pipebridge<T> *b = new pipebridge<T>(stage(from), in, stage(to), to > 0 ? stages[to] : NULL, size);
+        bridges.push_back(b);
+        return &b->out;
+    }
+
+    void start()
+    {
+        for (unsigned int i = 1; i < stages.size(); ++i) {
+            stages[i]->start();
+        }
+    }
+
+    void stop()
+    {
+        for (unsigned int i = 1; i < stages.size(); ++i) {
+            stages[i]->stop();
+        }
+    }
+
+    // Run stage 0 in the calling thread
+    void step()
+    {
+        stages[0]->sch.step();
+    }
+
+    void shutdown()
+    {
+        stop();
+
+        for (unsigned int i = 0; i < stages.size(); ++i) {
+            stages[i]->sch.shutdown();
+        }
+    }
+};
+
+}  // namespace
+
+#endif  // LEANSDR_MTSCHEDULER_H
@@ -3,6 +3,12 @@
 
 #include "leansdr/math.h"
 
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 #define DEBUG_RS 0
 
 namespace leansdr
@@ -99,6 +105,8 @@ struct rs_engine
     gf2x_p<unsigned char, unsigned short, 0x11d, 8, 2> gf;
 
     u8 G[17];  // { G_16, ..., G_0 }
+    u8 rem_table[256][16];         // f*{ G_15, ..., G_0 } to divide by G one coefficient at a time
+    uint64_t rem_table64[256][2];  // Same with coefficients packed in lowest bytes first
 
     rs_engine()
     {
@@ -118,6 +126,16 @@ struct rs_engine
         for ( int i=0; i<=16; ++i ) fprintf(stderr, " %02x", G[i]);
         fprintf(stderr, "\n");
 #endif
+        for (int f = 0; f < 256; ++f)
+        {
+            rem_table64[f][0] = 0;
+            rem_table64[f][1] = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                rem_table[f][i] = gf.mul(f, G[i + 1]);
+                rem_table64[f][i / 8] |= ((uint64_t) rem_table[f][i]) << (8 * (i % 8));
+            }
+        }
     }
 
     // RS-encoded messages are interpreted as coefficients in
@@ -126,7 +144,71 @@ struct rs_engine
     // By convention coefficients are listed by decreasing degree here,
     // so we can evaluate syndromes of the shortened code without
     // prepending with 51 zeroes.
+    // The remainder of the division by G is computed first. It is zero
+    // for valid codewords and has the same syndromes otherwise since
+    // alpha^0..alpha^15 are roots of G.
     bool syndromes(const u8 *poly, u8 *synd)
+    {
+        u8 rem[16];
+        remainder(poly, rem);
+        uint64_t nz = 0;
+        for (int i = 0; i < 16; ++i)
+            nz |= rem[i];
+        if (!nz)
+        {
+            memset(synd, 0, 16);
+            return false;
+        }
+        for (int i = 0; i < 16; ++i)
+            synd[i] = eval_poly_rev(rem, 16, gf.exp(i));
+        return true;
+    }
+
+    // Remainder of the division of the 204 coefficients of poly by G.
+    // Coefficients listed by decreasing degree.
+    void remainder(const u8 *poly, u8 rem[16])
+    {
+#if defined(USE_SSE2)
+        __m128i r = _mm_setzero_si128();
+        for (int i = 0; i < 204; ++i)
+        {
+            // R := R*X + poly[i] - R_15*G
+            int f = _mm_cvtsi128_si32(r) & 0xff;
+            r = _mm_or_si128(_mm_srli_si128(r, 1), _mm_slli_si128(_mm_cvtsi32_si128(poly[i]), 15));
+            r = _mm_xor_si128(r, _mm_loadu_si128((const __m128i *) rem_table[f]));
+        }
+        _mm_storeu_si128((__m128i *) rem, r);
+#elif defined(USE_NEON)
+        uint8x16_t r = vdupq_n_u8(0);
+        for (int i = 0; i < 204; ++i)
+        {
+            // R := R*X + poly[i] - R_15*G
+            int f = vgetq_lane_u8(r, 0);
+            r = vextq_u8(r, vdupq_n_u8(poly[i]), 1);
+            r = veorq_u8(r, vld1q_u8(rem_table[f]));
+        }
+        vst1q_u8(rem, r);
+#else
+        uint64_t lo = 0, hi = 0;
+        for (int i = 0; i < 204; ++i)
+        {
+            // R := R*X + poly[i] - R_15*G
+            int f = lo & 0xff;
+            lo = (lo >> 8) | (hi << 56);
+            hi = (hi >> 8) | (((uint64_t) poly[i]) << 56);
+            lo ^= rem_table64[f][0];
+            hi ^= rem_table64[f][1];
+        }
+        for (int i = 0; i < 8; ++i)
+        {
+            rem[i] = lo >> (8 * i);
+            rem[i + 8] = hi >> (8 * i);
+        }
+#endif
+    }
+
+    // Reference implementation: direct evaluation of the 16 syndromes
+    bool syndromes_horner(const u8 *poly, u8 *synd)
     {
         bool corrupted = false;
         for (int i = 0; i < 16; ++i)
@@ -269,13 +351,31 @@ struct rs_engine
         fprintf(stderr, "\n");
 #endif
 
-        // Find zeroes of C by exhaustive search?
-        // TODO Chien method
+        // Find zeroes of C with Chien search: the terms C_j*alpha^(i*j)
+        // are kept in log domain and advance by j at each step.
         int roots_found = 0;
+        int nterms = 0;
+        int term_log[16], term_inc[16];
+        for (int j = 1; j <= L && j < 16; ++j)
+        {
+            if (C[j])
+            {
+                term_log[nterms] = gf.log(C[j]);
+                term_inc[nterms] = j;
+                ++nterms;
+            }
+        }
         for (int i = 0; i < 255; ++i)
         {
             u8 r = gf.exp(i);  // Candidate root alpha^0..alpha^254
-            u8 v = eval_poly(C, L, r);
+            u8 v = C[0];
+            for (int t = 0; t < nterms; ++t)
+            {
+                v ^= gf.exp(term_log[t]);
+                term_log[t] += term_inc[t];
+                if (term_log[t] >= 255)
+                    term_log[t] -= 255;
+            }
             if (!v)
             {
                 // r is a root X_k^-1 of the error locator polynomial.
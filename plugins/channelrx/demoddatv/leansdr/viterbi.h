@@ -4,6 +4,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+
+// x86 kernels are compiled for their instruction set whatever the build flags and selected at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LEANSDR_VITERBI_X86_RUNTIME
+#define LEANSDR_VITERBI_SSE2 __attribute__((target("sse2")))
+#define LEANSDR_VITERBI_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
 
 // This is a generic implementation of Viterbi with explicit
 // representation of the trellis.  There is special support for
@@ -305,6 +316,368 @@ private:
     TPM max_tpm;
 };
 
+// Branches of a trellis in structure of arrays layout.
+// Branch k of state s is the k-th valid incoming branch by increasing
+// coded symbol, as scanned by viterbi_dec. States with fewer branches
+// are padded with copies of their last branch that never match.
+// Shared by all decoders of a same trellis.
+
+template<typename TS, int NSTATES, typename TUS, int NUS, int NCS>
+struct trellis_tables
+{
+    int nbranches;                  // Incoming branches per state
+    int32_t pred[NUS][NSTATES];     // Predecessor state
+    int32_t label[NUS][NSTATES];    // Coded symbol or -1 for padding
+    TUS us[NUS][NSTATES];           // Uncoded symbol
+
+    trellis_tables(trellis<TS, NSTATES, TUS, NUS, NCS> *trell) :
+            nbranches(0)
+    {
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            int k = 0;
+            for (int cs = 0; cs < NCS && k < NUS; ++cs)
+            {
+                typename trellis<TS, NSTATES, TUS, NUS, NCS>::state::branch *b = &trell->states[s].branches[cs];
+                if (b->pred == trell->NOSTATE)
+                    continue;
+                pred[k][s] = b->pred;
+                label[k][s] = cs;
+                us[k][s] = b->us;
+                ++k;
+            }
+            if (k > nbranches)
+                nbranches = k;
+            for (int kpad = k; kpad < NUS; ++kpad)
+            {
+                pred[kpad][s] = k ? pred[k - 1][s] : 0;
+                label[kpad][s] = -1;
+                us[kpad][s] = k ? us[k - 1][s] : 0;
+            }
+        }
+    }
+};
+
+// Add-compare-select of one branch for all states.
+// p[s] = cur[pred[s]] is the path metric of the predecessor on branch k
+// of state s. minp/selp track the best predecessor metric (last one on
+// ties) and its branch, mm/mk the metric of the branch labelled cs and
+// its branch. nstates is a multiple of 8.
+
+typedef void (*viterbi_acs_kernel)(const int32_t *cur, const int32_t *pred, const int32_t *label,
+        int nstates, int32_t k, int32_t cs, int32_t cost,
+        int32_t *minp, int32_t *selp, int32_t *mm, int32_t *mk);
+
+inline void viterbi_acs_plain(const int32_t *cur, const int32_t *pred, const int32_t *label,
+        int nstates, int32_t k, int32_t cs, int32_t cost,
+        int32_t *minp, int32_t *selp, int32_t *mm, int32_t *mk)
+{
+    for (int s = 0; s < nstates; ++s)
+    {
+        int32_t p = cur[pred[s]];
+        if (p <= minp[s])
+        {
+            minp[s] = p;
+            selp[s] = k;
+        }
+        if (label[s] == cs)
+        {
+            mm[s] = p + cost;
+            mk[s] = k;
+        }
+    }
+}
+
+#if defined(LEANSDR_VITERBI_SSE2)
+LEANSDR_VITERBI_SSE2
+inline void viterbi_acs_sse2(const int32_t *cur, const int32_t *pred, const int32_t *label,
+        int nstates, int32_t k, int32_t cs, int32_t cost,
+        int32_t *minp, int32_t *selp, int32_t *mm, int32_t *mk)
+{
+    const __m128i vk = _mm_set1_epi32(k), vcs = _mm_set1_epi32(cs), vcost = _mm_set1_epi32(cost);
+    for (int s = 0; s < nstates; s += 4)
+    {
+        __m128i vp = _mm_set_epi32(cur[pred[s + 3]], cur[pred[s + 2]], cur[pred[s + 1]], cur[pred[s]]);
+        __m128i vmin = _mm_loadu_si128((const __m128i *) &minp[s]);
+        __m128i gt = _mm_cmpgt_epi32(vp, vmin);
+        _mm_storeu_si128((__m128i *) &minp[s], _mm_or_si128(_mm_and_si128(gt, vmin), _mm_andnot_si128(gt, vp)));
+        _mm_storeu_si128((__m128i *) &selp[s], _mm_or_si128(_mm_and_si128(gt, _mm_loadu_si128((const __m128i *) &selp[s])), _mm_andnot_si128(gt, vk)));
+        __m128i match = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &label[s]), vcs);
+        _mm_storeu_si128((__m128i *) &mm[s], _mm_or_si128(_mm_and_si128(match, _mm_add_epi32(vp, vcost)), _mm_andnot_si128(match, _mm_loadu_si128((const __m128i *) &mm[s]))));
+        _mm_storeu_si128((__m128i *) &mk[s], _mm_or_si128(_mm_and_si128(match, vk), _mm_andnot_si128(match, _mm_loadu_si128((const __m128i *) &mk[s]))));
+    }
+}
+#endif
+
+#if defined(LEANSDR_VITERBI_AVX2)
+LEANSDR_VITERBI_AVX2
+inline void viterbi_acs_avx2(const int32_t *cur, const int32_t *pred, const int32_t *label,
+        int nstates, int32_t k, int32_t cs, int32_t cost,
+        int32_t *minp, int32_t *selp, int32_t *mm, int32_t *mk)
+{
+    const __m256i vk = _mm256_set1_epi32(k), vcs = _mm256_set1_epi32(cs), vcost = _mm256_set1_epi32(cost);
+    for (int s = 0; s < nstates; s += 8)
+    {
+        __m256i vp = _mm256_i32gather_epi32(cur, _mm256_loadu_si256((const __m256i *) &pred[s]), 4);
+        __m256i vmin = _mm256_loadu_si256((const __m256i *) &minp[s]);
+        __m256i gt = _mm256_cmpgt_epi32(vp, vmin);
+        _mm256_storeu_si256((__m256i *) &minp[s], _mm256_blendv_epi8(vp, vmin, gt));
+        _mm256_storeu_si256((__m256i *) &selp[s], _mm256_blendv_epi8(vk, _mm256_loadu_si256((const __m256i *) &selp[s]), gt));
+        __m256i match = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &label[s]), vcs);
+        _mm256_storeu_si256((__m256i *) &mm[s], _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i *) &mm[s]), _mm256_add_epi32(vp, vcost), match));
+        _mm256_storeu_si256((__m256i *) &mk[s], _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i *) &mk[s]), vk, match));
+    }
+}
+#endif
+
+#if defined(USE_NEON) && !defined(LEANSDR_VITERBI_X86_RUNTIME)
+inline void viterbi_acs_neon(const int32_t *cur, const int32_t *pred, const int32_t *label,
+        int nstates, int32_t k, int32_t cs, int32_t cost,
+        int32_t *minp, int32_t *selp, int32_t *mm, int32_t *mk)
+{
+    const int32x4_t vk = vdupq_n_s32(k), vcs = vdupq_n_s32(cs), vcost = vdupq_n_s32(cost);
+    for (int s = 0; s < nstates; s += 4)
+    {
+        int32_t p[4] = { cur[pred[s]], cur[pred[s + 1]], cur[pred[s + 2]], cur[pred[s + 3]] };
+        int32x4_t vp = vld1q_s32(p);
+        int32x4_t vmin = vld1q_s32(&minp[s]);
+        uint32x4_t gt = vcgtq_s32(vp, vmin);
+        vst1q_s32(&minp[s], vbslq_s32(gt, vmin, vp));
+        vst1q_s32(&selp[s], vbslq_s32(gt, vld1q_s32(&selp[s]), vk));
+        uint32x4_t match = vceqq_s32(vld1q_s32(&label[s]), vcs);
+        vst1q_s32(&mm[s], vbslq_s32(match, vaddq_s32(vp, vcost), vld1q_s32(&mm[s])));
+        vst1q_s32(&mk[s], vbslq_s32(match, vk, vld1q_s32(&mk[s])));
+    }
+}
+#endif
+
+struct viterbi_acs_kernel_info
+{
+    viterbi_acs_kernel acs;
+    const char *name;
+};
+
+// Kernels supported by the CPU, fastest first. The plain kernel is always
+// last. Returns the number of kernels (at most 3).
+
+inline int viterbi_acs_kernels(viterbi_acs_kernel_info kernels[3])
+{
+    int n = 0;
+#if defined(LEANSDR_VITERBI_X86_RUNTIME)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        kernels[n].acs = viterbi_acs_avx2;
+        kernels[n++].name = "AVX2";
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        kernels[n].acs = viterbi_acs_sse2;
+        kernels[n++].name = "SSE2";
+    }
+#elif defined(USE_NEON)
+    kernels[n].acs = viterbi_acs_neon;
+    kernels[n++].name = "NEON";
+#endif
+    kernels[n].acs = viterbi_acs_plain;
+    kernels[n++].name = "C++";
+    return n;
+}
+
+// Kernel used by default: the CPU is probed once
+
+inline const viterbi_acs_kernel_info &viterbi_acs_default()
+{
+    struct selector
+    {
+        static viterbi_acs_kernel_info select()
+        {
+            viterbi_acs_kernel_info kernels[3];
+            viterbi_acs_kernels(kernels);
+            return kernels[0];
+        }
+    };
+    static const viterbi_acs_kernel_info kernel = selector::select();
+    return kernel;
+}
+
+// Viterbi decoder giving the same results as viterbi_dec with 32 bit
+// path metrics. The add-compare-select of all states is vectorized
+// (AVX2 or SSE2 selected at runtime on x86, NEON when built for it) for
+// the single-symbol metric used by viterbi_sync. Other updates use the
+// scalar algorithm. NSTATES must be a multiple of 8.
+
+template<typename TS, int NSTATES, typename TUS, int NUS, typename TCS, int NCS, typename TBM, typename TPM, typename TP>
+struct viterbi_dec_simd: viterbi_dec_interface<TUS, TCS, TBM, TPM>
+{
+    typedef trellis<TS, NSTATES, TUS, NUS, NCS> trellis_type;
+    typedef trellis_tables<TS, NSTATES, TUS, NUS, NCS> tables_type;
+
+    trellis_type *trell;
+    tables_type *tables;
+    int32_t costs[2][NSTATES];  // Metric of best path leading to each state
+    TP paths[2][NSTATES];       // Best path leading to each state
+    int bank;                   // Current bank
+    viterbi_acs_kernel acs;     // Add-compare-select kernel
+
+    viterbi_dec_simd(trellis_type *_trellis, tables_type *_tables, viterbi_acs_kernel _acs = 0) :
+            trell(_trellis), tables(_tables), bank(0), acs(_acs ? _acs : viterbi_acs_default().acs)
+    {
+        for (int s = 0; s < NSTATES; ++s)
+            costs[0][s] = 0;
+    }
+
+    // Update with single-symbol metric.
+    // cost must be negative.
+
+    TUS update(TCS cs, TBM cost, TPM *quality = NULL)
+    {
+        int32_t *cur = costs[bank];
+        int32_t minp[NSTATES], selp[NSTATES], mm[NSTATES], mk[NSTATES];
+
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            minp[s] = INT32_MAX;
+            selp[s] = 0;
+            mm[s] = INT32_MAX;
+            mk[s] = 0;
+        }
+
+        for (int k = 0; k < tables->nbranches; ++k)
+            acs(cur, tables->pred[k], tables->label[k], NSTATES, k, cs, cost, minp, selp, mm, mk);
+
+        return select(minp, selp, mm, mk, quality);
+    }
+
+    // Update with full metric
+
+    TUS update(TBM costs_in[NCS], TPM *quality = NULL)
+    {
+        int32_t *cur = costs[bank];
+        int32_t minp[NSTATES], selp[NSTATES], mm[NSTATES], mk[NSTATES];
+
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            minp[s] = INT32_MAX;
+            selp[s] = 0;
+            mm[s] = INT32_MAX;
+            for (int k = 0; k < tables->nbranches; ++k)
+            {
+                if (tables->label[k][s] < 0)
+                    continue;
+                int32_t m = cur[tables->pred[k][s]] + costs_in[tables->label[k][s]];
+                if (m <= minp[s])
+                {
+                    minp[s] = m;
+                    selp[s] = k;
+                }
+            }
+            mk[s] = selp[s];
+        }
+
+        return select(minp, selp, mm, mk, quality);
+    }
+
+    // Update with partial metrics.
+    // The costs provided must be negative.
+    // The other symbols will be assigned a cost of 0.
+
+    TUS update(int nm, TCS cs[], TBM costs_in[], TPM *quality = NULL)
+    {
+        int32_t *cur = costs[bank];
+        int32_t minp[NSTATES], selp[NSTATES], mm[NSTATES], mk[NSTATES];
+
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            // Branches with metrics first then all branches as in viterbi_dec
+            int32_t best_m = INT32_MAX;
+            int32_t best_k = 0;
+            for (int im = 0; im < nm; ++im)
+            {
+                for (int k = 0; k < tables->nbranches; ++k)
+                {
+                    if (tables->label[k][s] != cs[im])
+                        continue;
+                    int32_t m = cur[tables->pred[k][s]] + costs_in[im];
+                    if (m <= best_m)
+                    {
+                        best_m = m;
+                        best_k = k;
+                    }
+                }
+            }
+            if (nm != NCS)
+            {
+                for (int k = 0; k < tables->nbranches; ++k)
+                {
+                    int32_t m = cur[tables->pred[k][s]];
+                    if (m <= best_m)
+                    {
+                        best_m = m;
+                        best_k = k;
+                    }
+                }
+            }
+            minp[s] = best_m;
+            selp[s] = best_k;
+            mm[s] = INT32_MAX;
+            mk[s] = best_k;
+        }
+
+        return select(minp, selp, mm, mk, quality);
+    }
+
+private:
+    // Survivor selection, path update and metric normalization
+    TUS select(const int32_t *minp, const int32_t *selp, const int32_t *mm, const int32_t *mk, TPM *quality)
+    {
+        int32_t *next = costs[bank ^ 1];
+        TP *curpaths = paths[bank];
+        TP *nextpaths = paths[bank ^ 1];
+        int32_t best_tpm = INT32_MAX, best2_tpm = INT32_MAX;
+        TS best_state = 0;
+
+        for (int s = 0; s < NSTATES; ++s)
+        {
+            int32_t best_m;
+            int k;
+            if (minp[s] <= mm[s])
+            {
+                best_m = minp[s];
+                k = selp[s];
+            }
+            else
+            {
+                best_m = mm[s];
+                k = mk[s];
+            }
+            nextpaths[s] = curpaths[tables->pred[k][s]];
+            nextpaths[s].append(tables->us[k][s]);
+            next[s] = best_m;
+            // Select best and second-best states
+            if (best_m < best_tpm)
+            {
+                best_state = s;
+                best2_tpm = best_tpm;
+                best_tpm = best_m;
+            }
+            else if (best_m < best2_tpm)
+                best2_tpm = best_m;
+        }
+
+        bank ^= 1;
+
+        // Prevent overflow of path metrics
+        for (int s = 0; s < NSTATES; ++s)
+            next[s] -= best_tpm;
+        // Return difference between best and second-best as quality metric.
+        if (quality)
+            *quality = best2_tpm - best_tpm;
+        // Return uncoded symbol of best path
+        return nextpaths[best_state].read();
+    }
+};
+
 // Paths (sequences of uncoded symbols) represented as bitstreams.
 // NBITS is the number of bits per symbol.
 // DEPTH is the number of symbols stored in the path.
@@ -122,10 +122,16 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_dsdDecoder.enableMbelib(!DSPEngine::instance()->hasDVSerialSupport()); // disable mbelib if DV serial support is present and activated else enable it
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++;
 
         if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
         {
@@ -296,7 +302,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	        if (nbAudioSamples > 0)
 	        {
 	            if (!m_settings.m_audioMute) {
-	                m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples, 10);
+	                m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples);
 	            }
 
 	            m_dsdDecoder.resetAudio1();
@@ -311,7 +317,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
             if (nbAudioSamples > 0)
             {
                 if (!m_settings.m_audioMute) {
-                    m_audioFifo2.write((const quint8*) dsdAudio, nbAudioSamples, 10);
+                    m_audioFifo2.write((const quint8*) dsdAudio, nbAudioSamples);
                 }
 
                 m_dsdDecoder.resetAudio2();
@@ -324,7 +330,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 //	    if (nbAudioSamples > 0)
 //	    {
 //	        if (!m_settings.m_audioMute) {
-//	            uint res = m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples, 10);
+//	            uint res = m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples);
 //	        }
 //
 //	        m_dsdDecoder.resetAudio1();
@@ -210,6 +210,8 @@ private:
     quint32 m_audioSampleRate;
 
 	NCO m_nco;
+
+	std::vector<Complex> m_mixBuffer; //!< NCO mixed samples of current block
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
@@ -260,10 +260,16 @@ void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
 
 	m_settingsMutex.lock();
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
-		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++ / SDR_RX_SCALEF;
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
@@ -141,6 +141,8 @@ private:
 	short* finetune;
 
 	NCO m_nco;
+
+	std::vector<Complex> m_mixBuffer; //!< NCO mixed samples of current block
 	Interpolator m_interpolator;
 	Real m_sampleDistanceRemain;
 
@@ -93,6 +93,7 @@ NFMDemod::NFMDemod(DeviceSourceAPI *devieAPI) :
     m_channelizer = new DownChannelizer(this);
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer, this);
     m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+    m_deviceAPI->setChannelizerBankSink(m_threadedChannelizer, m_settings.m_inputFrequencyOffset, m_settings.m_rfBandwidth, m_audioSampleRate);
     m_deviceAPI->addChannelAPI(this);
 }
 
@@ -139,186 +140,187 @@ Real angleDist(Real a, Real b)
 
 void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst __attribute__((unused)))
 {
-	Complex ci;
-
 	if (!m_running) {
 	    return;
 	}
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
-	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+		m_decimBuffer.resize(end - begin);
+	}
 
-        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-        {
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+
+	int nbDecimated = m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance,
+		m_mixBuffer.data(), end - begin, m_decimBuffer.data()); // decimate whole block
 
-            qint16 sample;
+	for (int i = 0; i < nbDecimated; i++)
+	{
+        const Complex& ci = m_decimBuffer[i];
 
-            double magsqRaw; // = ci.real()*ci.real() + c.imag()*c.imag();
-            Real deviation;
+        qint16 sample;
 
-            Real demod = m_phaseDiscri.phaseDiscriminatorDelta(ci, magsqRaw, deviation);
+        double magsqRaw; // = ci.real()*ci.real() + c.imag()*c.imag();
+        Real deviation;
 
-            Real magsq = magsqRaw / (SDR_RX_SCALED*SDR_RX_SCALED);
-            m_movingAverage(magsq);
-            m_magsqSum += magsq;
+        Real demod = m_phaseDiscri.phaseDiscriminatorDelta(ci, magsqRaw, deviation);
 
-            if (magsq > m_magsqPeak)
-            {
-                m_magsqPeak = magsq;
-            }
+        Real magsq = magsqRaw / (SDR_RX_SCALED*SDR_RX_SCALED);
+        m_movingAverage(magsq);
+        m_magsqSum += magsq;
+
+        if (magsq > m_magsqPeak)
+        {
+            m_magsqPeak = magsq;
+        }
 
-            m_magsqCount++;
-            m_sampleCount++;
+        m_magsqCount++;
+        m_sampleCount++;
 
-            // AF processing
+        // AF processing
 
-            if (m_settings.m_deltaSquelch)
+        if (m_settings.m_deltaSquelch)
+        {
+            if (m_afSquelch.analyze(demod * m_discriCompensation))
             {
-                if (m_afSquelch.analyze(demod * m_discriCompensation))
-                {
-                    m_afSquelchOpen = m_afSquelch.evaluate(); // ? m_squelchGate + m_squelchDecay : 0;
+                m_afSquelchOpen = m_afSquelch.evaluate(); // ? m_squelchGate + m_squelchDecay : 0;
 
-                    if (!m_afSquelchOpen) {
-                        m_squelchDelayLine.zeroBack(m_audioSampleRate/10); // zero out evaluation period
-                    }
+                if (!m_afSquelchOpen) {
+                    m_squelchDelayLine.zeroBack(m_audioSampleRate/10); // zero out evaluation period
                 }
+            }
 
-                if (m_afSquelchOpen)
-                {
-                    m_squelchDelayLine.write(demod * m_discriCompensation);
+            if (m_afSquelchOpen)
+            {
+                m_squelchDelayLine.write(demod * m_discriCompensation);
 
-                    if (m_squelchCount < 2*m_squelchGate) {
-                        m_squelchCount++;
-                    }
+                if (m_squelchCount < 2*m_squelchGate) {
+                    m_squelchCount++;
                 }
-                else
-                {
-                    m_squelchDelayLine.write(0);
+            }
+            else
+            {
+                m_squelchDelayLine.write(0);
 
-                    if (m_squelchCount > 0) {
-                        m_squelchCount--;
-                    }
+                if (m_squelchCount > 0) {
+                    m_squelchCount--;
                 }
             }
-            else
+        }
+        else
+        {
+            if ((Real) m_movingAverage < m_squelchLevel)
             {
-                if ((Real) m_movingAverage < m_squelchLevel)
-                {
-                    m_squelchDelayLine.write(0);
+                m_squelchDelayLine.write(0);
 
-                    if (m_squelchCount > 0) {
-                        m_squelchCount--;
-                    }
+                if (m_squelchCount > 0) {
+                    m_squelchCount--;
                 }
-                else
-                {
-                    m_squelchDelayLine.write(demod * m_discriCompensation);
+            }
+            else
+            {
+                m_squelchDelayLine.write(demod * m_discriCompensation);
 
-                    if (m_squelchCount < 2*m_squelchGate) {
-                        m_squelchCount++;
-                    }
+                if (m_squelchCount < 2*m_squelchGate) {
+                    m_squelchCount++;
                 }
             }
+        }
 
-            m_squelchOpen = (m_squelchCount > m_squelchGate);
+        m_squelchOpen = (m_squelchCount > m_squelchGate);
 
-            if (m_settings.m_audioMute)
-            {
-                sample = 0;
-            }
-            else
+        if (m_settings.m_audioMute)
+        {
+            sample = 0;
+        }
+        else
+        {
+            if (m_squelchOpen)
             {
-                if (m_squelchOpen)
+                if (m_settings.m_ctcssOn)
                 {
-                    if (m_settings.m_ctcssOn)
-                    {
-                        Real ctcss_sample = m_lowpass.filter(demod * m_discriCompensation);
+                    Real ctcss_sample = m_lowpass.filter(demod * m_discriCompensation);
 
-                        if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
+                    if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
+                    {
+                        if (m_ctcssDetector.analyze(&ctcss_sample))
                         {
-                            if (m_ctcssDetector.analyze(&ctcss_sample))
-                            {
-                                int maxToneIndex;
+                            int maxToneIndex;
 
-                                if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+                            if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+                            {
+                                if (maxToneIndex+1 != m_ctcssIndex)
                                 {
-                                    if (maxToneIndex+1 != m_ctcssIndex)
-                                    {
-                                        if (getMessageQueueToGUI()) {
-                                            MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
-                                            getMessageQueueToGUI()->push(msg);
-                                        }
-                                        m_ctcssIndex = maxToneIndex+1;
+                                    if (getMessageQueueToGUI()) {
+                                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
+                                        getMessageQueueToGUI()->push(msg);
                                     }
+                                    m_ctcssIndex = maxToneIndex+1;
                                 }
-                                else
+                            }
+                            else
+                            {
+                                if (m_ctcssIndex != 0)
                                 {
-                                    if (m_ctcssIndex != 0)
-                                    {
-                                        if (getMessageQueueToGUI()) {
-                                            MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
-                                            getMessageQueueToGUI()->push(msg);
-                                        }
-                                        m_ctcssIndex = 0;
+                                    if (getMessageQueueToGUI()) {
+                                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
+                                        getMessageQueueToGUI()->push(msg);
                                     }
+                                    m_ctcssIndex = 0;
                                 }
                             }
                         }
                     }
+                }
 
-                    if (m_settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
-                    {
-                        sample = 0;
-                    }
-                    else
-                    {
-                        sample = m_bandpass.filter(m_squelchDelayLine.readBack(m_squelchGate)) * m_settings.m_volume;
-                    }
+                if (m_settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
+                {
+                    sample = 0;
                 }
                 else
                 {
-                    if (m_ctcssIndex != 0)
-                    {
-                        if (getMessageQueueToGUI()) {
-                            MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
-                            getMessageQueueToGUI()->push(msg);
-                        }
-
-                        m_ctcssIndex = 0;
+                    sample = m_bandpass.filter(m_squelchDelayLine.readBack(m_squelchGate)) * m_settings.m_volume;
+                }
+            }
+            else
+            {
+                if (m_ctcssIndex != 0)
+                {
+                    if (getMessageQueueToGUI()) {
+                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
+                        getMessageQueueToGUI()->push(msg);
                     }
 
-                    sample = 0;
+                    m_ctcssIndex = 0;
                 }
-            }
 
+                sample = 0;
+            }
+        }
 
-            m_audioBuffer[m_audioBufferFill].l = sample;
-            m_audioBuffer[m_audioBufferFill].r = sample;
-            ++m_audioBufferFill;
 
-            if (m_audioBufferFill >= m_audioBuffer.size())
-            {
-                uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+        m_audioBuffer[m_audioBufferFill].l = sample;
+        m_audioBuffer[m_audioBufferFill].r = sample;
+        ++m_audioBufferFill;
 
-                if (res != m_audioBufferFill)
-                {
-                    qDebug("NFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
-                }
+        if (m_audioBufferFill >= m_audioBuffer.size())
+        {
+            uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
-                m_audioBufferFill = 0;
+            if (res != m_audioBufferFill)
+            {
+                qDebug("NFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
             }
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
+            m_audioBufferFill = 0;
         }
 	}
 
 	if (m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if (res != m_audioBufferFill)
 		{
@@ -369,6 +371,7 @@ bool NFMDemod::handleMessage(const Message& cmd)
         m_channelizer->configure(m_channelizer->getInputMessageQueue(),
             cfg.getSampleRate(),
             cfg.getCenterFrequency());
+        m_deviceAPI->setChannelizerBankSink(m_threadedChannelizer, cfg.getCenterFrequency(), m_settings.m_rfBandwidth, cfg.getSampleRate());
 
         return true;
     }
@@ -377,6 +380,10 @@ bool NFMDemod::handleMessage(const Message& cmd)
 	    MsgConfigureNFMDemod& cfg = (MsgConfigureNFMDemod&) cmd;
 		qDebug() << "NFMDemod::handleMessage: MsgConfigureNFMDemod";
 
+        if (cfg.getSettings().m_rfBandwidth != m_settings.m_rfBandwidth) { // channel may no longer fit in its bank bin or fit now
+            m_deviceAPI->setChannelizerBankSink(m_threadedChannelizer, m_settings.m_inputFrequencyOffset, cfg.getSettings().m_rfBandwidth, m_audioSampleRate);
+        }
+
         applySettings(cfg.getSettings(), cfg.getForce());
 
         return true;
@@ -201,6 +201,9 @@ private:
 	bool m_running;
 
 	NCO m_nco;
+
+	std::vector<Complex> m_mixBuffer; //!< NCO mixed samples of current block
+	std::vector<Complex> m_decimBuffer; //!< decimated samples of current block
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
@@ -155,10 +155,16 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	int decim = 1<<(m_spanLog2 - 1);
 	unsigned char decim_mask = decim - 1; // counter LSB bit mask for decimation by 2^(m_scaleLog2 - 1)
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++;
 
 		if(m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
 		{
@@ -253,7 +259,7 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 			if (m_audioBufferFill >= m_audioBuffer.size())
 			{
-				uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+				uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 				if (res != m_audioBufferFill)
 				{
@@ -265,7 +271,7 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 		}
 	}
 
-	uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+	uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 	if (res != m_audioBufferFill)
 	{
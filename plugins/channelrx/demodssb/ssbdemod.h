@@ -296,6 +296,8 @@ private:
     bool m_audioActive;         //!< True if an audio signal is produced (no AGC or AGC and above threshold)
 
 	NCOF m_nco;
+
+	std::vector<Complex> m_mixBuffer; //!< NCO mixed samples of current block
     Interpolator m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
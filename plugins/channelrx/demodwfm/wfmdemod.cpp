@@ -98,10 +98,16 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_settingsMutex.lock();
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++;
 
 		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
 
@@ -152,7 +158,7 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 				if(m_audioBufferFill >= m_audioBuffer.size())
 				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 					if (res != m_audioBufferFill) {
 						qDebug("WFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
@@ -168,7 +174,7 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	if (m_audioBufferFill > 0)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 		if (res != m_audioBufferFill) {
 			qDebug("WFMDemod::feed: %u/%u tail samples written", res, m_audioBufferFill);
@@ -65,6 +65,9 @@ UDPSrc::UDPSrc(DeviceSourceAPI *deviceAPI) :
 	m_udpBuffer16 = new UDPSink<Sample16>(this, udpBlockSize, m_settings.m_udpPort);
 	m_udpBufferMono16 = new UDPSink<int16_t>(this, udpBlockSize, m_settings.m_udpPort);
     m_udpBuffer24 = new UDPSink<Sample24>(this, udpBlockSize, m_settings.m_udpPort);
+	m_udpBuffer16->setSharedSender(true); // do not block the channel thread on the socket
+	m_udpBufferMono16->setSharedSender(true);
+	m_udpBuffer24->setSharedSender(true);
 	m_audioSocket = new QUdpSocket(this);
 	m_udpAudioBuf = new char[m_udpAudioPayloadSize];
 
@@ -142,10 +145,16 @@ void UDPSrc::feed(const SampleVector::const_iterator& begin, const SampleVector:
 	m_sampleBuffer.clear();
 	m_settingsMutex.lock();
 
+	if (m_mixBuffer.size() < (unsigned int) (end - begin)) {
+		m_mixBuffer.resize(end - begin);
+	}
+
+	m_nco.mix(begin, end, m_mixBuffer.data()); // mix whole block with NCO
+	const Complex *mixed = m_mixBuffer.data();
+
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *mixed++;
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
@@ -414,7 +423,7 @@ void UDPSrc::audioReadyRead()
 
 					if (m_audioBufferFill >= m_audioBuffer.size())
 					{
-						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 						if (res != m_audioBufferFill)
 						{
@@ -436,7 +445,7 @@ void UDPSrc::audioReadyRead()
 
 					if (m_audioBufferFill >= m_audioBuffer.size())
 					{
-						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+						uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
 						if (res != m_audioBufferFill)
 						{
@@ -448,7 +457,7 @@ void UDPSrc::audioReadyRead()
 				}
 			}
 
-			if (m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 0) != m_audioBufferFill)
+			if (m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill) != m_audioBufferFill)
 			{
 				qDebug("UDPSrc::audioReadyRead: lost samples");
 			}
@@ -358,6 +358,51 @@ void UDPSocket::SendDataGram( const void *buffer, int bufferLen, const string &f
 
 }
 
+int UDPSocket::SendDataGrams(void * const buffers[], const int bufferLens[], int nbBuffers, const sockaddr_in& destAddr)
+{
+#if defined(__linux__)
+    static const int maxBatch = 64;
+    struct mmsghdr msgs[maxBatch];
+    struct iovec iovecs[maxBatch];
+    int nbSent = 0;
+
+    while (nbSent < nbBuffers)
+    {
+        int nbMsgs = nbBuffers - nbSent < maxBatch ? nbBuffers - nbSent : maxBatch;
+        memset(msgs, 0, nbMsgs * sizeof(struct mmsghdr));
+
+        for (int i = 0; i < nbMsgs; i++)
+        {
+            iovecs[i].iov_base = buffers[nbSent + i];
+            iovecs[i].iov_len = bufferLens[nbSent + i];
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = (void *) &destAddr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(destAddr);
+        }
+
+        int ret = sendmmsg(m_sockDesc, msgs, nbMsgs, 0);
+
+        if (ret <= 0) {
+            break;
+        }
+
+        nbSent += ret;
+    }
+
+    return nbSent;
+#else
+    for (int i = 0; i < nbBuffers; i++)
+    {
+        if (sendto(m_sockDesc, buffers[i], bufferLens[i], 0, (const sockaddr *) &destAddr, sizeof(destAddr)) != bufferLens[i]) {
+            return i;
+        }
+    }
+
+    return nbBuffers;
+#endif
+}
+
 int UDPSocket::RecvDataGram( void *buffer, int bufferLen, string &sourceAddress, unsigned short &sourcePort )
 {
     sockaddr_in clntAddr;
@@ -296,6 +296,26 @@ public:
     void SendDataGram(const void *buffer, int bufferLen, const string &foreignAddress,
         unsigned short foreignPort);
 
+  /**
+   *   Send several datagrams to the same resolved address in as few system calls
+   *   as possible (sendmmsg on Linux else one sendto per datagram)
+   *   @param buffers datagrams to be written
+   *   @param bufferLens sizes of the datagrams
+   *   @param nbBuffers number of datagrams
+   *   @param destAddr destination address as given by ResolveAddr
+   *   @return number of datagrams sent. Stops at the first failure.
+   */
+    int SendDataGrams(void * const buffers[], const int bufferLens[], int nbBuffers, const sockaddr_in& destAddr);
+
+  /**
+   *   Resolve address (IP address or name) and port once for SendDataGrams
+   *   @exception SocketException thrown if unable to resolve the address
+   */
+    static void ResolveAddr(const string &foreignAddress, unsigned short foreignPort, sockaddr_in& destAddr)
+    {
+        FillAddr(foreignAddress, foreignPort, destAddr);
+    }
+
     /**
      *   Read read up to bufferLen bytes data from this socket.  The given buffer
      *   is where the data will be placed
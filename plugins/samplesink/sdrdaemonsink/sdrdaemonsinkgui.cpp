@@ -39,6 +39,7 @@
 #include "device/devicesinkapi.h"
 #include "device/deviceuiset.h"
 #include "sdrdaemonsinkgui.h"
+#include "udpsinkfec.h"
 
 SDRdaemonSinkGui::SDRdaemonSinkGui(DeviceUISet *deviceUISet, QWidget* parent) :
 	QWidget(parent),
@@ -235,7 +236,7 @@ void SDRdaemonSinkGui::updateSampleRateAndFrequency()
 
 void SDRdaemonSinkGui::updateTxDelayTooltip()
 {
-    double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
+    double delay = ((UDPSinkFEC::getSamplesPerBlock(m_settings.m_udpBlockSize, m_settings.m_compressionBits)*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
     ui->txDelayText->setToolTip(tr("%1 us").arg(QString::number(delay*1e6, 'f', 0)));
 }
 
@@ -70,10 +70,12 @@ bool SDRdaemonSinkOutput::start()
 	m_sdrDaemonSinkThread->setCenterFrequency(m_settings.m_centerFrequency);
 	m_sdrDaemonSinkThread->setSamplerate(m_settings.m_sampleRate);
 	m_sdrDaemonSinkThread->setNbBlocksFEC(m_settings.m_nbFECBlocks);
+	m_sdrDaemonSinkThread->setUdpSize(m_settings.m_udpBlockSize);
+	m_sdrDaemonSinkThread->setCompressionBits(m_settings.m_compressionBits);
 	m_sdrDaemonSinkThread->connectTimer(m_masterTimer);
 	m_sdrDaemonSinkThread->startWork();
 
-    double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
+    double delay = ((UDPSinkFEC::getSamplesPerBlock(m_settings.m_udpBlockSize, m_settings.m_compressionBits)*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
     m_sdrDaemonSinkThread->setTxDelay((int) (delay*1e6));
 
 	mutexLocker.unlock();
@@ -306,15 +308,39 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
         changeTxDelay = true;
     }
 
+    if (force || (m_settings.m_udpBlockSize != settings.m_udpBlockSize))
+    {
+        m_settings.m_udpBlockSize = settings.m_udpBlockSize;
+
+        if (m_sdrDaemonSinkThread != 0)
+        {
+            m_sdrDaemonSinkThread->setUdpSize(m_settings.m_udpBlockSize);
+        }
+
+        changeTxDelay = true;
+    }
+
+    if (force || (m_settings.m_compressionBits != settings.m_compressionBits))
+    {
+        m_settings.m_compressionBits = settings.m_compressionBits;
+
+        if (m_sdrDaemonSinkThread != 0)
+        {
+            m_sdrDaemonSinkThread->setCompressionBits(m_settings.m_compressionBits);
+        }
+
+        changeTxDelay = true;
+    }
+
     if (changeTxDelay)
     {
-        double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
+        double delay = ((UDPSinkFEC::getSamplesPerBlock(m_settings.m_udpBlockSize, m_settings.m_compressionBits)*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
         qDebug("SDRdaemonSinkOutput::applySettings: Tx delay: %f us", delay*1e6);
 
         if (m_sdrDaemonSinkThread != 0)
         {
             // delay is calculated as a fraction of the nominal UDP block process time
-            // frame size: 127 * 127 samples
+            // frame size: 127 blocks of samples per UDP block samples
             // divided by sample rate gives the frame process time
             // divided by the number of actual blocks including FEC blocks gives the block (i.e. UDP block) process time
             m_sdrDaemonSinkThread->setTxDelay((int) (delay*1e6));
@@ -323,13 +349,15 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
 
     mutexLocker.unlock();
 
-    qDebug("SDRdaemonSinkOutput::applySettings: %s m_centerFrequency: %llu m_sampleRate: %llu m_log2Interp: %d m_txDelay: %f m_nbFECBlocks: %d",
+    qDebug("SDRdaemonSinkOutput::applySettings: %s m_centerFrequency: %llu m_sampleRate: %llu m_log2Interp: %d m_txDelay: %f m_nbFECBlocks: %d m_udpBlockSize: %u m_compressionBits: %u",
             forwardChange ? "forward change" : "",
             m_settings.m_centerFrequency,
             m_settings.m_sampleRate,
             m_settings.m_log2Interp,
             m_settings.m_txDelay,
-            m_settings.m_nbFECBlocks);
+            m_settings.m_nbFECBlocks,
+            m_settings.m_udpBlockSize,
+            m_settings.m_compressionBits);
 
     if (forwardChange)
     {
@@ -397,6 +425,14 @@ int SDRdaemonSinkOutput::webapiSettingsPutPatch(
     if (deviceSettingsKeys.contains("nbFECBlocks")) {
         settings.m_nbFECBlocks = response.getSdrDaemonSinkSettings()->getNbFecBlocks();
     }
+    if (deviceSettingsKeys.contains("udpBlockSize")) {
+        settings.m_udpBlockSize = response.getSdrDaemonSinkSettings()->getUdpBlockSize();
+    }
+    if (deviceSettingsKeys.contains("compressionBits"))
+    {
+        int compressionBits = response.getSdrDaemonSinkSettings()->getCompressionBits();
+        settings.m_compressionBits = BlockFloatingPoint::isValidBits(compressionBits) ? compressionBits : 0;
+    }
     if (deviceSettingsKeys.contains("address")) {
         settings.m_address = *response.getSdrDaemonSinkSettings()->getAddress();
     }
@@ -440,6 +476,8 @@ void SDRdaemonSinkOutput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSetti
     response.getSdrDaemonSinkSettings()->setLog2Interp(settings.m_log2Interp);
     response.getSdrDaemonSinkSettings()->setTxDelay(settings.m_txDelay);
     response.getSdrDaemonSinkSettings()->setNbFecBlocks(settings.m_nbFECBlocks);
+    response.getSdrDaemonSinkSettings()->setUdpBlockSize(settings.m_udpBlockSize);
+    response.getSdrDaemonSinkSettings()->setCompressionBits(settings.m_compressionBits);
     response.getSdrDaemonSinkSettings()->setAddress(new QString(settings.m_address));
     response.getSdrDaemonSinkSettings()->setDataPort(settings.m_dataPort);
     response.getSdrDaemonSinkSettings()->setControlPort(settings.m_controlPort);
@@ -450,6 +488,14 @@ void SDRdaemonSinkOutput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport&
 {
     response.getSdrDaemonSinkReport()->setBufferRwBalance(m_sampleSourceFifo.getRWBalance());
     response.getSdrDaemonSinkReport()->setSampleCount(m_sdrDaemonSinkThread ? (int) m_sdrDaemonSinkThread->getSamplesCount() : 0);
+
+    // nominal values from the settings: 127 blocks of samples are sent with block zero and FEC blocks
+    int samplesPerBlock = UDPSinkFEC::getSamplesPerBlock(m_settings.m_udpBlockSize, m_settings.m_compressionBits);
+    int protectedBlockSize = m_settings.m_udpBlockSize - sizeof(UDPSinkFEC::Header);
+    float compressionRatio = m_settings.m_compressionBits ? (samplesPerBlock * 2 * sizeof(int16_t)) / (float) protectedBlockSize : 1.0f;
+    qint64 throughput = (m_settings.m_sampleRate * (128 + m_settings.m_nbFECBlocks) * (qint64) m_settings.m_udpBlockSize) / (127 * samplesPerBlock);
+    response.getSdrDaemonSinkReport()->setCompressionRatio(compressionRatio);
+    response.getSdrDaemonSinkReport()->setThroughput((int) throughput);
 }
 
 
@@ -25,6 +25,8 @@ struct SDRdaemonSinkSettings {
     quint32 m_log2Interp;
     float   m_txDelay;
     quint32 m_nbFECBlocks;
+    quint32 m_udpBlockSize;      //!< UDP block size in bytes (512 up to 8972 for jumbo frames)
+    quint32 m_compressionBits;   //!< block floating point mantissa bits (0 for no compression)
     QString m_address;
     quint16 m_dataPort;
     quint16 m_controlPort;
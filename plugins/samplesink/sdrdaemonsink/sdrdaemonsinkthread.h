@@ -51,6 +51,8 @@ public:
     void setNbBlocksFEC(uint32_t nbBlocksFEC) { m_udpSinkFEC.setNbBlocksFEC(nbBlocksFEC); };
     void setTxDelay(uint32_t txDelay) { m_udpSinkFEC.setTxDelay(txDelay); };
     void setRemoteAddress(const QString& address, uint16_t port) { m_udpSinkFEC.setRemoteAddress(address, port); }
+    void setUdpSize(uint32_t udpSize) { m_udpSinkFEC.setUdpSize(udpSize); }
+    void setCompressionBits(uint32_t compressionBits) { m_udpSinkFEC.setCompressionBits(compressionBits); }
 
     bool isRunning() const { return m_running; }
 
@@ -17,13 +17,14 @@
 #include <QDebug>
 
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
+#include <algorithm>
 #include <boost/crc.hpp>
 #include <boost/cstdint.hpp>
 
 #include "udpsinkfec.h"
 
-MESSAGE_CLASS_DEFINITION(UDPSinkFECWorker::MsgUDPFECEncodeAndSend, Message)
 MESSAGE_CLASS_DEFINITION(UDPSinkFECWorker::MsgConfigureRemoteAddress, Message)
 
 
@@ -35,16 +36,22 @@ UDPSinkFEC::UDPSinkFEC() :
     m_nbSamples(0),
     m_nbBlocksFEC(0),
     m_txDelay(0),
+    m_udpSize(m_udpSizeDefault),
+    m_udpSizeRequest(m_udpSizeDefault),
+    m_compressionBits(0),
+    m_compressionBitsRequest(0),
+    m_samplesPerBlock(0),
+    m_txFrame(0),
     m_txBlockIndex(0),
-    m_txBlocksIndex(0),
     m_frameCount(0),
-    m_sampleIndex(0)
+    m_sampleIndex(0),
+    m_dropSamples(0),
+    m_nbDroppedFrames(0)
 {
-    memset((char *) m_txBlocks, 0, 4*256*sizeof(SuperBlock));
-    memset((char *) &m_superBlock, 0, sizeof(SuperBlock));
+    setBlockParameters();
     m_currentMetaFEC.init();
-    m_bufMeta = new uint8_t[m_udpSize];
-    m_buf = new uint8_t[m_udpSize];
+    m_bufMeta = new uint8_t[m_udpSizeMax];
+    m_buf = new uint8_t[m_udpSizeMax];
     m_udpThread = new QThread();
     m_udpWorker = new UDPSinkFECWorker();
 
@@ -67,6 +74,35 @@ UDPSinkFEC::~UDPSinkFEC()
     delete m_udpThread;
 }
 
+void UDPSinkFEC::setBlockParameters()
+{
+    m_samplesPerBlock = getSamplesPerBlock(m_udpSize, m_compressionBits);
+    m_compressBuffer.resize(m_compressionBits ? m_samplesPerBlock : 0);
+}
+
+void UDPSinkFEC::setUdpSize(uint32_t udpSize)
+{
+    if (udpSize < m_udpSizeDefault) {
+        udpSize = m_udpSizeDefault;
+    } else if (udpSize > m_udpSizeMax) {
+        udpSize = m_udpSizeMax;
+    }
+
+    udpSize -= (udpSize - sizeof(Header)) % sizeof(Sample); // whole number of samples
+    qDebug() << "UDPSinkFEC::setUdpSize: udpSize: " << udpSize;
+    m_udpSizeRequest = udpSize;
+}
+
+void UDPSinkFEC::setCompressionBits(uint32_t compressionBits)
+{
+    if ((compressionBits != 0) && !BlockFloatingPoint::isValidBits(compressionBits)) {
+        compressionBits = 0;
+    }
+
+    qDebug() << "UDPSinkFEC::setCompressionBits: compressionBits: " << compressionBits;
+    m_compressionBitsRequest = compressionBits;
+}
+
 void UDPSinkFEC::setTxDelay(uint32_t txDelay)
 {
     qDebug() << "UDPSinkFEC::setTxDelay: txDelay: " << txDelay;
@@ -95,11 +131,47 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
     {
         int inRemainingSamples = end - it;
 
+        if (m_dropSamples > 0) // skip the samples of a dropped frame
+        {
+            int nbSkipped = std::min(m_dropSamples, inRemainingSamples);
+            it += nbSkipped;
+            m_dropSamples -= nbSkipped;
+
+            if (m_dropSamples == 0) {
+                m_frameCount++; // the receiver sees the missing frame index
+            }
+
+            continue;
+        }
+
         if (m_txBlockIndex == 0) // Tx block index 0 is a block with only meta data
         {
             struct timeval tv;
             MetaDataFEC metaData;
 
+            if (!m_txFrame)
+            {
+                m_txFrame = m_udpWorker->getFreeFrame(); // never wait: this is the device sample thread
+
+                if (!m_txFrame) // encoding or transmission cannot keep up: drop a whole frame
+                {
+                    m_nbDroppedFrames++;
+                    m_dropSamples = (m_nbOriginalBlocks - 1) * m_samplesPerBlock;
+                    qDebug("UDPSinkFEC::write: no free frame. Drop frame %u (%u dropped)", m_frameCount, m_nbDroppedFrames);
+                    continue;
+                }
+            }
+
+            if ((m_udpSizeRequest != m_udpSize) || (m_compressionBitsRequest != m_compressionBits)) // changes only at frame boundary
+            {
+                m_udpSize = m_udpSizeRequest;
+                m_compressionBits = m_compressionBitsRequest;
+                setBlockParameters();
+            }
+
+            m_txFrame->m_udpSize = m_udpSize; // frames in flight keep their own block size
+            m_txFrame->m_blocks.resize(256 * m_udpSize);
+
             gettimeofday(&tv, 0);
 
             // create meta data TODO: semaphore
@@ -116,12 +188,16 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
             crc32.process_bytes(&metaData, 20);
 
             metaData.m_crc32 = crc32.checksum();
+            metaData.m_blockSize = m_udpSize;
+            metaData.m_compressionBits = m_compressionBits;
 
-            memset((char *) &m_superBlock, 0, sizeof(m_superBlock));
+            uint8_t *txBlock = getTxBlock(0);
+            Header *header = (Header *) txBlock;
+            memset((char *) txBlock, 0, m_udpSize);
 
-            m_superBlock.header.frameIndex = m_frameCount;
-            m_superBlock.header.blockIndex = m_txBlockIndex;
-            memcpy((char *) &m_superBlock.protectedBlock, (const char *) &metaData, sizeof(MetaDataFEC));
+            header->frameIndex = m_frameCount;
+            header->blockIndex = m_txBlockIndex;
+            memcpy((char *) &txBlock[sizeof(Header)], (const char *) &metaData, sizeof(MetaDataFEC));
 
             if (!(metaData == m_currentMetaFEC))
             {
@@ -134,18 +210,23 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
                         << ":" << (int) metaData.m_nbFECBlocks
                         << "|" << metaData.m_tv_sec
                         << ":" << metaData.m_tv_usec
+                        << "|" << metaData.m_blockSize
+                        << ":" << (int) metaData.m_compressionBits
                         << "|";
 
                 m_currentMetaFEC = metaData;
             }
 
-            m_txBlocks[m_txBlocksIndex][0] = m_superBlock;
             m_txBlockIndex = 1; // next Tx block with data
         }
 
-        if (m_sampleIndex + inRemainingSamples < samplesPerBlock) // there is still room in the current super block
+        // super blocks are built in place in the Tx frame unless they are compressed when complete
+        uint8_t *txBlock = getTxBlock(m_txBlockIndex);
+        Sample *samples = m_compressionBits ? m_compressBuffer.data() : (Sample *) &txBlock[sizeof(Header)];
+
+        if (m_sampleIndex + inRemainingSamples < m_samplesPerBlock) // there is still room in the current super block
         {
-            memcpy((char *) &m_superBlock.protectedBlock.m_samples[m_sampleIndex],
+            memcpy((char *) &samples[m_sampleIndex],
                     (const char *) &(*it),
                     inRemainingSamples * sizeof(Sample));
             m_sampleIndex += inRemainingSamples;
@@ -153,28 +234,28 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
         }
         else // complete super block and initiate the next if not end of frame
         {
-            memcpy((char *) &m_superBlock.protectedBlock.m_samples[m_sampleIndex],
+            memcpy((char *) &samples[m_sampleIndex],
                     (const char *) &(*it),
-                    (samplesPerBlock - m_sampleIndex) * sizeof(Sample));
-            it += samplesPerBlock - m_sampleIndex;
+                    (m_samplesPerBlock - m_sampleIndex) * sizeof(Sample));
+            it += m_samplesPerBlock - m_sampleIndex;
             m_sampleIndex = 0;
 
-            m_superBlock.header.frameIndex = m_frameCount;
-            m_superBlock.header.blockIndex = m_txBlockIndex;
-            m_txBlocks[m_txBlocksIndex][m_txBlockIndex] =  m_superBlock;
+            if (m_compressionBits) {
+                BlockFloatingPoint::encode(&samples[0].m_real, m_samplesPerBlock, m_compressionBits, &txBlock[sizeof(Header)]);
+            }
+
+            Header *header = (Header *) txBlock;
+            header->frameIndex = m_frameCount;
+            header->blockIndex = m_txBlockIndex;
 
             if (m_txBlockIndex == m_nbOriginalBlocks - 1) // frame complete
             {
-                int nbBlocksFEC = m_nbBlocksFEC;
-                int txDelay = m_txDelay;
-
-                // TODO: send blocks
-                //qDebug("UDPSinkFEC::write: push frame to worker: %u", m_frameCount);
-                m_udpWorker->pushTxFrame(m_txBlocks[m_txBlocksIndex], nbBlocksFEC, txDelay, m_frameCount);
-                //m_txThread = new std::thread(transmitUDP, this, m_txBlocks[m_txBlocksIndex], m_frameCount, nbBlocksFEC, txDelay, m_cm256Valid);
-                //transmitUDP(this, m_txBlocks[m_txBlocksIndex], m_frameCount, m_nbBlocksFEC, m_txDelay, m_cm256Valid);
+                m_txFrame->m_nbBlocksFEC = m_nbBlocksFEC;
+                m_txFrame->m_txDelay = m_txDelay;
+                m_txFrame->m_frameIndex = m_frameCount;
+                m_udpWorker->pushTxFrame(m_txFrame);
 
-                m_txBlocksIndex = (m_txBlocksIndex + 1) % 4;
+                m_txFrame = 0;
                 m_txBlockIndex = 0;
                 m_frameCount++;
             }
@@ -188,25 +269,71 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
 
 UDPSinkFECWorker::UDPSinkFECWorker() :
         m_running(false),
-        m_remotePort(9090)
+        m_frames(m_nbFrames),
+        m_stopEncoders(false),
+        m_remotePort(9090),
+        m_remoteSockAddrValid(false),
+        m_tokens(0.0),
+        m_tokensTime(0)
 {
-    m_cm256Valid = m_cm256.isInitialized();
-    connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::DirectConnection);
+    for (int i = 0; i < m_nbFrames; i++) {
+        m_freeFrames.push_back(&m_frames[i]);
+    }
+
+    memset(&m_remoteSockAddr, 0, sizeof(m_remoteSockAddr));
+    // the input queue is polled by the process() loop: it is the only consumer of the queue
 }
 
 UDPSinkFECWorker::~UDPSinkFECWorker()
 {
-    disconnect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
     m_inputMessageQueue.clear();
 }
 
-void UDPSinkFECWorker::pushTxFrame(UDPSinkFEC::SuperBlock *txBlocks,
-    uint32_t nbBlocksFEC,
-    uint32_t txDelay,
-    uint16_t frameIndex)
+UDPSinkFECFrame *UDPSinkFECWorker::getFreeFrame()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_freeFrames.empty()) {
+        return 0;
+    }
+
+    UDPSinkFECFrame *frame = m_freeFrames.front();
+    m_freeFrames.pop_front();
+    return frame;
+}
+
+void UDPSinkFECWorker::pushTxFrame(UDPSinkFECFrame *frame)
 {
-    //qDebug("UDPSinkFECWorker::pushTxFrame. %d", m_inputMessageQueue.size());
-    m_inputMessageQueue.push(MsgUDPFECEncodeAndSend::create(txBlocks, nbBlocksFEC, txDelay, frameIndex));
+    QMutexLocker mutexLocker(&m_mutex);
+    frame->m_encoded = false;
+    frame->m_encodeError = false;
+    m_encodeQueue.push_back(frame);
+    m_sendQueue.push_back(frame);
+    m_frameToEncode.wakeOne();
+}
+
+UDPSinkFECFrame *UDPSinkFECWorker::takeFrameToEncode()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while (m_encodeQueue.empty() && !m_stopEncoders) {
+        m_frameToEncode.wait(&m_mutex);
+    }
+
+    if (m_stopEncoders) {
+        return 0;
+    }
+
+    UDPSinkFECFrame *frame = m_encodeQueue.front();
+    m_encodeQueue.pop_front();
+    return frame;
+}
+
+void UDPSinkFECWorker::frameEncoded(UDPSinkFECFrame *frame)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    frame->m_encoded = true;
+    m_frameEncoded.wakeAll();
 }
 
 void UDPSinkFECWorker::setRemoteAddress(const QString& address, uint16_t port)
@@ -217,14 +344,66 @@ void UDPSinkFECWorker::setRemoteAddress(const QString& address, uint16_t port)
 void UDPSinkFECWorker::process()
 {
     m_running  = true;
+    m_stopEncoders = false;
+
+    int nbEncoders = std::max(1, std::min(4, QThread::idealThreadCount() / 2));
+
+    for (int i = 0; i < nbEncoders; i++)
+    {
+        m_encoders.push_back(new Encoder(this));
+        m_encoders.back()->start();
+    }
+
+    qDebug("UDPSinkFECWorker::process: started with %d encoders", nbEncoders);
 
-    qDebug("UDPSinkFECWorker::process: started");
+    m_tokensTimer.start();
+    m_tokensTime = 0;
+    m_tokens = 0.0;
 
     while (m_running)
     {
-        usleep(250000);
+        UDPSinkFECFrame *frame = 0;
+
+        handleInputMessages();
+
+        m_mutex.lock();
+
+        if (m_sendQueue.empty() || !m_sendQueue.front()->m_encoded) {
+            m_frameEncoded.wait(&m_mutex, 100); // periodic wake up to check for stop requests
+        }
+
+        if (!m_sendQueue.empty() && m_sendQueue.front()->m_encoded) // frames are sent in order
+        {
+            frame = m_sendQueue.front();
+            m_sendQueue.pop_front();
+        }
+
+        m_mutex.unlock();
+
+        if (frame)
+        {
+            if (!frame->m_encodeError) {
+                transmit(frame);
+            }
+
+            QMutexLocker mutexLocker(&m_mutex);
+            m_freeFrames.push_back(frame);
+        }
+    }
+
+    m_mutex.lock();
+    m_stopEncoders = true;
+    m_frameToEncode.wakeAll();
+    m_mutex.unlock();
+
+    for (std::vector<Encoder*>::iterator it = m_encoders.begin(); it != m_encoders.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
     }
 
+    m_encoders.clear();
+
     qDebug("UDPSinkFECWorker::process: stopped");
     emit finished();
 }
@@ -240,101 +419,171 @@ void UDPSinkFECWorker::handleInputMessages()
 
     while ((message = m_inputMessageQueue.pop()) != 0)
     {
-        if (MsgUDPFECEncodeAndSend::match(*message))
-        {
-            MsgUDPFECEncodeAndSend *sendMsg = (MsgUDPFECEncodeAndSend *) message;
-            encodeAndTransmit(sendMsg->getTxBlocks(), sendMsg->getFrameIndex(), sendMsg->getNbBlocsFEC(), sendMsg->getTxDelay());
-        }
-        else if (MsgConfigureRemoteAddress::match(*message))
+        if (MsgConfigureRemoteAddress::match(*message))
         {
             qDebug("UDPSinkFECWorker::handleInputMessages: %s", message->getIdentifier());
             MsgConfigureRemoteAddress *addressMsg = (MsgConfigureRemoteAddress *) message;
+            QMutexLocker mutexLocker(&m_mutex);
             m_remoteAddress = addressMsg->getAddress();
             m_remotePort = addressMsg->getPort();
+
+            try // resolve once instead of for each datagram
+            {
+                UDPSocket::ResolveAddr(m_remoteAddress.toStdString(), m_remotePort, m_remoteSockAddr);
+                m_remoteSockAddrValid = true;
+            }
+            catch (CSocketException& e)
+            {
+                qWarning("UDPSinkFECWorker::handleInputMessages: %s: %s", qPrintable(m_remoteAddress), e.what());
+                m_remoteSockAddrValid = false;
+            }
         }
 
         delete message;
     }
 }
 
-void UDPSinkFECWorker::encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay)
+void UDPSinkFECWorker::waitForTokens(int nbDatagrams, uint32_t txDelay)
 {
-    CM256::cm256_encoder_params cm256Params;  //!< Main interface with CM256 encoder
-    CM256::cm256_block descriptorBlocks[256]; //!< Pointers to data for CM256 encoder
-    UDPSinkFEC::ProtectedBlock fecBlocks[256];   //!< FEC data
+    if (txDelay == 0) { // not paced
+        return;
+    }
 
-    if ((nbBlocksFEC == 0) || !m_cm256Valid)
-    {
-//        qDebug("UDPSinkFECWorker::encodeAndTransmit: transmit frame without FEC to %s:%d", m_remoteAddress.toStdString().c_str(), m_remotePort);
+    double nsPerToken = txDelay * 1000.0;
+    qint64 now = m_tokensTimer.nsecsElapsed();
+    m_tokens += (now - m_tokensTime) / nsPerToken;
+    m_tokensTime = now;
 
-        for (unsigned int i = 0; i < UDPSinkFEC::m_nbOriginalBlocks; i++)
-        {
-            m_socket.SendDataGram((const void *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress.toStdString(), (uint32_t) m_remotePort);
-            //m_udpSocket->writeDatagram((const char *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress, m_remotePort);
-            usleep(txDelay);
-        }
+    if (m_tokens > m_txBurstSize) { // no larger burst after idle time
+        m_tokens = m_txBurstSize;
     }
-    else
+
+    if (m_tokens < nbDatagrams)
     {
-        cm256Params.BlockBytes = sizeof(UDPSinkFEC::ProtectedBlock);
-        cm256Params.OriginalCount = UDPSinkFEC::m_nbOriginalBlocks;
-        cm256Params.RecoveryCount = nbBlocksFEC;
+        qint64 waitNs = (nbDatagrams - m_tokens) * nsPerToken;
+        struct timespec ts;
+        ts.tv_sec = waitNs / 1000000000LL;
+        ts.tv_nsec = waitNs % 1000000000LL;
+        nanosleep(&ts, 0);
+
+        now = m_tokensTimer.nsecsElapsed(); // oversleep is credited to the next datagrams
+        m_tokens += (now - m_tokensTime) / nsPerToken;
+        m_tokensTime = now;
+    }
 
+    m_tokens -= nbDatagrams;
+}
 
-        // Fill pointers to data
-        for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
-        {
-            if (i >= cm256Params.OriginalCount) {
-                memset((char *) &txBlockx[i].protectedBlock, 0, sizeof(UDPSinkFEC::ProtectedBlock));
-            }
+void UDPSinkFECWorker::transmit(UDPSinkFECFrame *frame)
+{
+    void *datagrams[256];
+    int datagramSizes[256];
+    int nbDatagrams = 0;
+    int nbBlocks = UDPSinkFEC::m_nbOriginalBlocks + frame->m_nbBlocksFEC;
+    sockaddr_in remoteSockAddr;
+
+    m_mutex.lock();
+    remoteSockAddr = m_remoteSockAddr;
+    bool remoteValid = m_remoteSockAddrValid;
+    m_mutex.unlock();
+
+    if (!remoteValid) {
+        return;
+    }
 
-            txBlockx[i].header.frameIndex = frameIndex;
-            txBlockx[i].header.blockIndex = i;
-            descriptorBlocks[i].Block = (void *) &(txBlockx[i].protectedBlock);
-            descriptorBlocks[i].Index = txBlockx[i].header.blockIndex;
+    for (int i = 0; i < nbBlocks; i++)
+    {
+#ifdef SDRDAEMON_PUNCTURE
+        if (i == SDRDAEMON_PUNCTURE) {
+            continue;
         }
+#endif
+        datagrams[nbDatagrams] = (void *) frame->getBlock(i);
+        datagramSizes[nbDatagrams] = frame->m_udpSize;
+        nbDatagrams++;
+    }
 
-        // Encode FEC blocks
-        if (m_cm256.cm256_encode(cm256Params, descriptorBlocks, fecBlocks))
-        {
-            qDebug("UDPSinkFECWorker::encodeAndTransmit: CM256 encode failed. No transmission.");
-            return;
-        }
+    for (int i = 0; i < nbDatagrams;)
+    {
+        int batchSize = frame->m_txDelay == 0 ? nbDatagrams - i : std::min(m_txBurstSize, nbDatagrams - i);
+        waitForTokens(batchSize, frame->m_txDelay);
+        int nbSent = m_socket.SendDataGrams(&datagrams[i], &datagramSizes[i], batchSize, remoteSockAddr);
 
-        // Merge FEC with data to transmit
-        for (int i = 0; i < cm256Params.RecoveryCount; i++)
-        {
-            txBlockx[i + cm256Params.OriginalCount].protectedBlock = fecBlocks[i];
+        if (nbSent < batchSize) { // e.g. socket buffer full: the rest of the batch is lost and recovered by FEC if possible
+            qDebug("UDPSinkFECWorker::transmit: frame %u: %d of %d datagrams sent: %s",
+                    frame->m_frameIndex, nbSent, batchSize, strerror(errno));
         }
 
-        // Transmit all blocks
+        i += batchSize;
+    }
+}
+
+UDPSinkFECWorker::Encoder::Encoder(UDPSinkFECWorker *worker) :
+        m_worker(worker)
+{
+}
 
-//        qDebug("UDPSinkFECWorker::encodeAndTransmit: transmit frame with FEC to %s:%d", m_remoteAddress.toStdString().c_str(), m_remotePort);
+void UDPSinkFECWorker::Encoder::run()
+{
+    UDPSinkFECFrame *frame;
 
-        for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; i++)
-        {
-#ifdef SDRDAEMON_PUNCTURE
-            if (i == SDRDAEMON_PUNCTURE) {
-                continue;
-            }
-#endif
-//            std::cerr << "UDPSinkFEC::transmitUDP:"
-//                  << " i: " << i
-//                  << " frameIndex: " << (int) m_txBlocks[i].header.frameIndex
-//                  << " blockIndex: " << (int) m_txBlocks[i].header.blockIndex
-//                  << " i.q:";
-//
-//            for (int j = 0; j < 10; j++)
-//            {
-//                std::cerr << " " << (int) m_txBlocks[i].protectedBlock.m_samples[j].m_real
-//                        << "." << (int) m_txBlocks[i].protectedBlock.m_samples[j].m_imag;
-//            }
-//
-//            std::cerr << std::endl;
-
-            m_socket.SendDataGram((const void *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress.toStdString(), (uint32_t) m_remotePort);
-            //m_udpSocket->writeDatagram((const char *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress, m_remotePort);
-            usleep(txDelay);
-        }
+    while ((frame = m_worker->takeFrameToEncode()) != 0)
+    {
+        encode(frame);
+        m_worker->frameEncoded(frame);
+    }
+}
+
+void UDPSinkFECWorker::Encoder::encode(UDPSinkFECFrame *frame)
+{
+    CM256::cm256_encoder_params cm256Params;  //!< Main interface with CM256 encoder
+    CM256::cm256_block descriptorBlocks[256]; //!< Pointers to data for CM256 encoder
+    int protectedBlockSize = frame->m_udpSize - sizeof(UDPSinkFEC::Header);
+
+    if (!m_cm256.isInitialized()) {
+        frame->m_nbBlocksFEC = 0;
+    }
+
+    // block headers for original and FEC blocks
+    for (unsigned int i = 0; i < UDPSinkFEC::m_nbOriginalBlocks + frame->m_nbBlocksFEC; i++)
+    {
+        UDPSinkFEC::Header *header = (UDPSinkFEC::Header *) frame->getBlock(i);
+        header->frameIndex = frame->m_frameIndex;
+        header->blockIndex = i;
+    }
+
+    if (frame->m_nbBlocksFEC == 0) {
+        return;
+    }
+
+    cm256Params.BlockBytes = protectedBlockSize;
+    cm256Params.OriginalCount = UDPSinkFEC::m_nbOriginalBlocks;
+    cm256Params.RecoveryCount = frame->m_nbBlocksFEC;
+
+    if (m_fecBlocks.size() < (unsigned int) (cm256Params.RecoveryCount * protectedBlockSize)) {
+        m_fecBlocks.resize(cm256Params.RecoveryCount * protectedBlockSize);
+    }
+
+    // Fill pointers to data
+    for (int i = 0; i < cm256Params.OriginalCount; ++i)
+    {
+        descriptorBlocks[i].Block = (void *) &frame->getBlock(i)[sizeof(UDPSinkFEC::Header)];
+        descriptorBlocks[i].Index = i;
+    }
+
+    // Encode FEC blocks
+    if (m_cm256.cm256_encode(cm256Params, descriptorBlocks, m_fecBlocks.data()))
+    {
+        qDebug("UDPSinkFECWorker::Encoder::encode: CM256 encode failed. No transmission.");
+        frame->m_encodeError = true;
+        return;
+    }
+
+    // Merge FEC with data to transmit
+    for (int i = 0; i < cm256Params.RecoveryCount; i++)
+    {
+        memcpy((char *) &frame->getBlock(i + cm256Params.OriginalCount)[sizeof(UDPSinkFEC::Header)],
+                (const char *) &m_fecBlocks[i * protectedBlockSize],
+                protectedBlockSize);
     }
 }
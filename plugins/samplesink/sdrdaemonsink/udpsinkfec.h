@@ -19,15 +19,21 @@
 
 #include <string.h>
 #include <cstddef>
+#include <vector>
+#include <deque>
 
 #include <QObject>
 #include <QHostAddress>
 #include <QString>
 #include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
 
 #include "cm256.h"
 
 #include "dsp/dsptypes.h"
+#include "dsp/blockfloatingpoint.h"
 #include "util/CRC64.h"
 #include "util/messagequeue.h"
 #include "util/message.h"
@@ -36,11 +42,26 @@
 
 class UDPSinkFECWorker;
 
+/** A frame of UDP blocks in flight between the samples writer, the FEC encoders and the sender */
+struct UDPSinkFECFrame
+{
+    std::vector<uint8_t> m_blocks; //!< 128 original blocks followed by the FEC blocks with a stride of UDP block size
+    uint32_t m_udpSize;            //!< UDP block size in bytes
+    uint32_t m_nbBlocksFEC;        //!< Number of FEC blocks to produce
+    uint32_t m_txDelay;            //!< Delay in microseconds between each UDP datagram
+    uint16_t m_frameIndex;         //!< Transmission frame count
+    bool     m_encoded;            //!< FEC encoding is done and frame is ready to be sent
+    bool     m_encodeError;        //!< FEC encoding failed and frame is not sent
+
+    uint8_t *getBlock(int blockIndex) { return &m_blocks[blockIndex * m_udpSize]; }
+};
+
 class UDPSinkFEC : public QObject
 {
     Q_OBJECT
 public:
-    static const uint32_t m_udpSize = 512;          //!< Size of UDP block in number of bytes
+    static const uint32_t m_udpSizeDefault = 512;   //!< Default size of UDP block in number of bytes
+    static const uint32_t m_udpSizeMax = 8972;      //!< Maximum size of UDP block: 9000 bytes jumbo frame MTU less IP and UDP headers
     static const uint32_t m_nbOriginalBlocks = 128; //!< Number of original blocks in a protected block sequence
 #pragma pack(push, 1)
     struct MetaDataFEC
@@ -54,6 +75,8 @@ public:
         uint32_t m_tv_sec;            //!< 16 seconds of timestamp at start time of super-frame processing
         uint32_t m_tv_usec;           //!< 20 microseconds of timestamp at start time of super-frame processing
         uint32_t m_crc32;             //!< 24 CRC32 of the above
+        uint16_t m_blockSize;         //!< 26 UDP block size in bytes (0 for legacy 512 bytes). Not covered by CRC32.
+        uint8_t  m_compressionBits;   //!< 27 block floating point mantissa bits (0 for no compression). Not covered by CRC32.
 
         bool operator==(const MetaDataFEC& rhs)
         {
@@ -74,19 +97,16 @@ public:
         uint8_t  filler;
     };
 
-    static const int samplesPerBlock = (m_udpSize - sizeof(Header)) / sizeof(Sample);
-
-    struct ProtectedBlock
-    {
-        Sample m_samples[samplesPerBlock];
-    };
+#pragma pack(pop)
 
-    struct SuperBlock
+    static int getSamplesPerBlock(uint32_t udpSize, uint32_t compressionBits = 0)
     {
-        Header         header;
-        ProtectedBlock protectedBlock;
-    };
-#pragma pack(pop)
+        if (compressionBits) {
+            return BlockFloatingPoint::getNbSamples(udpSize - sizeof(Header), compressionBits);
+        } else {
+            return (udpSize - sizeof(Header)) / sizeof(Sample);
+        }
+    }
 
     /**
      * Construct UDP sink
@@ -122,6 +142,17 @@ public:
     void setTxDelay(uint32_t txDelay);
     void setRemoteAddress(const QString& address, uint16_t port);
 
+    /** Set UDP block size in bytes. Effective at the start of the next frame. */
+    void setUdpSize(uint32_t udpSize);
+    uint32_t getUdpSize() const { return m_udpSize; }
+
+    /** Set block floating point mantissa bits (0 for no compression). Effective at the start of the next frame. */
+    void setCompressionBits(uint32_t compressionBits);
+    uint32_t getCompressionBits() const { return m_compressionBits; }
+
+    /** Number of frames dropped because encoding or transmission could not keep up */
+    uint32_t getNbDroppedFrames() const { return m_nbDroppedFrames; }
+
     /** Return true if the stream is OK, return false if there is an error. */
     operator bool() const
     {
@@ -146,58 +177,36 @@ private:
     MetaDataFEC m_currentMetaFEC;        //!< Meta data for current frame
     uint32_t m_nbBlocksFEC;              //!< Variable number of FEC blocks
     uint32_t m_txDelay;                  //!< Delay in microseconds (usleep) between each sending of an UDP datagram
-    SuperBlock m_txBlocks[4][256];       //!< UDP blocks to send with original data + FEC
-    SuperBlock m_superBlock;             //!< current super block being built
-    int m_txBlockIndex;                  //!< Current index in blocks to transmit in the Tx row
-    int m_txBlocksIndex;                 //!< Current index of Tx blocks row
+    uint32_t m_udpSize;                  //!< Size of UDP block in number of bytes
+    uint32_t m_udpSizeRequest;           //!< UDP block size to apply at next frame start
+    uint32_t m_compressionBits;          //!< Block floating point mantissa bits or 0 if not compressed
+    uint32_t m_compressionBitsRequest;   //!< Compression to apply at next frame start
+    int m_samplesPerBlock;               //!< Number of samples in one UDP block
+    SampleVector m_compressBuffer;       //!< Samples of the current block before compression
+    UDPSinkFECFrame *m_txFrame;          //!< Frame being filled or null if none was available
+    int m_txBlockIndex;                  //!< Current index in blocks to transmit in the Tx frame
     uint16_t m_frameCount;               //!< transmission frame count
     int m_sampleIndex;                   //!< Current sample index in protected block data
+    int m_dropSamples;                   //!< Samples left to skip in the frame being dropped
+    uint32_t m_nbDroppedFrames;          //!< Frames dropped because no free frame was available
 
     QThread *m_udpThread;
     UDPSinkFECWorker *m_udpWorker;
+
+    uint8_t *getTxBlock(int blockIndex) { return m_txFrame->getBlock(blockIndex); }
+    void setBlockParameters();
 };
 
 
+/**
+ * Frames are FEC encoded in parallel by a small pool of encoder threads as frames are independent.
+ * The worker thread sends them in order in batches of datagrams (sendmmsg) paced by a token bucket
+ * of one datagram per Tx delay so that the pacing does not drift with the time taken by the system calls.
+ */
 class UDPSinkFECWorker : public QObject
 {
     Q_OBJECT
 public:
-    class MsgUDPFECEncodeAndSend : public Message
-    {
-        MESSAGE_CLASS_DECLARATION
-    public:
-        UDPSinkFEC::SuperBlock *getTxBlocks() const { return m_txBlockx; }
-        uint32_t getNbBlocsFEC() const { return m_nbBlocksFEC; }
-        uint32_t getTxDelay() const { return m_txDelay; }
-        uint16_t getFrameIndex() const { return m_frameIndex; }
-
-        static MsgUDPFECEncodeAndSend* create(
-                UDPSinkFEC::SuperBlock *txBlocks,
-                uint32_t nbBlocksFEC,
-                uint32_t txDelay,
-                uint16_t frameIndex)
-        {
-            return new MsgUDPFECEncodeAndSend(txBlocks, nbBlocksFEC, txDelay, frameIndex);
-        }
-
-    private:
-        UDPSinkFEC::SuperBlock *m_txBlockx;
-        uint32_t m_nbBlocksFEC;
-        uint32_t m_txDelay;
-        uint16_t m_frameIndex;
-
-        MsgUDPFECEncodeAndSend(
-                UDPSinkFEC::SuperBlock *txBlocks,
-                uint32_t nbBlocksFEC,
-                uint32_t txDelay,
-                uint16_t frameIndex) :
-            m_txBlockx(txBlocks),
-            m_nbBlocksFEC(nbBlocksFEC),
-            m_txDelay(txDelay),
-            m_frameIndex(frameIndex)
-        {}
-    };
-
     class MsgConfigureRemoteAddress : public Message
     {
         MESSAGE_CLASS_DECLARATION
@@ -223,10 +232,10 @@ public:
     UDPSinkFECWorker();
     ~UDPSinkFECWorker();
 
-    void pushTxFrame(UDPSinkFEC::SuperBlock *txBlocks,
-        uint32_t nbBlocksFEC,
-        uint32_t txDelay,
-        uint16_t frameIndex);
+    /** Get a frame to fill without waiting. Returns null if all frames are in flight. */
+    UDPSinkFECFrame *getFreeFrame();
+    /** Queue a filled frame for FEC encoding and transmission */
+    void pushTxFrame(UDPSinkFECFrame *frame);
     void setRemoteAddress(const QString& address, uint16_t port);
     void stop();
 
@@ -238,18 +247,48 @@ signals:
 public slots:
     void process();
 
-private slots:
-    void handleInputMessages();
-
 private:
-    void encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay);
+    class Encoder : public QThread
+    {
+    public:
+        Encoder(UDPSinkFECWorker *worker);
+        virtual void run();
+
+    private:
+        UDPSinkFECWorker *m_worker;
+        CM256 m_cm256;                    //!< CM256 library object of this encoder
+        std::vector<uint8_t> m_fecBlocks; //!< FEC data
+
+        void encode(UDPSinkFECFrame *frame);
+    };
+
+    static const int m_nbFrames = 8;     //!< Number of frames in flight
+    static const int m_txBurstSize = 8;  //!< Token bucket depth in number of datagrams when paced
 
     volatile bool m_running;
-    CM256 m_cm256;                       //!< CM256 library object
-    bool m_cm256Valid;                   //!< true if CM256 library is initialized correctly
+    std::vector<UDPSinkFECFrame> m_frames;
+    std::vector<Encoder*> m_encoders;
+    QMutex m_mutex;                              //!< Protects the frame queues and the remote address
+    QWaitCondition m_frameToEncode;
+    QWaitCondition m_frameEncoded;
+    std::deque<UDPSinkFECFrame*> m_freeFrames;
+    std::deque<UDPSinkFECFrame*> m_encodeQueue;
+    std::deque<UDPSinkFECFrame*> m_sendQueue;    //!< Frames in transmission order
+    bool m_stopEncoders;
     UDPSocket    m_socket;
     QString      m_remoteAddress;
     uint16_t     m_remotePort;
+    sockaddr_in  m_remoteSockAddr;               //!< Resolved remote address
+    bool         m_remoteSockAddrValid;
+    double       m_tokens;                       //!< Token bucket level in number of datagrams
+    qint64       m_tokensTime;                   //!< Time of last token bucket update in ns
+    QElapsedTimer m_tokensTimer;
+
+    UDPSinkFECFrame *takeFrameToEncode();
+    void frameEncoded(UDPSinkFECFrame *frame);
+    void transmit(UDPSinkFECFrame *frame);
+    void waitForTokens(int nbDatagrams, uint32_t txDelay);
+    void handleInputMessages(); //!< called by the process() loop only
 };
 
 
@@ -111,6 +111,7 @@ public:
 	const std::vector<uint32_t>& getSampleRates() const { return m_sampleRates; }
 
 	virtual bool handleMessage(const Message& message);
+	virtual FileRecord *getFileRecord() { return m_fileSink; }
 
     virtual int webapiSettingsGet(
                 SWGSDRangel::SWGDeviceSettings& response,
@@ -111,6 +111,7 @@ public:
     virtual void setCenterFrequency(qint64 centerFrequency);
 
 	virtual bool handleMessage(const Message& message);
+	virtual FileRecord *getFileRecord() { return m_fileSink; }
 
     virtual int webapiSettingsGet(
                 SWGSDRangel::SWGDeviceSettings& response,
@@ -115,6 +115,7 @@ public:
     virtual void setCenterFrequency(qint64 centerFrequency);
 
 	virtual bool handleMessage(const Message& message);
+	virtual FileRecord *getFileRecord() { return m_fileSink; }
 
     virtual int webapiRunGet(
             SWGSDRangel::SWGDeviceState& response,
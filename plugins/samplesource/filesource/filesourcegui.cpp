@@ -65,8 +65,6 @@ FileSourceGui::FileSourceGui(DeviceUISet *deviceUISet, QWidget* parent) :
 	displaySettings();
 
 	ui->navTimeSlider->setEnabled(false);
-	ui->playLoop->setChecked(true); // FIXME: always play in a loop
-	ui->playLoop->setEnabled(false);
 
     m_sampleSource = m_deviceUISet->m_deviceSourceAPI->getSampleSource();
 
@@ -213,15 +211,24 @@ void FileSourceGui::updateSampleRateAndFrequency()
 
 void FileSourceGui::displaySettings()
 {
+	blockApplySettings(true);
+	ui->playLoop->setChecked(m_settings.m_loop);
+	blockApplySettings(false);
 }
 
 void FileSourceGui::sendSettings()
 {
+	FileSourceInput::MsgConfigureFileSource* message = FileSourceInput::MsgConfigureFileSource::create(m_settings);
+	m_sampleSource->getInputMessageQueue()->push(message);
 }
 
-void FileSourceGui::on_playLoop_toggled(bool checked __attribute__((unused)))
+void FileSourceGui::on_playLoop_toggled(bool checked)
 {
-	// TODO: do something about it!
+	if (m_doApplySettings)
+	{
+		m_settings.m_loop = checked;
+		sendSettings();
+	}
 }
 
 void FileSourceGui::on_startStop_toggled(bool checked)
@@ -16,8 +16,14 @@
 
 #include <string.h>
 #include <errno.h>
+#include <algorithm>
 #include <QDebug>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "SWGDeviceSettings.h"
 #include "SWGFileSourceSettings.h"
 #include "SWGDeviceState.h"
@@ -46,6 +52,8 @@ MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportFileSourceStreamTiming, Messa
 FileSourceInput::FileSourceInput(DeviceSourceAPI *deviceAPI) :
     m_deviceAPI(deviceAPI),
 	m_settings(),
+	m_fileData(0),
+	m_nbSamples(0),
 	m_fileSourceThread(NULL),
 	m_deviceDescription(),
 	m_fileName("..."),
@@ -64,6 +72,7 @@ FileSourceInput::FileSourceInput(DeviceSourceAPI *deviceAPI) :
 FileSourceInput::~FileSourceInput()
 {
 	stop();
+	closeFileStream();
 }
 
 void FileSourceInput::destroy()
@@ -75,29 +84,66 @@ void FileSourceInput::openFileStream()
 {
 	//stopInput();
 
-	if (m_ifstream.is_open()) {
-		m_ifstream.close();
+	if (m_fileSourceThread != 0)
+	{
+		qWarning("FileSourceInput::openFileStream: cannot change record while acquiring");
+		return;
 	}
 
-	m_ifstream.open(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
-	quint64 fileSize = m_ifstream.tellg();
-	m_ifstream.seekg(0,std::ios_base::beg);
+	closeFileStream();
+
+	m_file.setFileName(m_fileName);
+	quint64 fileSize = 0;
 	FileRecord::Header header;
-	FileRecord::readHeader(m_ifstream, header);
+	memset(&header, 0, sizeof(FileRecord::Header));
+
+	if (m_file.open(QIODevice::ReadOnly))
+	{
+		fileSize = m_file.size();
+
+		if (fileSize >= sizeof(FileRecord::Header))
+		{
+			// the whole record is mapped: reading is paging in from the page cache and seeking is pointer arithmetic
+			m_fileData = m_file.map(0, fileSize);
+
+			if (m_fileData)
+			{
+#if defined(__linux__)
+				posix_madvise((void *) m_fileData, fileSize, POSIX_MADV_NORMAL); // keep read-around: playback loops and seeks
+#endif
+				FileRecord::readHeader(m_fileData, header);
+			}
+			else
+			{
+				qCritical() << "FileSourceInput::openFileStream: cannot map " << m_fileName << ": " << m_file.errorString();
+			}
+		}
+	}
+	else
+	{
+		qCritical() << "FileSourceInput::openFileStream: cannot open " << m_fileName << ": " << m_file.errorString();
+	}
 
 	m_sampleRate = header.sampleRate;
 	m_centerFrequency = header.centerFrequency;
 	m_startingTimeStamp = header.startTimeStamp;
 	m_sampleSize = header.sampleSize;
 
-	if (fileSize > sizeof(FileRecord::Header)) {
-		m_recordLength = (fileSize - sizeof(FileRecord::Header)) / (4 * m_sampleRate);
-	} else {
+	if (m_fileData && (fileSize > sizeof(FileRecord::Header)))
+	{
+		quint32 sampleBytes = m_sampleSize > 16 ? 2 * sizeof(int32_t) : 2 * sizeof(int16_t);
+		m_nbSamples = (fileSize - sizeof(FileRecord::Header)) / sampleBytes;
+		m_recordLength = m_sampleRate > 0 ? m_nbSamples / m_sampleRate : 0;
+	}
+	else
+	{
+		m_nbSamples = 0;
 		m_recordLength = 0;
 	}
 
 	qDebug() << "FileSourceInput::openFileStream: " << m_fileName.toStdString().c_str()
 			<< " fileSize: " << fileSize << "bytes"
+			<< " samples: " << m_nbSamples
 			<< " length: " << m_recordLength << " seconds";
 
 	if (getMessageQueueToGUI()) {
@@ -110,18 +156,52 @@ void FileSourceInput::openFileStream()
 	}
 }
 
+void FileSourceInput::closeFileStream()
+{
+	if (m_fileData)
+	{
+		m_file.unmap((uchar *) m_fileData);
+		m_fileData = 0;
+	}
+
+	if (m_file.isOpen()) {
+		m_file.close();
+	}
+
+	m_nbSamples = 0;
+}
+
 void FileSourceInput::seekFileStream(int seekPercentage)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	if ((m_ifstream.is_open()) && m_fileSourceThread && !m_fileSourceThread->isRunning())
+	if (m_fileData && m_fileSourceThread)
 	{
-		int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
-		m_fileSourceThread->setSamplesCount(seekPoint);
-		seekPoint *= 4; // + sizeof(FileSink::Header)
-		m_ifstream.clear();
-		m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
+		// index based: immediate even while playing
+		quint64 seekPoint = (m_nbSamples * seekPercentage) / 100;
+#if defined(__linux__)
+		// start paging in the seek target ahead of the reads
+		quint32 sampleBytes = m_sampleSize > 16 ? 2 * sizeof(int32_t) : 2 * sizeof(int16_t);
+		quint64 seekOffset = sizeof(FileRecord::Header) + seekPoint * sampleBytes;
+		quint64 pageOffset = seekOffset & ~((quint64) sysconf(_SC_PAGESIZE) - 1);
+		quint64 mappedSize = sizeof(FileRecord::Header) + m_nbSamples * sampleBytes;
+		quint64 adviseSize = std::min(mappedSize - pageOffset, (quint64) (4<<20));
+		posix_madvise((void *) (m_fileData + pageOffset), adviseSize, POSIX_MADV_WILLNEED);
+#endif
+		m_fileSourceThread->seek(seekPoint);
+	}
+}
+
+void FileSourceInput::applyLoopSettings()
+{
+	if (m_fileSourceThread == 0) {
+		return;
 	}
+
+	quint64 loopStart = ((quint64) m_settings.m_loopStartMs * m_sampleRate) / 1000;
+	quint64 loopEnd = ((quint64) m_settings.m_loopEndMs * m_sampleRate) / 1000;
+	m_fileSourceThread->setLoop(m_settings.m_loop, loopStart, loopEnd);
+	m_fileSourceThread->setUnthrottled(m_settings.m_unthrottled);
 }
 
 void FileSourceInput::init()
@@ -135,11 +215,6 @@ bool FileSourceInput::start()
 	QMutexLocker mutexLocker(&m_mutex);
 	qDebug() << "FileSourceInput::start";
 
-	if (m_ifstream.tellg() != 0) {
-		m_ifstream.clear();
-		m_ifstream.seekg(sizeof(FileRecord::Header), std::ios::beg);
-	}
-
 	if(!m_sampleFifo.setSize(m_sampleRate * sizeof(Sample))) {
 		qCritical("Could not allocate SampleFifo");
 		return false;
@@ -147,8 +222,9 @@ bool FileSourceInput::start()
 
 	//openFileStream();
 
-	m_fileSourceThread = new FileSourceThread(&m_ifstream, &m_sampleFifo);
+	m_fileSourceThread = new FileSourceThread(m_fileData ? m_fileData + sizeof(FileRecord::Header) : 0, m_nbSamples, &m_sampleFifo);
 	m_fileSourceThread->setSampleRateAndSize(m_sampleRate, m_sampleSize);
+	applyLoopSettings();
 	m_fileSourceThread->connectTimer(m_masterTimer);
 	m_fileSourceThread->startWork();
 	m_deviceDescription = "FileSource";
@@ -260,6 +336,7 @@ bool FileSourceInput::handleMessage(const Message& message)
 	{
 		MsgConfigureFileSourceName& conf = (MsgConfigureFileSourceName&) message;
 		m_fileName = conf.getFileName();
+		m_settings.m_fileName = m_fileName;
 		openFileStream();
 		return true;
 	}
@@ -339,7 +416,19 @@ bool FileSourceInput::applySettings(const FileSourceSettings& settings, bool for
         m_centerFrequency = settings.m_centerFrequency;
     }
 
+    bool loopChanged = (m_settings.m_loop != settings.m_loop)
+            || (m_settings.m_loopStartMs != settings.m_loopStartMs)
+            || (m_settings.m_loopEndMs != settings.m_loopEndMs)
+            || (m_settings.m_unthrottled != settings.m_unthrottled);
+
     m_settings = settings;
+
+    if (loopChanged || force)
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        applyLoopSettings();
+    }
+
     return true;
 }
 
@@ -348,10 +437,68 @@ int FileSourceInput::webapiSettingsGet(
                 QString& errorMessage __attribute__((unused)))
 {
     response.setFileSourceSettings(new SWGSDRangel::SWGFileSourceSettings());
-    response.getFileSourceSettings()->setFileName(new QString(m_settings.m_fileName));
+    response.getFileSourceSettings()->init();
+    webapiFormatDeviceSettings(response, m_settings);
+    return 200;
+}
+
+int FileSourceInput::webapiSettingsPutPatch(
+                bool force __attribute__((unused)),
+                const QStringList& deviceSettingsKeys,
+                SWGSDRangel::SWGDeviceSettings& response, // query + response
+                QString& errorMessage __attribute__((unused)))
+{
+    FileSourceSettings settings = m_settings;
+
+    if (deviceSettingsKeys.contains("fileName")) {
+        settings.m_fileName = *response.getFileSourceSettings()->getFileName();
+    }
+    if (deviceSettingsKeys.contains("loop")) {
+        settings.m_loop = response.getFileSourceSettings()->getLoop() != 0;
+    }
+    if (deviceSettingsKeys.contains("loopStartMs")) {
+        settings.m_loopStartMs = response.getFileSourceSettings()->getLoopStartMs();
+    }
+    if (deviceSettingsKeys.contains("loopEndMs")) {
+        settings.m_loopEndMs = response.getFileSourceSettings()->getLoopEndMs();
+    }
+    if (deviceSettingsKeys.contains("unthrottled")) {
+        settings.m_unthrottled = response.getFileSourceSettings()->getUnthrottled() != 0;
+    }
+
+    MsgConfigureFileSource *msg = MsgConfigureFileSource::create(settings);
+    m_inputMessageQueue.push(msg);
+
+    if (deviceSettingsKeys.contains("fileName") && (settings.m_fileName != m_fileName)) // reopen the record
+    {
+        MsgConfigureFileSourceName *msgName = MsgConfigureFileSourceName::create(settings.m_fileName);
+        m_inputMessageQueue.push(msgName);
+    }
+
+    if (getMessageQueueToGUI()) // forward to GUI if any
+    {
+        MsgConfigureFileSource *msgToGUI = MsgConfigureFileSource::create(settings);
+        getMessageQueueToGUI()->push(msgToGUI);
+    }
+
+    webapiFormatDeviceSettings(response, settings);
     return 200;
 }
 
+void FileSourceInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& response, const FileSourceSettings& settings)
+{
+    if (response.getFileSourceSettings()->getFileName()) {
+        *response.getFileSourceSettings()->getFileName() = settings.m_fileName;
+    } else {
+        response.getFileSourceSettings()->setFileName(new QString(settings.m_fileName));
+    }
+
+    response.getFileSourceSettings()->setLoop(settings.m_loop ? 1 : 0);
+    response.getFileSourceSettings()->setLoopStartMs(settings.m_loopStartMs);
+    response.getFileSourceSettings()->setLoopEndMs(settings.m_loopEndMs);
+    response.getFileSourceSettings()->setUnthrottled(settings.m_unthrottled ? 1 : 0);
+}
+
 int FileSourceInput::webapiRunGet(
         SWGSDRangel::SWGDeviceState& response,
         QString& errorMessage __attribute__((unused)))
@@ -20,9 +20,8 @@
 #include <QString>
 #include <QByteArray>
 #include <QTimer>
+#include <QFile>
 #include <ctime>
-#include <iostream>
-#include <fstream>
 
 #include <dsp/devicesamplesource.h>
 #include "filesourcesettings.h"
@@ -252,6 +251,12 @@ public:
 	            SWGSDRangel::SWGDeviceSettings& response,
 	            QString& errorMessage);
 
+    virtual int webapiSettingsPutPatch(
+                bool force,
+                const QStringList& deviceSettingsKeys,
+                SWGSDRangel::SWGDeviceSettings& response, // query + response
+                QString& errorMessage);
+
     virtual int webapiRunGet(
             SWGSDRangel::SWGDeviceState& response,
             QString& errorMessage);
@@ -269,7 +274,9 @@ public:
 	DeviceSourceAPI *m_deviceAPI;
 	QMutex m_mutex;
 	FileSourceSettings m_settings;
-	std::ifstream m_ifstream;
+	QFile m_file;
+	const quint8 *m_fileData; //!< record memory mapped in full
+	quint64 m_nbSamples;      //!< number of I/Q samples in the record
 	FileSourceThread* m_fileSourceThread;
 	QString m_deviceDescription;
 	QString m_fileName;
@@ -281,8 +288,11 @@ public:
 	const QTimer& m_masterTimer;
 
 	void openFileStream();
+	void closeFileStream();
 	void seekFileStream(int seekPercentage);
+	void applyLoopSettings();
 	bool applySettings(const FileSourceSettings& settings, bool force = false);
+    void webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& response, const FileSourceSettings& settings);
     void webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response);
 };
 
@@ -28,12 +28,20 @@ void FileSourceSettings::resetToDefaults()
     m_centerFrequency = 435000000;
     m_sampleRate = 48000;
     m_fileName = "./test.sdriq";
+    m_loop = true;
+    m_loopStartMs = 0;
+    m_loopEndMs = 0;
+    m_unthrottled = false;
 }
 
 QByteArray FileSourceSettings::serialize() const
 {
     SimpleSerializer s(1);
     s.writeString(1, m_fileName);
+    s.writeBool(2, m_loop);
+    s.writeU32(3, m_loopStartMs);
+    s.writeU32(4, m_loopEndMs);
+    s.writeBool(5, m_unthrottled);
     return s.final();
 }
 
@@ -48,6 +56,10 @@ bool FileSourceSettings::deserialize(const QByteArray& data)
 
     if(d.getVersion() == 1) {
         d.readString(1, &m_fileName, "./test.sdriq");
+        d.readBool(2, &m_loop, true);
+        d.readU32(3, &m_loopStartMs, 0);
+        d.readU32(4, &m_loopEndMs, 0);
+        d.readBool(5, &m_unthrottled, false);
         return true;
     } else {
         resetToDefaults();
@@ -24,6 +24,10 @@ struct FileSourceSettings {
     quint64 m_centerFrequency;
     qint32  m_sampleRate;
     QString m_fileName;
+    bool    m_loop;          //!< replay in a loop
+    quint32 m_loopStartMs;   //!< loop range start in milliseconds from record start
+    quint32 m_loopEndMs;     //!< loop range end in milliseconds from record start. 0 is end of record
+    bool    m_unthrottled;   //!< replay as fast as the DSP chain consumes samples
 
     FileSourceSettings();
     ~FileSourceSettings() {}
@@ -16,30 +16,94 @@
 
 #include <stdio.h>
 #include <errno.h>
-#include <assert.h>
+#include <algorithm>
 #include <QDebug>
 
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "dsp/filerecord.h"
 #include "filesourcethread.h"
 #include "dsp/samplesinkfifo.h"
 
-FileSourceThread::FileSourceThread(std::ifstream *samplesStream, SampleSinkFifo* sampleFifo, QObject* parent) :
+namespace {
+
+/** 16 bit record samples to 24 bit sample buffer. n is the number of I or Q values */
+void convert16to24(const int16_t *in, int32_t *out, quint32 n)
+{
+    quint32 i = 0;
+#if defined(USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &in[i]);
+        // value placed in the high half of each 32 bit lane then shifted down arithmetically: v << 8 sign extended
+        _mm_storeu_si128((__m128i*) &out[i],   _mm_srai_epi32(_mm_unpacklo_epi16(zero, v), 8));
+        _mm_storeu_si128((__m128i*) &out[i+4], _mm_srai_epi32(_mm_unpackhi_epi16(zero, v), 8));
+    }
+#elif defined(USE_NEON)
+    for (; i + 8 <= n; i += 8)
+    {
+        int16x8_t v = vld1q_s16(&in[i]);
+        vst1q_s32(&out[i],   vshll_n_s16(vget_low_s16(v), 8));
+        vst1q_s32(&out[i+4], vshll_n_s16(vget_high_s16(v), 8));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = in[i] << 8;
+    }
+}
+
+/** 24 bit record samples to 16 bit sample buffer. n is the number of I or Q values */
+void convert24to16(const int32_t *in, int16_t *out, quint32 n)
+{
+    quint32 i = 0;
+#if defined(USE_SSE2)
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i lo = _mm_srai_epi32(_mm_loadu_si128((const __m128i*) &in[i]), 8);
+        __m128i hi = _mm_srai_epi32(_mm_loadu_si128((const __m128i*) &in[i+4]), 8);
+        _mm_storeu_si128((__m128i*) &out[i], _mm_packs_epi32(lo, hi));
+    }
+#elif defined(USE_NEON)
+    for (; i + 8 <= n; i += 8)
+    {
+        int16x4_t lo = vshrn_n_s32(vld1q_s32(&in[i]), 8);
+        int16x4_t hi = vshrn_n_s32(vld1q_s32(&in[i+4]), 8);
+        vst1q_s16(&out[i], vcombine_s16(lo, hi));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = in[i] >> 8;
+    }
+}
+
+} // namespace
+
+FileSourceThread::FileSourceThread(const quint8 *samples, quint64 nbSamples, SampleSinkFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
 	m_running(false),
-	m_ifstream(samplesStream),
-	m_fileBuf(0),
+	m_samples(samples),
+	m_nbSamples(nbSamples),
 	m_convertBuf(0),
-	m_bufsize(0),
-	m_chunksize(0),
 	m_sampleFifo(sampleFifo),
 	m_samplesCount(0),
+	m_loop(true),
+	m_loopStart(0),
+	m_loopEnd(0),
+	m_unthrottled(false),
     m_samplerate(0),
 	m_samplesize(0),
 	m_samplebytes(0),
     m_throttlems(FILESOURCE_THROTTLE_MS),
     m_throttleToggle(false)
 {
-    assert(m_ifstream != 0);
+    m_convertBuf = (quint8*) malloc(FILESOURCE_CONVERT_SAMPLES*sizeof(Sample));
+    connect(this, SIGNAL(unthrottledChanged(bool)), this, SLOT(applyUnthrottled(bool)), Qt::QueuedConnection);
 }
 
 FileSourceThread::~FileSourceThread()
@@ -48,10 +112,6 @@ FileSourceThread::~FileSourceThread()
 		stopWork();
 	}
 
-	if (m_fileBuf != 0) {
-		free(m_fileBuf);
-	}
-
 	if (m_convertBuf != 0) {
 		free(m_convertBuf);
 	}
@@ -61,9 +121,9 @@ void FileSourceThread::startWork()
 {
 	qDebug() << "FileSourceThread::startWork: ";
 
-    if (m_ifstream->is_open())
+    if (m_nbSamples > 0)
     {
-        qDebug() << "FileSourceThread::startWork: file stream open, starting...";
+        qDebug() << "FileSourceThread::startWork: record mapped, starting...";
         m_startWaitMutex.lock();
         m_elapsedTimer.start();
         start();
@@ -73,7 +133,7 @@ void FileSourceThread::startWork()
     }
     else
     {
-        qDebug() << "FileSourceThread::startWork: file stream closed, not starting.";
+        qDebug() << "FileSourceThread::startWork: empty record, not starting.";
     }
 }
 
@@ -101,51 +161,43 @@ void FileSourceThread::setSampleRateAndSize(int samplerate, quint32 samplesize)
 		m_samplerate = samplerate;
 		m_samplesize = samplesize;
 		m_samplebytes = m_samplesize > 16 ? sizeof(int32_t) : sizeof(int16_t);
-        // TODO: implement FF and slow motion here. 2 corresponds to live. 1 is half speed, 4 is double speed
-        m_chunksize = (m_samplerate * 2 * m_samplebytes * m_throttlems) / 1000;
-
-        setBuffers(m_chunksize);
 	}
+}
 
-	//m_samplerate = samplerate;
+void FileSourceThread::setLoop(bool loop, quint64 loopStart, quint64 loopEnd)
+{
+	QMutexLocker mutexLocker(&m_positionMutex);
+	m_loop = loop;
+	m_loopEnd = (loopEnd == 0) || (loopEnd > m_nbSamples) ? m_nbSamples : loopEnd;
+	m_loopStart = loopStart < m_loopEnd ? loopStart : 0;
+	qDebug() << "FileSourceThread::setLoop:"
+			<< " loop:" << m_loop
+			<< " start:" << m_loopStart
+			<< " end:" << m_loopEnd;
 }
 
-void FileSourceThread::setBuffers(std::size_t chunksize)
+void FileSourceThread::setUnthrottled(bool unthrottled)
 {
-    if (chunksize > m_bufsize)
-    {
-        m_bufsize = chunksize;
-        int nbSamples = m_bufsize/(2 * m_samplebytes);
+	qDebug() << "FileSourceThread::setUnthrottled: " << unthrottled;
+	emit unthrottledChanged(unthrottled); // the elapsed timer belongs to the tick() thread: apply the change there
+}
 
-        if (m_fileBuf == 0)
-        {
-            qDebug() << "FileSourceThread::setBuffers: Allocate file buffer";
-            m_fileBuf = (quint8*) malloc(m_bufsize);
-        }
-        else
-        {
-            qDebug() << "FileSourceThread::setBuffers: Re-allocate file buffer";
-            quint8 *buf = m_fileBuf;
-            m_fileBuf = (quint8*) realloc((void*) m_fileBuf, m_bufsize);
-            if (!m_fileBuf) free(buf);
-        }
+void FileSourceThread::applyUnthrottled(bool unthrottled)
+{
+	m_unthrottled = unthrottled;
+	m_elapsedTimer.restart();
+}
 
-        if (m_convertBuf == 0)
-        {
-            qDebug() << "FileSourceThread::setBuffers: Allocate conversion buffer";
-            m_convertBuf = (quint8*) malloc(nbSamples*sizeof(Sample));
-        }
-        else
-        {
-            qDebug() << "FileSourceThread::setBuffers: Re-allocate conversion buffer";
-            quint8 *buf = m_convertBuf;
-            m_convertBuf = (quint8*) realloc((void*) m_convertBuf, nbSamples*sizeof(Sample));
-            if (!m_convertBuf) free(buf);
-        }
+void FileSourceThread::seek(quint64 sampleIndex)
+{
+	QMutexLocker mutexLocker(&m_positionMutex);
+	m_samplesCount = sampleIndex < m_nbSamples ? sampleIndex : m_nbSamples;
+}
 
-        qDebug() << "FileSourceThread::setBuffers: size: " << m_bufsize
-                << " #samples: " << nbSamples;
-    }
+std::size_t FileSourceThread::getSamplesCount() const
+{
+	QMutexLocker mutexLocker(&m_positionMutex);
+	return m_samplesCount;
 }
 
 void FileSourceThread::run()
@@ -153,9 +205,21 @@ void FileSourceThread::run()
 	m_running = true;
 	m_startWaiter.wakeAll();
 
-	while(m_running) // actual work is in the tick() function
+	while(m_running)
 	{
-		sleep(1);
+		if (m_unthrottled)
+		{
+			// push as much as the FIFO can take without overflowing
+			quint32 room = m_sampleFifo->size() - m_sampleFifo->fill();
+
+			if ((room < FILESOURCE_CONVERT_SAMPLES) || (pushSamples(room) == 0)) {
+				usleep(1000);
+			}
+		}
+		else // actual work is in the tick() function
+		{
+			msleep(100);
+		}
 	}
 
 	m_running = false;
@@ -169,83 +233,66 @@ void FileSourceThread::connectTimer(const QTimer& timer)
 
 void FileSourceThread::tick()
 {
-	if (m_running)
+	if (m_running && !m_unthrottled)
 	{
         qint64 throttlems = m_elapsedTimer.restart();
 
         if (throttlems != m_throttlems)
         {
             m_throttlems = throttlems;
-            m_chunksize = 2 * m_samplebytes * ((m_samplerate * (m_throttlems+(m_throttleToggle ? 1 : 0))) / 1000);
             m_throttleToggle = !m_throttleToggle;
-            setBuffers(m_chunksize);
         }
 
-		// read samples directly feeding the SampleFifo (no callback)
-		m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
-
-        if (m_ifstream->eof())
-        {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
-            //m_sampleFifo->write(m_buf, m_ifstream->gcount());
-            // TODO: handle loop playback situation
-    		m_ifstream->clear();
-            m_ifstream->seekg(sizeof(FileRecord::Header), std::ios::beg);
-    		m_samplesCount = 0;
-            //stopWork();
-            //m_ifstream->close();
-        }
-        else
-        {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
-            //m_sampleFifo->write(m_buf, m_chunksize);
-    		m_samplesCount += m_chunksize / (2 * m_samplebytes);
-        }
+        // TODO: implement FF and slow motion here
+        pushSamples((m_samplerate * (m_throttlems+(m_throttleToggle ? 1 : 0))) / 1000);
 	}
 }
 
-void FileSourceThread::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
+quint64 FileSourceThread::pushSamples(quint64 nbSamples)
 {
-	if (m_samplesize == 16)
+	QMutexLocker mutexLocker(&m_positionMutex);
+	quint64 end = m_loopEnd == 0 ? m_nbSamples : m_loopEnd;
+	quint64 pushed = 0;
+
+	while (pushed < nbSamples)
 	{
-		if (SDR_RX_SAMP_SZ == 16)
+		if (m_samplesCount >= end)
 		{
-			m_sampleFifo->write(buf, nbBytes);
-		}
-		else if (SDR_RX_SAMP_SZ == 24)
-		{
-			FixReal *convertBuf = (FixReal *) m_convertBuf;
-			const int16_t *fileBuf = (int16_t *) buf;
-			int nbSamples = nbBytes / (2 * m_samplebytes);
-
-			for (int is = 0; is < nbSamples; is++)
-			{
-				convertBuf[2*is]   = fileBuf[2*is] << 8;
-				convertBuf[2*is+1] = fileBuf[2*is+1] << 8;
+			if (!m_loop) { // stay at the end of the record
+				break;
 			}
 
-			m_sampleFifo->write((quint8*) convertBuf, nbSamples*sizeof(Sample));
+			m_samplesCount = m_loopStart;
 		}
+
+		quint64 chunk = std::min(nbSamples - pushed, end - m_samplesCount);
+		writeToSampleFifo(m_samples + m_samplesCount * 2 * m_samplebytes, chunk);
+		m_samplesCount += chunk;
+		pushed += chunk;
 	}
-	else if (m_samplesize == 24)
+
+	return pushed;
+}
+
+void FileSourceThread::writeToSampleFifo(const quint8* buf, quint32 nbSamples)
+{
+	if (m_samplesize == SDR_RX_SAMP_SZ)
 	{
-		if (SDR_RX_SAMP_SZ == 24)
-		{
-			m_sampleFifo->write(buf, nbBytes);
-		}
-		else if (SDR_RX_SAMP_SZ == 16)
-		{
-			FixReal *convertBuf = (FixReal *) m_convertBuf;
-			const int32_t *fileBuf = (int32_t *) buf;
-			int nbSamples = nbBytes / (2 * m_samplebytes);
-
-			for (int is = 0; is < nbSamples; is++)
-			{
-				convertBuf[2*is]   = fileBuf[2*is] >> 8;
-				convertBuf[2*is+1] = fileBuf[2*is+1] >> 8;
-			}
+		// record layout is the FIFO layout: copy straight from the mapped record
+		m_sampleFifo->write(buf, nbSamples*sizeof(Sample));
+		return;
+	}
+
+	for (quint32 is = 0; is < nbSamples; is += FILESOURCE_CONVERT_SAMPLES)
+	{
+		quint32 n = std::min(nbSamples - is, (quint32) FILESOURCE_CONVERT_SAMPLES);
 
-			m_sampleFifo->write((quint8*) convertBuf, nbSamples*sizeof(Sample));
+		if (m_samplesize == 16) {
+			convert16to24(((const int16_t *) buf) + 2*is, (int32_t *) m_convertBuf, 2*n);
+		} else {
+			convert24to16(((const int32_t *) buf) + 2*is, (int16_t *) m_convertBuf, 2*n);
 		}
+
+		m_sampleFifo->write(m_convertBuf, n*sizeof(Sample));
 	}
 }
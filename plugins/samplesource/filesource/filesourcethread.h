@@ -22,30 +22,37 @@
 #include <QWaitCondition>
 #include <QTimer>
 #include <QElapsedTimer>
-#include <iostream>
-#include <fstream>
 #include <cstdlib>
 
 #include "dsp/inthalfbandfilter.h"
 
 #define FILESOURCE_THROTTLE_MS 50
+#define FILESOURCE_CONVERT_SAMPLES 8192 // conversion block: stays in L1/L2 cache
 
 class SampleSinkFifo;
 
+/**
+ * Replays a memory mapped I/Q record. The record is addressed by sample index so seeking
+ * is immediate and looping over a range of the record is just resetting the index.
+ * In throttled mode the samples are pushed at the record sample rate on each master timer
+ * tick. In unthrottled mode the thread fills the sample FIFO as fast as it is consumed.
+ */
 class FileSourceThread : public QThread {
 	Q_OBJECT
 
 public:
-	FileSourceThread(std::ifstream *samplesStream, SampleSinkFifo* sampleFifo, QObject* parent = NULL);
+	FileSourceThread(const quint8 *samples, quint64 nbSamples, SampleSinkFifo* sampleFifo, QObject* parent = NULL);
 	~FileSourceThread();
 
 	void startWork();
 	void stopWork();
 	void setSampleRateAndSize(int samplerate, quint32 samplesize);
-    void setBuffers(std::size_t chunksize);
+	void setLoop(bool loop, quint64 loopStart, quint64 loopEnd); //!< loop range in samples. End 0 is end of record
+	void setUnthrottled(bool unthrottled);
+	void seek(quint64 sampleIndex);
 	bool isRunning() const { return m_running; }
-	std::size_t getSamplesCount() const { return m_samplesCount; }
-	void setSamplesCount(int samplesCount) { m_samplesCount = samplesCount; }
+	std::size_t getSamplesCount() const;
+	void setSamplesCount(int samplesCount) { seek(samplesCount); }
 
 	void connectTimer(const QTimer& timer);
 
@@ -54,13 +61,16 @@ private:
 	QWaitCondition m_startWaiter;
 	volatile bool m_running;
 
-	std::ifstream* m_ifstream;
-	quint8  *m_fileBuf;
+	const quint8 *m_samples; //!< start of I/Q data in the mapped record
+	quint64 m_nbSamples;     //!< number of I/Q samples in the record
 	quint8  *m_convertBuf;
-	std::size_t m_bufsize;
-	std::size_t m_chunksize;
 	SampleSinkFifo* m_sampleFifo;
-	std::size_t m_samplesCount;
+	mutable QMutex m_positionMutex;
+	quint64 m_samplesCount;  //!< current position as a sample index in the record
+	bool m_loop;
+	quint64 m_loopStart;
+	quint64 m_loopEnd;
+	volatile bool m_unthrottled;
 
 	int m_samplerate;      //!< File I/Q stream original sample rate
 	quint32 m_samplesize;  //!< File effective sample size in bits (I or Q). Ex: 16, 24.
@@ -70,10 +80,14 @@ private:
     bool m_throttleToggle;
 
 	void run();
-	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
-	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
+	quint64 pushSamples(quint64 nbSamples);
+	void writeToSampleFifo(const quint8* buf, quint32 nbSamples);
+signals:
+	void unthrottledChanged(bool unthrottled);
+
 private slots:
 	void tick();
+	void applyUnthrottled(bool unthrottled);
 };
 
 #endif // INCLUDE_FILESOURCETHREAD_H
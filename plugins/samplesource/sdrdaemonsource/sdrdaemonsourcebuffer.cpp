@@ -29,6 +29,15 @@ const int SDRdaemonSourceBuffer::m_sampleSize = 2;
 const int SDRdaemonSourceBuffer::m_iqSampleSize = 2 * m_sampleSize;
 
 SDRdaemonSourceBuffer::SDRdaemonSourceBuffer() :
+        m_blockSize(SDRDAEMONSOURCE_UDPSIZE),
+        m_protectedBlockSize(0),
+        m_compressionBits(0),
+        m_samplesPerBlock(0),
+        m_decodedBlockSize(0),
+        m_frameSize(0),
+        m_frames(0),
+        m_slotBlocks(0),
+        m_framesNbBytes(0),
         m_decoderIndexHead(nbDecoderSlots/2),
         m_frameHead(0),
         m_curNbBlocks(0),
@@ -38,6 +47,8 @@ SDRdaemonSourceBuffer::SDRdaemonSourceBuffer() :
         m_curNbRecovery(0),
         m_maxNbRecovery(0),
         m_framesDecoded(true),
+        m_nbLostBlocks(0),
+        m_nbUnrecoverableFrames(0),
         m_readIndex(0),
         m_readBuffer(0),
         m_readSize(0),
@@ -48,12 +59,9 @@ SDRdaemonSourceBuffer::SDRdaemonSourceBuffer() :
 	    m_balCorrLimit(0)
 {
 	m_currentMeta.init();
-	m_framesNbBytes = nbDecoderSlots * sizeof(BufferFrame);
-	m_wrDeltaEstimate = m_framesNbBytes / 2;
 	m_tvOut_sec = 0;
 	m_tvOut_usec = 0;
 	m_readNbBytes = 1;
-    m_paramsCM256.BlockBytes = sizeof(ProtectedBlock); // never changes
     m_paramsCM256.OriginalCount = m_nbOriginalBlocks;  // never changes
 
     if (!m_cm256.isInitialized()) {
@@ -64,7 +72,7 @@ SDRdaemonSourceBuffer::SDRdaemonSourceBuffer() :
     }
 
     std::fill(m_decoderSlots, m_decoderSlots + nbDecoderSlots, DecoderSlot());
-    std::fill(m_frames, m_frames + nbDecoderSlots, BufferFrame());
+    allocateBuffers();
 }
 
 SDRdaemonSourceBuffer::~SDRdaemonSourceBuffer()
@@ -72,6 +80,92 @@ SDRdaemonSourceBuffer::~SDRdaemonSourceBuffer()
 	if (m_readBuffer) {
 		delete[] m_readBuffer;
 	}
+
+	delete[] m_frames;
+	delete[] m_slotBlocks;
+}
+
+void SDRdaemonSourceBuffer::allocateBuffers()
+{
+    delete[] m_frames;
+    delete[] m_slotBlocks;
+
+    m_protectedBlockSize = m_blockSize - sizeof(Header);
+
+    if (m_compressionBits) {
+        m_samplesPerBlock = BlockFloatingPoint::getNbSamples(m_protectedBlockSize, m_compressionBits);
+    } else {
+        m_samplesPerBlock = m_protectedBlockSize / sizeof(SDRdaemonSample);
+    }
+
+    m_decodedBlockSize = m_samplesPerBlock * sizeof(SDRdaemonSample);
+    m_frameSize = (m_nbOriginalBlocks - 1) * m_decodedBlockSize;
+    m_framesNbBytes = nbDecoderSlots * m_frameSize;
+    m_wrDeltaEstimate = m_framesNbBytes / 2;
+    m_frames = new uint8_t[m_framesNbBytes]();
+
+    // block zero followed by recovery blocks then compressed original blocks if any
+    int slotNbBytes = (m_nbOriginalBlocks + 1 + (m_compressionBits ? m_nbOriginalBlocks - 1 : 0)) * m_protectedBlockSize;
+    m_slotBlocks = new uint8_t[nbDecoderSlots * slotNbBytes]();
+
+    for (int i = 0; i < nbDecoderSlots; i++)
+    {
+        m_decoderSlots[i].m_blockZero = &m_slotBlocks[i * slotNbBytes];
+        m_decoderSlots[i].m_recoveryBlocks = &m_slotBlocks[i * slotNbBytes + m_protectedBlockSize];
+        m_decoderSlots[i].m_compressedBlocks = m_compressionBits ?
+                &m_slotBlocks[i * slotNbBytes + (m_nbOriginalBlocks + 1) * m_protectedBlockSize] : 0;
+    }
+
+    m_paramsCM256.BlockBytes = m_protectedBlockSize;
+}
+
+bool SDRdaemonSourceBuffer::setBlockSize(int blockSize)
+{
+    if (blockSize == m_blockSize) {
+        return true;
+    }
+
+    if (!isValidBlockSize(blockSize))
+    {
+        qWarning("SDRdaemonSourceBuffer::setBlockSize: invalid block size: %d", blockSize);
+        return false;
+    }
+
+    qDebug("SDRdaemonSourceBuffer::setBlockSize: %d -> %d bytes", m_blockSize, blockSize);
+
+    m_blockSize = blockSize;
+    resetBuffers();
+
+    return true;
+}
+
+bool SDRdaemonSourceBuffer::setCompressionBits(int compressionBits)
+{
+    if (compressionBits == m_compressionBits) {
+        return true;
+    }
+
+    if ((compressionBits != 0) && !BlockFloatingPoint::isValidBits(compressionBits))
+    {
+        qWarning("SDRdaemonSourceBuffer::setCompressionBits: invalid number of bits: %d", compressionBits);
+        return false;
+    }
+
+    qDebug("SDRdaemonSourceBuffer::setCompressionBits: %d -> %d bits", m_compressionBits, compressionBits);
+
+    m_compressionBits = compressionBits;
+    resetBuffers();
+
+    return true;
+}
+
+void SDRdaemonSourceBuffer::resetBuffers()
+{
+    allocateBuffers();
+    initDecodeAllSlots();
+    initReadIndex();
+    m_currentMeta.init(); // force meta data dependent values to be recalculated
+    m_frameHead = -1;     // restart on next block
 }
 
 void SDRdaemonSourceBuffer::initDecodeAllSlots()
@@ -84,7 +178,7 @@ void SDRdaemonSourceBuffer::initDecodeAllSlots()
         m_decoderSlots[i].m_decoded = false;
         m_decoderSlots[i].m_metaRetrieved = false;
         resetOriginalBlocks(i);
-        memset((void *) m_decoderSlots[i].m_recoveryBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
+        memset((void *) m_decoderSlots[i].m_recoveryBlocks, 0, m_nbOriginalBlocks * m_protectedBlockSize);
     }
 }
 
@@ -112,6 +206,19 @@ void SDRdaemonSourceBuffer::initDecodeSlot(int slotIndex)
         m_maxNbRecovery = m_curNbRecovery;
     }
 
+    if (m_curNbBlocks > 0) // slot was in use
+    {
+        int nbExpectedBlocks = m_nbOriginalBlocks + m_currentMeta.m_nbFECBlocks;
+
+        if (m_curNbBlocks < nbExpectedBlocks) {
+            m_nbLostBlocks += nbExpectedBlocks - m_curNbBlocks;
+        }
+
+        if (!m_decoderSlots[slotIndex].m_decoded) {
+            m_nbUnrecoverableFrames++;
+        }
+    }
+
     // void the slot
 
     m_decoderSlots[slotIndex].m_blockCount = 0;
@@ -121,12 +228,12 @@ void SDRdaemonSourceBuffer::initDecodeSlot(int slotIndex)
     m_decoderSlots[slotIndex].m_metaRetrieved = false;
 
     resetOriginalBlocks(slotIndex);
-    memset((void *) m_decoderSlots[slotIndex].m_recoveryBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
+    memset((void *) m_decoderSlots[slotIndex].m_recoveryBlocks, 0, m_nbOriginalBlocks * m_protectedBlockSize);
 }
 
 void SDRdaemonSourceBuffer::initReadIndex()
 {
-    m_readIndex = ((m_decoderIndexHead + (nbDecoderSlots/2)) % nbDecoderSlots) * sizeof(BufferFrame);
+    m_readIndex = ((m_decoderIndexHead + (nbDecoderSlots/2)) % nbDecoderSlots) * m_frameSize;
     m_wrDeltaEstimate = m_framesNbBytes / 2;
     m_nbReads = 0;
     m_nbWrites = 0;
@@ -137,19 +244,19 @@ void SDRdaemonSourceBuffer::rwCorrectionEstimate(int slotIndex)
 	if (m_nbReads >= 40) // check every ~1s as tick is ~50ms
 	{
 		int targetPivotSlot = (slotIndex + (nbDecoderSlots/2))  % nbDecoderSlots; // slot at half buffer opposite of current write slot
-		int targetPivotIndex = targetPivotSlot * sizeof(BufferFrame);             // buffer index corresponding to start of above slot
-		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + nbDecoderSlots * sizeof(BufferFrame) :  m_readIndex)
-				- (targetPivotSlot * sizeof(BufferFrame)); // normalize read index so it is positive and zero at start of pivot slot
+		int targetPivotIndex = targetPivotSlot * m_frameSize;                     // buffer index corresponding to start of above slot
+		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + m_framesNbBytes :  m_readIndex)
+				- (targetPivotSlot * m_frameSize); // normalize read index so it is positive and zero at start of pivot slot
 		int dBytes;
-        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * sizeof(BufferFrame));
+        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * m_frameSize);
 
-		if (normalizedReadIndex < (nbDecoderSlots/ 2) * (int) sizeof(BufferFrame)) // read leads
+		if (normalizedReadIndex < (nbDecoderSlots/ 2) * m_frameSize) // read leads
 		{
 			dBytes = - normalizedReadIndex - rwDelta;
 		}
 		else // read lags
 		{
-			dBytes = (nbDecoderSlots * sizeof(BufferFrame)) - normalizedReadIndex - rwDelta;
+			dBytes = m_framesNbBytes - normalizedReadIndex - rwDelta;
 		}
 
         m_balCorrection = (m_balCorrection / 4) + (dBytes / (int) (m_iqSampleSize * m_nbReads)); // correction is in number of samples. Alpha = 0.25
@@ -167,11 +274,11 @@ void SDRdaemonSourceBuffer::rwCorrectionEstimate(int slotIndex)
 
 void SDRdaemonSourceBuffer::checkSlotData(int slotIndex)
 {
-    int pseudoWriteIndex = slotIndex * sizeof(BufferFrame);
+    int pseudoWriteIndex = slotIndex * m_frameSize;
     m_wrDeltaEstimate = pseudoWriteIndex - m_readIndex;
     m_nbWrites++;
 
-    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : sizeof(BufferFrame) * nbDecoderSlots + m_wrDeltaEstimate);
+    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : m_framesNbBytes + m_wrDeltaEstimate);
     int sampleRate = m_currentMeta.m_sampleRate;
 
     if (sampleRate > 0)
@@ -192,10 +299,28 @@ void SDRdaemonSourceBuffer::checkSlotData(int slotIndex)
 
 void SDRdaemonSourceBuffer::writeData(char *array)
 {
-    SuperBlock *superBlock = (SuperBlock *) array;
-    int frameIndex = superBlock->header.frameIndex;
+    Header *header = (Header *) array;
+    uint8_t *protectedBlock = (uint8_t *) &array[sizeof(Header)];
+    int frameIndex = header->frameIndex;
     int decoderIndex = frameIndex % nbDecoderSlots;
 
+    // compression change is signalled in the meta data of block zero
+
+    if (header->blockIndex == 0)
+    {
+        MetaDataFEC *metaData = (MetaDataFEC *) protectedBlock;
+
+        if (metaData->m_compressionBits != m_compressionBits)
+        {
+            boost::crc_32_type crc32;
+            crc32.process_bytes(metaData, 20);
+
+            if (crc32.checksum() == metaData->m_crc32) {
+                setCompressionBits(metaData->m_compressionBits); // restarts from initial state
+            }
+        }
+    }
+
     // frame break
 
     if (m_frameHead == -1) // initial state
@@ -218,7 +343,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
     if (m_decoderSlots[decoderIndex].m_blockCount < m_nbOriginalBlocks) // not enough blocks to decode -> store data
     {
-        int blockIndex = superBlock->header.blockIndex;
+        int blockIndex = header->blockIndex;
         int blockCount = m_decoderSlots[decoderIndex].m_blockCount;
         int recoveryCount = m_decoderSlots[decoderIndex].m_recoveryCount;
         m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Index = blockIndex;
@@ -230,13 +355,14 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
         if (blockIndex < m_nbOriginalBlocks) // original data
         {
-            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) storeOriginalBlock(decoderIndex, blockIndex, superBlock->protectedBlock);
+            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) storeOriginalBlock(decoderIndex, blockIndex, protectedBlock);
             m_decoderSlots[decoderIndex].m_originalCount++;
         }
         else // recovery data
         {
-            m_decoderSlots[decoderIndex].m_recoveryBlocks[recoveryCount] = superBlock->protectedBlock;
-            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) &m_decoderSlots[decoderIndex].m_recoveryBlocks[recoveryCount];
+            uint8_t *recoveryBlock = getRecoveryBlock(decoderIndex, recoveryCount);
+            memcpy((void *) recoveryBlock, (const void *) protectedBlock, m_protectedBlockSize);
+            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) recoveryBlock;
             m_decoderSlots[decoderIndex].m_recoveryCount++;
         }
     }
@@ -249,7 +375,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
         if (m_cm256_OK && (m_decoderSlots[decoderIndex].m_recoveryCount > 0)) // recovery data used => need to decode FEC
         {
-            m_paramsCM256.BlockBytes = sizeof(ProtectedBlock); // never changes
+            m_paramsCM256.BlockBytes = m_protectedBlockSize;   // changes only with block size
             m_paramsCM256.OriginalCount = m_nbOriginalBlocks;  // never changes
 
             if (m_decoderSlots[decoderIndex].m_metaRetrieved) {
@@ -274,7 +400,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
                 {
                     int recoveryIndex = m_nbOriginalBlocks - m_decoderSlots[decoderIndex].m_recoveryCount + ir;
                     int blockIndex = m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Index;
-                    ProtectedBlock *recoveredBlock = (ProtectedBlock *) m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
+                    uint8_t *recoveredBlock = (uint8_t *) m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
 
                     if (blockIndex == 0) // first block with meta
                     {
@@ -294,7 +420,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
                         }
                     }
 
-                    storeOriginalBlock(decoderIndex, blockIndex, *recoveredBlock);
+                    storeOriginalBlock(decoderIndex, blockIndex, recoveredBlock);
 
                     qDebug() << "SDRdaemonSourceBuffer::writeData: recovered block #" << blockIndex;
                 } // restore missing blocks
@@ -316,6 +442,11 @@ void SDRdaemonSourceBuffer::writeData(char *array)
                 }
 
                 printMeta("SDRdaemonSourceBuffer::writeData: new meta", metaData); // print for change other than timestamp
+                int metaBlockSize = metaData->m_blockSize == 0 ? m_udpPayloadSizeDefault : metaData->m_blockSize;
+
+                if (metaBlockSize != m_blockSize) {
+                    qWarning("SDRdaemonSourceBuffer::writeData: meta block size %d does not match received block size %d", metaBlockSize, m_blockSize);
+                }
             }
 
             m_currentMeta = *metaData; // renew current meta
@@ -398,14 +529,14 @@ void SDRdaemonSourceBuffer::writeData0(char *array __attribute__((unused)), uint
 
 uint8_t *SDRdaemonSourceBuffer::readData(int32_t length)
 {
-    uint8_t *buffer = (uint8_t *) m_frames;
+    uint8_t *buffer = m_frames;
     uint32_t readIndex = m_readIndex;
 
     m_nbReads++;
 
     // SEGFAULT FIX: arbitratily truncate so that it does not exceed buffer length
-    if (length > framesSize) {
-        length = framesSize;
+    if (length > m_framesNbBytes) {
+        length = m_framesNbBytes;
     }
 
     if (m_readIndex + length < m_framesNbBytes) // ends before buffer bound
@@ -449,5 +580,7 @@ void SDRdaemonSourceBuffer::printMeta(const QString& header, MetaDataFEC *metaDa
             << ":" << (int) metaData->m_nbFECBlocks
             << "|" << metaData->m_tv_sec
             << ":" << metaData->m_tv_usec
+            << "|" << metaData->m_blockSize
+            << ":" << (int) metaData->m_compressionBits
             << "|";
 }
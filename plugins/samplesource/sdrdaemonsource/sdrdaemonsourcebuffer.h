@@ -21,10 +21,12 @@
 #include <QDebug>
 #include <cstdlib>
 #include "cm256.h"
+#include "dsp/blockfloatingpoint.h"
 #include "util/movingaverage.h"
 
 
-#define SDRDAEMONSOURCE_UDPSIZE 512               // UDP payload size
+#define SDRDAEMONSOURCE_UDPSIZE 512               // default UDP payload size
+#define SDRDAEMONSOURCE_UDPSIZE_MAX 8972          // maximum UDP payload size: 9000 bytes jumbo frame MTU less IP and UDP headers
 #define SDRDAEMONSOURCE_NBORIGINALBLOCKS 128      // number of sample blocks per frame excluding FEC blocks
 #define SDRDAEMONSOURCE_NBDECODERSLOTS 16         // power of two sub multiple of uint16_t size. A too large one is superfluous.
 
@@ -43,6 +45,8 @@ public:
         uint32_t m_tv_sec;            //!< 16 seconds of timestamp at start time of super-frame processing
         uint32_t m_tv_usec;           //!< 20 microseconds of timestamp at start time of super-frame processing
         uint32_t m_crc32;             //!< 24 CRC32 of the above
+        uint16_t m_blockSize;         //!< 26 UDP block size in bytes (0 for legacy 512 bytes). Not covered by CRC32.
+        uint8_t  m_compressionBits;   //!< 27 block floating point mantissa bits (0 for no compression). Not covered by CRC32.
 
         bool operator==(const MetaDataFEC& rhs)
         {
@@ -68,32 +72,35 @@ public:
         uint8_t  filler;
     };
 
-    static const int samplesPerBlock = (SDRDAEMONSOURCE_UDPSIZE - sizeof(Header)) / sizeof(SDRdaemonSample);
-    static const int framesSize = SDRDAEMONSOURCE_NBDECODERSLOTS * (SDRDAEMONSOURCE_NBORIGINALBLOCKS - 1) * (SDRDAEMONSOURCE_UDPSIZE - sizeof(Header));
-
-    struct ProtectedBlock
-    {
-        SDRdaemonSample samples[samplesPerBlock];
-    };
-
-    struct SuperBlock
-    {
-        Header         header;
-        ProtectedBlock protectedBlock;
-    };
 #pragma pack(pop)
 
 	SDRdaemonSourceBuffer();
 	~SDRdaemonSourceBuffer();
 
 	// R/W operations
-	void writeData(char *array); //!< Write data into buffer.
+	void writeData(char *array); //!< Write one block of getBlockSize() bytes into buffer.
     void writeData0(char *array, uint32_t length); //!< Write data into buffer.
 	uint8_t *readData(int32_t length);            //!< Read data from buffer
 
 	// meta data
 	const MetaDataFEC& getCurrentMeta() const { return m_currentMeta; }
 
+	// block size
+	bool setBlockSize(int blockSize); //!< Resize buffers for a new UDP block size. Buffered data is lost.
+	int getBlockSize() const { return m_blockSize; }
+	static bool isValidBlockSize(int blockSize)
+	{
+	    return (blockSize >= m_udpPayloadSizeDefault)
+	        && (blockSize <= m_udpPayloadSizeMax)
+	        && (((blockSize - (int) sizeof(Header)) % (int) sizeof(SDRdaemonSample)) == 0);
+	}
+
+	// compression
+	bool setCompressionBits(int compressionBits); //!< Resize buffers for a new compression (0: none). Buffered data is lost.
+	int getCompressionBits() const { return m_compressionBits; }
+	/** Ratio of decoded samples size to transmitted samples size */
+	float getCompressionRatio() const { return (float) m_decodedBlockSize / (float) m_protectedBlockSize; }
+
 	// samples timestamp
 	uint32_t getTVOutSec() const { return m_tvOut_sec; }
 	uint32_t getTVOutUsec() const { return m_tvOut_usec; }
@@ -135,6 +142,9 @@ public:
         return framesDecoded;
     }
 
+    quint64 getNbLostBlocks() const { return m_nbLostBlocks; }
+    quint64 getNbUnrecoverableFrames() const { return m_nbUnrecoverableFrames; }
+
     float getBufferLengthInSecs() const { return m_bufferLenSec; }
     int32_t getRWBalanceCorrection() const { return m_balCorrection; }
 
@@ -156,7 +166,8 @@ public:
         }
     }
 
-    static const int m_udpPayloadSize = SDRDAEMONSOURCE_UDPSIZE;
+    static const int m_udpPayloadSizeDefault = SDRDAEMONSOURCE_UDPSIZE;
+    static const int m_udpPayloadSizeMax = SDRDAEMONSOURCE_UDPSIZE_MAX;
     static const int m_nbOriginalBlocks = SDRDAEMONSOURCE_NBORIGINALBLOCKS;
 	static const int m_sampleSize;
 	static const int m_iqSampleSize;
@@ -164,18 +175,11 @@ public:
 private:
     static const int nbDecoderSlots = SDRDAEMONSOURCE_NBDECODERSLOTS;
 
-#pragma pack(push, 1)
-    struct BufferFrame
-    {
-        ProtectedBlock  m_blocks[m_nbOriginalBlocks - 1];
-    };
-#pragma pack(pop)
-
     struct DecoderSlot
     {
-        ProtectedBlock       m_blockZero;                                 //!< First block of a frame. Has meta data.
-        ProtectedBlock       m_originalBlocks[m_nbOriginalBlocks];        //!< Original blocks retrieved directly or by later FEC
-        ProtectedBlock       m_recoveryBlocks[m_nbOriginalBlocks];        //!< Recovery blocks (FEC blocks) with max size
+        uint8_t             *m_blockZero;                                 //!< First block of a frame. Has meta data.
+        uint8_t             *m_recoveryBlocks;                            //!< Recovery blocks (FEC blocks) with max count
+        uint8_t             *m_compressedBlocks;                          //!< Original blocks as received when compressed else null
         CM256::cm256_block   m_cm256DescriptorBlocks[m_nbOriginalBlocks]; //!< CM256 decoder descriptors (block addresses and block indexes)
         int                  m_blockCount;         //!< number of blocks received for this frame
         int                  m_originalCount;      //!< number of original blocks received
@@ -187,7 +191,14 @@ private:
     MetaDataFEC          m_currentMeta;          //!< Stored current meta data
     CM256::cm256_encoder_params m_paramsCM256;          //!< CM256 decoder parameters block
     DecoderSlot          m_decoderSlots[nbDecoderSlots]; //!< CM256 decoding control/buffer slots
-    BufferFrame          m_frames[nbDecoderSlots];       //!< Samples buffer
+    int                  m_blockSize;                    //!< UDP block size in bytes
+    int                  m_protectedBlockSize;           //!< Size of the data part of a block in bytes
+    int                  m_compressionBits;              //!< Block floating point mantissa bits or 0 if not compressed
+    int                  m_samplesPerBlock;              //!< Number of I/Q samples in a block
+    int                  m_decodedBlockSize;             //!< Size of the samples of a block in samples buffer in bytes
+    int                  m_frameSize;                    //!< Size of a frame in samples buffer in bytes (block zero excluded)
+    uint8_t             *m_frames;                       //!< Samples buffer
+    uint8_t             *m_slotBlocks;                   //!< Storage for block zero and recovery blocks of all slots
     int                  m_framesNbBytes;                //!< Number of bytes in samples buffer
     int                  m_decoderIndexHead;     //!< index of the current head frame slot in decoding slots
     int                  m_frameHead;            //!< index of the current head frame sent
@@ -201,6 +212,8 @@ private:
     MovingAverageUtil<int, int, 10> m_avgOrigBlocks; //!< (stats) average number of original blocks received
     MovingAverageUtil<int, int, 10> m_avgNbRecovery; //!< (stats) average number of recovery blocks used
     bool                 m_framesDecoded;        //!< [stats] true if all frames were decoded since last poll
+    quint64              m_nbLostBlocks;         //!< (stats) cumulative number of blocks missing in received frames
+    quint64              m_nbUnrecoverableFrames; //!< (stats) cumulative number of frames with too few blocks to be decoded
     int                  m_readIndex;            //!< current byte read index in frames buffer
     int                  m_wrDeltaEstimate;      //!< Sampled estimate of write to read indexes difference
     uint32_t             m_tvOut_sec;            //!< Estimated returned samples timestamp (seconds)
@@ -219,45 +232,53 @@ private:
     CM256    m_cm256;         //!< CM256 library
     bool     m_cm256_OK;      //!< CM256 library initialized OK
 
-    inline ProtectedBlock* storeOriginalBlock(int slotIndex, int blockIndex, const ProtectedBlock& protectedBlock)
+    inline uint8_t *getOriginalBlock(int slotIndex, int blockIndex)
     {
         if (blockIndex == 0) {
-            // m_decoderSlots[slotIndex].m_originalBlocks[0] = protectedBlock;
-            // return &m_decoderSlots[slotIndex].m_originalBlocks[0];
-            m_decoderSlots[slotIndex].m_blockZero = protectedBlock;
-            return &m_decoderSlots[slotIndex].m_blockZero;
+            return m_decoderSlots[slotIndex].m_blockZero;
+        } else if (m_compressionBits) {
+            return &m_decoderSlots[slotIndex].m_compressedBlocks[(blockIndex - 1) * m_protectedBlockSize];
         } else {
-            // m_decoderSlots[slotIndex].m_originalBlocks[blockIndex] = protectedBlock;
-            // return &m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
-            m_frames[slotIndex].m_blocks[blockIndex - 1] = protectedBlock;
-            return &m_frames[slotIndex].m_blocks[blockIndex - 1];
+            return &m_frames[slotIndex * m_frameSize + (blockIndex - 1) * m_protectedBlockSize];
         }
     }
 
-    inline ProtectedBlock& getOriginalBlock(int slotIndex, int blockIndex)
+    inline uint8_t *storeOriginalBlock(int slotIndex, int blockIndex, const uint8_t *protectedBlock)
     {
-        if (blockIndex == 0) {
-            // return m_decoderSlots[slotIndex].m_originalBlocks[0];
-            return m_decoderSlots[slotIndex].m_blockZero;
-        } else {
-            // return m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
-            return m_frames[slotIndex].m_blocks[blockIndex - 1];
+        uint8_t *block = getOriginalBlock(slotIndex, blockIndex);
+        memcpy((void *) block, (const void *) protectedBlock, m_protectedBlockSize);
+
+        if (m_compressionBits && (blockIndex > 0)) // expand into samples buffer. The compressed copy is kept for FEC decoding.
+        {
+            int16_t *samples = (int16_t *) &m_frames[slotIndex * m_frameSize + (blockIndex - 1) * m_decodedBlockSize];
+            BlockFloatingPoint::decode(block, m_samplesPerBlock, m_compressionBits, samples);
         }
+
+        return block;
+    }
+
+    inline uint8_t *getRecoveryBlock(int slotIndex, int recoveryIndex)
+    {
+        return &m_decoderSlots[slotIndex].m_recoveryBlocks[recoveryIndex * m_protectedBlockSize];
     }
 
     inline MetaDataFEC *getMetaData(int slotIndex)
     {
-        // return (MetaDataFEC *) &m_decoderSlots[slotIndex].m_originalBlocks[0];
-        return (MetaDataFEC *) &m_decoderSlots[slotIndex].m_blockZero;
+        return (MetaDataFEC *) m_decoderSlots[slotIndex].m_blockZero;
     }
 
     inline void resetOriginalBlocks(int slotIndex)
     {
-        // memset((void *) m_decoderSlots[slotIndex].m_originalBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
-        memset((void *) &m_decoderSlots[slotIndex].m_blockZero, 0, sizeof(ProtectedBlock));
-        memset((void *) m_frames[slotIndex].m_blocks, 0, (m_nbOriginalBlocks - 1) * sizeof(ProtectedBlock));
+        memset((void *) m_decoderSlots[slotIndex].m_blockZero, 0, m_protectedBlockSize);
+        memset((void *) &m_frames[slotIndex * m_frameSize], 0, m_frameSize);
+
+        if (m_compressionBits) {
+            memset((void *) m_decoderSlots[slotIndex].m_compressedBlocks, 0, (m_nbOriginalBlocks - 1) * m_protectedBlockSize);
+        }
     }
 
+    void allocateBuffers();
+    void resetBuffers();
     void initDecodeAllSlots();
     void initReadIndex();
     void rwCorrectionEstimate(int slotIndex);
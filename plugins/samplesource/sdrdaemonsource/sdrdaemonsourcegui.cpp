@@ -60,6 +60,8 @@ SDRdaemonSourceGui::SDRdaemonSourceGui(DeviceUISet *deviceUISet, QWidget* parent
     m_bufferGauge(-50),
 	m_nbOriginalBlocks(128),
     m_nbFECBlocks(0),
+    m_compressionRatio(1.0f),
+    m_throughput(0),
     m_samplesCount(0),
     m_tickCount(0),
     m_addressEdited(false),
@@ -217,6 +219,8 @@ bool SDRdaemonSourceGui::handleMessage(const Message& message)
         m_avgNbOriginalBlocks = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getAvgNbOriginalBlocks();
         m_avgNbRecovery = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getAvgNbRecovery();
         m_nbOriginalBlocks = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getNbOriginalBlocksPerFrame();
+        m_compressionRatio = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getCompressionRatio();
+        m_throughput = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getThroughput();
 
         int nbFECBlocks = ((SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming&)message).getNbFECBlocksPerFrame();
 
@@ -324,6 +328,7 @@ void SDRdaemonSourceGui::displaySettings()
 
     QString s0 = QString::number(128 + m_settings.m_nbFECBlocks, 'f', 0);
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s0).arg(nstr));
+    ui->compression->setCurrentIndex(m_settings.m_compressionBits < 8 ? 0 : m_settings.m_compressionBits > 14 ? 4 : (m_settings.m_compressionBits - 6) / 2);
 
     ui->address->setText(m_settings.m_address);
     ui->dataPort->setText(tr("%1").arg(m_settings.m_dataPort));
@@ -476,6 +481,12 @@ void SDRdaemonSourceGui::on_nbFECBlocks_valueChanged(int value)
     sendSettings();
 }
 
+void SDRdaemonSourceGui::on_compression_currentIndexChanged(int index)
+{
+    m_settings.m_compressionBits = index == 0 ? 0 : 6 + 2*index; // Off, 8, 10, 12, 14 bits
+    sendSettings();
+}
+
 void SDRdaemonSourceGui::on_startStop_toggled(bool checked)
 {
     if (m_doApplySettings)
@@ -571,6 +582,12 @@ void SDRdaemonSourceGui::updateWithStreamTime()
     QString s1 = QString("%1").arg(m_nbFECBlocks, 2, 10, QChar('0'));
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s).arg(s1));
 
+    s = QString::number(m_compressionRatio, 'f', 2);
+    ui->compressionRatioText->setText(tr("%1").arg(s));
+
+    s = QString::number(m_throughput / 1000.0, 'f', 0);
+    ui->throughputText->setText(tr("%1").arg(s));
+
     if (updateEventCounts)
     {
         displayEventCounts();
@@ -80,6 +80,8 @@ private:
     float m_avgNbRecovery;
     int m_nbOriginalBlocks;
     int m_nbFECBlocks;
+    float m_compressionRatio;
+    int m_throughput;
 
 	int m_samplesCount;
 	std::size_t m_tickCount;
@@ -128,6 +130,7 @@ private slots:
     void on_eventCountsReset_clicked(bool checked);
     void on_txDelay_valueChanged(int value);
     void on_nbFECBlocks_valueChanged(int value);
+    void on_compression_currentIndexChanged(int index);
     void updateHardware();
 	void updateStatus();
 };
@@ -36,6 +36,7 @@
 #include "util/simpleserializer.h"
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
+#include "dsp/blockfloatingpoint.h"
 #include <device/devicesourceapi.h>
 #include <dsp/filerecord.h>
 
@@ -318,6 +319,13 @@ void SDRdaemonSourceInput::applySettings(const SDRdaemonSourceSettings& settings
         changeTxDelay = true;
     }
 
+    if (force || (m_settings.m_compressionBits != settings.m_compressionBits))
+    {
+        if (nbArgs > 0) os << ",";
+        os << "compbits=" << settings.m_compressionBits;
+        nbArgs++;
+    }
+
     if (force || (m_settings.m_txDelay != settings.m_txDelay))
     {
         changeTxDelay = true;
@@ -382,6 +390,7 @@ void SDRdaemonSourceInput::applySettings(const SDRdaemonSourceSettings& settings
             << " m_fcPos: " << m_settings.m_fcPos
             << " m_txDelay: " << m_settings.m_txDelay
             << " m_nbFECBlocks: " << m_settings.m_nbFECBlocks
+            << " m_compressionBits: " << m_settings.m_compressionBits
             << " m_specificParameters: " << m_settings.m_specificParameters;
 }
 
@@ -469,6 +478,11 @@ int SDRdaemonSourceInput::webapiSettingsPutPatch(
     if (deviceSettingsKeys.contains("fileRecordName")) {
         settings.m_fileRecordName = *response.getSdrDaemonSourceSettings()->getFileRecordName();
     }
+    if (deviceSettingsKeys.contains("compressionBits"))
+    {
+        int compressionBits = response.getSdrDaemonSourceSettings()->getCompressionBits();
+        settings.m_compressionBits = BlockFloatingPoint::isValidBits(compressionBits) ? compressionBits : 0;
+    }
 
     MsgConfigureSDRdaemonSource *msg = MsgConfigureSDRdaemonSource::create(settings, force);
     m_inputMessageQueue.push(msg);
@@ -497,6 +511,7 @@ void SDRdaemonSourceInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSett
     response.getSdrDaemonSourceSettings()->setDcBlock(settings.m_dcBlock ? 1 : 0);
     response.getSdrDaemonSourceSettings()->setIqCorrection(settings.m_iqCorrection);
     response.getSdrDaemonSourceSettings()->setFcPos((int) settings.m_fcPos);
+    response.getSdrDaemonSourceSettings()->setCompressionBits(settings.m_compressionBits);
 
     if (response.getSdrDaemonSourceSettings()->getFileRecordName()) {
         *response.getSdrDaemonSourceSettings()->getFileRecordName() = settings.m_fileRecordName;
@@ -527,4 +542,11 @@ void SDRdaemonSourceInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport
 
     response.getSdrDaemonSourceReport()->setMinNbBlocks(m_SDRdaemonUDPHandler->getMinNbBlocks());
     response.getSdrDaemonSourceReport()->setMaxNbRecovery(m_SDRdaemonUDPHandler->getMaxNbRecovery());
+    response.getSdrDaemonSourceReport()->setPacketRate(m_SDRdaemonUDPHandler->getPacketRate());
+    response.getSdrDaemonSourceReport()->setNbPackets(m_SDRdaemonUDPHandler->getNbPackets());
+    response.getSdrDaemonSourceReport()->setNbSocketDrops(m_SDRdaemonUDPHandler->getNbSocketDrops());
+    response.getSdrDaemonSourceReport()->setNbLostBlocks(m_SDRdaemonUDPHandler->getNbLostBlocks());
+    response.getSdrDaemonSourceReport()->setNbUnrecoverableFrames(m_SDRdaemonUDPHandler->getNbUnrecoverableFrames());
+    response.getSdrDaemonSourceReport()->setCompressionRatio(m_SDRdaemonUDPHandler->getCompressionRatio());
+    response.getSdrDaemonSourceReport()->setThroughput(m_SDRdaemonUDPHandler->getThroughput());
 }
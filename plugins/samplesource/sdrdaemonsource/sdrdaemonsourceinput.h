@@ -140,6 +140,8 @@ public:
         float getAvgNbRecovery() const { return m_avgNbRecovery; }
         int getNbOriginalBlocksPerFrame() const { return m_nbOriginalBlocksPerFrame; }
         int getNbFECBlocksPerFrame() const { return m_nbFECBlocksPerFrame; }
+        float getCompressionRatio() const { return m_compressionRatio; }
+        int getThroughput() const { return m_throughput; }
 
 		static MsgReportSDRdaemonSourceStreamTiming* create(uint32_t tv_sec,
 				uint32_t tv_usec,
@@ -154,7 +156,9 @@ public:
                 float avgNbOriginalBlocks,
                 float avgNbRecovery,
                 int nbOriginalBlocksPerFrame,
-                int nbFECBlocksPerFrame)
+                int nbFECBlocksPerFrame,
+                float compressionRatio,
+                int throughput)
 		{
 			return new MsgReportSDRdaemonSourceStreamTiming(tv_sec,
 					tv_usec,
@@ -169,7 +173,9 @@ public:
                     avgNbOriginalBlocks,
                     avgNbRecovery,
                     nbOriginalBlocksPerFrame,
-                    nbFECBlocksPerFrame);
+                    nbFECBlocksPerFrame,
+                    compressionRatio,
+                    throughput);
 		}
 
 	protected:
@@ -187,6 +193,8 @@ public:
         float    m_avgNbRecovery;
         int      m_nbOriginalBlocksPerFrame;
         int      m_nbFECBlocksPerFrame;
+        float    m_compressionRatio; //!< decoded to received samples size ratio
+        int      m_throughput;       //!< network throughput in bytes per second
 
 		MsgReportSDRdaemonSourceStreamTiming(uint32_t tv_sec,
 				uint32_t tv_usec,
@@ -201,7 +209,9 @@ public:
                 float avgNbOriginalBlocks,
                 float avgNbRecovery,
                 int nbOriginalBlocksPerFrame,
-                int nbFECBlocksPerFrame) :
+                int nbFECBlocksPerFrame,
+                float compressionRatio,
+                int throughput) :
 			Message(),
 			m_tv_sec(tv_sec),
 			m_tv_usec(tv_usec),
@@ -216,7 +226,9 @@ public:
             m_avgNbOriginalBlocks(avgNbOriginalBlocks),
             m_avgNbRecovery(avgNbRecovery),
             m_nbOriginalBlocksPerFrame(nbOriginalBlocksPerFrame),
-            m_nbFECBlocksPerFrame(nbFECBlocksPerFrame)
+            m_nbFECBlocksPerFrame(nbFECBlocksPerFrame),
+            m_compressionRatio(compressionRatio),
+            m_throughput(throughput)
 		{ }
 	};
 
@@ -278,6 +290,7 @@ public:
 	bool isStreaming() const;
 
 	virtual bool handleMessage(const Message& message);
+	virtual FileRecord *getFileRecord() { return m_fileSink; }
 
     virtual int webapiSettingsGet(
                 SWGSDRangel::SWGDeviceSettings& response,
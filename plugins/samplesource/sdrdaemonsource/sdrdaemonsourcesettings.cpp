@@ -37,6 +37,7 @@ void SDRdaemonSourceSettings::resetToDefaults()
     m_iqCorrection = false;
     m_fcPos = 2; // center
     m_fileRecordName = "";
+    m_compressionBits = 0;
 }
 
 QByteArray SDRdaemonSourceSettings::serialize() const
@@ -54,6 +55,7 @@ QByteArray SDRdaemonSourceSettings::serialize() const
     s.writeBool(9, m_dcBlock);
     s.writeBool(10, m_iqCorrection);
     s.writeU32(11, m_fcPos);
+    s.writeU32(12, m_compressionBits);
 
     return s.final();
 }
@@ -84,6 +86,7 @@ bool SDRdaemonSourceSettings::deserialize(const QByteArray& data)
         d.readBool(9, &m_dcBlock, false);
         d.readBool(10, &m_iqCorrection, false);
         d.readU32(11, &m_fcPos, 2);
+        d.readU32(12, &m_compressionBits, 0);
         return true;
     }
     else
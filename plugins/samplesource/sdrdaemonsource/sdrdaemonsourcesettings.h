@@ -34,6 +34,7 @@ struct SDRdaemonSourceSettings {
     bool    m_iqCorrection;
     quint32 m_fcPos;
     QString m_fileRecordName;
+    quint32 m_compressionBits; //!< block floating point mantissa bits requested to the remote. 0 for no compression.
 
     SDRdaemonSourceSettings();
     void resetToDefaults();
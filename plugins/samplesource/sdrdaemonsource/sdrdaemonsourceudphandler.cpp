@@ -18,6 +18,7 @@
 #include <QDebug>
 #include <QTimer>
 #include <unistd.h>
+#include <string.h>
 
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
@@ -25,6 +26,7 @@
 
 #include "sdrdaemonsourceinput.h"
 #include "sdrdaemonsourceudphandler.h"
+#include "sdrdaemonsourceudpthread.h"
 
 SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo, DeviceSourceAPI *deviceAPI) :
     m_deviceAPI(deviceAPI),
@@ -33,6 +35,7 @@ SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo,
     m_running(false),
     m_rateDivider(1000/SDRDAEMONSOURCE_THROTTLE_MS),
 	m_dataSocket(0),
+	m_udpThread(0),
 	m_dataAddress(QHostAddress::LocalHost),
 	m_remoteAddress(QHostAddress::LocalHost),
 	m_dataPort(9090),
@@ -54,9 +57,13 @@ SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo,
     m_converterBuffer(0),
     m_converterBufferNbSamples(0),
     m_throttleToggle(false),
-	m_autoCorrBuffer(true)
+	m_autoCorrBuffer(true),
+	m_nbPackets(0),
+	m_nbSocketDrops(0),
+	m_nbPacketsAtRate(0),
+	m_packetRate(0)
 {
-    m_udpBuf = new char[SDRdaemonSourceBuffer::m_udpPayloadSize];
+    m_udpBuf = new char[SDRdaemonSourceBuffer::m_udpPayloadSizeMax];
 
 #ifdef USE_INTERNAL_TIMER
 #warning "Uses internal timer"
@@ -89,6 +96,31 @@ void SDRdaemonSourceUDPHandler::start()
 	    return;
 	}
 
+#if defined(__linux__)
+	if (!m_dataConnected && (m_dataAddress.protocol() == QAbstractSocket::IPv4Protocol))
+	{
+	    m_udpThread = new SDRdaemonSourceUDPThread(this);
+
+	    if (m_udpThread->startWork(m_dataAddress, m_dataPort))
+	    {
+	        qDebug("SDRdaemonSourceUDPHandler::start: receive thread on %s:%d", m_dataAddress.toString().toStdString().c_str(),  m_dataPort);
+	        m_dataConnected = true;
+	    }
+	    else
+	    {
+	        qWarning("SDRdaemonSourceUDPHandler::start: cannot bind data port %d", m_dataPort);
+	        delete m_udpThread;
+	        m_udpThread = 0;
+	        m_dataConnected = false;
+	    }
+
+	    m_elapsedTimer.start();
+	    m_packetRateTimer.start();
+	    m_running = true;
+	    return;
+	}
+#endif
+
 	if (!m_dataSocket)
 	{
 		m_dataSocket = new QUdpSocket(this);
@@ -112,6 +144,7 @@ void SDRdaemonSourceUDPHandler::start()
 	}
 
     m_elapsedTimer.start();
+    m_packetRateTimer.start();
     m_running = true;
 }
 
@@ -123,6 +156,14 @@ void SDRdaemonSourceUDPHandler::stop()
 	    return;
 	}
 
+	if (m_udpThread) // stop the receive side before the timer so that it is not connected again
+	{
+	    m_udpThread->stopWork();
+	    delete m_udpThread;
+	    m_udpThread = 0;
+	    m_dataConnected = false;
+	}
+
 	disconnectTimer();
 
     if (m_dataConnected)
@@ -160,23 +201,40 @@ void SDRdaemonSourceUDPHandler::configureUDPLink(const QString& address, quint16
 
 void SDRdaemonSourceUDPHandler::dataReadyRead()
 {
-    m_udpReadBytes = 0;
-
 	while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
 	{
-		qint64 pendingDataSize = m_dataSocket->pendingDatagramSize();
-		m_udpReadBytes += m_dataSocket->readDatagram(&m_udpBuf[m_udpReadBytes], pendingDataSize, &m_remoteAddress, 0);
+		// one datagram is one block whose size is given by the datagram length
+		m_udpReadBytes = m_dataSocket->readDatagram(m_udpBuf, SDRdaemonSourceBuffer::m_udpPayloadSizeMax, &m_remoteAddress, 0);
 
-		if (m_udpReadBytes == SDRdaemonSourceBuffer::m_udpPayloadSize) {
-		    processData();
-		    m_udpReadBytes = 0;
+		if (SDRdaemonSourceBuffer::isValidBlockSize(m_udpReadBytes))
+		{
+		    QMutexLocker mutexLocker(&m_mutex);
+		    processData(m_udpBuf, m_udpReadBytes);
+		    m_nbPackets++;
 		}
 	}
 }
 
-void SDRdaemonSourceUDPHandler::processData()
+void SDRdaemonSourceUDPHandler::processBlocks(char *blocks[], int blockSizes[], int nbBlocks, quint32 remoteAddress, quint32 socketDrops)
 {
-    m_sdrDaemonBuffer.writeData(m_udpBuf);
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (int i = 0; i < nbBlocks; i++) {
+        processData(blocks[i], blockSizes[i]);
+    }
+
+    m_nbPackets += nbBlocks;
+    m_nbSocketDrops = socketDrops;
+    m_remoteAddress.setAddress(remoteAddress);
+}
+
+void SDRdaemonSourceUDPHandler::processData(char *block, int blockSize)
+{
+    if (blockSize != m_sdrDaemonBuffer.getBlockSize()) {
+        m_sdrDaemonBuffer.setBlockSize(blockSize); // sender changed its block size
+    }
+
+    m_sdrDaemonBuffer.writeData(block);
     const SDRdaemonSourceBuffer::MetaDataFEC& metaData =  m_sdrDaemonBuffer.getCurrentMeta();
     bool change = false;
 
@@ -249,6 +307,8 @@ void SDRdaemonSourceUDPHandler::disconnectTimer()
 
 void SDRdaemonSourceUDPHandler::tick()
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     // auto throttling
     int throttlems = m_elapsedTimer.restart();
 
@@ -300,6 +360,14 @@ void SDRdaemonSourceUDPHandler::tick()
 	{
 		m_tickCount = 0;
 
+		qint64 rateElapsedms = m_packetRateTimer.restart();
+
+		if (rateElapsedms > 0) {
+		    m_packetRate = ((m_nbPackets - m_nbPacketsAtRate) * 1000) / rateElapsedms;
+		}
+
+		m_nbPacketsAtRate = m_nbPackets;
+
 		if (m_outputMessageQueueToGUI)
 		{
 	        int framesDecodingStatus;
@@ -331,7 +399,9 @@ void SDRdaemonSourceUDPHandler::tick()
 	            m_sdrDaemonBuffer.getAvgOriginalBlocks(),
 	            m_sdrDaemonBuffer.getAvgNbRecovery(),
 	            nbOriginalBlocks,
-	            nbFECblocks);
+	            nbFECblocks,
+	            m_sdrDaemonBuffer.getCompressionRatio(),
+	            m_packetRate * m_sdrDaemonBuffer.getBlockSize());
 
 	            m_outputMessageQueueToGUI->push(report);
 		}
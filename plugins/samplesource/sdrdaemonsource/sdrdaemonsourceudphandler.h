@@ -31,6 +31,7 @@ class SampleSinkFifo;
 class MessageQueue;
 class QTimer;
 class DeviceSourceAPI;
+class SDRdaemonSourceUDPThread;
 
 class SDRdaemonSourceUDPHandler : public QObject
 {
@@ -42,8 +43,9 @@ public:
 	void start();
 	void stop();
 	void configureUDPLink(const QString& address, quint16 port);
-	void getRemoteAddress(QString& s) const { s = m_remoteAddress.toString(); }
+	void getRemoteAddress(QString& s) const { QMutexLocker mutexLocker(&m_mutex); s = m_remoteAddress.toString(); }
     int getNbOriginalBlocks() const { return SDRdaemonSourceBuffer::m_nbOriginalBlocks; }
+    int getBlockSize() const { QMutexLocker mutexLocker(&m_mutex); return m_sdrDaemonBuffer.getBlockSize(); }
     bool isStreaming() const { return m_masterTimerConnected; }
     int getSampleRate() const { return m_samplerate; }
     int getCenterFrequency() const { return m_centerFrequency * 1000; }
@@ -52,6 +54,17 @@ public:
     uint32_t getTVuSec() const { return m_tv_usec; }
     int getMinNbBlocks() { return m_sdrDaemonBuffer.getMinNbBlocks(); }
     int getMaxNbRecovery() { return m_sdrDaemonBuffer.getMaxNbRecovery(); }
+    int getPacketRate() const { return m_packetRate; }
+    int getThroughput() const { QMutexLocker mutexLocker(&m_mutex); return m_packetRate * m_sdrDaemonBuffer.getBlockSize(); }
+    float getCompressionRatio() const { QMutexLocker mutexLocker(&m_mutex); return m_sdrDaemonBuffer.getCompressionRatio(); }
+    quint64 getNbPackets() const { QMutexLocker mutexLocker(&m_mutex); return m_nbPackets; }
+    quint64 getNbSocketDrops() const { QMutexLocker mutexLocker(&m_mutex); return m_nbSocketDrops; }
+    quint64 getNbLostBlocks() const { QMutexLocker mutexLocker(&m_mutex); return m_sdrDaemonBuffer.getNbLostBlocks(); }
+    quint64 getNbUnrecoverableFrames() const { QMutexLocker mutexLocker(&m_mutex); return m_sdrDaemonBuffer.getNbUnrecoverableFrames(); }
+
+    /** Store a batch of received blocks. Called from the receive thread. */
+    void processBlocks(char *blocks[], int blockSizes[], int nbBlocks, quint32 remoteAddress, quint32 socketDrops);
+
 public slots:
 	void dataReadyRead();
 
@@ -63,6 +76,8 @@ private:
     uint32_t m_rateDivider;
 	SDRdaemonSourceBuffer m_sdrDaemonBuffer;
 	QUdpSocket *m_dataSocket;
+	SDRdaemonSourceUDPThread *m_udpThread; //!< batched receive thread when available else m_dataSocket is used
+	mutable QMutex m_mutex;                //!< serializes decoder buffer access between receive and read sides
 	QHostAddress m_dataAddress;
 	QHostAddress m_remoteAddress;
 	quint16 m_dataPort;
@@ -87,10 +102,15 @@ private:
     uint32_t m_converterBufferNbSamples;
     bool m_throttleToggle;
     bool m_autoCorrBuffer;
+    quint64 m_nbPackets;         //!< number of blocks received
+    quint64 m_nbSocketDrops;     //!< number of datagrams dropped by the kernel on socket buffer overflow
+    quint64 m_nbPacketsAtRate;   //!< number of blocks received at last packet rate evaluation
+    int m_packetRate;            //!< received blocks per second
+    QElapsedTimer m_packetRateTimer;
 
 	void connectTimer();
     void disconnectTimer();
-	void processData();
+	void processData(char *block, int blockSize);
 
 private slots:
 	void tick();
@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <QDebug>
+
+#include "sdrdaemonsourcebuffer.h"
+#include "sdrdaemonsourceudphandler.h"
+#include "sdrdaemonsourceudpthread.h"
+
+#if defined(__linux__)
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+
+#ifndef SO_RXQ_OVFL
+#define SO_RXQ_OVFL 40
+#endif
+
+SDRdaemonSourceUDPThread::SDRdaemonSourceUDPThread(SDRdaemonSourceUDPHandler *udpHandler) :
+    m_udpHandler(udpHandler),
+    m_socket(-1),
+    m_running(false)
+{
+    m_batchBuffer = new char[SDRDAEMONSOURCE_UDPBATCHSIZE * SDRdaemonSourceBuffer::m_udpPayloadSizeMax];
+}
+
+SDRdaemonSourceUDPThread::~SDRdaemonSourceUDPThread()
+{
+    stopWork();
+    delete[] m_batchBuffer;
+}
+
+bool SDRdaemonSourceUDPThread::startWork(const QHostAddress& address, quint16 port)
+{
+    if (m_running) {
+        return true;
+    }
+
+    m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (m_socket < 0)
+    {
+        qWarning("SDRdaemonSourceUDPThread::startWork: cannot create socket: %s", strerror(errno));
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // a large receive buffer rides through scheduling hiccups of this thread. Privileged processes can go past rmem_max.
+    int bufSize = SDRDAEMONSOURCE_SOCKETBUFSIZE;
+
+    if (setsockopt(m_socket, SOL_SOCKET, SO_RCVBUFFORCE, &bufSize, sizeof(bufSize)) < 0) {
+        setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize));
+    }
+
+    socklen_t optLen = sizeof(bufSize);
+    getsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &bufSize, &optLen);
+
+    // kernel reports its cumulative count of datagrams dropped on this socket as ancillary data
+    int ovfl = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_RXQ_OVFL, &ovfl, sizeof(ovfl));
+
+    // periodic wake up to check for stop requests
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 100000;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    struct sockaddr_in sockAddr;
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sin_family = AF_INET;
+    sockAddr.sin_port = htons(port);
+    sockAddr.sin_addr.s_addr = htonl(address.toIPv4Address());
+
+    if (bind(m_socket, (struct sockaddr *) &sockAddr, sizeof(sockAddr)) < 0)
+    {
+        qWarning("SDRdaemonSourceUDPThread::startWork: cannot bind %s:%d: %s",
+                address.toString().toStdString().c_str(), port, strerror(errno));
+        close(m_socket);
+        m_socket = -1;
+        return false;
+    }
+
+    qDebug("SDRdaemonSourceUDPThread::startWork: bound to %s:%d receive buffer: %d bytes",
+            address.toString().toStdString().c_str(), port, bufSize);
+
+    m_running = true;
+    start(QThread::HighPriority);
+    return true;
+}
+
+void SDRdaemonSourceUDPThread::stopWork()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    wait();
+    close(m_socket);
+    m_socket = -1;
+}
+
+void SDRdaemonSourceUDPThread::run()
+{
+    struct mmsghdr msgs[SDRDAEMONSOURCE_UDPBATCHSIZE];
+    struct iovec iovecs[SDRDAEMONSOURCE_UDPBATCHSIZE];
+    struct sockaddr_in addrs[SDRDAEMONSOURCE_UDPBATCHSIZE];
+    char controls[SDRDAEMONSOURCE_UDPBATCHSIZE][CMSG_SPACE(sizeof(uint32_t))];
+    char *blocks[SDRDAEMONSOURCE_UDPBATCHSIZE];
+    int blockSizes[SDRDAEMONSOURCE_UDPBATCHSIZE];
+    uint32_t socketDrops = 0;
+
+    memset(msgs, 0, sizeof(msgs));
+
+    for (int i = 0; i < SDRDAEMONSOURCE_UDPBATCHSIZE; i++)
+    {
+        iovecs[i].iov_base = &m_batchBuffer[i * SDRdaemonSourceBuffer::m_udpPayloadSizeMax];
+        iovecs[i].iov_len = SDRdaemonSourceBuffer::m_udpPayloadSizeMax;
+        msgs[i].msg_hdr.msg_iov = &iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &addrs[i];
+        msgs[i].msg_hdr.msg_control = controls[i];
+    }
+
+    while (m_running)
+    {
+        for (int i = 0; i < SDRDAEMONSOURCE_UDPBATCHSIZE; i++)
+        {
+            msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+        }
+
+        // blocks until at least one datagram is there (or time out) then takes whatever is queued
+        int nbMsgs = recvmmsg(m_socket, msgs, SDRDAEMONSOURCE_UDPBATCHSIZE, MSG_WAITFORONE, 0);
+
+        if (nbMsgs < 0)
+        {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+            {
+                qWarning("SDRdaemonSourceUDPThread::run: recvmmsg: %s", strerror(errno));
+                usleep(10000);
+            }
+
+            continue;
+        }
+
+        int nbBlocks = 0;
+
+        for (int i = 0; i < nbMsgs; i++)
+        {
+            for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg; cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg))
+            {
+                if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_RXQ_OVFL)) {
+                    memcpy(&socketDrops, CMSG_DATA(cmsg), sizeof(uint32_t));
+                }
+            }
+
+            if (!(msgs[i].msg_hdr.msg_flags & MSG_TRUNC) && SDRdaemonSourceBuffer::isValidBlockSize(msgs[i].msg_len)) // truncated or foreign datagrams are ignored
+            {
+                blocks[nbBlocks] = (char *) iovecs[i].iov_base;
+                blockSizes[nbBlocks] = msgs[i].msg_len;
+                nbBlocks++;
+            }
+        }
+
+        if (nbBlocks > 0) {
+            m_udpHandler->processBlocks(blocks, blockSizes, nbBlocks, ntohl(addrs[nbMsgs-1].sin_addr.s_addr), socketDrops);
+        }
+    }
+}
+
+#else // !__linux__ : the UDP handler reads datagrams with QUdpSocket and never starts this thread
+
+SDRdaemonSourceUDPThread::SDRdaemonSourceUDPThread(SDRdaemonSourceUDPHandler *udpHandler) :
+    m_udpHandler(udpHandler),
+    m_socket(-1),
+    m_running(false),
+    m_batchBuffer(0)
+{
+}
+
+SDRdaemonSourceUDPThread::~SDRdaemonSourceUDPThread()
+{
+}
+
+bool SDRdaemonSourceUDPThread::startWork(const QHostAddress& address __attribute__((unused)), quint16 port __attribute__((unused)))
+{
+    return false;
+}
+
+void SDRdaemonSourceUDPThread::stopWork()
+{
+}
+
+void SDRdaemonSourceUDPThread::run()
+{
+}
+
+#endif
@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_
+#define PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_
+
+#include <QThread>
+#include <QHostAddress>
+
+#define SDRDAEMONSOURCE_UDPBATCHSIZE 64                 // datagrams read per system call
+#define SDRDAEMONSOURCE_SOCKETBUFSIZE (8*1024*1024)     // requested socket receive buffer size
+
+class SDRdaemonSourceUDPHandler;
+
+/**
+ * Dedicated receive thread for the SDRdaemon UDP stream (Linux only). Datagrams are
+ * read in batches with recvmmsg on a native socket with a large receive buffer and handed
+ * over to the UDP handler a batch at a time so there is no per packet signal/slot round trip.
+ */
+class SDRdaemonSourceUDPThread : public QThread
+{
+public:
+    SDRdaemonSourceUDPThread(SDRdaemonSourceUDPHandler *udpHandler);
+    ~SDRdaemonSourceUDPThread();
+
+    bool startWork(const QHostAddress& address, quint16 port); //!< bind and start receiving. False if the socket cannot be bound.
+    void stopWork();
+
+private:
+    SDRdaemonSourceUDPHandler *m_udpHandler;
+    int m_socket;
+    volatile bool m_running;
+    char *m_batchBuffer; //!< SDRDAEMONSOURCE_UDPBATCHSIZE datagram buffers
+
+    void run();
+};
+
+#endif /* PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_ */
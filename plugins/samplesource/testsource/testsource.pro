@@ -29,12 +29,14 @@ CONFIG(Debug):build_subdir = debug
 SOURCES += testsourcegui.cpp\
 	testsourceinput.cpp\
 	testsourceplugin.cpp\
+	testsourcescenario.cpp\
 	testsourcesettings.cpp\
 	testsourcethread.cpp
 
 HEADERS += testsourcegui.h\
 	testsourceinput.h\
 	testsourceplugin.h\
+	testsourcescenario.h\
 	testsourcesettings.h\
 	testsourcethread.h
 
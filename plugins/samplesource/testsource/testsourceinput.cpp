@@ -374,6 +374,20 @@ bool TestSourceInput::applySettings(const TestSourceSettings& settings, bool for
         }
     }
 
+    if ((m_settings.m_scenario != settings.m_scenario) || force)
+    {
+        if (m_testSourceThread != 0) {
+            m_testSourceThread->setScenario(settings.m_scenario);
+        }
+    }
+
+    if ((m_settings.m_unthrottled != settings.m_unthrottled) || force)
+    {
+        if (m_testSourceThread != 0) {
+            m_testSourceThread->setUnthrottled(settings.m_unthrottled);
+        }
+    }
+
     m_settings = settings;
     return true;
 }
@@ -478,6 +492,12 @@ int TestSourceInput::webapiSettingsPutPatch(
     if (deviceSettingsKeys.contains("phaseImbalance")) {
         settings.m_phaseImbalance = response.getTestSourceSettings()->getPhaseImbalance();
     };
+    if (deviceSettingsKeys.contains("scenario")) {
+        settings.m_scenario = *response.getTestSourceSettings()->getScenario();
+    }
+    if (deviceSettingsKeys.contains("unthrottled")) {
+        settings.m_unthrottled = response.getTestSourceSettings()->getUnthrottled() != 0;
+    }
     if (deviceSettingsKeys.contains("fileRecordName")) {
         settings.m_fileRecordName = *response.getTestSourceSettings()->getFileRecordName();
     }
@@ -513,6 +533,13 @@ void TestSourceInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings&
     response.getTestSourceSettings()->setIFactor(settings.m_iFactor);
     response.getTestSourceSettings()->setQFactor(settings.m_qFactor);
     response.getTestSourceSettings()->setPhaseImbalance(settings.m_phaseImbalance);
+    response.getTestSourceSettings()->setUnthrottled(settings.m_unthrottled ? 1 : 0);
+
+    if (response.getTestSourceSettings()->getScenario()) {
+        *response.getTestSourceSettings()->getScenario() = settings.m_scenario;
+    } else {
+        response.getTestSourceSettings()->setScenario(new QString(settings.m_scenario));
+    }
 
     if (response.getTestSourceSettings()->getFileRecordName()) {
         *response.getTestSourceSettings()->getFileRecordName() = settings.m_fileRecordName;
@@ -0,0 +1,415 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QStringList>
+#include <QRegExp>
+#include <QDebug>
+
+#include <algorithm>
+#include <complex>
+#include <math.h>
+
+#include "testsourcescenario.h"
+
+namespace {
+const double voiceRate = 48000.0;  //!< table rate of voice modulations
+const int voicePeriod = 2;         //!< seconds of voice before it repeats
+const int voiceTones = 32;         //!< number of tones making the voice like audio
+const int loraOversampling = 4;    //!< table rate over LoRa bandwidth
+const int pskSamplesPerSymbol = 8; //!< table rate over PSK symbol rate
+}
+
+TestSourceScenario::TestSourceScenario() :
+    m_noiseAmplitude(0.0f),
+    m_noiseSeed(0x12345678),
+    m_sampleRate(48000)
+{
+    for (int i = 0; i < (1<<m_ncoBits); i++)
+    {
+        m_ncoCos[i] = cos((2.0 * M_PI * i) / (1<<m_ncoBits));
+        m_ncoSin[i] = sin((2.0 * M_PI * i) / (1<<m_ncoBits));
+    }
+}
+
+TestSourceScenario::~TestSourceScenario()
+{
+}
+
+bool TestSourceScenario::setScenario(const QString& scenario, int sampleRate)
+{
+    bool success = true;
+    bool noise = false;
+    bool noiseSNR = false;
+    double noiseValue = 0.0;
+
+    m_carriers.clear();
+    m_noiseAmplitude = 0.0f;
+    m_sampleRate = sampleRate <= 0 ? 48000 : sampleRate;
+
+    QStringList entries = scenario.split(QRegExp("[;\\n]"), QString::SkipEmptyParts);
+
+    for (int i = 0; i < entries.size(); i++)
+    {
+        QStringList tokens = entries[i].trimmed().split(QRegExp("\\s+"), QString::SkipEmptyParts);
+
+        if (tokens.size() == 0) {
+            continue;
+        }
+
+        QString type = tokens[0].toLower();
+        Parameters parameters;
+
+        for (int j = 1; j < tokens.size(); j++)
+        {
+            int equal = tokens[j].indexOf('=');
+            bool ok = false;
+            double value = equal > 0 ? tokens[j].mid(equal + 1).toDouble(&ok) : 0.0;
+
+            if (ok)
+            {
+                parameters[tokens[j].left(equal).toLower()] = value;
+            }
+            else
+            {
+                qWarning() << "TestSourceScenario::setScenario: invalid parameter: " << tokens[j];
+                success = false;
+            }
+        }
+
+        if (type == "noise")
+        {
+            noise = true;
+            noiseSNR = parameters.contains("snr");
+            noiseValue = noiseSNR ? parameters["snr"] : getParameter(parameters, "level", -60.0);
+        }
+        else if (!addCarrier(type, parameters))
+        {
+            qWarning() << "TestSourceScenario::setScenario: unknown carrier type: " << type;
+            success = false;
+        }
+    }
+
+    if (noise)
+    {
+        double noisePower;
+
+        if (noiseSNR) // relative to the strongest carrier
+        {
+            float amplitude = 0.0f;
+
+            for (unsigned int i = 0; i < m_carriers.size(); i++) {
+                amplitude = std::max(amplitude, m_carriers[i].m_amplitude);
+            }
+
+            noisePower = amplitude * amplitude * pow(10.0, -noiseValue / 10.0);
+        }
+        else
+        {
+            noisePower = pow(10.0, noiseValue / 10.0);
+        }
+
+        m_noiseAmplitude = sqrt(noisePower);
+
+        if (m_noiseI.size() == 0) {
+            makeNoise();
+        }
+    }
+
+    qDebug() << "TestSourceScenario::setScenario:"
+            << " sample rate: " << m_sampleRate
+            << " carriers: " << m_carriers.size()
+            << " noise amplitude: " << m_noiseAmplitude;
+
+    return success;
+}
+
+void TestSourceScenario::generate(float *re, float *im, unsigned int nbSamples)
+{
+    std::fill(re, re + nbSamples, 0.0f);
+    std::fill(im, im + nbSamples, 0.0f);
+
+    for (unsigned int c = 0; c < m_carriers.size(); c++)
+    {
+        Carrier& carrier = m_carriers[c];
+        const float *tableI = carrier.m_tableI.data();
+        const float *tableQ = carrier.m_tableQ.data();
+        uint64_t tablePos = carrier.m_tablePos;
+        uint32_t ncoPhase = carrier.m_ncoPhase;
+
+        for (unsigned int i = 0; i < nbSamples; i++)
+        {
+            uint32_t k = tablePos >> 32;
+            float frac = ((uint32_t) tablePos) * (1.0f / 4294967296.0f);
+            float bi = tableI[k] + frac * (tableI[k+1] - tableI[k]);
+            float bq = tableQ[k] + frac * (tableQ[k+1] - tableQ[k]);
+            uint32_t n = ncoPhase >> (32 - m_ncoBits);
+            re[i] += bi * m_ncoCos[n] - bq * m_ncoSin[n];
+            im[i] += bi * m_ncoSin[n] + bq * m_ncoCos[n];
+            ncoPhase += carrier.m_ncoStep;
+            tablePos += carrier.m_tableStep;
+
+            if (tablePos >= carrier.m_tableEnd) {
+                tablePos -= carrier.m_tableEnd;
+            }
+        }
+
+        carrier.m_tablePos = tablePos;
+        carrier.m_ncoPhase = ncoPhase;
+    }
+
+    if (m_noiseAmplitude > 0.0f)
+    {
+        unsigned int mask = m_noiseTableSize - 1;
+        unsigned int offset = nextRandom() & mask;
+
+        for (unsigned int i = 0; i < nbSamples; i++)
+        {
+            unsigned int j = (offset + i) & mask;
+            re[i] += m_noiseAmplitude * m_noiseI[j];
+            im[i] += m_noiseAmplitude * m_noiseQ[j];
+        }
+    }
+}
+
+bool TestSourceScenario::addCarrier(const QString& type, const Parameters& parameters)
+{
+    Carrier carrier;
+    double frequency = getParameter(parameters, "f", 0.0);
+
+    carrier.m_amplitude = pow(10.0, getParameter(parameters, "level", -20.0) / 20.0);
+    carrier.m_ncoPhase = 0;
+    carrier.m_ncoStep = (uint32_t) (int64_t) llround((frequency / m_sampleRate) * 4294967296.0);
+
+    if (2.0 * fabs(frequency) > m_sampleRate) {
+        qWarning("TestSourceScenario::addCarrier: %s: frequency %f Hz out of band", qPrintable(type), frequency);
+    }
+
+    if (type == "tone") {
+        makeTone(carrier);
+    } else if ((type == "nfm") || (type == "am") || (type == "usb") || (type == "lsb")) {
+        makeVoice(carrier, type, parameters);
+    } else if (type == "lora") {
+        makeLoRa(carrier, parameters);
+    } else if (type == "psk") {
+        makePSK(carrier, parameters);
+    } else {
+        return false;
+    }
+
+    m_carriers.push_back(carrier);
+    return true;
+}
+
+void TestSourceScenario::setTable(Carrier& carrier, double tableRate)
+{
+    if (tableRate > m_sampleRate) {
+        qWarning("TestSourceScenario::setTable: table rate %f S/s above sample rate: signal is aliased", tableRate);
+    }
+
+    unsigned int size = carrier.m_tableI.size();
+
+    for (unsigned int i = 0; i < size; i++)
+    {
+        carrier.m_tableI[i] *= carrier.m_amplitude;
+        carrier.m_tableQ[i] *= carrier.m_amplitude;
+    }
+
+    carrier.m_tableI.push_back(carrier.m_tableI[0]); // interpolation across the loop point
+    carrier.m_tableQ.push_back(carrier.m_tableQ[0]);
+    carrier.m_tableEnd = ((uint64_t) size) << 32;
+    carrier.m_tablePos = 0;
+    carrier.m_tableStep = (uint64_t) llround((tableRate / m_sampleRate) * 4294967296.0);
+}
+
+void TestSourceScenario::makeTone(Carrier& carrier)
+{
+    carrier.m_tableI.assign(1, 1.0f);
+    carrier.m_tableQ.assign(1, 0.0f);
+    setTable(carrier, m_sampleRate);
+}
+
+void TestSourceScenario::makeVoice(Carrier& carrier, const QString& type, const Parameters& parameters)
+{
+    // Tones between 300 and 3000 Hz with a syllabic envelope. All frequencies are multiples
+    // of the inverse of the period so that the audio loops without discontinuity.
+    int size = voicePeriod * voiceRate;
+    std::vector<std::complex<double> > phasors(voiceTones), steps(voiceTones);
+    std::vector<std::complex<float> > audio(size); // analytic signal
+    float peak = 0.0f;
+
+    for (int k = 0; k < voiceTones; k++)
+    {
+        int cycles = (300 + (nextRandom() % 2700)) * voicePeriod;
+        steps[k] = std::polar(1.0, (2.0 * M_PI * cycles) / size);
+        phasors[k] = std::polar(1.0, (2.0 * M_PI * (nextRandom() % 1000)) / 1000.0);
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        std::complex<double> sum = 0.0;
+
+        for (int k = 0; k < voiceTones; k++)
+        {
+            sum += phasors[k];
+            phasors[k] *= steps[k];
+        }
+
+        double syllable = sin((M_PI * 7 * i) / size); // 7 syllables per period
+        audio[i] = std::complex<float>(sum * (0.25 + 0.75 * syllable * syllable));
+        peak = std::max(peak, std::abs(audio[i].real()));
+    }
+
+    carrier.m_tableI.resize(size);
+    carrier.m_tableQ.resize(size);
+
+    if (type == "am")
+    {
+        float modulation = getParameter(parameters, "mod", 0.5);
+
+        for (int i = 0; i < size; i++)
+        {
+            carrier.m_tableI[i] = (1.0f + modulation * (audio[i].real() / peak)) / (1.0f + modulation);
+            carrier.m_tableQ[i] = 0.0f;
+        }
+    }
+    else if (type == "nfm")
+    {
+        double deviation = getParameter(parameters, "dev", 5000.0);
+        double mean = 0.0;
+        double phase = 0.0;
+
+        for (int i = 0; i < size; i++) {
+            mean += audio[i].real();
+        }
+
+        mean /= size; // zero mean audio gets the phase back to start at the loop point
+
+        for (int i = 0; i < size; i++)
+        {
+            carrier.m_tableI[i] = cos(phase);
+            carrier.m_tableQ[i] = sin(phase);
+            phase += (2.0 * M_PI * deviation * ((audio[i].real() - mean) / peak)) / voiceRate;
+        }
+    }
+    else // SSB
+    {
+        float sign = type == "lsb" ? -1.0f : 1.0f;
+
+        for (int i = 0; i < size; i++)
+        {
+            carrier.m_tableI[i] = audio[i].real() / peak;
+            carrier.m_tableQ[i] = sign * audio[i].imag() / peak;
+        }
+    }
+
+    setTable(carrier, voiceRate);
+}
+
+void TestSourceScenario::makeLoRa(Carrier& carrier, const Parameters& parameters)
+{
+    // preamble of 8 up chirps, 2 down chirps then random symbols and silence up to the period
+    double bandwidth = getParameter(parameters, "bw", 125000.0);
+    int spreadFactor = std::min(12, std::max(6, (int) getParameter(parameters, "sf", 7.0)));
+    int nbSymbols = std::max(1, (int) getParameter(parameters, "symbols", 16.0));
+    double tableRate = loraOversampling * bandwidth;
+    int symbolSize = loraOversampling << spreadFactor;
+    int frameSize = (10 + nbSymbols) * symbolSize;
+    int size = std::max(frameSize, (int) ((getParameter(parameters, "period", 0.0) * tableRate) / 1000.0));
+    double phase = 0.0;
+
+    carrier.m_tableI.assign(size, 0.0f);
+    carrier.m_tableQ.assign(size, 0.0f);
+
+    for (int s = 0; s < 10 + nbSymbols; s++)
+    {
+        bool down = (s == 8) || (s == 9);
+        double start = s < 8 ? 0.0 : (double) (nextRandom() % (1<<spreadFactor)) / (1<<spreadFactor);
+
+        for (int j = 0; j < symbolSize; j++)
+        {
+            double t = (double) j / symbolSize;
+            double frequency = down ? bandwidth * (0.5 - t) : bandwidth * (fmod(t + start, 1.0) - 0.5);
+            carrier.m_tableI[s*symbolSize + j] = cos(phase);
+            carrier.m_tableQ[s*symbolSize + j] = sin(phase);
+            phase += (2.0 * M_PI * frequency) / tableRate;
+        }
+    }
+
+    setTable(carrier, tableRate);
+}
+
+void TestSourceScenario::makePSK(Carrier& carrier, const Parameters& parameters)
+{
+    // burst of random symbols with raised cosine transitions then silence up to the period
+    double symbolRate = getParameter(parameters, "rate", 10000.0);
+    int order = std::min(8, std::max(2, (int) getParameter(parameters, "order", 4.0)));
+    int nbSymbols = std::max(1, (int) ((getParameter(parameters, "burst", 10.0) * symbolRate) / 1000.0));
+    double tableRate = pskSamplesPerSymbol * symbolRate;
+    int burstSize = (nbSymbols + 1) * pskSamplesPerSymbol; // with ramp down
+    int size = std::max(burstSize, (int) ((getParameter(parameters, "period", 50.0) * tableRate) / 1000.0));
+    std::complex<float> previous = 0.0f;
+
+    carrier.m_tableI.assign(size, 0.0f);
+    carrier.m_tableQ.assign(size, 0.0f);
+
+    for (int s = 0; s <= nbSymbols; s++)
+    {
+        std::complex<float> symbol = s == nbSymbols ? 0.0f :
+                std::polar(1.0f, (float) ((2.0 * M_PI * (nextRandom() % order) + M_PI) / order));
+
+        for (int j = 0; j < pskSamplesPerSymbol; j++)
+        {
+            float w = (1.0f - cos((M_PI * j) / pskSamplesPerSymbol)) / 2.0f;
+            std::complex<float> value = previous * (1.0f - w) + symbol * w;
+            carrier.m_tableI[s*pskSamplesPerSymbol + j] = value.real();
+            carrier.m_tableQ[s*pskSamplesPerSymbol + j] = value.imag();
+        }
+
+        previous = symbol;
+    }
+
+    setTable(carrier, tableRate);
+}
+
+void TestSourceScenario::makeNoise()
+{
+    // gaussian noise with a complex power of 1 (Box-Muller)
+    m_noiseI.resize(m_noiseTableSize);
+    m_noiseQ.resize(m_noiseTableSize);
+
+    for (unsigned int i = 0; i < m_noiseTableSize; i++)
+    {
+        double u1 = (nextRandom() + 1.0) / 4294967296.0;
+        double u2 = nextRandom() / 4294967296.0;
+        double r = sqrt(-log(u1));
+        m_noiseI[i] = r * cos(2.0 * M_PI * u2);
+        m_noiseQ[i] = r * sin(2.0 * M_PI * u2);
+    }
+}
+
+uint32_t TestSourceScenario::nextRandom()
+{
+    // xorshift32
+    m_noiseSeed ^= m_noiseSeed << 13;
+    m_noiseSeed ^= m_noiseSeed >> 17;
+    m_noiseSeed ^= m_noiseSeed << 5;
+    return m_noiseSeed;
+}
+
+double TestSourceScenario::getParameter(const Parameters& parameters, const char *key, double defaultValue)
+{
+    return parameters.value(key, defaultValue);
+}
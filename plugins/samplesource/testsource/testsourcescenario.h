@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TESTSOURCE_TESTSOURCESCENARIO_H_
+#define _TESTSOURCE_TESTSOURCESCENARIO_H_
+
+#include <QString>
+#include <QMap>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * Synthetic signal made of several carriers and a noise floor described by a scenario string:
+ * one carrier per line or separated by semicolons, a type followed by key=value parameters
+ * (ex: "nfm f=-25000 level=-20 dev=5000; lora f=100000 bw=125000 sf=7; noise snr=30").
+ *
+ * The modulated baseband of each carrier is computed once in a looped table at a rate suited to
+ * its bandwidth. Generation only reads the table with linear interpolation, mixes it to the carrier
+ * frequency with a table NCO and adds it to the output. The noise is read from a precomputed
+ * gaussian noise table at a random position for each call.
+ */
+class TestSourceScenario
+{
+public:
+    TestSourceScenario();
+    ~TestSourceScenario();
+
+    /** Parse the scenario and build the tables. Invalid entries are skipped and make it return false. */
+    bool setScenario(const QString& scenario, int sampleRate);
+    int getNbCarriers() const { return m_carriers.size(); }
+    /** Overwrite re and im with the next nbSamples samples. Full scale is 1.0. */
+    void generate(float *re, float *im, unsigned int nbSamples);
+
+private:
+    typedef QMap<QString, double> Parameters;
+
+    struct Carrier
+    {
+        std::vector<float> m_tableI;   //!< baseband I with the first sample repeated at the end
+        std::vector<float> m_tableQ;   //!< baseband Q with the first sample repeated at the end
+        uint64_t m_tableEnd;           //!< table size in 32.32 fixed point
+        uint64_t m_tablePos;           //!< read position in 32.32 fixed point
+        uint64_t m_tableStep;          //!< table rate over sample rate in 32.32 fixed point
+        uint32_t m_ncoPhase;
+        uint32_t m_ncoStep;
+        float m_amplitude;             //!< already applied to the table
+    };
+
+    static const int m_ncoBits = 12;
+    static const unsigned int m_noiseTableSize = 1<<16;
+
+    std::vector<Carrier> m_carriers;
+    std::vector<float> m_noiseI;
+    std::vector<float> m_noiseQ;
+    float m_noiseAmplitude;
+    uint32_t m_noiseSeed;
+    int m_sampleRate;
+
+    float m_ncoCos[1<<m_ncoBits];
+    float m_ncoSin[1<<m_ncoBits];
+
+    bool addCarrier(const QString& type, const Parameters& parameters);
+    void setTable(Carrier& carrier, double tableRate);
+    void makeTone(Carrier& carrier);
+    void makeVoice(Carrier& carrier, const QString& type, const Parameters& parameters);
+    void makeLoRa(Carrier& carrier, const Parameters& parameters);
+    void makePSK(Carrier& carrier, const Parameters& parameters);
+    void makeNoise();
+    uint32_t nextRandom();
+    static double getParameter(const Parameters& parameters, const char *key, double defaultValue);
+};
+
+#endif // _TESTSOURCE_TESTSOURCESCENARIO_H_
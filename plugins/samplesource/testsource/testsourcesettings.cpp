@@ -41,6 +41,8 @@ void TestSourceSettings::resetToDefaults()
     m_iFactor = 0.0f;
     m_qFactor = 0.0f;
     m_phaseImbalance = 0.0f;
+    m_scenario = "";
+    m_unthrottled = false;
     m_fileRecordName = "";
 }
 
@@ -63,6 +65,8 @@ QByteArray TestSourceSettings::serialize() const
     s.writeS32(15, m_modulationTone);
     s.writeS32(16, m_amModulation);
     s.writeS32(17, m_fmDeviation);
+    s.writeString(18, m_scenario);
+    s.writeBool(19, m_unthrottled);
 
     return s.final();
 }
@@ -111,6 +115,8 @@ bool TestSourceSettings::deserialize(const QByteArray& data)
         d.readS32(15, &m_modulationTone, 44);
         d.readS32(16, &m_amModulation, 50);
         d.readS32(17, &m_fmDeviation, 50);
+        d.readString(18, &m_scenario, "");
+        d.readBool(19, &m_unthrottled, false);
 
         return true;
     }
@@ -56,6 +56,8 @@ struct TestSourceSettings {
     float m_iFactor;        //!< -1.0 < x < 1.0
     float m_qFactor;        //!< -1.0 < x < 1.0
     float m_phaseImbalance; //!< -1.0 < x < 1.0
+    QString m_scenario;     //!< carriers and noise generated instead of the tone when not empty
+    bool m_unthrottled;     //!< generate as fast as samples are consumed
     QString m_fileRecordName;
 
 	TestSourceSettings();
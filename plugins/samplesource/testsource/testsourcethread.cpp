@@ -16,11 +16,14 @@
 
 #include <stdio.h>
 #include <errno.h>
+#include <algorithm>
 #include "testsourcethread.h"
+#include "testsourcescenario.h"
 
 #include "dsp/samplesinkfifo.h"
 
 #define TESTSOURCE_BLOCKSIZE 16384
+#define TESTSOURCE_REPORT_MS 1000
 
 TestSourceThread::TestSourceThread(SampleSinkFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
@@ -36,6 +39,7 @@ TestSourceThread::TestSourceThread(SampleSinkFifo* sampleFifo, QObject* parent)
 	m_amModulation(0.5f),
 	m_fmDeviationUnit(0.0f),
 	m_fmPhasor(0.0f),
+	m_scenario(0),
 	m_samplerate(48000),
 	m_log2Decim(4),
 	m_fcPos(0),
@@ -53,6 +57,8 @@ TestSourceThread::TestSourceThread(SampleSinkFifo* sampleFifo, QObject* parent)
 	m_fcPosShift(0),
     m_throttlems(TESTSOURCE_THROTTLE_MS),
     m_throttleToggle(false),
+    m_unthrottled(false),
+    m_unthrottledSamples(0),
     m_mutex(QMutex::Recursive)
 {
 }
@@ -60,12 +66,14 @@ TestSourceThread::TestSourceThread(SampleSinkFifo* sampleFifo, QObject* parent)
 TestSourceThread::~TestSourceThread()
 {
 	stopWork();
+	delete m_scenario;
 }
 
 void TestSourceThread::startWork()
 {
 	m_startWaitMutex.lock();
 	m_elapsedTimer.start();
+	m_unthrottledTimer.start();
 	start();
 	while(!m_running)
 		m_startWaiter.wait(&m_startWaitMutex, 100);
@@ -87,6 +95,10 @@ void TestSourceThread::setSamplerate(int samplerate)
     m_throttleToggle = !m_throttleToggle;
 	m_nco.setFreq(m_frequencyShift, m_samplerate);
 	m_toneNco.setFreq(m_toneFrequency, m_samplerate);
+
+	if (m_scenario) { // tables depend on sample rate
+	    m_scenario->setScenario(m_scenarioDescription, m_samplerate);
+	}
 }
 
 void TestSourceThread::setLog2Decimation(unsigned int log2_decim)
@@ -177,19 +189,76 @@ void TestSourceThread::setFMDeviation(float deviation)
     qDebug("TestSourceThread::setFMDeviation: m_fmDeviationUnit: %f", m_fmDeviationUnit);
 }
 
+void TestSourceThread::setScenario(const QString& scenario)
+{
+    TestSourceScenario *testSourceScenario = 0;
+
+    if (!scenario.isEmpty()) // build tables before taking the lock
+    {
+        testSourceScenario = new TestSourceScenario();
+
+        if (!testSourceScenario->setScenario(scenario, m_samplerate)) {
+            qWarning() << "TestSourceThread::setScenario: errors in scenario: " << scenario;
+        }
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    delete m_scenario;
+    m_scenario = testSourceScenario;
+    m_scenarioDescription = scenario;
+}
+
+void TestSourceThread::setUnthrottled(bool unthrottled)
+{
+    qDebug() << "TestSourceThread::setUnthrottled: " << unthrottled;
+    m_unthrottled = unthrottled;
+    m_unthrottledSamples = 0;
+    m_unthrottledTimer.restart();
+    m_elapsedTimer.restart();
+}
+
 void TestSourceThread::run()
 {
     m_running = true;
     m_startWaiter.wakeAll();
 
-    while (m_running) // actual work is in the tick() function
+    while (m_running)
     {
-        sleep(1);
+        if (m_unthrottled) {
+            generateUnthrottled();
+        } else { // actual work is in the tick() function
+            msleep(100);
+        }
     }
 
     m_running = false;
 }
 
+void TestSourceThread::generateUnthrottled()
+{
+    // generate as much as the FIFO can take without overflowing
+    quint32 room = m_sampleFifo->size() - m_sampleFifo->fill();
+
+    if (room < (TESTSOURCE_BLOCKSIZE >> m_log2Decim))
+    {
+        usleep(1000);
+    }
+    else
+    {
+        generate(4 * TESTSOURCE_BLOCKSIZE);
+        m_unthrottledSamples += TESTSOURCE_BLOCKSIZE;
+    }
+
+    qint64 elapsedms = m_unthrottledTimer.elapsed();
+
+    if (elapsedms >= TESTSOURCE_REPORT_MS)
+    {
+        qDebug("TestSourceThread::generateUnthrottled: %.3f MS/s", m_unthrottledSamples / (elapsedms * 1000.0));
+        m_unthrottledSamples = 0;
+        m_unthrottledTimer.restart();
+    }
+}
+
 void TestSourceThread::setBuffers(quint32 chunksize)
 {
     if (chunksize > m_bufsize)
@@ -218,9 +287,17 @@ void TestSourceThread::setBuffers(quint32 chunksize)
 
 void TestSourceThread::generate(quint32 chunksize)
 {
+    QMutexLocker mutexLocker(&m_mutex);
     int n = chunksize / 2;
     setBuffers(chunksize);
 
+    if (m_scenario)
+    {
+        generateScenario(n);
+        callback(m_buf, n);
+        return;
+    }
+
     for (int i = 0; i < n-1;)
     {
         switch (m_modulation)
@@ -264,6 +341,30 @@ void TestSourceThread::generate(quint32 chunksize)
     callback(m_buf, n);
 }
 
+void TestSourceThread::generateScenario(int n)
+{
+    unsigned int nbSamples = n / 2;
+
+    if (m_scenarioI.size() < nbSamples)
+    {
+        m_scenarioI.resize(nbSamples);
+        m_scenarioQ.resize(nbSamples);
+    }
+
+    m_scenario->generate(m_scenarioI.data(), m_scenarioQ.data(), nbSamples);
+
+    // same scaling and impairments as the tone saturated to the sample size
+    float maxValue = (1<<m_bitShift) - 1;
+
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        float re = m_scenarioI[i] * m_amplitudeBitsI + m_amplitudeBitsDC;
+        float im = (m_scenarioQ[i] + m_phaseImbalance * m_scenarioI[i]) * m_amplitudeBitsQ;
+        m_buf[2*i]   = (int16_t) std::min(maxValue, std::max(-maxValue, re));
+        m_buf[2*i+1] = (int16_t) std::min(maxValue, std::max(-maxValue, im));
+    }
+}
+
 void TestSourceThread::pullAF(Real& afSample)
 {
     afSample = m_toneNco.next();
@@ -299,7 +400,7 @@ void TestSourceThread::connectTimer(const QTimer& timer)
 
 void TestSourceThread::tick()
 {
-    if (m_running)
+    if (m_running && !m_unthrottled)
     {
         qint64 throttlems = m_elapsedTimer.restart();
 
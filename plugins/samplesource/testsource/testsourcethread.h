@@ -23,6 +23,7 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QDebug>
+#include <vector>
 
 #include "dsp/samplesinkfifo.h"
 #include "dsp/decimators.h"
@@ -32,6 +33,8 @@
 
 #define TESTSOURCE_THROTTLE_MS 50
 
+class TestSourceScenario;
+
 class TestSourceThread : public QThread {
 	Q_OBJECT
 
@@ -55,6 +58,8 @@ public:
     void setModulation(TestSourceSettings::Modulation modulation);
     void setAMModulation(float amModulation);
     void setFMDeviation(float deviation);
+    void setScenario(const QString& scenario); //!< empty for the tone
+    void setUnthrottled(bool unthrottled);
 
     void connectTimer(const QTimer& timer);
 
@@ -76,6 +81,10 @@ private:
 	float m_amModulation;
 	float m_fmDeviationUnit;
 	float m_fmPhasor;
+	TestSourceScenario *m_scenario;
+	QString m_scenarioDescription;
+	std::vector<float> m_scenarioI;
+	std::vector<float> m_scenarioQ;
 
 	int m_samplerate;
     unsigned int m_log2Decim;
@@ -97,6 +106,9 @@ private:
     int m_throttlems;
     QElapsedTimer m_elapsedTimer;
     bool m_throttleToggle;
+    volatile bool m_unthrottled;
+    quint64 m_unthrottledSamples; //!< generated since last throughput report
+    QElapsedTimer m_unthrottledTimer;
     QMutex m_mutex;
 
 	Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 8> m_decimators_8;
@@ -107,6 +119,8 @@ private:
 	void callback(const qint16* buf, qint32 len);
 	void setBuffers(quint32 chunksize);
     void generate(quint32 chunksize);
+    void generateScenario(int n);
+    void generateUnthrottled();
     void pullAF(Real& afSample);
 
 	//  Decimate according to specified log2 (ex: log2=4 => decim=16)
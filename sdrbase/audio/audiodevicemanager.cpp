@@ -155,6 +155,8 @@ QByteArray AudioDeviceManager::serialize() const
     s.writeBlob(1, data);
     serializeOutputMap(data);
     s.writeBlob(2, data);
+    serializeOutputTypeMap(data);
+    s.writeBlob(3, data);
 
     return s.final();
 }
@@ -173,6 +175,21 @@ void AudioDeviceManager::serializeOutputMap(QByteArray& data) const
     delete stream;
 }
 
+// Output type is kept apart from the output info stream so that settings saved by previous versions still load
+void AudioDeviceManager::serializeOutputTypeMap(QByteArray& data) const
+{
+    QMap<QString, QPair<int, QString> > outputTypes;
+    QMap<QString, OutputDeviceInfo>::const_iterator it = m_audioOutputInfos.begin();
+
+    for (; it != m_audioOutputInfos.end(); ++it) {
+        outputTypes[it.key()] = qMakePair((int) it.value().outputType, it.value().outputPath);
+    }
+
+    QDataStream *stream = new QDataStream(&data, QIODevice::WriteOnly);
+    *stream << outputTypes;
+    delete stream;
+}
+
 bool AudioDeviceManager::deserialize(const QByteArray& data)
 {
     qDebug("AudioDeviceManager::deserialize");
@@ -193,6 +210,10 @@ bool AudioDeviceManager::deserialize(const QByteArray& data)
         d.readBlob(2, &data);
         deserializeOutputMap(data);
 
+        if (d.readBlob(3, &data)) {
+            deserializeOutputTypeMap(data);
+        }
+
         debugAudioInputInfos();
         debugAudioOutputInfos();
 
@@ -217,6 +238,23 @@ void AudioDeviceManager::deserializeOutputMap(QByteArray& data)
     readStream >> m_audioOutputInfos;
 }
 
+void AudioDeviceManager::deserializeOutputTypeMap(QByteArray& data)
+{
+    QMap<QString, QPair<int, QString> > outputTypes;
+    QDataStream readStream(&data, QIODevice::ReadOnly);
+    readStream >> outputTypes;
+    QMap<QString, QPair<int, QString> >::const_iterator it = outputTypes.begin();
+
+    for (; it != outputTypes.end(); ++it)
+    {
+        if (m_audioOutputInfos.contains(it.key()))
+        {
+            m_audioOutputInfos[it.key()].outputType = (AudioOutput::OutputType) (it.value().first % 4);
+            m_audioOutputInfos[it.key()].outputPath = it.value().second;
+        }
+    }
+}
+
 void AudioDeviceManager::addAudioSink(AudioFifo* audioFifo, MessageQueue *sampleSinkMessageQueue, int outputDeviceIndex)
 {
     qDebug("AudioDeviceManager::addAudioSink: %d: %p", outputDeviceIndex, audioFifo);
@@ -242,9 +280,16 @@ void AudioDeviceManager::addAudioSink(AudioFifo* audioFifo, MessageQueue *sample
 
         if (audioOutputDeviceIndex != outputDeviceIndex) // change of audio device
         {
+            bool hasGainPan = m_audioSinkGainPans.contains(audioFifo);
+            QPair<float, float> gainPan = m_audioSinkGainPans.value(audioFifo);
             removeAudioSink(audioFifo); // remove from current
             m_audioOutputs[outputDeviceIndex]->addFifo(audioFifo); // add to new
             m_audioSinkFifos[audioFifo] = outputDeviceIndex; // new index
+
+            if (hasGainPan) { // follows the FIFO
+                setAudioSinkGainPan(audioFifo, gainPan.first, gainPan.second);
+            }
+
             m_outputDeviceSinkMessageQueues[audioOutputDeviceIndex].removeOne(sampleSinkMessageQueue);
             m_outputDeviceSinkMessageQueues[outputDeviceIndex].append(sampleSinkMessageQueue);
         }
@@ -269,10 +314,23 @@ void AudioDeviceManager::removeAudioSink(AudioFifo* audioFifo)
     }
 
     m_audioSinkFifos.remove(audioFifo); // unregister audio FIFO
+    m_audioSinkGainPans.remove(audioFifo);
     m_outputDeviceSinkMessageQueues[audioOutputDeviceIndex].removeOne(m_audioFifoToSinkMessageQueues[audioFifo]);
     m_audioFifoToSinkMessageQueues.remove(audioFifo);
 }
 
+void AudioDeviceManager::setAudioSinkGainPan(AudioFifo* audioFifo, float gain, float pan)
+{
+    if (m_audioSinkFifos.find(audioFifo) == m_audioSinkFifos.end())
+    {
+        qWarning("AudioDeviceManager::setAudioSinkGainPan: audio FIFO %p not found", audioFifo);
+        return;
+    }
+
+    m_audioOutputs[m_audioSinkFifos[audioFifo]]->setFifoGainPan(audioFifo, gain, pan);
+    m_audioSinkGainPans[audioFifo] = qMakePair(gain, pan);
+}
+
 void AudioDeviceManager::addAudioSource(AudioFifo* audioFifo, MessageQueue *sampleSourceMessageQueue, int inputDeviceIndex)
 {
     qDebug("AudioDeviceManager::addAudioSource: %d: %p", inputDeviceIndex, audioFifo);
@@ -335,6 +393,8 @@ void AudioDeviceManager::startAudioOutput(int outputDeviceIndex)
     bool copyAudioToUDP;
     bool udpUseRTP;
     AudioOutput::UDPChannelMode udpChannelMode;
+    AudioOutput::OutputType outputType;
+    QString outputPath;
     QString deviceName;
 
     if (getOutputDeviceName(outputDeviceIndex, deviceName))
@@ -347,6 +407,7 @@ void AudioDeviceManager::startAudioOutput(int outputDeviceIndex)
             copyAudioToUDP = false;
             udpUseRTP = false;
             udpChannelMode = AudioOutput::UDPChannelLeft;
+            outputType = AudioOutput::OutputAudioDevice;
         }
         else
         {
@@ -356,15 +417,19 @@ void AudioDeviceManager::startAudioOutput(int outputDeviceIndex)
             copyAudioToUDP = m_audioOutputInfos[deviceName].copyToUDP;
             udpUseRTP = m_audioOutputInfos[deviceName].udpUseRTP;
             udpChannelMode = m_audioOutputInfos[deviceName].udpChannelMode;
+            outputType = m_audioOutputInfos[deviceName].outputType;
+            outputPath = m_audioOutputInfos[deviceName].outputPath;
         }
 
-        m_audioOutputs[outputDeviceIndex]->start(outputDeviceIndex, sampleRate);
+        m_audioOutputs[outputDeviceIndex]->start(outputDeviceIndex, sampleRate, outputType, outputPath);
         m_audioOutputInfos[deviceName].sampleRate = m_audioOutputs[outputDeviceIndex]->getRate(); // update with actual rate
         m_audioOutputInfos[deviceName].udpAddress = udpAddress;
         m_audioOutputInfos[deviceName].udpPort = udpPort;
         m_audioOutputInfos[deviceName].copyToUDP = copyAudioToUDP;
         m_audioOutputInfos[deviceName].udpUseRTP = udpUseRTP;
         m_audioOutputInfos[deviceName].udpChannelMode = udpChannelMode;
+        m_audioOutputInfos[deviceName].outputType = outputType;
+        m_audioOutputInfos[deviceName].outputPath = outputPath;
     }
     else
     {
@@ -557,12 +622,17 @@ void AudioDeviceManager::setOutputDeviceInfo(int outputDeviceIndex, const Output
 
     AudioOutput *audioOutput = m_audioOutputs[outputDeviceIndex];
 
-    if (oldDeviceInfo.sampleRate != deviceInfo.sampleRate)
+    if ((oldDeviceInfo.sampleRate != deviceInfo.sampleRate)
+     || (oldDeviceInfo.outputType != deviceInfo.outputType)
+     || (oldDeviceInfo.outputPath != deviceInfo.outputPath))
     {
         audioOutput->stop();
-        audioOutput->start(outputDeviceIndex, deviceInfo.sampleRate);
+        audioOutput->start(outputDeviceIndex, deviceInfo.sampleRate, deviceInfo.outputType, deviceInfo.outputPath);
         m_audioOutputInfos[deviceName].sampleRate = audioOutput->getRate(); // store actual sample rate
+    }
 
+    if (oldDeviceInfo.sampleRate != m_audioOutputInfos[deviceName].sampleRate)
+    {
         // send message to attached channels
         QList<MessageQueue *>::const_iterator it = m_outputDeviceSinkMessageQueues[outputDeviceIndex].begin();
 
@@ -623,6 +693,38 @@ void AudioDeviceManager::unsetOutputDeviceInfo(int outputDeviceIndex)
     }
 }
 
+bool AudioDeviceManager::getOutputFifoReports(int outputDeviceIndex, std::vector<AudioOutput::FifoReport>& reports) const
+{
+    QMap<int, AudioOutput*>::const_iterator it = m_audioOutputs.find(outputDeviceIndex);
+
+    if (it == m_audioOutputs.end())
+    {
+        reports.clear();
+        return false;
+    }
+
+    (*it)->getFifoReports(reports);
+    return true;
+}
+
+bool AudioDeviceManager::setOutputFifoGainPan(int outputDeviceIndex, int fifoIndex, float gain, float pan)
+{
+    QMap<int, AudioOutput*>::const_iterator it = m_audioOutputs.find(outputDeviceIndex);
+
+    if (it == m_audioOutputs.end()) {
+        return false;
+    }
+
+    AudioFifo *audioFifo = (*it)->getFifo(fifoIndex);
+
+    if (!audioFifo) {
+        return false;
+    }
+
+    setAudioSinkGainPan(audioFifo, gain, pan); // remembered so that it follows the FIFO on device change
+    return true;
+}
+
 void AudioDeviceManager::unsetInputDeviceInfo(int inputDeviceIndex)
 {
     QString deviceName;
@@ -733,6 +835,8 @@ void AudioDeviceManager::debugAudioOutputInfos() const
                 << " udpPort: " << it.value().udpPort
                 << " copyToUDP: " << it.value().copyToUDP
                 << " udpUseRTP: " << it.value().udpUseRTP
-                << " udpChannelMode: " << (int) it.value().udpChannelMode;
+                << " udpChannelMode: " << (int) it.value().udpChannelMode
+                << " outputType: " << (int) it.value().outputType
+                << " outputPath: " << it.value().outputPath;
     }
 }
@@ -21,6 +21,7 @@
 #include <QStringList>
 #include <QList>
 #include <QMap>
+#include <QPair>
 #include <QAudioDeviceInfo>
 
 #include "audio/audioinput.h"
@@ -59,7 +60,8 @@ public:
             udpPort(m_defaultUDPPort),
             copyToUDP(false),
             udpUseRTP(false),
-            udpChannelMode(AudioOutput::UDPChannelLeft)
+            udpChannelMode(AudioOutput::UDPChannelLeft),
+            outputType(AudioOutput::OutputAudioDevice)
         {}
         void resetToDefaults() {
             sampleRate = m_defaultAudioSampleRate;
@@ -68,6 +70,8 @@ public:
             copyToUDP = false;
             udpUseRTP = false;
             udpChannelMode = AudioOutput::UDPChannelLeft;
+            outputType = AudioOutput::OutputAudioDevice;
+            outputPath.clear();
         }
         unsigned int sampleRate;
         QString udpAddress;
@@ -75,6 +79,8 @@ public:
         bool copyToUDP;
         bool udpUseRTP;
         AudioOutput::UDPChannelMode udpChannelMode;
+        AudioOutput::OutputType outputType; //!< audio device or headless output
+        QString outputPath;                 //!< WAV file or named pipe path of headless output
         friend QDataStream& operator<<(QDataStream& ds, const OutputDeviceInfo& info);
         friend QDataStream& operator>>(QDataStream& ds, OutputDeviceInfo& info);
     };
@@ -92,6 +98,7 @@ public:
 
     void addAudioSink(AudioFifo* audioFifo, MessageQueue *sampleSinkMessageQueue, int outputDeviceIndex = -1); //!< Add the audio sink
     void removeAudioSink(AudioFifo* audioFifo); //!< Remove the audio sink
+    void setAudioSinkGainPan(AudioFifo* audioFifo, float gain, float pan); //!< Mix the audio sink with a linear gain and a balance from -1.0 (left) to 1.0 (right)
 
     void addAudioSource(AudioFifo* audioFifo, MessageQueue *sampleSourceMessageQueue, int inputDeviceIndex = -1);    //!< Add an audio source
     void removeAudioSource(AudioFifo* audioFifo); //!< Remove an audio source
@@ -104,6 +111,8 @@ public:
     void setOutputDeviceInfo(int outputDeviceIndex, const OutputDeviceInfo& deviceInfo);
     void unsetInputDeviceInfo(int inputDeviceIndex);
     void unsetOutputDeviceInfo(int outputDeviceIndex);
+    bool getOutputFifoReports(int outputDeviceIndex, std::vector<AudioOutput::FifoReport>& reports) const; //!< false if the output is not allocated
+    bool setOutputFifoGainPan(int outputDeviceIndex, int fifoIndex, float gain, float pan); //!< FIFO index as in the reports. false if not found
     void inputInfosCleanup();  //!< Remove input info from map for input devices not present
     void outputInfosCleanup(); //!< Remove output info from map for output devices not present
 
@@ -120,6 +129,7 @@ private:
     QMap<AudioFifo*, int> m_audioSinkFifos; //< audio sink FIFO to audio output device index-1 map
     QMap<AudioFifo*, MessageQueue*> m_audioFifoToSinkMessageQueues; //!< audio sink FIFO to attached sink message queue
     QMap<int, QList<MessageQueue*> > m_outputDeviceSinkMessageQueues; //!< sink message queues attached to device
+    QMap<AudioFifo*, QPair<float, float> > m_audioSinkGainPans; //!< audio sink FIFO to gain and pan when not the default
     QMap<int, AudioOutput*> m_audioOutputs; //!< audio device index to audio output map (index -1 is default device)
     QMap<QString, OutputDeviceInfo> m_audioOutputInfos; //!< audio device name to audio output info
 
@@ -144,6 +154,8 @@ private:
 
     void serializeOutputMap(QByteArray& data) const;
     void deserializeOutputMap(QByteArray& data);
+    void serializeOutputTypeMap(QByteArray& data) const;
+    void deserializeOutputTypeMap(QByteArray& data);
     void debugAudioOutputInfos() const;
 
 	friend class MainSettings;
@@ -17,254 +17,224 @@
 
 #include <string.h>
 #include <QTime>
+#include <QThread>
 #include "dsp/dsptypes.h"
 #include "audio/audiofifo.h"
-#include "audio/audionetsink.h"
 
 #define MIN(x, y) ((x) < (y) ? (x) : (y))
 
 AudioFifo::AudioFifo() :
 	m_fifo(0),
-	m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_bufferMask(0),
+	m_head(0),
+	m_tail(0),
+	m_resetting(0),
+	m_readerBusy(0),
+	m_writerBusy(0),
+	m_underrunCount(0),
+	m_overrunCount(0)
 {
-	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 AudioFifo::AudioFifo(uint32_t numSamples) :
 	m_fifo(0),
-    m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_bufferMask(0),
+	m_head(0),
+	m_tail(0),
+	m_resetting(0),
+	m_readerBusy(0),
+	m_writerBusy(0),
+	m_underrunCount(0),
+	m_overrunCount(0)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	create(numSamples);
 }
 
 AudioFifo::~AudioFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	if (m_fifo != 0)
 	{
 		delete[] m_fifo;
 		m_fifo = 0;
 	}
 
-	m_writeWaitCondition.wakeOne();
-	m_readWaitCondition.wakeOne();
-
 	m_size = 0;
 }
 
 bool AudioFifo::setSize(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	beginReset();
+	bool ok = create(numSamples);
+	endReset();
 
-	return create(numSamples);
+	return ok;
 }
 
-uint AudioFifo::write(const quint8* data, uint32_t numSamples, int timeout_ms)
+uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 {
-	QTime time;
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
+	// the ordered operations on both sides make sure that either the reset sees the writer busy
+	// or the writer sees the reset in progress
+	m_writerBusy.fetchAndStoreOrdered(1);
 
-	if(m_fifo == 0)
+	if ((m_resetting.fetchAndAddOrdered(0) != 0) || (m_fifo == 0))
 	{
+		m_writerBusy.storeRelease(0);
 		return 0;
 	}
 
-	time.start();
-	m_mutex.lock();
+	uint32_t tail = (uint32_t) m_tail.load(); // only modified by this (writer) thread
+	uint32_t head = (uint32_t) m_head.loadAcquire();
+	uint32_t total = MIN(numSamples, m_size - (tail - head));
 
-	if(timeout_ms == 0)
-	{
-		total = MIN(numSamples, m_size - m_fill);
-	}
-	else
-	{
-		total = numSamples;
+	if (total < numSamples) {
+		m_overrunCount++;
 	}
 
-	remaining = total;
-
-	while (remaining > 0)
+	if (total > 0)
 	{
-		if (isFull())
-		{
-			if (time.elapsed() < timeout_ms)
-			{
-				m_writeWaitLock.lock();
-				m_mutex.unlock();
-				int ms = timeout_ms - time.elapsed();
-
-				if(ms < 1)
-				{
-					ms = 1;
-				}
-
-				bool ok = m_writeWaitCondition.wait(&m_writeWaitLock, ms);
-				m_writeWaitLock.unlock();
-
-				if(!ok)
-				{
-					return total - remaining;
-				}
-
-				m_mutex.lock();
-
-				if(m_fifo == 0)
-				{
-					m_mutex.unlock();
-					return 0;
-				}
-			}
-			else
-			{
-				m_mutex.unlock();
-				return total - remaining;
-			}
+		uint32_t index = tail & m_bufferMask;
+		uint32_t len = MIN(total, m_bufferMask + 1 - index);
+		memcpy(m_fifo + (index * m_sampleSize), data, len * m_sampleSize);
+
+		if (len < total) { // wrap around
+			memcpy(m_fifo, data + (len * m_sampleSize), (total - len) * m_sampleSize);
 		}
 
-		copyLen = MIN(remaining, m_size - m_fill);
-		copyLen = MIN(copyLen, m_size - m_tail);
-		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
-		m_tail += copyLen;
-		m_tail %= m_size;
-		m_fill += copyLen;
-		data += copyLen * m_sampleSize;
-		remaining -= copyLen;
-		m_readWaitCondition.wakeOne();
+		m_tail.storeRelease((int) (tail + total));
 	}
 
-	m_mutex.unlock();
+	m_writerBusy.storeRelease(0);
 	return total;
 }
 
 uint AudioFifo::read(quint8* data, uint32_t numSamples, int timeout_ms)
 {
 	QTime time;
-	uint32_t total;
-	uint32_t remaining;
-	uint32_t copyLen;
-
-	if(m_fifo == 0)
-	{
-		return 0;
-	}
+	uint32_t total = 0;
 
 	time.start();
-	m_mutex.lock();
 
-	if(timeout_ms == 0)
-	{
-		total = MIN(numSamples, m_fill);
-	}
-	else
+	while (true)
 	{
-		total = numSamples;
-	}
+		m_readerBusy.fetchAndStoreOrdered(1);
+
+		if ((m_resetting.fetchAndAddOrdered(0) != 0) || (m_fifo == 0))
+		{
+			m_readerBusy.storeRelease(0);
+			return total;
+		}
 
-	remaining = total;
+		total += readAvailable(data + (total * m_sampleSize), numSamples - total);
+		m_readerBusy.storeRelease(0);
 
-	while(remaining > 0)
-	{
-		if(isEmpty())
+		if (total == numSamples) {
+			return total;
+		}
+
+		if (time.elapsed() >= timeout_ms)
 		{
-			if(time.elapsed() < timeout_ms)
-			{
-				m_readWaitLock.lock();
-				m_mutex.unlock();
-				int ms = timeout_ms - time.elapsed();
-
-				if(ms < 1)
-				{
-					ms = 1;
-				}
-
-				bool ok = m_readWaitCondition.wait(&m_readWaitLock, ms);
-				m_readWaitLock.unlock();
-
-				if(!ok)
-				{
-					return total - remaining;
-				}
-
-				m_mutex.lock();
-
-				if(m_fifo == 0)
-				{
-					m_mutex.unlock();
-					return 0;
-				}
-			}
-			else
-			{
-				m_mutex.unlock();
-				return total - remaining;
-			}
+			m_underrunCount++;
+			return total;
 		}
 
-		copyLen = MIN(remaining, m_fill);
-		copyLen = MIN(copyLen, m_size - m_head);
-		memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
+		QThread::msleep(1); // not busy while sleeping so that a reset can proceed
+	}
+}
+
+uint32_t AudioFifo::readAvailable(quint8* data, uint32_t numSamples)
+{
+	uint32_t head = (uint32_t) m_head.load(); // only modified by this (reader) thread
+	uint32_t tail = (uint32_t) m_tail.loadAcquire();
+	uint32_t total = MIN(numSamples, tail - head);
+
+	if (total > 0)
+	{
+		uint32_t index = head & m_bufferMask;
+		uint32_t len = MIN(total, m_bufferMask + 1 - index);
+		memcpy(data, m_fifo + (index * m_sampleSize), len * m_sampleSize);
+
+		if (len < total) { // wrap around
+			memcpy(data + (len * m_sampleSize), m_fifo, (total - len) * m_sampleSize);
+		}
 
-		m_head += copyLen;
-		m_head %= m_size;
-		m_fill -= copyLen;
-		data += copyLen * m_sampleSize;
-		remaining -= copyLen;
-		m_writeWaitCondition.wakeOne();
+		m_head.storeRelease((int) (head + total));
 	}
 
-	m_mutex.unlock();
 	return total;
 }
 
 uint AudioFifo::drain(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	m_readerBusy.fetchAndStoreOrdered(1);
 
-	if(numSamples > m_fill)
+	if (m_resetting.fetchAndAddOrdered(0) != 0)
 	{
-		numSamples = m_fill;
+		m_readerBusy.storeRelease(0);
+		return 0;
 	}
 
-	m_head = (m_head + numSamples) % m_size;
-	m_fill -= numSamples;
+	uint32_t head = (uint32_t) m_head.load();
+	uint32_t tail = (uint32_t) m_tail.loadAcquire();
+	numSamples = MIN(numSamples, tail - head);
+	m_head.storeRelease((int) (head + numSamples));
 
-	m_writeWaitCondition.wakeOne();
+	m_readerBusy.storeRelease(0);
 	return numSamples;
 }
 
 void AudioFifo::clear()
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	beginReset();
+	m_head.storeRelease(0);
+	m_tail.storeRelease(0);
+	endReset();
+}
+
+void AudioFifo::beginReset()
+{
+	while (!m_resetting.testAndSetOrdered(0, 1)) { // another reset in progress
+		QThread::yieldCurrentThread();
+	}
 
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	while ((m_readerBusy.fetchAndAddOrdered(0) != 0) || (m_writerBusy.fetchAndAddOrdered(0) != 0)) {
+		QThread::yieldCurrentThread();
+	}
+}
 
-	m_writeWaitCondition.wakeOne();
+void AudioFifo::endReset()
+{
+	m_resetting.storeRelease(0);
 }
 
 bool AudioFifo::create(uint32_t numSamples)
 {
-	if(m_fifo != 0)
+	uint32_t bufferSize = 0;
+
+	if (m_fifo != 0)
 	{
 		delete[] m_fifo;
 		m_fifo = 0;
 	}
 
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	if (numSamples > 0)
+	{
+		bufferSize = 1;
+
+		while (bufferSize < numSamples) {
+			bufferSize <<= 1;
+		}
+
+		m_fifo = new qint8[bufferSize * m_sampleSize];
+	}
 
-	m_fifo = new qint8[numSamples * m_sampleSize];
+	m_head.storeRelease(0);
+	m_tail.storeRelease(0);
 	m_size = numSamples;
+	m_bufferMask = bufferSize == 0 ? 0 : bufferSize - 1;
 
 	return true;
 }
@@ -19,12 +19,19 @@
 #define INCLUDE_AUDIOFIFO_H
 
 #include <QObject>
-#include <QMutex>
-#include <QWaitCondition>
+#include <QAtomicInt>
 
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+/**
+ * Lock free single producer single consumer FIFO of audio samples. The writer (DSP side)
+ * never waits: what does not fit is dropped and counted as an overrun. The reader can
+ * poll for the missing samples up to a timeout.
+ *
+ * setSize() and clear() can be called from any thread: they wait for a read or write in
+ * progress to complete and reads or writes that start meanwhile return nothing.
+ */
 class SDRBASE_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -34,36 +41,41 @@ public:
 
 	bool setSize(uint32_t numSamples);
 
-	uint32_t write(const quint8* data, uint32_t numSamples, int timeout_ms = INT_MAX);
-	uint32_t read(quint8* data, uint32_t numSamples, int timeout_ms = INT_MAX);
+	uint32_t write(const quint8* data, uint32_t numSamples);
+	uint32_t read(quint8* data, uint32_t numSamples, int timeout_ms = 0);
 
-	uint32_t drain(uint32_t numSamples);
+	uint32_t drain(uint32_t numSamples); //!< reader side
 	void clear();
 
-	inline uint32_t flush() { return drain(m_fill); }
-	inline uint32_t fill() const { return m_fill; }
-	inline bool isEmpty() const { return m_fill == 0; }
-	inline bool isFull() const { return m_fill == m_size; }
+	inline uint32_t flush() { return drain(m_size); }
+	inline uint32_t fill() const { return (uint32_t) m_tail.loadAcquire() - (uint32_t) m_head.loadAcquire(); }
+	inline bool isEmpty() const { return fill() == 0; }
+	inline bool isFull() const { return fill() >= m_size; }
 	inline uint32_t size() const { return m_size; }
+	inline uint32_t getUnderrunCount() const { return m_underrunCount; } //!< reads that could not get all samples requested
+	inline uint32_t getOverrunCount() const { return m_overrunCount; }   //!< writes that could not store all samples given
 
 private:
-	QMutex m_mutex;
-
 	qint8* m_fifo;
 
 	const uint32_t m_sampleSize;
 
-	uint32_t m_size;
-	uint32_t m_fill;
-	uint32_t m_head;
-	uint32_t m_tail;
+	uint32_t m_size;        //!< capacity in samples
+	uint32_t m_bufferMask;  //!< storage is rounded up to a power of two for the index masking
+	QAtomicInt m_head;      //!< read counter (written by reader only)
+	QAtomicInt m_tail;      //!< write counter (written by writer only)
+
+	QAtomicInt m_resetting;  //!< setSize() or clear() in progress
+	QAtomicInt m_readerBusy;
+	QAtomicInt m_writerBusy;
 
-	QMutex m_writeWaitLock;
-	QMutex m_readWaitLock;
-	QWaitCondition m_writeWaitCondition;
-	QWaitCondition m_readWaitCondition;
+	uint32_t m_underrunCount;
+	uint32_t m_overrunCount;
 
 	bool create(uint32_t numSamples);
+	void beginReset();
+	void endReset();
+	uint32_t readAvailable(quint8* data, uint32_t numSamples);
 };
 
 #endif // INCLUDE_AUDIOFIFO_H
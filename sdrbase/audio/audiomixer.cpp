@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "audio/audiomixer.h"
+
+namespace {
+
+const float audioMax = 32767.0f;
+const float audioMin = -32768.0f;
+
+inline qint16 saturate(float v)
+{
+    return (qint16) lrintf(v > audioMax ? audioMax : v < audioMin ? audioMin : v);
+}
+
+#if defined(USE_NEON)
+/** Round to nearest, halves to even, as SSE2 and lrintf do */
+inline int32x4_t roundToInt(float32x4_t v)
+{
+#if defined(__aarch64__)
+    return vcvtnq_s32_f32(v);
+#else
+    // ARMv7 conversion truncates: correct by one when the remainder exceeds a half or is a half
+    // on an odd value. Computed in integers as -ffast-math may fold float rounding tricks.
+    int32x4_t t = vcvtq_s32_f32(v);
+    float32x4_t f = vsubq_f32(v, vcvtq_f32_s32(t)); // exact as |v| < 2^23
+    float32x4_t af = vabsq_f32(f);
+    float32x4_t half = vdupq_n_f32(0.5f);
+    uint32x4_t adjust = vorrq_u32(vcgtq_f32(af, half), vandq_u32(vceqq_f32(af, half), vtstq_s32(t, vdupq_n_s32(1))));
+    int32x4_t step = vbslq_s32(vcltq_f32(f, vdupq_n_f32(0.0f)), vdupq_n_s32(-1), vdupq_n_s32(1));
+    return vaddq_s32(t, vandq_s32(step, vreinterpretq_s32_u32(adjust)));
+#endif
+}
+#endif
+
+}
+
+void AudioMixer::mix(const AudioSample *in, float *out, unsigned int n, float gainLeft, float gainRight)
+{
+    unsigned int i = 0;
+#if defined(USE_SSE2)
+    __m128 g = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+
+    // 4 samples of 2 x 16 bits at a time
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &in[i]);
+        // sign extend to 32 bits
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        __m128 olo = _mm_loadu_ps(&out[2*i]);
+        __m128 ohi = _mm_loadu_ps(&out[2*i + 4]);
+        _mm_storeu_ps(&out[2*i], _mm_add_ps(olo, _mm_mul_ps(_mm_cvtepi32_ps(lo), g)));
+        _mm_storeu_ps(&out[2*i + 4], _mm_add_ps(ohi, _mm_mul_ps(_mm_cvtepi32_ps(hi), g)));
+    }
+#elif defined(USE_NEON)
+    float32x4_t g = {gainLeft, gainRight, gainLeft, gainRight};
+
+    for (; i + 4 <= n; i += 4)
+    {
+        int16x8_t s = vld1q_s16((const int16_t*) &in[i]);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(s)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(s)));
+        vst1q_f32(&out[2*i], vmlaq_f32(vld1q_f32(&out[2*i]), lo, g));
+        vst1q_f32(&out[2*i + 4], vmlaq_f32(vld1q_f32(&out[2*i + 4]), hi, g));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        out[2*i] += in[i].l * gainLeft;
+        out[2*i + 1] += in[i].r * gainRight;
+    }
+}
+
+void AudioMixer::clip(const float *in, AudioSample *out, unsigned int n)
+{
+    unsigned int i = 0;
+#if defined(USE_SSE2)
+    __m128 vmax = _mm_set1_ps(audioMax);
+    __m128 vmin = _mm_set1_ps(audioMin);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        // clamp first as out of range floats convert to the integer indefinite value
+        __m128 lo = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(&in[2*i]), vmax), vmin);
+        __m128 hi = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(&in[2*i + 4]), vmax), vmin);
+        __m128i p = _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi));
+        _mm_storeu_si128((__m128i*) &out[i], p);
+    }
+#elif defined(USE_NEON)
+    float32x4_t vmax = vdupq_n_f32(audioMax);
+    float32x4_t vmin = vdupq_n_f32(audioMin);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        // clamp first so that the rounding works on exact 16 bit range values
+        float32x4_t lo = vmaxq_f32(vminq_f32(vld1q_f32(&in[2*i]), vmax), vmin);
+        float32x4_t hi = vmaxq_f32(vminq_f32(vld1q_f32(&in[2*i + 4]), vmax), vmin);
+        int16x8_t p = vcombine_s16(vqmovn_s32(roundToInt(lo)), vqmovn_s32(roundToInt(hi)));
+        vst1q_s16((int16_t*) &out[i], p);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        out[i].l = saturate(in[2*i]);
+        out[i].r = saturate(in[2*i + 1]);
+    }
+}
+
+void AudioMixer::getGains(float gain, float pan, float& gainLeft, float& gainRight)
+{
+    pan = pan < -1.0f ? -1.0f : pan > 1.0f ? 1.0f : pan;
+    // balance: the centre leaves both sides untouched
+    gainLeft = pan > 0.0f ? gain * (1.0f - pan) : gain;
+    gainRight = pan < 0.0f ? gain * (1.0f + pan) : gain;
+}
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIOMIXER_H_
+#define SDRBASE_AUDIO_AUDIOMIXER_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Block kernels used to mix the audio FIFOs of an audio output. Channels are summed in a
+ * float buffer of interleaved left and right values with a gain per side then rounded and
+ * saturated to 16 bits. SSE2 or NEON is used when available.
+ */
+class SDRBASE_API AudioMixer
+{
+public:
+    /** out = out + in x gain. out holds 2 x n values */
+    static void mix(const AudioSample *in, float *out, unsigned int n, float gainLeft, float gainRight);
+    /** out = in rounded and saturated to 16 bits. in holds 2 x n values */
+    static void clip(const float *in, AudioSample *out, unsigned int n);
+    /** gains of each side for a linear gain and a balance from -1.0 (left only) to 1.0 (right only) */
+    static void getGains(float gain, float pan, float& gainLeft, float& gainRight);
+};
+
+#endif /* SDRBASE_AUDIO_AUDIOMIXER_H_ */
@@ -16,27 +16,47 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
+#include <QThread>
 #include <QAudioFormat>
 #include <QAudioDeviceInfo>
 #include <QAudioOutput>
 #include "audiooutput.h"
 #include "audiofifo.h"
 #include "audionetsink.h"
+#include "audiooutputheadless.h"
+#include "audiomixer.h"
 
 AudioOutput::AudioOutput() :
 	m_mutex(QMutex::Recursive),
 	m_audioOutput(0),
+	m_audioOutputHeadless(0),
+	m_outputType(OutputAudioDevice),
+	m_deviceBufferMs(0.0f),
 	m_audioNetSink(0),
 	m_copyAudioToUdp(false),
 	m_udpChannelMode(UDPChannelLeft),
 	m_audioUsageCount(0),
 	m_onExit(false),
-	m_audioFifos()
+	m_audioFifos(),
+	m_mixInputs(0),
+	m_pendingMixInputs(0),
+	m_retiredMixInputs(0),
+	m_readSequence(0)
 {
 }
 
 AudioOutput::~AudioOutput()
 {
+    if (m_audioOutputHeadless) // its thread would keep draining a deleted output
+    {
+        m_audioOutputHeadless->stopWork();
+        delete m_audioOutputHeadless;
+    }
+
+    delete m_mixInputs;
+    delete m_pendingMixInputs.fetchAndStoreOrdered(0);
+    delete m_retiredMixInputs.fetchAndStoreOrdered(0);
+
 //	stop();
 //
 //	QMutexLocker mutexLocker(&m_mutex);
@@ -49,13 +69,18 @@ AudioOutput::~AudioOutput()
 //	m_audioFifos.clear();
 }
 
-bool AudioOutput::start(int device, int rate)
+bool AudioOutput::start(int device, int rate, OutputType outputType, const QString& outputPath)
 {
 
 //	if (m_audioUsageCount == 0)
 //	{
         QMutexLocker mutexLocker(&m_mutex);
         QAudioDeviceInfo devInfo;
+        m_outputType = outputType;
+
+        if (outputType != OutputAudioDevice) {
+            return startHeadless(rate, outputType, outputPath);
+        }
 
         if (device < 0)
         {
@@ -106,8 +131,9 @@ bool AudioOutput::start(int device, int rate)
 
         if (m_audioFormat.sampleSize() != 16)
         {
-            qWarning("AudioOutput::start: Audio device ( %s ) failed", qPrintable(devInfo.defaultOutputDevice().deviceName()));
-            return false;
+            qWarning("AudioOutput::start: Audio device ( %s ) failed. Falling back to null output", qPrintable(devInfo.defaultOutputDevice().deviceName()));
+            m_outputType = OutputNull; // no sound card: FIFOs still need to be drained at the audio rate
+            return startHeadless(rate, OutputNull, outputPath);
         }
 
         m_audioOutput = new QAudioOutput(devInfo, m_audioFormat);
@@ -121,6 +147,9 @@ bool AudioOutput::start(int device, int rate)
         {
             qWarning("AudioOutput::start: cannot start");
         }
+
+        // the device pulls until its buffer is full so a sample goes through all of it
+        m_deviceBufferMs = (m_audioOutput->bufferSize() * 1000.0f) / (4 * m_audioFormat.sampleRate());
 //	}
 //
 //	m_audioUsageCount++;
@@ -128,16 +157,52 @@ bool AudioOutput::start(int device, int rate)
 	return true;
 }
 
+bool AudioOutput::startHeadless(int rate, OutputType outputType, const QString& outputPath)
+{
+    m_audioFormat.setSampleRate(rate);
+    m_audioFormat.setChannelCount(2);
+    m_audioFormat.setSampleSize(16);
+    m_audioFormat.setCodec("audio/pcm");
+    m_audioFormat.setByteOrder(QAudioFormat::LittleEndian);
+    m_audioFormat.setSampleType(QAudioFormat::SignedInt);
+    m_deviceBufferMs = 0.0f;
+
+    m_audioNetSink = new AudioNetSink(0, rate, false);
+    m_audioOutputHeadless = new AudioOutputHeadless(this);
+
+    if (!m_audioOutputHeadless->startWork(outputType, outputPath, rate))
+    {
+        qWarning("AudioOutput::startHeadless: cannot open %s. Falling back to null output", qPrintable(outputPath));
+        m_outputType = OutputNull;
+        m_audioOutputHeadless->startWork(OutputNull, "", rate);
+    }
+
+    return true;
+}
+
 void AudioOutput::stop()
 {
     qDebug("AudioOutput::stop");
 
+    if (m_audioOutputHeadless) // its thread drains the FIFOs and uses the UDP sink deleted below
+    {
+        m_audioOutputHeadless->stopWork();
+        delete m_audioOutputHeadless;
+        m_audioOutputHeadless = 0;
+    }
+
     QMutexLocker mutexLocker(&m_mutex);
-    m_audioOutput->stop();
-    QIODevice::close();
+
+    if (m_audioOutput)
+    {
+        m_audioOutput->stop();
+        QIODevice::close();
+        delete m_audioOutput;
+        m_audioOutput = 0;
+    }
+
     delete m_audioNetSink;
     m_audioNetSink = 0;
-    delete m_audioOutput;
 
 //    if (m_audioUsageCount > 0)
 //    {
@@ -159,14 +224,95 @@ void AudioOutput::addFifo(AudioFifo* audioFifo)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	m_audioFifos.push_back(audioFifo);
+	m_audioFifos.push_back(FifoInput(audioFifo));
+	publishMixInputs();
 }
 
 void AudioOutput::removeFifo(AudioFifo* audioFifo)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	m_audioFifos.remove(audioFifo);
+	for (std::list<FifoInput>::iterator it = m_audioFifos.begin(); it != m_audioFifos.end();)
+	{
+		if (it->m_audioFifo == audioFifo) {
+			it = m_audioFifos.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	publishMixInputs();
+
+	// the caller deletes the FIFO on return: let a readData still working on the previous snapshot
+	// finish. A call starting from now swaps in the new snapshot first. This only lasts part of
+	// one audio buffer and happens on channel removal.
+	int readSequence = m_readSequence.loadAcquire();
+
+	if (readSequence & 1)
+	{
+		while (m_readSequence.loadAcquire() == readSequence) {
+			QThread::yieldCurrentThread();
+		}
+	}
+}
+
+void AudioOutput::publishMixInputs()
+{
+	delete m_retiredMixInputs.fetchAndStoreOrdered(0);
+	std::vector<FifoInput> *mixInputs = new std::vector<FifoInput>(m_audioFifos.begin(), m_audioFifos.end());
+	delete m_pendingMixInputs.fetchAndStoreOrdered(mixInputs); // not taken by readData yet so unused
+}
+
+void AudioOutput::setFifoGainPan(AudioFifo* audioFifo, float gain, float pan)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	for (std::list<FifoInput>::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
+	{
+		if (it->m_audioFifo == audioFifo)
+		{
+			it->m_gain = gain;
+			it->m_pan = pan;
+			AudioMixer::getGains(gain, pan, it->m_gainLeft, it->m_gainRight);
+		}
+	}
+
+	publishMixInputs();
+}
+
+AudioFifo *AudioOutput::getFifo(int fifoIndex)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	std::list<FifoInput>::const_iterator it = m_audioFifos.begin();
+
+	for (int i = 0; it != m_audioFifos.end(); ++it, i++)
+	{
+		if (i == fifoIndex) {
+			return it->m_audioFifo;
+		}
+	}
+
+	return 0;
+}
+
+void AudioOutput::getFifoReports(std::vector<FifoReport>& reports)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	unsigned int rate = m_audioFormat.sampleRate();
+	reports.clear();
+
+	for (std::list<FifoInput>::const_iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
+	{
+		FifoReport report;
+		report.m_fill = it->m_audioFifo->fill();
+		report.m_size = it->m_audioFifo->size();
+		report.m_underrunCount = it->m_audioFifo->getUnderrunCount();
+		report.m_overrunCount = it->m_audioFifo->getOverrunCount();
+		report.m_latencyMs = (rate == 0 ? 0.0f : (report.m_fill * 1000.0f) / rate) + m_deviceBufferMs;
+		report.m_gain = it->m_gain;
+		report.m_pan = it->m_pan;
+		reports.push_back(report);
+	}
 }
 
 /*
@@ -224,11 +370,12 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 		return 0;
 	}
 
-	if (m_mixBuffer.size() < samplesPerBuffer * 2)
+	if ((m_mixBuffer.size() < samplesPerBuffer * 2) || (m_readBuffer.size() < samplesPerBuffer))
 	{
-		m_mixBuffer.resize(samplesPerBuffer * 2); // allocate 2 qint32 per sample (stereo)
+		m_mixBuffer.resize(samplesPerBuffer * 2); // 2 floats per sample (stereo)
+		m_readBuffer.resize(samplesPerBuffer);
 
-		if (m_mixBuffer.size() != samplesPerBuffer * 2)
+		if ((m_mixBuffer.size() != samplesPerBuffer * 2) || (m_readBuffer.size() != samplesPerBuffer))
 		{
 			return 0;
 		}
@@ -236,88 +383,61 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 
 	memset(&m_mixBuffer[0], 0x00, 2 * samplesPerBuffer * sizeof(m_mixBuffer[0])); // start with silence
 
-	// sum up a block from all fifos
+	// the FIFOs list is changed from other threads: work on the last published snapshot without locking
+	m_readSequence.fetchAndAddOrdered(1);
+	std::vector<FifoInput> *mixInputs = m_pendingMixInputs.fetchAndStoreOrdered(0);
 
-	for (std::list<AudioFifo*>::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
+	if (mixInputs)
 	{
-		// use outputBuffer as temp - yes, one memcpy could be saved
-		unsigned int samples = (*it)->read((quint8*) data, samplesPerBuffer, 1);
-		const qint16* src = (const qint16*) data;
-		std::vector<qint32>::iterator dst = m_mixBuffer.begin();
-
-//		if (samples != framesPerBuffer)
-//		{
-//            qDebug("AudioOutput::readData: read %d samples vs %d requested", samples, framesPerBuffer);
-//		}
-
-		for (unsigned int i = 0; i < samples; i++)
-		{
-			*dst += *src;
-			++src;
-			++dst;
-			*dst += *src;
-			++src;
-			++dst;
-		}
-    }
-	// convert to int16
+		std::vector<FifoInput> *retired = m_retiredMixInputs.fetchAndStoreOrdered(m_mixInputs);
+		delete retired; // only when two snapshots were swapped in before a writer came by
+		m_mixInputs = mixInputs;
+	}
 
-	//std::vector<qint32>::const_iterator src = m_mixBuffer.begin(); // Valgrind optim
-	qint16* dst = (qint16*) data;
-	qint32 sl, sr;
+	// sum up a block from all fifos. Reads do not wait so that a late channel does not hold the others
+	// and the time spent here only depends on the number of channels.
 
-	for (unsigned int i = 0; i < samplesPerBuffer; i++)
+	if (m_mixInputs)
 	{
-		// left channel
-
-		//s = *src++; // Valgrind optim
-		sl = m_mixBuffer[2*i];
-
-		if(sl < -32768)
-		{
-			sl = -32768;
-		}
-		else if (sl > 32767)
+		for (std::vector<FifoInput>::const_iterator it = m_mixInputs->begin(); it != m_mixInputs->end(); ++it)
 		{
-			sl = 32767;
+			unsigned int samples = it->m_audioFifo->read((quint8*) &m_readBuffer[0], samplesPerBuffer);
+			AudioMixer::mix(&m_readBuffer[0], &m_mixBuffer[0], samples, it->m_gainLeft, it->m_gainRight);
 		}
+	}
 
-		*dst++ = sl;
+	m_readSequence.fetchAndAddOrdered(1);
 
-		// right channel
+	// convert to int16
 
-		//s = *src++; // Valgrind optim
-		sr = m_mixBuffer[2*i + 1];
+	AudioMixer::clip(&m_mixBuffer[0], (AudioSample*) data, samplesPerBuffer);
 
-		if(sr < -32768)
-		{
-			sr = -32768;
-		}
-		else if (sr > 32767)
-		{
-			sr = 32767;
-		}
-
-		*dst++ = sr;
+	if ((m_copyAudioToUdp) && (m_audioNetSink))
+	{
+		const AudioSample* src = (const AudioSample*) data;
+		qint32 sl, sr;
 
-		if ((m_copyAudioToUdp) && (m_audioNetSink))
+		for (unsigned int i = 0; i < samplesPerBuffer; i++)
 		{
-	        switch (m_udpChannelMode)
-	        {
-            case UDPChannelStereo:
-                m_audioNetSink->write(sl, sr);
-                break;
-            case UDPChannelMixed:
-                m_audioNetSink->write((sl+sr)/2);
-                break;
-            case UDPChannelRight:
-                m_audioNetSink->write(sr);
-                break;
-	        case UDPChannelLeft:
-	        default:
-	            m_audioNetSink->write(sl);
-	            break;
-	        }
+			sl = src[i].l;
+			sr = src[i].r;
+
+			switch (m_udpChannelMode)
+			{
+			case UDPChannelStereo:
+				m_audioNetSink->write(sl, sr);
+				break;
+			case UDPChannelMixed:
+				m_audioNetSink->write((sl+sr)/2);
+				break;
+			case UDPChannelRight:
+				m_audioNetSink->write(sr);
+				break;
+			case UDPChannelLeft:
+			default:
+				m_audioNetSink->write(sl);
+				break;
+			}
 		}
 	}
 
@@ -19,16 +19,20 @@
 #define INCLUDE_AUDIOOUTPUT_H
 
 #include <QMutex>
+#include <QAtomicPointer>
+#include <QAtomicInt>
 #include <QIODevice>
 #include <QAudioFormat>
 #include <list>
 #include <vector>
 #include <stdint.h>
+#include "dsp/dsptypes.h"
 #include "export.h"
 
 class QAudioOutput;
 class AudioFifo;
 class AudioOutputPipe;
+class AudioOutputHeadless;
 class AudioNetSink;
 
 class SDRBASE_API AudioOutput : QIODevice {
@@ -41,17 +45,40 @@ public:
         UDPChannelStereo
     };
 
+    enum OutputType
+    {
+        OutputAudioDevice, //!< audio device pulls the samples
+        OutputNull,        //!< samples are drained on a timer and discarded
+        OutputWAVFile,     //!< samples are drained on a timer and written to a WAV file
+        OutputPipe         //!< samples are drained on a timer and written to a named pipe
+    };
+
+    struct FifoReport
+    {
+        uint32_t m_fill;
+        uint32_t m_size;
+        uint32_t m_underrunCount;
+        uint32_t m_overrunCount;
+        float m_latencyMs; //!< time for a sample written now in the FIFO to reach the output
+        float m_gain;      //!< linear mixing gain
+        float m_pan;       //!< balance from -1.0 (left) to 1.0 (right)
+    };
+
 	AudioOutput();
 	virtual ~AudioOutput();
 
-	bool start(int device, int rate);
+	bool start(int device, int rate, OutputType outputType = OutputAudioDevice, const QString& outputPath = "");
 	void stop();
 
 	void addFifo(AudioFifo* audioFifo);
 	void removeFifo(AudioFifo* audioFifo);
+	void setFifoGainPan(AudioFifo* audioFifo, float gain, float pan); //!< linear gain and balance from -1.0 (left) to 1.0 (right)
 	int getNbFifos() const { return m_audioFifos.size(); }
+	AudioFifo *getFifo(int fifoIndex); //!< FIFO in the order of the reports or null
 
 	unsigned int getRate() const { return m_audioFormat.sampleRate(); }
+	OutputType getOutputType() const { return m_outputType; }
+	void getFifoReports(std::vector<FifoReport>& reports);
 	void setOnExit(bool onExit) { m_onExit = onExit; }
 
 	void setUdpDestination(const QString& address, uint16_t port);
@@ -61,24 +88,52 @@ public:
 	void setUdpChannelFormat(bool stereo, int sampleRate);
 
 private:
+	struct FifoInput
+	{
+		AudioFifo* m_audioFifo;
+		float m_gain;
+		float m_pan;
+		float m_gainLeft;
+		float m_gainRight;
+
+		FifoInput(AudioFifo* audioFifo) :
+			m_audioFifo(audioFifo),
+			m_gain(1.0f),
+			m_pan(0.0f),
+			m_gainLeft(1.0f),
+			m_gainRight(1.0f)
+		{}
+	};
+
 	QMutex m_mutex;
 	QAudioOutput* m_audioOutput;
+	AudioOutputHeadless* m_audioOutputHeadless;
+	OutputType m_outputType;
+	float m_deviceBufferMs;
 	AudioNetSink* m_audioNetSink;
 	bool m_copyAudioToUdp;
 	UDPChannelMode m_udpChannelMode;
 	uint m_audioUsageCount;
 	bool m_onExit;
 
-	std::list<AudioFifo*> m_audioFifos;
-	std::vector<qint32> m_mixBuffer;
+	std::list<FifoInput> m_audioFifos; //!< under m_mutex. Copied to a snapshot for the audio thread on each change
+	std::vector<FifoInput> *m_mixInputs; //!< snapshot used by readData (audio thread only)
+	QAtomicPointer<std::vector<FifoInput> > m_pendingMixInputs; //!< snapshot published for readData to swap in
+	QAtomicPointer<std::vector<FifoInput> > m_retiredMixInputs; //!< snapshot swapped out by readData to be deleted by the next writer
+	QAtomicInt m_readSequence;        //!< odd while readData is running
+	std::vector<float> m_mixBuffer;   //!< interleaved left and right sums
+	std::vector<AudioSample> m_readBuffer;
 
 	QAudioFormat m_audioFormat;
 
 	//virtual bool open(OpenMode mode);
 	virtual qint64 readData(char* data, qint64 maxLen);
 	virtual qint64 writeData(const char* data, qint64 len);
+	bool startHeadless(int rate, OutputType outputType, const QString& outputPath);
+	void publishMixInputs(); //!< call with m_mutex locked after any change of m_audioFifos
 
 	friend class AudioOutputPipe;
+	friend class AudioOutputHeadless;
 };
 
 #endif // INCLUDE_AUDIOOUTPUT_H
@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QElapsedTimer>
+#include <QByteArray>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+#include "audio/audiooutputheadless.h"
+
+static void appendLE(QByteArray& bytes, quint32 value, int nbBytes)
+{
+    for (int i = 0; i < nbBytes; i++) {
+        bytes.append((char) ((value >> (8*i)) & 0xFF));
+    }
+}
+
+AudioOutputHeadless::AudioOutputHeadless(AudioOutput *audioOutput) :
+    m_audioOutput(audioOutput),
+    m_outputType(AudioOutput::OutputNull),
+    m_sampleRate(0),
+    m_running(false),
+    m_wavDataSize(0),
+    m_pipeFd(-1),
+    m_nbDroppedFrames(0)
+{
+}
+
+AudioOutputHeadless::~AudioOutputHeadless()
+{
+    stopWork();
+}
+
+bool AudioOutputHeadless::startWork(AudioOutput::OutputType outputType, const QString& outputPath, int sampleRate)
+{
+    m_outputType = outputType;
+    m_outputPath = outputPath;
+    m_sampleRate = sampleRate;
+    m_nbDroppedFrames = 0;
+
+    if (!openSink()) {
+        return false;
+    }
+
+    qDebug("AudioOutputHeadless::startWork: type: %d path: %s rate: %d", (int) m_outputType, qPrintable(m_outputPath), m_sampleRate);
+    m_running = true;
+    start(QThread::HighPriority);
+
+    return true;
+}
+
+void AudioOutputHeadless::stopWork()
+{
+    if (m_running)
+    {
+        m_running = false;
+        wait();
+        closeSink();
+        qDebug("AudioOutputHeadless::stopWork: %llu frames dropped by the sink", m_nbDroppedFrames);
+    }
+}
+
+void AudioOutputHeadless::run()
+{
+    unsigned int periodFrames = (m_sampleRate * m_periodMs) / 1000;
+    quint64 nbFramesOut = 0;
+    QElapsedTimer timer;
+
+    m_buffer.resize(2 * periodFrames);
+    timer.start();
+
+    while (m_running)
+    {
+        // due frames are counted from the start so that the wake up jitter does not make the rate drift
+        quint64 nbFramesDue = ((timer.nsecsElapsed() / 1000) * m_sampleRate) / 1000000;
+
+        if (nbFramesDue > nbFramesOut + m_sampleRate) // thread was held for more than a second: resume without a burst
+        {
+            qWarning("AudioOutputHeadless::run: %llu frames late", nbFramesDue - nbFramesOut);
+            nbFramesOut = nbFramesDue - periodFrames;
+        }
+
+        while (nbFramesOut + periodFrames <= nbFramesDue)
+        {
+            m_audioOutput->readData((char *) m_buffer.data(), periodFrames * 4); // works on a snapshot of the FIFOs as the audio device does
+
+            writeSink(m_buffer.data(), periodFrames);
+            nbFramesOut += periodFrames;
+        }
+
+        qint64 sleepUs = (qint64) (((nbFramesOut + periodFrames) * 1000000) / m_sampleRate) - timer.nsecsElapsed() / 1000;
+
+        if (sleepUs > 0) {
+            usleep(sleepUs);
+        }
+    }
+}
+
+bool AudioOutputHeadless::openSink()
+{
+    switch (m_outputType)
+    {
+    case AudioOutput::OutputWAVFile:
+        m_wavFile.setFileName(m_outputPath);
+
+        if (!m_wavFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qWarning("AudioOutputHeadless::openSink: cannot open WAV file %s", qPrintable(m_outputPath));
+            return false;
+        }
+
+        m_wavDataSize = 0;
+        writeWAVHeader();
+        return true;
+    case AudioOutput::OutputPipe:
+#ifdef _WIN32
+        qWarning("AudioOutputHeadless::openSink: named pipe output is not supported on this platform");
+        return false;
+#else
+    {
+        QByteArray path = m_outputPath.toLocal8Bit();
+        struct stat pathStat;
+
+        if (path.isEmpty()) {
+            return false;
+        }
+
+        if (stat(path.constData(), &pathStat) != 0)
+        {
+            if (mkfifo(path.constData(), 0644) != 0)
+            {
+                qWarning("AudioOutputHeadless::openSink: cannot create named pipe %s: %s", path.constData(), strerror(errno));
+                return false;
+            }
+        }
+        else if (!S_ISFIFO(pathStat.st_mode))
+        {
+            qWarning("AudioOutputHeadless::openSink: %s is not a named pipe", path.constData());
+            return false;
+        }
+
+        signal(SIGPIPE, SIG_IGN); // the reader going away must not terminate the process
+        m_pipeFd = -1;
+        openPipe(); // else the reader will be picked up when it connects
+        return true;
+    }
+#endif
+    case AudioOutput::OutputNull:
+    default:
+        return true;
+    }
+}
+
+void AudioOutputHeadless::closeSink()
+{
+    if (m_wavFile.isOpen())
+    {
+        writeWAVHeader(); // final sizes
+        m_wavFile.close();
+    }
+
+#ifndef _WIN32
+    if (m_pipeFd >= 0)
+    {
+        ::close(m_pipeFd);
+        m_pipeFd = -1;
+    }
+#endif
+}
+
+bool AudioOutputHeadless::openPipe()
+{
+#ifndef _WIN32
+    // non blocking so that the drain clock keeps running: fails with ENXIO until a reader opens the pipe
+    m_pipeFd = ::open(m_outputPath.toLocal8Bit().constData(), O_WRONLY | O_NONBLOCK);
+
+    if (m_pipeFd >= 0) {
+        qDebug("AudioOutputHeadless::openPipe: reader connected to %s", qPrintable(m_outputPath));
+    }
+
+    return m_pipeFd >= 0;
+#else
+    return false;
+#endif
+}
+
+void AudioOutputHeadless::writeSink(const qint16 *data, unsigned int nbFrames)
+{
+    unsigned int nbBytes = nbFrames * 4;
+
+    switch (m_outputType)
+    {
+    case AudioOutput::OutputWAVFile:
+    {
+        if ((quint64) m_wavDataSize + nbBytes > 0xFFFFFFFFULL - 36) // RIFF size limit
+        {
+            m_nbDroppedFrames += nbFrames;
+            return;
+        }
+
+        qint64 nbWritten = m_wavFile.write((const char *) data, nbBytes);
+
+        if (nbWritten > 0) {
+            m_wavDataSize += nbWritten;
+        }
+        if (nbWritten < nbBytes) {
+            m_nbDroppedFrames += (nbBytes - (nbWritten < 0 ? 0 : nbWritten)) / 4;
+        }
+        break;
+    }
+    case AudioOutput::OutputPipe:
+#ifndef _WIN32
+    {
+        if ((m_pipeFd < 0) && !openPipe())
+        {
+            m_nbDroppedFrames += nbFrames;
+            return;
+        }
+
+        ssize_t nbWritten = ::write(m_pipeFd, data, nbBytes);
+
+        if (nbWritten < 0)
+        {
+            if (errno == EPIPE) // reader has gone: wait for the next one
+            {
+                qDebug("AudioOutputHeadless::writeSink: reader disconnected from %s", qPrintable(m_outputPath));
+                ::close(m_pipeFd);
+                m_pipeFd = -1;
+            }
+
+            m_nbDroppedFrames += nbFrames; // or EAGAIN: reader is late
+        }
+        else if ((unsigned int) nbWritten < nbBytes) // partial writes to a pipe are made of whole pages hence whole frames
+        {
+            m_nbDroppedFrames += (nbBytes - nbWritten) / 4;
+        }
+        break;
+    }
+#endif
+    case AudioOutput::OutputNull:
+    default:
+        break;
+    }
+}
+
+void AudioOutputHeadless::writeWAVHeader()
+{
+    QByteArray header;
+
+    header.append("RIFF", 4);
+    appendLE(header, 36 + m_wavDataSize, 4);
+    header.append("WAVE", 4);
+    header.append("fmt ", 4);
+    appendLE(header, 16, 4);                // format chunk size
+    appendLE(header, 1, 2);                 // PCM
+    appendLE(header, 2, 2);                 // channels
+    appendLE(header, m_sampleRate, 4);
+    appendLE(header, m_sampleRate * 4, 4);  // bytes per second
+    appendLE(header, 4, 2);                 // bytes per frame
+    appendLE(header, 16, 2);                // bits per sample
+    header.append("data", 4);
+    appendLE(header, m_wavDataSize, 4);
+
+    m_wavFile.seek(0);
+    m_wavFile.write(header);
+}
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_AUDIOOUTPUTHEADLESS_H
+#define INCLUDE_AUDIOOUTPUTHEADLESS_H
+
+#include <QThread>
+#include <QFile>
+#include <QString>
+#include <vector>
+
+#include "audio/audiooutput.h"
+#include "export.h"
+
+/**
+ * Takes the place of the audio device when there is none or when audio is not to be played.
+ * A thread drains the FIFOs of the audio output at the audio sample rate with its own clock
+ * and sends the mix to a null sink, a WAV file or a named pipe.
+ */
+class SDRBASE_API AudioOutputHeadless : public QThread
+{
+public:
+    AudioOutputHeadless(AudioOutput *audioOutput);
+    ~AudioOutputHeadless();
+
+    bool startWork(AudioOutput::OutputType outputType, const QString& outputPath, int sampleRate);
+    void stopWork();
+
+private:
+    AudioOutput *m_audioOutput;
+    AudioOutput::OutputType m_outputType;
+    QString m_outputPath;
+    int m_sampleRate;
+    volatile bool m_running;
+    QFile m_wavFile;
+    quint32 m_wavDataSize;  //!< bytes of samples written in the WAV file
+    int m_pipeFd;           //!< -1 while no reader has opened the pipe
+    quint64 m_nbDroppedFrames;
+    std::vector<qint16> m_buffer;
+
+    static const int m_periodMs = 10; //!< FIFOs are drained every period
+
+    void run();
+    bool openSink();
+    void closeSink();
+    void writeSink(const qint16 *data, unsigned int nbFrames);
+    void writeWAVHeader();
+    bool openPipe();
+};
+
+#endif // INCLUDE_AUDIOOUTPUTHEADLESS_H
@@ -62,6 +62,11 @@ void DeviceSourceAPI::removeThreadedSink(ThreadedBasebandSampleSink* sink)
     m_deviceSourceEngine->removeThreadedSink(sink);
 }
 
+void DeviceSourceAPI::setChannelizerBankSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate)
+{
+    m_deviceSourceEngine->setChannelizerBankSink(sink, frequencyOffset, bandwidth, sampleRate);
+}
+
 void DeviceSourceAPI::addChannelAPI(ChannelSinkAPI* channelAPI)
 {
     m_channelAPIs.append(channelAPI);
@@ -48,6 +48,7 @@ public:
     void removeSink(BasebandSampleSink* sink);    //!< Remove a sample sink from device engine
     void addThreadedSink(ThreadedBasebandSampleSink* sink);     //!< Add a sample sink that will run on its own thread to device engine
     void removeThreadedSink(ThreadedBasebandSampleSink* sink);  //!< Remove a sample sink that runs on its own thread from device engine
+    void setChannelizerBankSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate); //!< Let the device engine feed the sink from its channelizer bank when the channel fits in a bin at no less than sampleRate
     void addChannelAPI(ChannelSinkAPI* channelAPI);
     void removeChannelAPI(ChannelSinkAPI* channelAPI);
     void setSampleSource(DeviceSampleSource* source); //!< Set device sample source
@@ -66,8 +66,8 @@ protected:
 	MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
     MessageQueue *m_guiMessageQueue;  //!< Input message queue to the GUI
 
-protected slots:
-	void handleInputMessages();
+public slots:
+	void handleInputMessages(); //!< also called by the worker pool task of a threaded sink
 };
 
 #endif // INCLUDE_SAMPLESINK_H
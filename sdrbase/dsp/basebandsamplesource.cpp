@@ -54,16 +54,26 @@ void BasebandSampleSource::handleWriteToDeviceFifo(int nbSamples)
     handleWriteToFifo(m_deviceSampleFifo, nbSamples);
 }
 
+void BasebandSampleSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pull(*begin);
+    }
+}
+
 void BasebandSampleSource::handleWriteToFifo(SampleSourceFifo *sampleFifo, int nbSamples)
 {
     SampleVector::iterator writeAt;
-    sampleFifo->getWriteIterator(writeAt);
     pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
 
-    for (int i = 0; i < nbSamples; i++)
+    // at most two contiguous blocks when wrapping around the FIFO end
+    while (nbSamples > 0)
     {
-        pull((*writeAt));
-        sampleFifo->bumpIndex(writeAt);
+        unsigned int chunkSize = nbSamples;
+        sampleFifo->getWriteIterator(writeAt, chunkSize);
+        pull(writeAt, chunkSize);
+        sampleFifo->bumpIndex(writeAt, chunkSize);
+        nbSamples -= chunkSize;
     }
 }
 
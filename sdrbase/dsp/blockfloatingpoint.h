@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+//                                                                               //
+// Block floating point compression of I/Q samples. A block of samples shares    //
+// a single exponent (the right shift that makes the largest magnitude fit) and  //
+// each I and Q value is stored as a two's complement mantissa of "bits" bits.   //
+// This is lossless when the samples of the block fit in "bits" bits (exponent   //
+// is zero) e.g. when "bits" is set to the effective number of bits of the ADC.  //
+//                                                                               //
+// Block layout: 1 byte exponent then I0 Q0 I1 Q1 ... mantissas packed LSB first //
+//                                                                               //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_BLOCKFLOATINGPOINT_H_
+#define SDRBASE_DSP_BLOCKFLOATINGPOINT_H_
+
+#include <stdint.h>
+
+class BlockFloatingPoint
+{
+public:
+    static const int m_minBits = 4;  //!< smallest mantissa size
+    static const int m_maxBits = 15; //!< largest mantissa size. 16 bits would not compress 16 bit samples.
+
+    static bool isValidBits(int bits) { return (bits >= m_minBits) && (bits <= m_maxBits); }
+
+    /** Number of I/Q samples that fit in a compressed block of the given size in bytes */
+    static int getNbSamples(int blockBytes, int bits) { return ((blockBytes - 1) * 8) / (2 * bits); }
+
+    /** Compress nbSamples I/Q samples given as interleaved I and Q values into block */
+    template<typename T>
+    static void encode(const T *iq, int nbSamples, int bits, uint8_t *block)
+    {
+        int32_t magnitudes = 0;
+
+        for (int i = 0; i < 2*nbSamples; i++)
+        {
+            int32_t v = iq[i];
+            magnitudes |= v < 0 ? ~v : v; // OR-ing gives the bit length of the largest magnitude
+        }
+
+        int exponent = 0;
+
+        while ((magnitudes >> exponent) >= (1 << (bits - 1))) {
+            exponent++;
+        }
+
+        const int32_t maxValue = (1 << (bits - 1)) - 1;
+        const uint32_t mask = (1U << bits) - 1;
+        const int32_t round = exponent > 0 ? 1 << (exponent - 1) : 0;
+        uint8_t *p = &block[1];
+        uint32_t acc = 0;
+        int nbAccBits = 0;
+
+        block[0] = exponent;
+
+        for (int i = 0; i < 2*nbSamples; i++)
+        {
+            int32_t v = (((int32_t) iq[i]) + round) >> exponent;
+            v = v > maxValue ? maxValue : v; // rounding may step over the positive limit
+            acc |= (((uint32_t) v) & mask) << nbAccBits;
+            nbAccBits += bits;
+
+            while (nbAccBits >= 8)
+            {
+                *p++ = acc & 0xFF;
+                acc >>= 8;
+                nbAccBits -= 8;
+            }
+        }
+
+        if (nbAccBits > 0) {
+            *p = acc & 0xFF;
+        }
+    }
+
+    /** Expand a compressed block into nbSamples I/Q samples given as interleaved I and Q values */
+    template<typename T>
+    static void decode(const uint8_t *block, int nbSamples, int bits, T *iq)
+    {
+        const int exponent = block[0];
+        const int signShift = 32 - bits;
+        const uint32_t mask = (1U << bits) - 1;
+        const uint8_t *p = &block[1];
+        uint32_t acc = 0;
+        int nbAccBits = 0;
+
+        for (int i = 0; i < 2*nbSamples; i++)
+        {
+            while (nbAccBits < bits)
+            {
+                acc |= ((uint32_t) *p++) << nbAccBits;
+                nbAccBits += 8;
+            }
+
+            int32_t v = ((int32_t) ((acc & mask) << signShift)) >> signShift; // sign extension
+            acc >>= bits;
+            nbAccBits -= bits;
+            iq[i] = v << exponent;
+        }
+    }
+};
+
+#endif /* SDRBASE_DSP_BLOCKFLOATINGPOINT_H_ */
@@ -17,8 +17,11 @@
 #ifndef INCLUDE_GPL_DSP_DECIMATORS_H_
 #define INCLUDE_GPL_DSP_DECIMATORS_H_
 
+#include <vector>
+
 #include "dsp/dsptypes.h"
 #include "dsp/inthalfbandfiltereo.h"
+#include "dsp/inthalfbandfilterblock.h"
 
 #define DECIMATORS_HB_FILTER_ORDER 64
 
@@ -279,6 +282,12 @@ template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 class Decimators
 {
 public:
+    Decimators();
+
+    /** Decimate the interleaved I/Q buffers by 4 to 64 with IntHalfbandFilterBlock (same results). Default is on when it is faster. */
+    void setBlockDecimation(bool blockDecimation);
+    bool getBlockDecimation() const { return m_blockDecimation; }
+
     // interleaved I/Q input buffer
 	void decimate1(SampleVector::iterator* it, const T* buf, qint32 len);
 	void decimate2_u(SampleVector::iterator* it, const T* buf, qint32 len);
@@ -337,9 +346,78 @@ private:
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator16; // 4th stages
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator32; // 5th stages
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator64; // 6th stages
+    IntHalfbandFilterBlock m_blockDecimators[6];   // all stages of block decimation
+    std::vector<int32_t> m_blockI, m_blockQ;
+
+    void decimateBlock(SampleVector::iterator* it, const T* buf, qint32 len, qint32 step, int log2Decim,
+            IntHalfbandFilterBlock::Mode mode, uint preShift, uint postShift);
 #endif
+    bool m_blockDecimation;
 };
 
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+Decimators<StorageType, T, SdrBits, InputBits>::Decimators()
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    m_blockDecimation = false; // 64 bit accumulators
+#else
+    m_blockDecimation = IntHalfbandFilterBlock::hasSIMD();
+#endif
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::setBlockDecimation(bool blockDecimation)
+{
+#ifndef SDR_RX_SAMPLE_24BIT
+    m_blockDecimation = blockDecimation; // filters of each method have their own history
+#else
+    (void) blockDecimation;
+#endif
+}
+
+#ifndef SDR_RX_SAMPLE_24BIT
+/**
+ * Same cascade as the sample by sample methods on the samples they would process (whole steps of len):
+ * first stage in mode, then opposite half bands and center for the last stage when there are more than 2 stages
+ */
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimateBlock(SampleVector::iterator* it, const T* buf, qint32 len, qint32 step, int log2Decim,
+        IntHalfbandFilterBlock::Mode mode, uint preShift, uint postShift)
+{
+    int nbSamples = (len / step) * (step / 2);
+
+    if (nbSamples <= 0) {
+        return;
+    }
+
+    m_blockI.resize(nbSamples);
+    m_blockQ.resize(nbSamples);
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        m_blockI[i] = buf[2*i] << preShift;
+        m_blockQ[i] = buf[2*i+1] << preShift;
+    }
+
+    IntHalfbandFilterBlock::Mode opposite = mode == IntHalfbandFilterBlock::ModeLowerHalf ? IntHalfbandFilterBlock::ModeUpperHalf :
+            mode == IntHalfbandFilterBlock::ModeUpperHalf ? IntHalfbandFilterBlock::ModeLowerHalf : IntHalfbandFilterBlock::ModeCenter;
+
+    for (int stage = 0; stage < log2Decim; stage++)
+    {
+        IntHalfbandFilterBlock::Mode stageMode = stage == 0 ? mode :
+                (stage == log2Decim - 1) && (log2Decim > 2) ? IntHalfbandFilterBlock::ModeCenter : opposite;
+        nbSamples = m_blockDecimators[stage].decimate(stageMode, m_blockI.data(), m_blockQ.data(), nbSamples, m_blockI.data(), m_blockQ.data());
+    }
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        (**it).setReal(m_blockI[i] >> postShift);
+        (**it).setImag(m_blockQ[i] >> postShift);
+        ++(*it);
+    }
+}
+#endif
+
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate1(SampleVector::iterator* it, const T* buf, qint32 len)
 {
@@ -540,6 +618,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_sup(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 16, 2, IntHalfbandFilterBlock::ModeLowerHalf,
+                decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4);
+        return;
+    }
+#endif
+
     StorageType buf2[8], buf4[4];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -590,6 +677,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_inf(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 16, 2, IntHalfbandFilterBlock::ModeUpperHalf,
+                decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4);
+        return;
+    }
+#endif
+
     StorageType buf2[8], buf4[4];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -682,6 +778,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_sup(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 32, 3, IntHalfbandFilterBlock::ModeLowerHalf,
+                decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8);
+        return;
+    }
+#endif
+
     StorageType buf2[16], buf4[8], buf8[4];
 
 	for (int pos = 0; pos < len - 31; pos += 32)
@@ -755,6 +860,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_inf(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 32, 3, IntHalfbandFilterBlock::ModeUpperHalf,
+                decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8);
+        return;
+    }
+#endif
+
     StorageType buf2[16], buf4[8], buf8[4];
 
     for (int pos = 0; pos < len - 31; pos += 32)
@@ -828,6 +942,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_sup(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 64, 4, IntHalfbandFilterBlock::ModeLowerHalf,
+                decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16);
+        return;
+    }
+#endif
+
     StorageType buf2[32], buf4[16], buf8[8], buf16[4];
 
     for (int pos = 0; pos < len - 63; pos += 64)
@@ -961,6 +1084,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_inf(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 64, 4, IntHalfbandFilterBlock::ModeUpperHalf,
+                decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16);
+        return;
+    }
+#endif
+
     StorageType buf2[32], buf4[16], buf8[8], buf16[4];
 
     for (int pos = 0; pos < len - 63; pos += 64)
@@ -1094,6 +1226,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_sup(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 128, 5, IntHalfbandFilterBlock::ModeLowerHalf,
+                decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32);
+        return;
+    }
+#endif
+
     StorageType buf2[64], buf4[32], buf8[16], buf16[8], buf32[4];
 
     for (int pos = 0; pos < len - 127; pos += 128)
@@ -1347,6 +1488,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_inf(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 128, 5, IntHalfbandFilterBlock::ModeUpperHalf,
+                decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32);
+        return;
+    }
+#endif
+
     StorageType buf2[64], buf4[32], buf8[16], buf16[8], buf32[4];
 
     for (int pos = 0; pos < len - 127; pos += 128)
@@ -1600,6 +1750,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_sup(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 256, 6, IntHalfbandFilterBlock::ModeLowerHalf,
+                decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64);
+        return;
+    }
+#endif
+
     StorageType buf2[128], buf4[64], buf8[32], buf16[16], buf32[8], buf64[4];
 
     for (int pos = 0; pos < len - 255; pos += 256)
@@ -2093,6 +2252,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_inf(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 256, 6, IntHalfbandFilterBlock::ModeUpperHalf,
+                decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64);
+        return;
+    }
+#endif
+
     StorageType buf2[128], buf4[64], buf8[32], buf16[16], buf32[8], buf64[4];
 
     for (int pos = 0; pos < len - 255; pos += 256)
@@ -2659,6 +2827,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 16, 2, IntHalfbandFilterBlock::ModeCenter,
+                decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4);
+        return;
+    }
+#endif
+
 	StorageType buf2[8], buf4[4];
 
 	for (int pos = 0; pos < len - 15; pos += 16)
@@ -2737,6 +2914,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 16, 3, IntHalfbandFilterBlock::ModeCenter,
+                decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8);
+        return;
+    }
+#endif
+
 	StorageType intbuf[8];
 
 	for (int pos = 0; pos < len - 15; pos += 16)
@@ -2857,6 +3043,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 32, 4, IntHalfbandFilterBlock::ModeCenter,
+                decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16);
+        return;
+    }
+#endif
+
 	StorageType intbuf[16];
 
 	for (int pos = 0; pos < len - 31; pos += 32)
@@ -3075,6 +3270,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_cen(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 64, 5, IntHalfbandFilterBlock::ModeCenter,
+                decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32);
+        return;
+    }
+#endif
+
 	StorageType intbuf[32];
 
 	for (int pos = 0; pos < len - 63; pos += 64)
@@ -3487,6 +3691,15 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_cen(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#ifndef SDR_RX_SAMPLE_24BIT
+    if (m_blockDecimation)
+    {
+        decimateBlock(it, buf, len, 128, 6, IntHalfbandFilterBlock::ModeCenter,
+                decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64);
+        return;
+    }
+#endif
+
 	StorageType intbuf[64];
 
 	for (int pos = 0; pos < len - 127; pos += 128)
@@ -26,6 +26,8 @@
 #include "util/messagequeue.h"
 #include "export.h"
 
+class FileRecord;
+
 namespace SWGSDRangel
 {
     class SWGDeviceSettings;
@@ -87,6 +89,8 @@ public:
             QString& errorMessage)
     { errorMessage = "Not implemented"; return 501; }
 
+    virtual FileRecord *getFileRecord() { return 0; } //!< I/Q recorder of the device if any
+
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
 	virtual void setMessageQueueToGUI(MessageQueue *queue) = 0; // pure virtual so that child classes must have to deal with this
 	MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
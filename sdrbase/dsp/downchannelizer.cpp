@@ -25,8 +25,11 @@
 MESSAGE_CLASS_DEFINITION(DownChannelizer::MsgChannelizerNotification, Message)
 
 DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
+	m_filterStages(new FilterStages()),
+	m_newFilterStages(0),
 	m_sampleSink(sampleSink),
 	m_inputSampleRate(0),
+	m_inputFrequencyOffset(0),
 	m_requestedOutputSampleRate(0),
 	m_requestedCenterFrequency(0),
 	m_currentOutputSampleRate(0),
@@ -38,7 +41,8 @@ DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
 
 DownChannelizer::~DownChannelizer()
 {
-	freeFilterChain();
+	freeFilterChain(m_newFilterStages.fetchAndStoreOrdered(0));
+	freeFilterChain(m_filterStages);
 }
 
 void DownChannelizer::configure(MessageQueue* messageQueue, int sampleRate, int centerFrequency)
@@ -54,39 +58,48 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 		return;
 	}
 
-	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+	FilterStages *newFilterStages = m_newFilterStages.fetchAndStoreAcquire(0);
+
+	if (newFilterStages) // pick up new configuration
+	{
+		freeFilterChain(m_filterStages);
+		m_filterStages = newFilterStages;
+	}
+
+	if (m_filterStages->size() == 0) // optimization when no downsampling is done anyway
 	{
 		m_sampleSink->feed(begin, end, positiveOnly);
 	}
 	else
 	{
-		m_mutex.lock();
+		int nbSamples = end - begin;
 
-		for(SampleVector::const_iterator sample = begin; sample != end; ++sample)
-		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
-
-			for (; stage != m_filterStages.end(); ++stage)
-			{
-				if(!(*stage)->work(&s))
-				{
-					break;
-				}
-			}
-
-			if(stage == m_filterStages.end())
-			{
-			    s.m_real /= (1<<(m_filterStages.size()));
-			    s.m_imag /= (1<<(m_filterStages.size()));
-				m_sampleBuffer.push_back(s);
-			}
+		if (nbSamples <= 0) {
+			return;
 		}
 
-		m_mutex.unlock();
+		if ((int) m_sampleBuffer.size() < nbSamples/2 + 1) {
+			m_sampleBuffer.resize(nbSamples/2 + 1);
+		}
 
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
-		m_sampleBuffer.clear();
+		// first stage reads from input then the next stages work in place in the buffer
+		Sample *buffer = &m_sampleBuffer[0];
+		FilterStages::iterator stage = m_filterStages->begin();
+		nbSamples = (*stage)->work(&(*begin), nbSamples, buffer);
+
+		for (++stage; stage != m_filterStages->end(); ++stage) {
+			nbSamples = (*stage)->work(buffer, nbSamples, buffer);
+		}
+
+		int divisor = 1<<(m_filterStages->size());
+
+		for (int i = 0; i < nbSamples; i++)
+		{
+			buffer[i].m_real /= divisor;
+			buffer[i].m_imag /= divisor;
+		}
+
+		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.begin() + nbSamples, positiveOnly);
 	}
 }
 
@@ -116,6 +129,7 @@ bool DownChannelizer::handleMessage(const Message& cmd)
 	{
 		DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
 		m_inputSampleRate = notif.getSampleRate();
+		m_inputFrequencyOffset = 0;
 		qDebug() << "DownChannelizer::handleMessage: DSPSignalNotification: m_inputSampleRate: " << m_inputSampleRate;
 		applyConfiguration();
 
@@ -128,6 +142,18 @@ bool DownChannelizer::handleMessage(const Message& cmd)
 		emit inputSampleRateChanged();
 		return true;
 	}
+	else if (DSPChannelizerBankNotification::match(cmd))
+	{
+		// input is now a channelizer bank bin: the demod is not notified as for it nothing changes
+		DSPChannelizerBankNotification& notif = (DSPChannelizerBankNotification&) cmd;
+		m_inputSampleRate = notif.getSampleRate();
+		m_inputFrequencyOffset = notif.getFrequencyOffset();
+		qDebug() << "DownChannelizer::handleMessage: DSPChannelizerBankNotification:"
+				<< " m_inputSampleRate: " << m_inputSampleRate
+				<< " m_inputFrequencyOffset: " << m_inputFrequencyOffset;
+		applyConfiguration();
+		return true;
+	}
 	else if (DSPConfigureChannelizer::match(cmd))
 	{
 		DSPConfigureChannelizer& chan = (DSPConfigureChannelizer&) cmd;
@@ -164,18 +190,24 @@ void DownChannelizer::applyConfiguration()
 
 	m_mutex.lock();
 
-	freeFilterChain();
+	FilterStages *filterStages = new FilterStages();
 
-	m_currentCenterFrequency = createFilterChain(
+	// requested center is relative to the device center and input may be offset by a channelizer bank bin
+	int requestedCenterFrequency = m_requestedCenterFrequency - m_inputFrequencyOffset;
+
+	m_currentCenterFrequency = createFilterChain(*filterStages,
 		m_inputSampleRate / -2, m_inputSampleRate / 2,
-		m_requestedCenterFrequency - m_requestedOutputSampleRate / 2, m_requestedCenterFrequency + m_requestedOutputSampleRate / 2);
+		requestedCenterFrequency - m_requestedOutputSampleRate / 2, requestedCenterFrequency + m_requestedOutputSampleRate / 2);
+
+	m_currentOutputSampleRate = m_inputSampleRate / (1 << filterStages->size());
+
+	// publish new chain. If the previous one was not picked up by feed yet it is discarded.
+	freeFilterChain(m_newFilterStages.fetchAndStoreOrdered(filterStages));
 
 	m_mutex.unlock();
 
 	//debugFilterChain();
 
-	m_currentOutputSampleRate = m_inputSampleRate / (1 << m_filterStages.size());
-
 	qDebug() << "DownChannelizer::applyConfiguration in=" << m_inputSampleRate
 			<< ", req=" << m_requestedOutputSampleRate
 			<< ", out=" << m_currentOutputSampleRate
@@ -191,44 +223,20 @@ void DownChannelizer::applyConfiguration()
 #ifdef SDR_RX_SAMPLE_24BIT
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0),
     m_mode(mode),
-    m_sse(true)
+    m_sse(false)
 {
-    switch(mode) {
-        case ModeCenter:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
-            break;
-
-        case ModeLowerHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
-            break;
-
-        case ModeUpperHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
-            break;
-    }
 }
 #else
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0),
     m_mode(mode),
+#if defined(USE_SSE4_1) && !defined(NO_DSP_SIMD)
     m_sse(true)
+#else
+    m_sse(false)
+#endif
 {
-    switch(mode) {
-        case ModeCenter:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
-            break;
-
-        case ModeLowerHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
-            break;
-
-        case ModeUpperHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
-            break;
-    }
 }
 #endif
 
@@ -247,7 +255,7 @@ bool DownChannelizer::signalContainsChannel(Real sigStart, Real sigEnd, Real cha
 	return (sigStart <= chanStart) && (sigEnd >= chanEnd);
 }
 
-Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd)
+Real DownChannelizer::createFilterChain(FilterStages& filterStages, Real sigStart, Real sigEnd, Real chanStart, Real chanEnd)
 {
 	Real sigBw = sigEnd - sigStart;
 	Real safetyMargin = sigBw / 20;
@@ -261,24 +269,24 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	// check if it fits into the left half
 	if(signalContainsChannel(sigStart + safetyMargin, sigStart + sigBw / 2.0 - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take left half (rotate by +1/4 and decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeLowerHalf));
-		return createFilterChain(sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd);
+		filterStages.push_back(new FilterStage(FilterStage::ModeLowerHalf));
+		return createFilterChain(filterStages, sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd);
 	}
 
 	// check if it fits into the right half
 	if(signalContainsChannel(sigEnd - sigBw / 2.0f + safetyMargin, sigEnd - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take right half (rotate by -1/4 and decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeUpperHalf));
-		return createFilterChain(sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd);
+		filterStages.push_back(new FilterStage(FilterStage::ModeUpperHalf));
+		return createFilterChain(filterStages, sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd);
 	}
 
 	// check if it fits into the center
 	// Was: if(signalContainsChannel(sigStart + rot + safetyMargin, sigStart + rot + sigBw / 2.0f - safetyMargin, chanStart, chanEnd)) {
 	if(signalContainsChannel(sigStart + rot + safetyMargin, sigEnd - rot - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take center half (decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeCenter));
+		filterStages.push_back(new FilterStage(FilterStage::ModeCenter));
 		// Was: return createFilterChain(sigStart + rot, sigStart + sigBw / 2.0f + rot, chanStart, chanEnd);
-		return createFilterChain(sigStart + rot, sigEnd - rot, chanStart, chanEnd);
+		return createFilterChain(filterStages, sigStart + rot, sigEnd - rot, chanStart, chanEnd);
 	}
 #endif
 	Real ofs = ((chanEnd - chanStart) / 2.0 + chanStart) - ((sigEnd - sigStart) / 2.0 + sigStart);
@@ -286,18 +294,23 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	return ofs;
 }
 
-void DownChannelizer::freeFilterChain()
+void DownChannelizer::freeFilterChain(FilterStages *filterStages)
 {
-	for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
+	if (filterStages == 0) {
+		return;
+	}
+
+	for(FilterStages::iterator it = filterStages->begin(); it != filterStages->end(); ++it)
 		delete *it;
-	m_filterStages.clear();
+
+	delete filterStages;
 }
 
 void DownChannelizer::debugFilterChain()
 {
-    qDebug("DownChannelizer::debugFilterChain: %lu stages", m_filterStages.size());
+    qDebug("DownChannelizer::debugFilterChain: %lu stages", m_filterStages->size());
 
-    for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
+    for(FilterStages::iterator it = m_filterStages->begin(); it != m_filterStages->end(); ++it)
     {
         switch ((*it)->m_mode)
         {
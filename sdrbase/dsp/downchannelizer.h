@@ -19,8 +19,9 @@
 #define SDRBASE_DSP_DOWNCHANNELIZER_H
 
 #include <dsp/basebandsamplesink.h>
-#include <list>
+#include <vector>
 #include <QMutex>
+#include <QAtomicPointer>
 #include "export.h"
 #include "util/message.h"
 #include "dsp/inthalfbandfiltereo.h"
@@ -76,40 +77,49 @@ protected:
 		};
 
 #ifdef SDR_RX_SAMPLE_24BIT
-        typedef bool (IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
         IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #else
-        typedef bool (IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
         IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #endif
 
-		WorkFunction m_workFunction;
 		Mode m_mode;
 		bool m_sse;
 
 		FilterStage(Mode mode);
 		~FilterStage();
 
-		bool work(Sample* sample)
+		/** Decimate a block by 2. Can work in place (out == in). Returns the number of output samples */
+		int work(const Sample* in, int nbIn, Sample* out)
 		{
-			return (m_filter->*m_workFunction)(sample);
+			switch (m_mode)
+			{
+			case ModeLowerHalf:
+				return m_filter->workDecimateLowerHalfBlock(in, nbIn, out);
+			case ModeUpperHalf:
+				return m_filter->workDecimateUpperHalfBlock(in, nbIn, out);
+			case ModeCenter:
+			default:
+				return m_filter->workDecimateCenterBlock(in, nbIn, out);
+			}
 		}
 	};
-	typedef std::list<FilterStage*> FilterStages;
-	FilterStages m_filterStages;
+	typedef std::vector<FilterStage*> FilterStages;
+	FilterStages *m_filterStages;                  //!< chain in use by feed (feeding thread only)
+	QAtomicPointer<FilterStages> m_newFilterStages; //!< chain published by configuration and picked up by next feed
 	BasebandSampleSink* m_sampleSink; //!< Demodulator
 	int m_inputSampleRate;
+	qint64 m_inputFrequencyOffset; //!< center of input relative to device center when fed by a channelizer bank
 	int m_requestedOutputSampleRate;
 	int m_requestedCenterFrequency;
 	int m_currentOutputSampleRate;
 	int m_currentCenterFrequency;
 	SampleVector m_sampleBuffer;
-	QMutex m_mutex;
+	QMutex m_mutex; //!< serializes configuration changes
 
 	void applyConfiguration();
 	bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
-	Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
-	void freeFilterChain();
+	Real createFilterChain(FilterStages& filterStages, Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
+	static void freeFilterChain(FilterStages *filterStages);
 	void debugFilterChain();
 
 signals:
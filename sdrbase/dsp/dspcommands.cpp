@@ -46,4 +46,7 @@ MESSAGE_CLASS_DEFINITION(DSPEngineReport, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureScopeVis, Message)
 MESSAGE_CLASS_DEFINITION(DSPSignalNotification, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureChannelizer, Message)
+MESSAGE_CLASS_DEFINITION(DSPChannelizerBankNotification, Message)
+MESSAGE_CLASS_DEFINITION(DSPConfigureChannelizerBank, Message)
+MESSAGE_CLASS_DEFINITION(DSPSetChannelizerBankSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureAudio, Message)
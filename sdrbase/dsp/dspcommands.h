@@ -371,6 +371,63 @@ private:
 	int m_centerFrequency;
 };
 
+class SDRBASE_API DSPChannelizerBankNotification : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPChannelizerBankNotification(int sampleRate, qint64 frequencyOffset) :
+		Message(),
+		m_sampleRate(sampleRate),
+		m_frequencyOffset(frequencyOffset)
+	{ }
+
+	int getSampleRate() const { return m_sampleRate; }
+	qint64 getFrequencyOffset() const { return m_frequencyOffset; } //!< center of the bin relative to device center
+
+private:
+	int m_sampleRate;
+	qint64 m_frequencyOffset;
+};
+
+class SDRBASE_API DSPConfigureChannelizerBank : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPConfigureChannelizerBank(int channelSpacing) :
+		Message(),
+		m_channelSpacing(channelSpacing)
+	{ }
+
+	int getChannelSpacing() const { return m_channelSpacing; }
+
+private:
+	int m_channelSpacing;
+};
+
+class SDRBASE_API DSPSetChannelizerBankSink : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPSetChannelizerBankSink(ThreadedBasebandSampleSink* threadedSampleSink, qint64 frequencyOffset, int bandwidth, int sampleRate) :
+		Message(),
+		m_threadedSampleSink(threadedSampleSink),
+		m_frequencyOffset(frequencyOffset),
+		m_bandwidth(bandwidth),
+		m_sampleRate(sampleRate)
+	{ }
+
+	ThreadedBasebandSampleSink* getThreadedSampleSink() const { return m_threadedSampleSink; }
+	qint64 getFrequencyOffset() const { return m_frequencyOffset; }
+	int getBandwidth() const { return m_bandwidth; }
+	int getSampleRate() const { return m_sampleRate; }
+
+private:
+	ThreadedBasebandSampleSink* m_threadedSampleSink;
+	qint64 m_frequencyOffset;
+	int m_bandwidth;
+	int m_sampleRate;
+};
+
 class SDRBASE_API DSPConfigureAudio : public Message {
     MESSAGE_CLASS_DECLARATION
 
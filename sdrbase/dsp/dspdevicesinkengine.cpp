@@ -26,6 +26,7 @@
 #include "dsp/devicesamplesink.h"
 #include "dsp/dspcommands.h"
 #include "samplesourcefifo.h"
+#include "samplesourcemixer.h"
 #include "threadedbasebandsamplesource.h"
 
 DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
@@ -38,7 +39,7 @@ DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 	m_spectrumSink(0),
 	m_sampleRate(0),
 	m_centerFrequency(0),
-	m_multipleSourcesDivisionFactor(1)
+	m_multipleSourcesDivisionLog2(0)
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
@@ -175,12 +176,10 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
 	// multiple channel sources handling
 	if ((m_threadedBasebandSampleSources.size() + m_basebandSampleSources.size()) > 1)
 	{
-//	    qDebug("DSPDeviceSinkEngine::work: multiple channel sources handling: %u", m_multipleSourcesDivisionFactor);
+//	    qDebug("DSPDeviceSinkEngine::work: multiple channel sources handling: %u", m_multipleSourcesDivisionLog2);
 
-	    SampleVector::iterator writeBegin;
+	    SampleVector::iterator writeAt;
 	    SampleSourceFifo* sampleFifo = m_deviceSampleSink->getSampleFifo();
-	    sampleFifo->getWriteIterator(writeBegin);
-	    SampleVector::iterator writeAt = writeBegin;
 	    std::vector<SampleVector::iterator> sampleSourceIterators;
 
 	    for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
@@ -197,24 +196,28 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
             sampleSourceIterators.back() -= nbWriteSamples;
 	    }
 
-	    for (int is = 0; is < nbWriteSamples; is++)
-		{
-			// pull data from sources FIFOs and merge them in the device sample FIFO
+	    // merge the sources FIFOs data in the device sample FIFO by contiguous blocks
+	    unsigned int remainder = nbWriteSamples;
+
+	    while (remainder > 0)
+	    {
+	        unsigned int chunkSize = remainder;
+	        sampleFifo->getWriteIterator(writeAt, chunkSize);
+
 	        for (std::vector<SampleVector::iterator>::iterator it = sampleSourceIterators.begin(); it != sampleSourceIterators.end(); ++it)
 	        {
-	            Sample s = (**it);
-	            s /= m_multipleSourcesDivisionFactor;
-	            ++(*it);
-
 	            if (it == sampleSourceIterators.begin()) {
-	                (*writeAt) = s;
+	                SampleSourceMixer::copy(&(**it), &(*writeAt), chunkSize, m_multipleSourcesDivisionLog2);
 	            } else {
-	                (*writeAt) += s;
+	                SampleSourceMixer::mix(&(**it), &(*writeAt), chunkSize, m_multipleSourcesDivisionLog2);
 	            }
+
+	            (*it) += chunkSize;
 	        }
 
-			sampleFifo->bumpIndex(writeAt);
-		}
+	        sampleFifo->bumpIndex(writeAt, chunkSize);
+	        remainder -= chunkSize;
+	    }
 	}
 }
 
@@ -595,7 +598,7 @@ void DSPDeviceSinkEngine::checkNumberOfBasebandSources()
             m_threadedBasebandSampleSources.back()->setDeviceSampleSourceFifo(sampleFifo);
         }
 
-        m_multipleSourcesDivisionFactor = 1; // for consistency but it is not used in this case
+        m_multipleSourcesDivisionLog2 = 0; // for consistency but it is not used in this case
     }
     // null or multiple channel sources handling
     else
@@ -615,11 +618,11 @@ void DSPDeviceSinkEngine::checkNumberOfBasebandSources()
         }
 
         if (nbSources == 0) {
-            m_multipleSourcesDivisionFactor = 1;
+            m_multipleSourcesDivisionLog2 = 0;
         } else if (nbSources < 3) {
-            m_multipleSourcesDivisionFactor = nbSources;
+            m_multipleSourcesDivisionLog2 = nbSources - 1; // divide by 1 or 2
         } else {
-            m_multipleSourcesDivisionFactor = 1<<nbSources;
+            m_multipleSourcesDivisionLog2 = nbSources;     // divide by 2^nbSources
         }
 
         if (nbSources > 1) {
@@ -21,10 +21,12 @@
 #include <dsp/devicesamplesource.h>
 #include <dsp/downchannelizer.h>
 #include <stdio.h>
+#include <algorithm>
 #include <QDebug>
 #include "dsp/dspcommands.h"
 #include "util/fixed.h"
 #include "samplesinkfifo.h"
+#include "sampleblock.h"
 #include "threadedbasebandsamplesink.h"
 
 DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
@@ -34,6 +36,8 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_deviceSampleSource(0),
 	m_sampleSourceSequence(0),
 	m_basebandSampleSinks(),
+	m_channelizerBankSpacing(0),
+	m_nbChannelizerBankSinksFed(0),
 	m_sampleRate(0),
 	m_centerFrequency(0),
 	m_dcOffsetCorrection(false),
@@ -156,6 +160,21 @@ void DSPDeviceSourceEngine::configureCorrections(bool dcOffsetCorrection, bool i
 	m_inputMessageQueue.push(cmd);
 }
 
+void DSPDeviceSourceEngine::configureChannelizerBank(int channelSpacing)
+{
+	qDebug() << "DSPDeviceSourceEngine::configureChannelizerBank: " << channelSpacing;
+	DSPConfigureChannelizerBank* cmd = new DSPConfigureChannelizerBank(channelSpacing);
+	m_inputMessageQueue.push(cmd);
+}
+
+void DSPDeviceSourceEngine::setChannelizerBankSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate)
+{
+	qDebug() << "DSPDeviceSourceEngine::setChannelizerBankSink: " << sink->getSampleSinkObjectName().toStdString().c_str()
+			<< " offset: " << frequencyOffset << " bandwidth: " << bandwidth << " sampleRate: " << sampleRate;
+	DSPSetChannelizerBankSink* cmd = new DSPSetChannelizerBankSink(sink, frequencyOffset, bandwidth, sampleRate);
+	m_inputMessageQueue.push(cmd); // asynchronous as channels call it from their own thread
+}
+
 QString DSPDeviceSourceEngine::errorMessage()
 {
 	qDebug() << "DSPDeviceSourceEngine::errorMessage";
@@ -328,7 +347,7 @@ void DSPDeviceSourceEngine::work()
 	std::size_t samplesDone = 0;
 	bool positiveOnly = false;
 
-	while ((sampleFifo->fill() > 0) && (m_inputMessageQueue.size() == 0) && (samplesDone < m_sampleRate))
+	while ((sampleFifo->fill() > 0) && m_inputMessageQueue.isEmpty() && (samplesDone < m_sampleRate))
 	{
 		SampleVector::iterator part1begin;
 		SampleVector::iterator part1end;
@@ -363,10 +382,7 @@ void DSPDeviceSourceEngine::work()
 			}
 
 			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
-			{
-				(*it)->feed(part1begin, part1end, positiveOnly);
-			}
+			feedThreadedSinks(part1begin, part1end, positiveOnly);
 		}
 
 		// second part of FIFO data (used when block wraps around)
@@ -395,10 +411,7 @@ void DSPDeviceSourceEngine::work()
 			}
 
 			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
-			{
-				(*it)->feed(part2begin, part2end, positiveOnly);
-			}
+			feedThreadedSinks(part2begin, part2end, positiveOnly);
 		}
 
 		// adjust FIFO pointers
@@ -407,6 +420,161 @@ void DSPDeviceSourceEngine::work()
 	}
 }
 
+void DSPDeviceSourceEngine::feedThreadedSinks(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly __attribute__((unused)))
+{
+	if (m_threadedBasebandSampleSinks.size() == 0) {
+		return;
+	}
+
+	// samples are copied once in a shared block and each sink thread gets a reference to it
+	SampleBlock *block = 0;
+
+	for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+	{
+		if (m_nbChannelizerBankSinksFed > 0)
+		{
+			// sinks served by the bank are fed below
+			ChannelizerBankSinks::const_iterator bankIt = m_channelizerBankSinks.find(*it);
+
+			if ((bankIt != m_channelizerBankSinks.end()) && (bankIt->second.m_bin >= 0)) {
+				continue;
+			}
+		}
+
+		if (block == 0) {
+			block = SampleBlockPool::instance()->allocate(begin, end);
+		}
+
+		(*it)->feed(block);
+	}
+
+	if (block) {
+		block->unref();
+	}
+
+	if (m_nbChannelizerBankSinksFed == 0) {
+		return;
+	}
+
+	// a single filter bank pass serves all the other sinks
+	m_channelizerBank.feed(begin, end);
+	m_channelizerBankBlocks.assign(m_channelizerBank.getNbChannels(), (SampleBlock*) 0);
+
+	for (ChannelizerBankSinks::const_iterator it = m_channelizerBankSinks.begin(); it != m_channelizerBankSinks.end(); ++it)
+	{
+		int bin = it->second.m_bin;
+
+		if (bin >= 0)
+		{
+			const SampleVector& binSamples = m_channelizerBank.getBinSamples(bin);
+
+			if (binSamples.size() == 0) {
+				continue;
+			}
+
+			if (m_channelizerBankBlocks[bin] == 0) { // sinks on the same bin share the block
+				m_channelizerBankBlocks[bin] = SampleBlockPool::instance()->allocate(binSamples.begin(), binSamples.end());
+			}
+
+			it->first->feed(m_channelizerBankBlocks[bin]);
+		}
+	}
+
+	for (std::vector<SampleBlock*>::iterator it = m_channelizerBankBlocks.begin(); it != m_channelizerBankBlocks.end(); ++it)
+	{
+		if (*it) {
+			(*it)->unref();
+		}
+	}
+
+	m_channelizerBank.clearOutputs();
+}
+
+void DSPDeviceSourceEngine::applyChannelizerBank()
+{
+	int nbChannels = 0;
+
+	if ((m_channelizerBankSpacing > 0) && (m_sampleRate > 0) && ((int) m_sampleRate % m_channelizerBankSpacing == 0)) {
+		nbChannels = (int) m_sampleRate / m_channelizerBankSpacing;
+	}
+
+	if ((nbChannels < 4) || (nbChannels % 2 != 0)) {
+		nbChannels = 0;
+	}
+
+	qDebug() << "DSPDeviceSourceEngine::applyChannelizerBank:"
+			<< " spacing: " << m_channelizerBankSpacing
+			<< " sampleRate: " << m_sampleRate
+			<< " nbChannels: " << nbChannels;
+
+	if (nbChannels != m_channelizerBank.getNbChannels()) {
+		m_channelizerBank.configure(nbChannels);
+	}
+
+	for (ChannelizerBankSinks::iterator it = m_channelizerBankSinks.begin(); it != m_channelizerBankSinks.end(); ++it)
+	{
+		it->second.m_bin = -2; // force notification of new input rate
+		applyChannelizerBankSink(it->first, it->second);
+	}
+}
+
+void DSPDeviceSourceEngine::applyChannelizerBankSink(ThreadedBasebandSampleSink* sink, ChannelizerBankSink& bankSink)
+{
+	int bin = -1;
+
+	if (m_channelizerBank.isEnabled())
+	{
+		bin = PolyphaseChannelizer::getBinIndex(bankSink.m_frequencyOffset, bankSink.m_bandwidth,
+			m_sampleRate, m_channelizerBank.getNbChannels());
+
+		// the sink channelizer can only decimate so a bin slower than its output keeps it on the full band
+		if ((int) m_sampleRate / m_channelizerBank.getDecimation() < bankSink.m_sampleRate) {
+			bin = -1;
+		}
+	}
+
+	if (bin == bankSink.m_bin) {
+		return;
+	}
+
+	bankSink.m_bin = bin;
+
+	if (bin >= 0)
+	{
+		int binSampleRate = (int) m_sampleRate / m_channelizerBank.getDecimation();
+		qint64 binOffset = (bin < m_channelizerBank.getNbChannels() / 2 ? bin : bin - m_channelizerBank.getNbChannels())
+			* (qint64) m_channelizerBankSpacing;
+		DSPChannelizerBankNotification notif(binSampleRate, binOffset);
+		sink->handleSinkMessage(notif);
+	}
+	else
+	{
+		DSPSignalNotification notif(m_sampleRate, m_centerFrequency);
+		sink->handleSinkMessage(notif);
+	}
+
+	updateChannelizerBankBins();
+
+	qDebug() << "DSPDeviceSourceEngine::applyChannelizerBankSink: " << sink->getSampleSinkObjectName().toStdString().c_str()
+			<< " bin: " << bin
+			<< " sinks fed by bank: " << m_nbChannelizerBankSinksFed;
+}
+
+void DSPDeviceSourceEngine::updateChannelizerBankBins()
+{
+	m_channelizerBank.clearActiveBins();
+	m_nbChannelizerBankSinksFed = 0;
+
+	for (ChannelizerBankSinks::const_iterator it = m_channelizerBankSinks.begin(); it != m_channelizerBankSinks.end(); ++it)
+	{
+		if (it->second.m_bin >= 0)
+		{
+			m_channelizerBank.setBinActive(it->second.m_bin, true);
+			m_nbChannelizerBankSinksFed++;
+		}
+	}
+}
+
 // notStarted -> idle -> init -> running -+
 //                ^                       |
 //                +-----------------------+
@@ -504,6 +672,8 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoInit()
 		(*it)->handleSinkMessage(notif);
 	}
 
+	applyChannelizerBank();
+
 	// pass data to listeners
 	if (m_deviceSampleSource->getMessageQueueToGUI())
 	{
@@ -542,6 +712,8 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoRunning()
 
 	// Start everything
 
+	m_deviceSampleSource->getSampleFifo()->handleDataReady(); // a signal may have been lost while not running
+
 	if(!m_deviceSampleSource->start())
 	{
 		return gotoError("Could not start sample source");
@@ -598,6 +770,10 @@ void DSPDeviceSourceEngine::handleSetSource(DeviceSampleSource* source)
 
 void DSPDeviceSourceEngine::handleData()
 {
+	if (m_deviceSampleSource) {
+		m_deviceSampleSource->getSampleFifo()->handleDataReady();
+	}
+
 	if(m_state == StRunning)
 	{
 		work();
@@ -677,6 +853,13 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 		ThreadedBasebandSampleSink* threadedSink = ((DSPRemoveThreadedBasebandSampleSink*) message)->getThreadedSampleSink();
 		threadedSink->stop();
 		m_threadedBasebandSampleSinks.remove(threadedSink);
+		ChannelizerBankSinks::iterator bankIt = m_channelizerBankSinks.find(threadedSink);
+
+		if (bankIt != m_channelizerBankSinks.end())
+		{
+			m_channelizerBankSinks.erase(bankIt);
+			updateChannelizerBankBins();
+		}
 	}
 
 	m_syncMessenger.done(m_state);
@@ -760,6 +943,33 @@ void DSPDeviceSourceEngine::handleInputMessages()
 
 			//m_outputMessageQueue.push(rep);
 
+			applyChannelizerBank();
+
+			delete message;
+		}
+		else if (DSPConfigureChannelizerBank::match(*message))
+		{
+			DSPConfigureChannelizerBank *conf = (DSPConfigureChannelizerBank*) message;
+			m_channelizerBankSpacing = conf->getChannelSpacing();
+			applyChannelizerBank();
+
+			delete message;
+		}
+		else if (DSPSetChannelizerBankSink::match(*message))
+		{
+			DSPSetChannelizerBankSink *cmd = (DSPSetChannelizerBankSink*) message;
+			ThreadedBasebandSampleSink *sink = cmd->getThreadedSampleSink();
+
+			// the sink may have been removed since the message was posted
+			if (std::find(m_threadedBasebandSampleSinks.begin(), m_threadedBasebandSampleSinks.end(), sink) != m_threadedBasebandSampleSinks.end())
+			{
+				ChannelizerBankSink& bankSink = m_channelizerBankSinks[sink];
+				bankSink.m_frequencyOffset = cmd->getFrequencyOffset();
+				bankSink.m_bandwidth = cmd->getBandwidth();
+				bankSink.m_sampleRate = cmd->getSampleRate();
+				applyChannelizerBankSink(sink, bankSink);
+			}
+
 			delete message;
 		}
 	}
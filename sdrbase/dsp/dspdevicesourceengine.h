@@ -22,8 +22,10 @@
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <map>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
+#include "dsp/polyphasechannelizer.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "export.h"
@@ -32,6 +34,7 @@
 class DeviceSampleSource;
 class BasebandSampleSink;
 class ThreadedBasebandSampleSink;
+class SampleBlock;
 
 class SDRBASE_API DSPDeviceSourceEngine : public QThread {
 	Q_OBJECT
@@ -70,6 +73,8 @@ public:
 	void removeThreadedSink(ThreadedBasebandSampleSink* sink); //!< Remove a sample sink that runs on its own thread
 
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
+	void configureChannelizerBank(int channelSpacing); //!< Set channelizer bank spacing in Hz (0 to disable)
+	void setChannelizerBankSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset, int bandwidth, int sampleRate); //!< Declare a threaded sink channel for the channelizer bank (asynchronous)
 
 	State state() const { return m_state; } //!< Return DSP engine current state
 
@@ -96,6 +101,23 @@ private:
 	typedef std::list<ThreadedBasebandSampleSink*> ThreadedBasebandSampleSinks;
 	ThreadedBasebandSampleSinks m_threadedBasebandSampleSinks; //!< sample sinks on their own threads (usually channels)
 
+	struct ChannelizerBankSink
+	{
+		qint64 m_frequencyOffset; //!< channel center relative to device center
+		int m_bandwidth;          //!< channel bandwidth
+		int m_sampleRate;         //!< sample rate requested by the sink channelizer. The bin rate must be at least this as it cannot upsample
+		int m_bin;                //!< bank bin feeding the sink or -1 if fed with full band
+
+		ChannelizerBankSink() : m_frequencyOffset(0), m_bandwidth(0), m_sampleRate(0), m_bin(-1) {}
+	};
+
+	typedef std::map<ThreadedBasebandSampleSink*, ChannelizerBankSink> ChannelizerBankSinks;
+	ChannelizerBankSinks m_channelizerBankSinks; //!< threaded sinks candidate to be fed by the channelizer bank
+	PolyphaseChannelizer m_channelizerBank;
+	int m_channelizerBankSpacing;
+	int m_nbChannelizerBankSinksFed; //!< number of threaded sinks currently fed by the bank
+	std::vector<SampleBlock*> m_channelizerBankBlocks; //!< blocks published for each bin in the current pass
+
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
 
@@ -135,6 +157,10 @@ private:
 	void dcOffset(SampleVector::iterator begin, SampleVector::iterator end);
 	void imbalance(SampleVector::iterator begin, SampleVector::iterator end);
 	void work(); //!< transfer samples from source to sinks if in running state
+	void feedThreadedSinks(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly);
+	void applyChannelizerBank(); //!< (re)assign threaded sinks to bank bins after sample rate or spacing change
+	void applyChannelizerBankSink(ThreadedBasebandSampleSink* sink, ChannelizerBankSink& bankSink);
+	void updateChannelizerBankBins(); //!< recompute active bins from sinks assignment
 
 	State gotoIdle();     //!< Go to the idle state
 	State gotoInit();     //!< Go to the acquisition init state from idle
@@ -21,13 +21,19 @@
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/dspworkerpool.h"
 
 
 DSPEngine::DSPEngine() :
     m_deviceSourceEnginesUIDSequence(0),
     m_deviceSinkEnginesUIDSequence(0),
     m_audioInputDeviceIndex(-1),    // default device
-    m_audioOutputDeviceIndex(-1)    // default device
+    m_audioOutputDeviceIndex(-1),   // default device
+    m_channelizerBankSpacing(0),
+    m_channelWorkerPool(0),
+    m_spectrumFrameRate(0),
+    m_recordDirectIO(false),
+    m_recordPreallocation(0)
 {
 	m_dvSerialSupport = false;
     m_masterTimer.start(50);
@@ -42,6 +48,21 @@ DSPEngine::~DSPEngine()
         delete *it;
         ++it;
     }
+
+    delete m_channelWorkerPool;
+}
+
+void DSPEngine::setChannelWorkerPoolSize(int nbWorkers)
+{
+    if (m_channelWorkerPool)
+    {
+        qWarning("DSPEngine::setChannelWorkerPoolSize: pool already created with %d workers", m_channelWorkerPool->getNbWorkers());
+        return;
+    }
+
+    if (nbWorkers > 0) {
+        m_channelWorkerPool = new DSPWorkerPool(nbWorkers);
+    }
 }
 
 Q_GLOBAL_STATIC(DSPEngine, dspEngine)
@@ -54,6 +75,11 @@ DSPDeviceSourceEngine *DSPEngine::addDeviceSourceEngine()
 {
     m_deviceSourceEngines.push_back(new DSPDeviceSourceEngine(m_deviceSourceEnginesUIDSequence));
     m_deviceSourceEnginesUIDSequence++;
+
+    if (m_channelizerBankSpacing > 0) {
+        m_deviceSourceEngines.back()->configureChannelizerBank(m_channelizerBankSpacing);
+    }
+
     return m_deviceSourceEngines.back();
 }
 
@@ -32,6 +32,7 @@
 
 class DSPDeviceSourceEngine;
 class DSPDeviceSinkEngine;
+class DSPWorkerPool;
 
 class SDRBASE_API DSPEngine : public QObject {
 	Q_OBJECT
@@ -73,6 +74,20 @@ public:
 
     const QTimer& getMasterTimer() const { return m_masterTimer; }
 
+    void setChannelizerBankSpacing(int channelSpacing) { m_channelizerBankSpacing = channelSpacing; } //!< Applies to device source engines added afterwards
+    int getChannelizerBankSpacing() const { return m_channelizerBankSpacing; }
+
+    void setChannelWorkerPoolSize(int nbWorkers); //!< 0 for a thread per channel. Must be set before channels are created.
+    DSPWorkerPool *getChannelWorkerPool() { return m_channelWorkerPool; } //!< null when running a thread per channel
+
+    void setSpectrumFrameRate(int frameRate) { m_spectrumFrameRate = frameRate; } //!< Applies to spectrum visualizations created afterwards
+    int getSpectrumFrameRate() const { return m_spectrumFrameRate; }
+
+    void setRecordDirectIO(bool directIO) { m_recordDirectIO = directIO; } //!< Applies to I/Q recordings started afterwards
+    bool getRecordDirectIO() const { return m_recordDirectIO; }
+    void setRecordPreallocation(quint64 bytes) { m_recordPreallocation = bytes; } //!< Applies to I/Q recordings started afterwards
+    quint64 getRecordPreallocation() const { return m_recordPreallocation; }
+
 private:
 	std::vector<DSPDeviceSourceEngine*> m_deviceSourceEngines;
 	uint m_deviceSourceEnginesUIDSequence;
@@ -82,6 +97,11 @@ private:
     int m_audioInputDeviceIndex;
     int m_audioOutputDeviceIndex;
     QTimer m_masterTimer;
+    int m_channelizerBankSpacing; //!< Rx channelizer bank channel spacing (Hz) or 0 if disabled
+    DSPWorkerPool *m_channelWorkerPool;
+    int m_spectrumFrameRate; //!< maximum spectrum frames per second or 0 for no limit
+    bool m_recordDirectIO; //!< I/Q recordings bypass the page cache
+    quint64 m_recordPreallocation; //!< I/Q recordings file space reserved up front (bytes)
 	bool m_dvSerialSupport;
 #ifdef DSD_USE_SERIALDV
 	DVSerialEngine m_dvSerialEngine;
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dspworkerpool.h"
+
+DSPWorkerPool::Worker::Worker(DSPWorkerPool *pool, int index) :
+    m_pool(pool),
+    m_index(index)
+{
+}
+
+void DSPWorkerPool::Worker::run()
+{
+    while (true)
+    {
+        Task *task = m_pool->getTask(m_index);
+
+        if (task)
+        {
+            task->run();
+            continue;
+        }
+
+        m_pool->m_idleMutex.lock();
+
+        if (m_pool->m_stop)
+        {
+            m_pool->m_idleMutex.unlock();
+            break;
+        }
+
+        if (m_pool->m_nbPendingTasks.load() == 0) {
+            m_pool->m_taskAvailable.wait(&m_pool->m_idleMutex);
+        }
+
+        m_pool->m_idleMutex.unlock();
+    }
+}
+
+DSPWorkerPool::DSPWorkerPool(int nbWorkers) :
+    m_nextWorker(0),
+    m_nbPendingTasks(0),
+    m_stop(false)
+{
+    if (nbWorkers < 1) {
+        nbWorkers = 1;
+    }
+
+    qDebug("DSPWorkerPool::DSPWorkerPool: %d workers", nbWorkers);
+
+    m_eventThread.setObjectName("DSPWorkerPool events");
+    m_eventThread.start();
+
+    for (int i = 0; i < nbWorkers; i++)
+    {
+        m_workers.push_back(new Worker(this, i));
+        m_workers.back()->start(QThread::HighPriority);
+    }
+}
+
+DSPWorkerPool::~DSPWorkerPool()
+{
+    m_idleMutex.lock();
+    m_stop = true;
+    m_taskAvailable.wakeAll();
+    m_idleMutex.unlock();
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_eventThread.exit();
+    m_eventThread.wait();
+}
+
+void DSPWorkerPool::submit(Task *task)
+{
+    Worker *worker = 0;
+    QThread *currentThread = QThread::currentThread();
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        if (*it == currentThread) // keep continuation on the same worker (cache)
+        {
+            worker = *it;
+            break;
+        }
+    }
+
+    if (worker == 0) {
+        worker = m_workers[((unsigned int) m_nextWorker.fetchAndAddRelaxed(1)) % m_workers.size()];
+    }
+
+    worker->m_mutex.lock();
+    worker->m_tasks.push_back(task);
+    worker->m_mutex.unlock();
+
+    m_nbPendingTasks.ref();
+    m_idleMutex.lock();
+    m_taskAvailable.wakeOne();
+    m_idleMutex.unlock();
+}
+
+DSPWorkerPool::Task *DSPWorkerPool::getTask(int workerIndex)
+{
+    int nbWorkers = m_workers.size();
+
+    for (int i = 0; i < nbWorkers; i++)
+    {
+        Worker *worker = m_workers[(workerIndex + i) % nbWorkers];
+        Task *task = 0;
+        worker->m_mutex.lock();
+
+        if (worker->m_tasks.size() > 0)
+        {
+            if (i == 0) // own deque
+            {
+                task = worker->m_tasks.front();
+                worker->m_tasks.pop_front();
+            }
+            else // steal
+            {
+                task = worker->m_tasks.back();
+                worker->m_tasks.pop_back();
+            }
+        }
+
+        worker->m_mutex.unlock();
+
+        if (task)
+        {
+            m_nbPendingTasks.deref();
+            return task;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DSPWORKERPOOL_H_
+#define SDRBASE_DSP_DSPWORKERPOOL_H_
+
+#include <deque>
+#include <vector>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+
+#include "export.h"
+
+/**
+ * Fixed size pool of DSP worker threads with work stealing used to run channel sinks
+ * instead of a thread per channel. Each worker has its own task deque: tasks submitted by
+ * a worker go to its own deque and the other ones are dispatched round robin. A worker
+ * takes tasks from the front of its deque and when empty steals from the back of the
+ * other workers' deques.
+ *
+ * A task is never queued twice at the same time (the submitter is responsible for this,
+ * see ThreadedBasebandSampleSinkFifo) so tasks of the same channel run in sequence and
+ * samples are processed in order.
+ *
+ * Channel sink objects live in the pool event thread where their timers run. Their input
+ * messages are handled by the channel task before the samples are fed.
+ */
+class SDRBASE_API DSPWorkerPool
+{
+public:
+    class Task
+    {
+    public:
+        virtual ~Task() {}
+        virtual void run() = 0;
+    };
+
+    DSPWorkerPool(int nbWorkers);
+    ~DSPWorkerPool();
+
+    int getNbWorkers() const { return m_workers.size(); }
+    QThread *getEventThread() { return &m_eventThread; }
+    void submit(Task *task);
+
+private:
+    class Worker : public QThread
+    {
+    public:
+        Worker(DSPWorkerPool *pool, int index);
+        void run();
+
+        DSPWorkerPool *m_pool;
+        int m_index;
+        QMutex m_mutex; //!< protects the deque
+        std::deque<Task*> m_tasks;
+    };
+
+    std::vector<Worker*> m_workers;
+    QThread m_eventThread;
+    QAtomicInt m_nextWorker;   //!< round robin for tasks submitted from outside the pool
+    QAtomicInt m_nbPendingTasks;
+    QMutex m_idleMutex;
+    QWaitCondition m_taskAvailable;
+    bool m_stop;
+
+    Task *getTask(int workerIndex);
+};
+
+#endif /* SDRBASE_DSP_DSPWORKERPOOL_H_ */
@@ -263,10 +263,11 @@ void DVSerialEngine::pushMbeFrame(
 
     while (it != m_controllers.end())
     {
-        if (it->worker->hasFifo(audioFifo))
+        if (it->worker->hasFifo(audioFifo)) // a FIFO is only written by one worker at a time
         {
             it->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
             done = true;
+            break;
         }
         else if (it->worker->isAvailable())
         {
@@ -35,6 +35,7 @@ DVSerialWorker::DVSerialWorker() :
     m_audioBuffer.resize(48000);
     m_audioBufferFill = 0;
     m_audioFifo = 0;
+    m_nbPendingFrames = 0;
     memset(m_dvAudioSamples, 0, SerialDV::MBE_AUDIO_BLOCK_SIZE*sizeof(short));
     setVolumeFactors();
 }
@@ -77,12 +78,14 @@ void DVSerialWorker::handleInputMessages()
     Message* message;
     m_audioBufferFill = 0;
     AudioFifo *audioFifo = 0;
+    int nbFrames = 0;
 
     while ((message = m_inputMessageQueue.pop()) != 0)
     {
         if (MsgMbeDecode::match(*message))
         {
             MsgMbeDecode *decodeMsg = (MsgMbeDecode *) message;
+            nbFrames++;
             int dBVolume = (decodeMsg->getVolumeIndex() - 30) / 4;
             float volume = pow(10.0, dBVolume / 10.0f);
             int upsampling = decodeMsg->getUpsampling();
@@ -118,7 +121,7 @@ void DVSerialWorker::handleInputMessages()
 
     if (audioFifo)
     {
-        uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+        uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
         if (res != m_audioBufferFill)
         {
@@ -126,6 +129,8 @@ void DVSerialWorker::handleInputMessages()
         }
     }
 
+    m_nbPendingFrames.fetchAndAddOrdered(-nbFrames); // the FIFO is written: this worker may be given another one
+
     m_timestamp = QDateTime::currentDateTime();
 }
 
@@ -138,6 +143,7 @@ void DVSerialWorker::pushMbeFrame(const unsigned char *mbeFrame,
         AudioFifo *audioFifo)
 {
     m_audioFifo = audioFifo;
+    m_nbPendingFrames.fetchAndAddOrdered(1);
     m_inputMessageQueue.push(MsgMbeDecode::create(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo));
 }
 
@@ -147,6 +153,10 @@ bool DVSerialWorker::isAvailable()
 		return true;
 	}
 
+	if (m_nbPendingFrames.loadAcquire() > 0) { // the FIFO stays with this worker until its frames are written
+		return false;
+	}
+
 	return m_timestamp.time().msecsTo(QDateTime::currentDateTime().time()) > 1000; // 1 second inactivity timeout
 }
 
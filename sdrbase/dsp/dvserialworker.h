@@ -22,6 +22,7 @@
 #include <QDebug>
 #include <QTimer>
 #include <QDateTime>
+#include <QAtomicInt>
 
 #include <vector>
 
@@ -126,6 +127,7 @@ public:
 
     MessageQueue m_inputMessageQueue; //!< Queue for asynchronous inbound communication
     AudioFifo *m_audioFifo;
+    QAtomicInt m_nbPendingFrames;     //!< MBE frames queued and not yet written to m_audioFifo
     QDateTime m_timestamp;
 
 signals:
@@ -23,3 +23,29 @@ FFTEngine* FFTEngine::create()
 	return 0;
 #endif
 }
+
+void FFTEngine::loadWisdom()
+{
+#ifdef USE_FFTW
+	FFTWEngine::importWisdom(FFTWEngine::getDefaultWisdomFileName());
+#endif
+}
+
+void FFTEngine::saveWisdom()
+{
+#ifdef USE_FFTW
+	FFTWEngine::stopPlanner();
+	FFTWEngine::exportWisdom(FFTWEngine::getDefaultWisdomFileName());
+#endif
+}
+
+void FFTEngine::preplan(const std::vector<int>& sizes)
+{
+#ifdef USE_FFTW
+	for (std::vector<int>::const_iterator it = sizes.begin(); it != sizes.end(); ++it) {
+		FFTWEngine::preplan(*it, false);
+	}
+#else
+	(void) sizes;
+#endif
+}
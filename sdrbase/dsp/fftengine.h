@@ -1,6 +1,8 @@
 #ifndef INCLUDE_FFTENGINE_H
 #define INCLUDE_FFTENGINE_H
 
+#include <vector>
+
 #include "dsp/dsptypes.h"
 #include "export.h"
 
@@ -15,6 +17,10 @@ public:
 	virtual Complex* out() = 0;
 
 	static FFTEngine* create();
+
+	static void loadWisdom();                           //!< restore plans measured by previous runs (FFTW only)
+	static void saveWisdom();                           //!< keep measured plans for next runs (FFTW only)
+	static void preplan(const std::vector<int>& sizes); //!< measure forward plans of these sizes in the background (FFTW only)
 };
 
 #endif // INCLUDE_FFTENGINE_H
@@ -1,6 +1,129 @@
 #include <QTime>
+#include <QThread>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include "dsp/fftwengine.h"
 
+/**
+ * Measuring a plan with FFTW_PATIENT can take seconds for large sizes. Instead of stalling the
+ * DSP thread on it a fast FFTW_ESTIMATE plan is used right away and the measured plan is computed
+ * here. Its only purpose is to populate the FFTW wisdom: the engine then re-creates its plan from
+ * wisdom, which is immediate.
+ */
+struct FFTWEngine::PlanRequest
+{
+	int m_n;
+	bool m_inverse;
+	QAtomicInt m_done;     //!< set by the planner when wisdom holds the measured plan
+	QAtomicInt m_refCount; //!< shared by the planner and the requesting engine if any
+
+	PlanRequest(int n, bool inverse, int refCount) :
+		m_n(n),
+		m_inverse(inverse),
+		m_done(0),
+		m_refCount(refCount)
+	{}
+
+	void release()
+	{
+		if (!m_refCount.deref()) {
+			delete this;
+		}
+	}
+};
+
+class FFTWEngine::Planner : public QThread
+{
+public:
+	static Planner *instance()
+	{
+		static Planner *planner = new Planner(); // never deleted as it may outlive any engine
+		return planner;
+	}
+
+	void submit(PlanRequest *request)
+	{
+		QMutexLocker mutexLocker(&m_mutex);
+		m_requests.push_back(request);
+		m_condition.wakeOne();
+
+		if (!isRunning()) {
+			start(QThread::LowPriority);
+		}
+	}
+
+	void stop()
+	{
+		m_mutex.lock();
+		m_stop = true;
+		m_condition.wakeOne();
+		m_mutex.unlock();
+		wait();
+	}
+
+protected:
+	virtual void run()
+	{
+		m_mutex.lock();
+
+		while (true)
+		{
+			while (m_requests.empty() && !m_stop) {
+				m_condition.wait(&m_mutex);
+			}
+
+			if (m_stop) {
+				break;
+			}
+
+			PlanRequest *request = m_requests.front();
+			m_requests.pop_front();
+			m_mutex.unlock();
+
+			measure(request->m_n, request->m_inverse);
+			request->m_done.storeRelease(1);
+			request->release();
+
+			m_mutex.lock();
+		}
+
+		for (std::list<PlanRequest*>::iterator it = m_requests.begin(); it != m_requests.end(); ++it) {
+			(*it)->release();
+		}
+
+		m_requests.clear();
+		m_stop = false;
+		m_mutex.unlock();
+	}
+
+private:
+	QMutex m_mutex;
+	QWaitCondition m_condition;
+	std::list<PlanRequest*> m_requests;
+	bool m_stop;
+
+	Planner() : m_stop(false) {}
+
+	static void measure(int n, bool inverse)
+	{
+		fftwf_complex *in = (fftwf_complex*) fftwf_malloc(sizeof(fftwf_complex) * n);
+		fftwf_complex *out = (fftwf_complex*) fftwf_malloc(sizeof(fftwf_complex) * n);
+		QTime t;
+		t.start();
+		m_globalPlanMutex.lock();
+		fftwf_plan plan = fftwf_plan_dft_1d(n, in, out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
+		fftwf_destroy_plan(plan);
+		m_globalPlanMutex.unlock();
+		fftwf_free(in);
+		fftwf_free(out);
+		qDebug("FFT: measuring FFTW plan (n=%d,%s) in background took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+	}
+};
+
 FFTWEngine::FFTWEngine() :
 	m_plans(),
 	m_currentPlan(NULL)
@@ -26,19 +149,44 @@ void FFTWEngine::configure(int n, bool inverse)
 	m_currentPlan->inverse = inverse;
 	m_currentPlan->in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
 	m_currentPlan->out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
+	m_currentPlan->request = NULL;
 	QTime t;
 	t.start();
 	m_globalPlanMutex.lock();
-	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
+	// plans measured by this run or a previous one (wisdom file) are available at once
+	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+
+	if (m_currentPlan->plan == NULL)
+	{
+		m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_ESTIMATE);
+		m_currentPlan->request = new PlanRequest(n, inverse, 2);
+	}
+
 	m_globalPlanMutex.unlock();
-	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+
+	if (m_currentPlan->request)
+	{
+		qDebug("FFT: creating FFTW estimate plan (n=%d,%s) took %dms - measuring in background", n, inverse ? "inverse" : "forward", t.elapsed());
+		Planner::instance()->submit(m_currentPlan->request);
+	}
+	else
+	{
+		qDebug("FFT: creating FFTW plan from wisdom (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+	}
+
 	m_plans.push_back(m_currentPlan);
 }
 
 void FFTWEngine::transform()
 {
 	if(m_currentPlan != NULL)
+	{
+		if (m_currentPlan->request && m_currentPlan->request->m_done.loadAcquire()) {
+			adoptMeasuredPlan(m_currentPlan);
+		}
+
 		fftwf_execute(m_currentPlan->plan);
+	}
 }
 
 Complex* FFTWEngine::in()
@@ -57,9 +205,33 @@ Complex* FFTWEngine::out()
 
 QMutex FFTWEngine::m_globalPlanMutex;
 
+void FFTWEngine::adoptMeasuredPlan(Plan* plan)
+{
+	if (!m_globalPlanMutex.tryLock()) { // planner is busy with another size: retry on next transform
+		return;
+	}
+
+	// FFTW_WISDOM_ONLY does not touch the arrays so the input buffer contents are preserved
+	fftwf_plan measuredPlan = fftwf_plan_dft_1d(plan->n, plan->in, plan->out, plan->inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+
+	if (measuredPlan)
+	{
+		fftwf_destroy_plan(plan->plan);
+		plan->plan = measuredPlan;
+	}
+
+	m_globalPlanMutex.unlock();
+
+	plan->request->release();
+	plan->request = NULL;
+}
+
 void FFTWEngine::freeAll()
 {
 	for(Plans::iterator it = m_plans.begin(); it != m_plans.end(); ++it) {
+		if ((*it)->request) {
+			(*it)->request->release();
+		}
 		fftwf_destroy_plan((*it)->plan);
 		fftwf_free((*it)->in);
 		fftwf_free((*it)->out);
@@ -67,3 +239,41 @@ void FFTWEngine::freeAll()
 	}
 	m_plans.clear();
 }
+
+QString FFTWEngine::getDefaultWisdomFileName()
+{
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fftwf-wisdom";
+}
+
+void FFTWEngine::importWisdom(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if (fftwf_import_wisdom_from_filename(QFile::encodeName(fileName).constData())) {
+		qDebug("FFTWEngine::importWisdom: imported %s", qPrintable(fileName));
+	} else {
+		qDebug("FFTWEngine::importWisdom: no valid wisdom in %s", qPrintable(fileName));
+	}
+}
+
+void FFTWEngine::exportWisdom(const QString& fileName)
+{
+	QDir().mkpath(QFileInfo(fileName).absolutePath());
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if (fftwf_export_wisdom_to_filename(QFile::encodeName(fileName).constData())) {
+		qDebug("FFTWEngine::exportWisdom: exported %s", qPrintable(fileName));
+	} else {
+		qWarning("FFTWEngine::exportWisdom: cannot write %s", qPrintable(fileName));
+	}
+}
+
+void FFTWEngine::preplan(int n, bool inverse)
+{
+	Planner::instance()->submit(new PlanRequest(n, inverse, 1));
+}
+
+void FFTWEngine::stopPlanner()
+{
+	Planner::instance()->stop();
+}
@@ -2,6 +2,7 @@
 #define INCLUDE_FFTWENGINE_H
 
 #include <QMutex>
+#include <QString>
 #include <fftw3.h>
 #include <list>
 #include "dsp/fftengine.h"
@@ -18,20 +19,31 @@ public:
 	Complex* in();
 	Complex* out();
 
+	static QString getDefaultWisdomFileName();
+	static void importWisdom(const QString& fileName);
+	static void exportWisdom(const QString& fileName);
+	static void preplan(int n, bool inverse); //!< measure a plan in the background so that it is found in wisdom later
+	static void stopPlanner();                //!< abandon pending background plans and stop the planner thread
+
 protected:
 	static QMutex m_globalPlanMutex;
 
+	struct PlanRequest;
+	class Planner;
+
 	struct Plan {
 		int n;
 		bool inverse;
 		fftwf_plan plan;
 		fftwf_complex* in;
 		fftwf_complex* out;
+		PlanRequest* request; //!< pending measured plan, plan is an estimate until it completes
 	};
 	typedef std::list<Plan*> Plans;
 	Plans m_plans;
 	Plan* m_currentPlan;
 
+	void adoptMeasuredPlan(Plan* plan);
 	void freeAll();
 };
 
@@ -15,6 +15,12 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "dsp/fftwindow.h"
 
 void FFTWindow::create(Function function, int n)
@@ -68,6 +74,20 @@ void FFTWindow::apply(const std::vector<Complex>& in, std::vector<Complex>* out)
 
 void FFTWindow::apply(const Complex* in, Complex* out)
 {
-	for(size_t i = 0; i < m_window.size(); i++)
+	size_t i = 0;
+#if defined(USE_SSE2)
+	// 2 complex samples at a time with window coefficients duplicated as (w0, w0, w1, w1)
+	for(; i + 2 <= m_window.size(); i += 2) {
+		__m128 w = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*) &m_window[i]);
+		_mm_storeu_ps((float*) &out[i], _mm_mul_ps(_mm_loadu_ps((const float*) &in[i]), _mm_unpacklo_ps(w, w)));
+	}
+#elif defined(USE_NEON)
+	for(; i + 2 <= m_window.size(); i += 2) {
+		float32x2_t w = vld1_f32(&m_window[i]);
+		float32x4_t w2 = vcombine_f32(vdup_lane_f32(w, 0), vdup_lane_f32(w, 1));
+		vst1q_f32((float*) &out[i], vmulq_f32(vld1q_f32((const float*) &in[i]), w2));
+	}
+#endif
+	for(; i < m_window.size(); i++)
 		out[i] = in[i] * m_window[i];
 }
@@ -1,10 +1,14 @@
 #include <dsp/filerecord.h>
 #include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
 #include "util/simpleserializer.h"
 #include "util/message.h"
 
 #include <QDebug>
 #include <QDateTime>
+#include <string.h>
+
+#include "SWGFileRecordReport.h"
 
 FileRecord::FileRecord() :
 	BasebandSampleSink(),
@@ -54,7 +58,9 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
     if(!m_recordOn)
         return;
 
-    if (begin < end) // if there is something to put out
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_recordOn && (begin < end)) // if there is something to put out
     {
         if (m_recordStart)
         {
@@ -62,8 +68,10 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
             m_recordStart = false;
         }
 
-        m_sampleFile.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
-        m_byteCount += end - begin;
+        // copied to the writer buffer pool: the disk is only touched by the writer thread
+        qint64 size = (end - begin)*sizeof(Sample);
+        m_writer.write(reinterpret_cast<const char*>(&*(begin)), size);
+        m_byteCount += size;
     }
 }
 
@@ -78,24 +86,36 @@ void FileRecord::stop()
 
 void FileRecord::startRecording()
 {
-    if (!m_sampleFile.is_open())
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_writer.isOpen())
     {
     	qDebug() << "FileRecord::startRecording";
-        m_sampleFile.open(m_fileName.toStdString().c_str(), std::ios::binary);
-        m_recordOn = true;
-        m_recordStart = true;
-        m_byteCount = 0;
+        DSPEngine *dspEngine = DSPEngine::instance();
+        m_writer.setDirectIO(dspEngine->getRecordDirectIO());
+        m_writer.setPreallocation(dspEngine->getRecordPreallocation());
+
+        if (m_writer.open(m_fileName))
+        {
+            m_recordOn = true;
+            m_recordStart = true;
+            m_byteCount = 0;
+        }
     }
 }
 
 void FileRecord::stopRecording()
 {
-    if (m_sampleFile.is_open())
+    m_mutex.lock();
+    bool wasRecording = m_recordOn && m_writer.isOpen();
+    m_recordOn = false; // feed no longer touches the writer
+    m_recordStart = false;
+    m_mutex.unlock();
+
+    if (wasRecording) // close out of the lock as flushing the writer would stall feed
     {
     	qDebug() << "FileRecord::stopRecording";
-        m_sampleFile.close();
-        m_recordOn = false;
-        m_recordStart = false;
+        m_writer.close();
     }
 }
 
@@ -128,12 +148,12 @@ void FileRecord::handleConfigure(const QString& fileName)
 
 void FileRecord::writeHeader()
 {
-    m_sampleFile.write((const char *) &m_sampleRate, sizeof(qint32));         // 4 bytes
-    m_sampleFile.write((const char *) &m_centerFrequency, sizeof(quint64));   // 8 bytes
+    m_writer.write((const char *) &m_sampleRate, sizeof(qint32));         // 4 bytes
+    m_writer.write((const char *) &m_centerFrequency, sizeof(quint64));   // 8 bytes
     std::time_t ts = time(0);
-    m_sampleFile.write((const char *) &ts, sizeof(std::time_t));              // 8 bytes
+    m_writer.write((const char *) &ts, sizeof(std::time_t));              // 8 bytes
     quint32 sampleSize = SDR_RX_SAMP_SZ;
-    m_sampleFile.write((const char *) &sampleSize, sizeof(int));              // 4 bytes
+    m_writer.write((const char *) &sampleSize, sizeof(int));              // 4 bytes
 }
 
 void FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
@@ -146,3 +166,28 @@ void FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
     	header.sampleSize = 16;
     }
 }
+
+void FileRecord::readHeader(const quint8 *data, Header& header)
+{
+    memcpy(&(header.sampleRate), data, sizeof(qint32));
+    data += sizeof(qint32);
+    memcpy(&(header.centerFrequency), data, sizeof(quint64));
+    data += sizeof(quint64);
+    memcpy(&(header.startTimeStamp), data, sizeof(std::time_t));
+    data += sizeof(std::time_t);
+    memcpy(&(header.sampleSize), data, sizeof(quint32));
+    if ((header.sampleSize != 16) && (header.sampleSize != 24)) { // assume 16 bits if garbage (old I/Q file)
+    	header.sampleSize = 16;
+    }
+}
+
+void FileRecord::webapiFormatReport(SWGSDRangel::SWGFileRecordReport& response)
+{
+    response.setFileName(new QString(m_fileName));
+    response.setRecording(m_recordOn ? 1 : 0);
+    response.setDirectIo(m_writer.isDirectIO() ? 1 : 0);
+    response.setByteCount(m_byteCount);
+    response.setWrittenBytes(m_writer.getWrittenBytes());
+    response.setBacklogBytes(m_writer.getBacklogBytes());
+    response.setDroppedBytes(m_writer.getDroppedBytes());
+}
@@ -2,15 +2,22 @@
 #define INCLUDE_FILESINK_H
 
 #include <dsp/basebandsamplesink.h>
+#include <QMutex>
 #include <string>
 #include <iostream>
 #include <fstream>
 
 #include <ctime>
+#include "dsp/filerecordwriter.h"
 #include "export.h"
 
 class Message;
 
+namespace SWGSDRangel
+{
+    class SWGFileRecordReport;
+}
+
 class SDRBASE_API FileRecord : public BasebandSampleSink {
 public:
 
@@ -27,6 +34,9 @@ public:
 	virtual ~FileRecord();
 
     quint64 getByteCount() const { return m_byteCount; }
+    quint64 getBacklogBytes() { return m_writer.getBacklogBytes(); }
+    quint64 getDroppedBytes() { return m_writer.getDroppedBytes(); }
+    bool isRecording() const { return m_recordOn; }
 
     void setFileName(const QString& filename);
     void genUniqueFileName(uint deviceUID);
@@ -38,6 +48,8 @@ public:
     void startRecording();
     void stopRecording();
     static void readHeader(std::ifstream& samplefile, Header& header);
+    static void readHeader(const quint8 *data, Header& header); //!< from a memory mapped record
+    void webapiFormatReport(SWGSDRangel::SWGFileRecordReport& response);
 
 private:
 	QString m_fileName;
@@ -45,8 +57,9 @@ private:
 	quint64 m_centerFrequency;
 	bool m_recordOn;
     bool m_recordStart;
-    std::ofstream m_sampleFile;
+    FileRecordWriter m_writer;
     quint64 m_byteCount;
+    QMutex m_mutex; //!< serializes feed with recording start and stop
 
 	void handleConfigure(const QString& fileName);
     void writeHeader();
@@ -0,0 +1,295 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <QDebug>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "dsp/filerecordwriter.h"
+
+FileRecordWriter::FileRecordWriter() :
+    m_alignedPool(0),
+    m_nbBuffers(32),
+    m_bufferSize(4<<20),
+    m_fillBuffer(0),
+    m_fillSize(0),
+    m_directIO(false),
+    m_directIOActive(0),
+    m_preallocation(0),
+    m_stop(false),
+    m_writeError(false),
+    m_writtenBytes(0),
+    m_backlogBytes(0),
+    m_droppedBytes(0)
+{
+}
+
+FileRecordWriter::~FileRecordWriter()
+{
+    close();
+}
+
+void FileRecordWriter::allocatePool()
+{
+    m_pool.resize((size_t) m_nbBuffers * m_bufferSize + m_alignment);
+    m_alignedPool = (char*) ((((quintptr) m_pool.data()) + m_alignment - 1) & ~((quintptr) m_alignment - 1));
+    m_freeBuffers.clear();
+
+    for (int i = 0; i < m_nbBuffers; i++) {
+        m_freeBuffers.push_back(m_alignedPool + (size_t) i * m_bufferSize);
+    }
+}
+
+bool FileRecordWriter::open(const QString& fileName)
+{
+    if (isOpen()) {
+        return false;
+    }
+
+    m_directIOActive.storeRelease(0);
+#ifdef __linux__
+    QByteArray encodedName = QFile::encodeName(fileName);
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    int fd = -1;
+
+    if (m_directIO)
+    {
+        fd = ::open(encodedName.constData(), flags | O_DIRECT, 0644);
+
+        if (fd < 0) {
+            qWarning("FileRecordWriter::open: O_DIRECT not supported for %s. Using buffered I/O", qPrintable(fileName));
+        } else {
+            m_directIOActive.storeRelease(1);
+        }
+    }
+
+    if (fd < 0) {
+        fd = ::open(encodedName.constData(), flags, 0644);
+    }
+
+    if (fd < 0)
+    {
+        qWarning("FileRecordWriter::open: cannot open %s", qPrintable(fileName));
+        return false;
+    }
+
+    if (m_preallocation > 0)
+    {
+        int rc = posix_fallocate(fd, 0, m_preallocation);
+
+        if (rc != 0) {
+            qWarning("FileRecordWriter::open: cannot preallocate %llu bytes: %s", m_preallocation, strerror(rc));
+        }
+    }
+
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(fd, QIODevice::WriteOnly | QIODevice::Unbuffered, QFileDevice::AutoCloseHandle))
+    {
+        qWarning("FileRecordWriter::open: cannot open %s: %s", qPrintable(fileName), qPrintable(m_file.errorString()));
+        ::close(fd);
+        return false;
+    }
+#else
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+    {
+        qWarning("FileRecordWriter::open: cannot open %s: %s", qPrintable(fileName), qPrintable(m_file.errorString()));
+        return false;
+    }
+#endif
+
+    allocatePool();
+    m_fullBuffers.clear();
+    m_fillBuffer = 0;
+    m_fillSize = 0;
+    m_writtenBytes = 0;
+    m_backlogBytes = 0;
+    m_droppedBytes = 0;
+    m_stop = false;
+    m_writeError = false;
+
+    qDebug("FileRecordWriter::open: %s with %d x %d bytes buffers%s",
+            qPrintable(fileName), m_nbBuffers, m_bufferSize, isDirectIO() ? " (direct I/O)" : "");
+    start();
+
+    return true;
+}
+
+void FileRecordWriter::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    m_mutex.lock();
+
+    if (m_fillBuffer)
+    {
+        if (m_fillSize > 0)
+        {
+            Buffer buffer = {m_fillBuffer, m_fillSize};
+            m_fullBuffers.push_back(buffer);
+            m_backlogBytes += m_fillSize;
+        }
+        else
+        {
+            m_freeBuffers.push_back(m_fillBuffer);
+        }
+
+        m_fillBuffer = 0;
+        m_fillSize = 0;
+    }
+
+    m_stop = true;
+    m_condition.wakeOne();
+    m_mutex.unlock();
+    wait();
+
+    if (m_preallocation > 0) {
+        m_file.resize(m_writtenBytes); // give back the unused preallocated space
+    }
+
+    m_file.close();
+    qDebug("FileRecordWriter::close: written: %llu dropped: %llu bytes", m_writtenBytes, m_droppedBytes);
+
+    // the pool is only held while recording
+    m_freeBuffers.clear();
+    std::vector<char>().swap(m_pool);
+    m_alignedPool = 0;
+}
+
+void FileRecordWriter::write(const char *data, qint64 size)
+{
+    while (size > 0)
+    {
+        if (!m_fillBuffer)
+        {
+            QMutexLocker mutexLocker(&m_mutex);
+
+            if (m_freeBuffers.empty()) // writer cannot keep up
+            {
+                m_droppedBytes += size;
+                return;
+            }
+
+            m_fillBuffer = m_freeBuffers.back();
+            m_freeBuffers.pop_back();
+            m_fillSize = 0;
+        }
+
+        int chunk = size < m_bufferSize - m_fillSize ? (int) size : m_bufferSize - m_fillSize;
+        memcpy(m_fillBuffer + m_fillSize, data, chunk);
+        m_fillSize += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (m_fillSize == m_bufferSize)
+        {
+            QMutexLocker mutexLocker(&m_mutex);
+            Buffer buffer = {m_fillBuffer, m_fillSize};
+            m_fullBuffers.push_back(buffer);
+            m_backlogBytes += m_fillSize;
+            m_condition.wakeOne();
+            m_fillBuffer = 0;
+            m_fillSize = 0;
+        }
+    }
+}
+
+void FileRecordWriter::run()
+{
+    m_mutex.lock();
+
+    while (true)
+    {
+        while (m_fullBuffers.empty() && !m_stop) {
+            m_condition.wait(&m_mutex);
+        }
+
+        if (m_fullBuffers.empty()) { // stopped and drained
+            break;
+        }
+
+        Buffer buffer = m_fullBuffers.front();
+        m_fullBuffers.pop_front();
+        m_mutex.unlock();
+
+        bool written = writeBuffer(buffer);
+
+        m_mutex.lock();
+        m_backlogBytes -= buffer.m_size;
+
+        if (written) {
+            m_writtenBytes += buffer.m_size;
+        } else {
+            m_droppedBytes += buffer.m_size;
+        }
+
+        m_freeBuffers.push_back(buffer.m_data);
+    }
+
+    m_mutex.unlock();
+}
+
+bool FileRecordWriter::writeBuffer(const Buffer& buffer)
+{
+    if (m_writeError) {
+        return false;
+    }
+
+#ifdef __linux__
+    if (isDirectIO() && (buffer.m_size % m_alignment != 0)) // last partial buffer of the recording
+    {
+        int flags = fcntl(m_file.handle(), F_GETFL);
+        fcntl(m_file.handle(), F_SETFL, flags & ~O_DIRECT);
+        m_directIOActive.storeRelease(0);
+    }
+#endif
+
+    if (m_file.write(buffer.m_data, buffer.m_size) != buffer.m_size)
+    {
+        qWarning("FileRecordWriter::writeBuffer: %s", qPrintable(m_file.errorString()));
+        m_writeError = true;
+        return false;
+    }
+
+    return true;
+}
+
+quint64 FileRecordWriter::getWrittenBytes()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_writtenBytes;
+}
+
+quint64 FileRecordWriter::getBacklogBytes()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_backlogBytes;
+}
+
+quint64 FileRecordWriter::getDroppedBytes()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_droppedBytes;
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDWRITER_H_
+#define SDRBASE_DSP_FILERECORDWRITER_H_
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QFile>
+#include <QString>
+#include <vector>
+#include <deque>
+
+#include "export.h"
+
+/**
+ * Writes a byte stream to a file from its own thread. The producer copies data into
+ * buffers taken from a preallocated pool and never waits for the disk: full buffers
+ * are queued to the writer thread which issues one large aligned write per buffer.
+ * When the pool is exhausted incoming data is dropped and accounted for.
+ */
+class SDRBASE_API FileRecordWriter : public QThread
+{
+public:
+    static const int m_alignment = 4096; //!< buffer address and size alignment suitable for O_DIRECT
+
+    FileRecordWriter();
+    ~FileRecordWriter();
+
+    /** Bypass page cache (Linux O_DIRECT) falling back to normal I/O if not supported */
+    void setDirectIO(bool directIO) { m_directIO = directIO; }
+    /** Reserve file space up front (Linux fallocate). Trimmed to the actual size on close */
+    void setPreallocation(quint64 bytes) { m_preallocation = bytes; }
+
+    bool open(const QString& fileName);
+    void close(); //!< flush pending data and stop the writer thread
+    bool isOpen() const { return m_file.isOpen(); }
+    bool isDirectIO() const { return m_directIOActive.loadAcquire() != 0; }
+
+    void write(const char *data, qint64 size); //!< producer side: copy to pool, never blocks on I/O
+
+    quint64 getWrittenBytes();
+    quint64 getBacklogBytes();
+    quint64 getDroppedBytes();
+
+protected:
+    virtual void run();
+
+private:
+    struct Buffer
+    {
+        char *m_data;
+        int m_size;
+    };
+
+    std::vector<char> m_pool;
+    char *m_alignedPool;
+    int m_nbBuffers;
+    int m_bufferSize;
+    std::vector<char*> m_freeBuffers; //!< guarded by m_mutex
+    std::deque<Buffer> m_fullBuffers; //!< guarded by m_mutex
+    char *m_fillBuffer;               //!< producer only
+    int m_fillSize;                   //!< producer only
+
+    QFile m_file;
+    bool m_directIO;
+    QAtomicInt m_directIOActive; //!< cleared by the writer thread on the last partial buffer
+    quint64 m_preallocation;
+    bool m_stop;
+    bool m_writeError;
+
+    quint64 m_writtenBytes;  //!< guarded by m_mutex
+    quint64 m_backlogBytes;  //!< guarded by m_mutex
+    quint64 m_droppedBytes;  //!< guarded by m_mutex
+
+    QMutex m_mutex;
+    QWaitCondition m_condition;
+
+    void allocatePool();
+    bool writeBuffer(const Buffer& buffer);
+};
+
+#endif /* SDRBASE_DSP_FILERECORDWRITER_H_ */
@@ -58,8 +58,6 @@ void Interpolator::createPolyphaseLowPass(
 Interpolator::Interpolator() :
 	m_taps(0),
 	m_alignedTaps(0),
-	m_taps2(0),
-	m_alignedTaps2(0),
     m_ptr(0),
 	m_phaseSteps(1),
     m_nTaps(1)
@@ -89,8 +87,8 @@ void Interpolator::create(int phaseSteps, double sampleRate, double cutoff, doub
 	m_ptr = 0;
 	m_nTaps = taps.size() / phaseSteps;
 	m_phaseSteps = phaseSteps;
-	m_samples.resize(m_nTaps + 2);
-	for(int i = 0; i < m_nTaps + 2; i++)
+	m_samples.resize(2 * m_nTaps);
+	for(int i = 0; i < 2 * m_nTaps; i++)
 		m_samples[i] = 0;
 
 	// reorder into polyphase
@@ -118,14 +116,6 @@ void Interpolator::create(int phaseSteps, double sampleRate, double cutoff, doub
 		m_alignedTaps[2 * i + 0] = polyphase[i];
 		m_alignedTaps[2 * i + 1] = polyphase[i];
 	}
-	m_taps2 = new float[2 * taps.size() + 8];
-	for(uint i = 0; i < 2 * taps.size() + 8; ++i)
-		m_taps2[i] = 0;
-	m_alignedTaps2 = (float*)((((quint64)m_taps2) + 15) & ~15);
-	for(uint i = 1; i < taps.size(); ++i) {
-		m_alignedTaps2[2 * (i - 1) + 0] = polyphase[i];
-		m_alignedTaps2[2 * (i - 1) + 1] = polyphase[i];
-	}
 }
 
 void Interpolator::free()
@@ -134,8 +124,51 @@ void Interpolator::free()
 		delete[] m_taps;
 		m_taps = NULL;
 		m_alignedTaps = NULL;
-		delete[] m_taps2;
-		m_taps2 = NULL;
-		m_alignedTaps2 = NULL;
+	}
+}
+
+int Interpolator::decimate(Real *distance, Real step, const Complex* next, int nbNext, Complex* result)
+{
+	Real d = *distance;
+	int nbOut = 0;
+
+	for (int i = 0; i < nbNext; i++)
+	{
+		advanceFilter(next[i]);
+		d -= 1.0;
+
+		if (d < 1.0)
+		{
+			doInterpolate((int) floor(d * (Real)m_phaseSteps), &result[nbOut++]);
+			d += step;
+		}
+	}
+
+	*distance = d;
+	return nbOut;
+}
+
+int Interpolator::resample(Real *distance, Real step, const Complex* next, int nbNext, Complex* result)
+{
+	Real d = *distance;
+	int nbOut = 0;
+	int i = 0;
+
+	while (true)
+	{
+		while (d >= 1.0)
+		{
+			if (i == nbNext)
+			{
+				*distance = d;
+				return nbOut;
+			}
+
+			advanceFilter(next[i++]);
+			d -= 1.0;
+		}
+
+		doInterpolate((int) floor(d * (Real)m_phaseSteps), &result[nbOut++]);
+		d += step;
 	}
 }
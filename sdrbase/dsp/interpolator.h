@@ -1,8 +1,10 @@
 #ifndef INCLUDE_INTERPOLATOR_H
 #define INCLUDE_INTERPOLATOR_H
 
-#ifdef USE_SSE2
+#if defined(USE_SSE2)
 #include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
 #endif
 #include "dsp/dsptypes.h"
 #include "export.h"
@@ -75,12 +77,22 @@ public:
 		return true;
 	}
 
+	// Block versions of the above. They process a whole span of nbNext input samples and are
+	// equivalent to calling the per sample versions in a loop with *distance incremented by
+	// step after each output sample. Return the number of samples written to result.
+	// decimate yields at most one sample per input sample while resample needs room for
+	// getMaxOutputs(nbNext, step) samples.
+	int decimate(Real *distance, Real step, const Complex* next, int nbNext, Complex* result);
+	int resample(Real *distance, Real step, const Complex* next, int nbNext, Complex* result);
+
+	static int getMaxOutputs(int nbNext, Real step) {
+		return (int) ((nbNext + 1) / step) + 2;
+	}
+
 private:
 	float* m_taps;
 	float* m_alignedTaps;
-	float* m_taps2;
-	float* m_alignedTaps2;
-	std::vector<Complex> m_samples;
+	std::vector<Complex> m_samples; //!< linear history: each sample is stored at m_ptr and m_ptr + m_nTaps
 	int m_ptr;
 	int m_phaseSteps;
 	int m_nTaps;
@@ -110,90 +122,59 @@ private:
 		if(m_ptr < 0)
 			m_ptr = m_nTaps - 1;
 		m_samples[m_ptr] = next;
+		m_samples[m_ptr + m_nTaps] = next;
 	}
 
     void advanceFilter()
     {
-        m_ptr--;
-        if(m_ptr < 0)
-            m_ptr = m_nTaps - 1;
-        m_samples[m_ptr].real(0.0);
-        m_samples[m_ptr].imag(0.0);
+        advanceFilter(Complex(0.0, 0.0));
     }
 
 	void doInterpolate(int phase, Complex* result)
 	{
 		if (phase < 0)
 			phase = 0;
-#if USE_SSE2
-		// beware of the ringbuffer
-		if(m_ptr == 0) {
-			// only one straight block
-			const float* src = (const float*)&m_samples[0];
-			const __m128* filter = (const __m128*)&m_alignedTaps[phase * m_nTaps * 2];
-			__m128 sum = _mm_setzero_ps();
-			int todo = m_nTaps / 2;
-
-			for(int i = 0; i < todo; i++) {
-				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src), *filter));
-				src += 4;
-				filter += 1;
-			}
+		// the m_nTaps samples from m_ptr are always contiguous thanks to the doubled history
+		// and m_nTaps is always even
+		const float* src = (const float*)&m_samples[m_ptr];
+		const float* coeff = &m_alignedTaps[phase * m_nTaps * 2];
+		int todo = m_nTaps / 2;
+#if defined(USE_SSE2)
+		__m128 sum = _mm_setzero_ps();
+
+		for(int i = 0; i < todo; i++) {
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src), _mm_load_ps(coeff)));
+			src += 4;
+			coeff += 4;
+		}
 
-			// add upper half to lower half and store
-			_mm_storel_pi((__m64*)result, _mm_add_ps(sum, _mm_shuffle_ps(sum, _mm_setzero_ps(), _MM_SHUFFLE(1, 0, 3, 2))));
-		} else {
-			// two blocks
-			const float* src = (const float*)&m_samples[m_ptr];
-			const __m128* filter = (const __m128*)&m_alignedTaps[phase * m_nTaps * 2];
-			__m128 sum = _mm_setzero_ps();
-
-			// first block
-			int block = m_nTaps - m_ptr;
-			int todo = block / 2;
-			if(block & 1)
-				todo++;
-			for(int i = 0; i < todo; i++) {
-				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src), *filter));
-				src += 4;
-				filter += 1;
-			}
-			if(block & 1) {
-				// one sample beyond the end -> switch coefficient table
-				filter = (const __m128*)&m_alignedTaps2[phase * m_nTaps * 2 + todo * 4 - 4];
-			}
-			// second block
-			src = (const float*)&m_samples[0];
-			block = m_ptr;
-			todo = block / 2;
-			for(int i = 0; i < todo; i++) {
-				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src), *filter));
-				src += 4;
-				filter += 1;
-			}
-			if(block & 1) {
-				// one sample remaining
-				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)src), filter[0]));
-			}
+		// add upper half to lower half and store
+		_mm_storel_pi((__m64*)result, _mm_add_ps(sum, _mm_shuffle_ps(sum, _mm_setzero_ps(), _MM_SHUFFLE(1, 0, 3, 2))));
+#elif defined(USE_NEON)
+		float32x4_t sum = vdupq_n_f32(0.0f);
 
-			// add upper half to lower half and store
-			_mm_storel_pi((__m64*)result, _mm_add_ps(sum, _mm_shuffle_ps(sum, _mm_setzero_ps(), _MM_SHUFFLE(1, 0, 3, 2))));
+		for(int i = 0; i < todo; i++) {
+			sum = vmlaq_f32(sum, vld1q_f32(src), vld1q_f32(coeff));
+			src += 4;
+			coeff += 4;
 		}
+
+		// add upper half to lower half and store
+		vst1_f32((float*)result, vadd_f32(vget_low_f32(sum), vget_high_f32(sum)));
 #else
-		int sample = m_ptr;
-		const Real* coeff = &m_alignedTaps[phase * m_nTaps * 2];
-		Real rAcc = 0;
-		Real iAcc = 0;
-
-		for(int i = 0; i < m_nTaps; i++) {
-			rAcc += *coeff * m_samples[sample].real();
-			iAcc += *coeff * m_samples[sample].imag();
-			sample = (sample + 1) % m_nTaps;
-			coeff += 2;
+		Real acc[4] = {0, 0, 0, 0};
+
+		for(int i = 0; i < todo; i++) {
+			acc[0] += coeff[0] * src[0];
+			acc[1] += coeff[1] * src[1];
+			acc[2] += coeff[2] * src[2];
+			acc[3] += coeff[3] * src[3];
+			src += 4;
+			coeff += 4;
 		}
-		*result = Complex(rAcc, iAcc);
-#endif
 
+		*result = Complex(acc[0] + acc[2], acc[1] + acc[3]);
+#endif
 	}
 };
 
@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+// x86 kernels are compiled for their instruction set whatever the build flags and selected at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HB_BLOCK_X86_RUNTIME
+#define HB_BLOCK_SSE4_1 __attribute__((target("sse4.1")))
+#define HB_BLOCK_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(USE_SSE4_1)
+#define HB_BLOCK_SSE4_1
+#include <smmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "dsp/inthalfbandfilterblock.h"
+
+namespace {
+
+typedef HBFIRFilterTraits<INTHALFBANDFILTERBLOCK_ORDER> Traits;
+
+const int nbTaps = Traits::hbOrder / 4;        // coefficient pairs
+const int oddTip = Traits::hbOrder / 2 - 1;    // newest odd sample of the first output
+const int evenCenter = Traits::hbOrder / 4;    // even sample in the middle of the first output
+const int shift = Traits::hbShift - 1;
+
+// out[k] = (sum(c[i] * (odd[oddTip+k-i] + odd[k+i])) + (even[evenCenter+k] << shift)) >> shift
+// with 32 bit wrap around like IntHalfbandFilterEO<qint32, qint32, 64>
+typedef void (*FIRKernel)(const int32_t *even, const int32_t *odd, int nbOut, int32_t *out);
+
+void firScalar(const int32_t *even, const int32_t *odd, int k, int nbOut, int32_t *out)
+{
+    for (; k < nbOut; k++)
+    {
+        uint32_t acc = ((uint32_t) even[evenCenter + k]) << shift;
+
+        for (int i = 0; i < nbTaps; i++) {
+            acc += ((uint32_t) odd[oddTip + k - i] + (uint32_t) odd[k + i]) * (uint32_t) Traits::hbCoeffs[i];
+        }
+
+        out[k] = ((int32_t) acc) >> shift;
+    }
+}
+
+void firPlain(const int32_t *even, const int32_t *odd, int nbOut, int32_t *out)
+{
+    firScalar(even, odd, 0, nbOut, out);
+}
+
+#if defined(HB_BLOCK_SSE4_1)
+HB_BLOCK_SSE4_1 void firSSE4_1(const int32_t *even, const int32_t *odd, int nbOut, int32_t *out)
+{
+    int k = 0;
+
+    // 16 output samples at a time with 4 accumulators sharing each coefficient
+    for (; k + 16 <= nbOut; k += 16)
+    {
+        __m128i acc[4];
+
+        for (int j = 0; j < 4; j++) {
+            acc[j] = _mm_slli_epi32(_mm_loadu_si128((const __m128i*) &even[evenCenter + k + 4*j]), shift);
+        }
+
+        for (int i = 0; i < nbTaps; i++)
+        {
+            __m128i c = _mm_set1_epi32(Traits::hbCoeffs[i]);
+
+            for (int j = 0; j < 4; j++)
+            {
+                __m128i sum = _mm_add_epi32(
+                        _mm_loadu_si128((const __m128i*) &odd[oddTip + k + 4*j - i]),
+                        _mm_loadu_si128((const __m128i*) &odd[k + 4*j + i]));
+                acc[j] = _mm_add_epi32(acc[j], _mm_mullo_epi32(sum, c));
+            }
+        }
+
+        for (int j = 0; j < 4; j++) {
+            _mm_storeu_si128((__m128i*) &out[k + 4*j], _mm_srai_epi32(acc[j], shift));
+        }
+    }
+
+    firScalar(even, odd, k, nbOut, out);
+}
+#endif
+
+#if defined(HB_BLOCK_AVX2)
+HB_BLOCK_AVX2 void firAVX2(const int32_t *even, const int32_t *odd, int nbOut, int32_t *out)
+{
+    int k = 0;
+
+    // 32 output samples at a time with 4 accumulators sharing each coefficient
+    for (; k + 32 <= nbOut; k += 32)
+    {
+        __m256i acc[4];
+
+        for (int j = 0; j < 4; j++) {
+            acc[j] = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i*) &even[evenCenter + k + 8*j]), shift);
+        }
+
+        for (int i = 0; i < nbTaps; i++)
+        {
+            __m256i c = _mm256_set1_epi32(Traits::hbCoeffs[i]);
+
+            for (int j = 0; j < 4; j++)
+            {
+                __m256i sum = _mm256_add_epi32(
+                        _mm256_loadu_si256((const __m256i*) &odd[oddTip + k + 8*j - i]),
+                        _mm256_loadu_si256((const __m256i*) &odd[k + 8*j + i]));
+                acc[j] = _mm256_add_epi32(acc[j], _mm256_mullo_epi32(sum, c));
+            }
+        }
+
+        for (int j = 0; j < 4; j++) {
+            _mm256_storeu_si256((__m256i*) &out[k + 8*j], _mm256_srai_epi32(acc[j], shift));
+        }
+    }
+
+    firScalar(even, odd, k, nbOut, out);
+}
+#endif
+
+#if defined(USE_NEON) && !defined(HB_BLOCK_X86_RUNTIME)
+void firNEON(const int32_t *even, const int32_t *odd, int nbOut, int32_t *out)
+{
+    int k = 0;
+
+    // 16 output samples at a time with 4 accumulators sharing each coefficient
+    for (; k + 16 <= nbOut; k += 16)
+    {
+        int32x4_t acc[4];
+
+        for (int j = 0; j < 4; j++) {
+            acc[j] = vshlq_n_s32(vld1q_s32(&even[evenCenter + k + 4*j]), shift);
+        }
+
+        for (int i = 0; i < nbTaps; i++)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                int32x4_t sum = vaddq_s32(vld1q_s32(&odd[oddTip + k + 4*j - i]), vld1q_s32(&odd[k + 4*j + i]));
+                acc[j] = vmlaq_n_s32(acc[j], sum, Traits::hbCoeffs[i]);
+            }
+        }
+
+        for (int j = 0; j < 4; j++) {
+            vst1q_s32(&out[k + 4*j], vshrq_n_s32(acc[j], shift));
+        }
+    }
+
+    firScalar(even, odd, k, nbOut, out);
+}
+#endif
+
+struct Kernel
+{
+    FIRKernel m_fir;
+    const char *m_name;
+    bool m_simd; //!< faster than the sample by sample filter
+};
+
+Kernel selectKernel()
+{
+#if defined(HB_BLOCK_X86_RUNTIME)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return Kernel{firAVX2, "AVX2", true};
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        return Kernel{firSSE4_1, "SSE4.1", false};
+    }
+#elif defined(HB_BLOCK_SSE4_1)
+    return Kernel{firSSE4_1, "SSE4.1", false};
+#elif defined(USE_NEON)
+    return Kernel{firNEON, "NEON", true};
+#endif
+    return Kernel{firPlain, "C++", false};
+}
+
+const Kernel& getKernel()
+{
+    static const Kernel kernel = selectKernel(); // CPU is probed once
+    return kernel;
+}
+
+}
+
+IntHalfbandFilterBlock::IntHalfbandFilterBlock()
+{
+    for (int c = 0; c < 2; c++)
+    {
+        m_even[c].assign(m_historySize, 0);
+        m_odd[c].assign(m_historySize, 0);
+    }
+}
+
+bool IntHalfbandFilterBlock::hasSIMD()
+{
+    return getKernel().m_simd;
+}
+
+const char *IntHalfbandFilterBlock::getKernelName()
+{
+    return getKernel().m_name;
+}
+
+int IntHalfbandFilterBlock::decimate(Mode mode, const int32_t *inI, const int32_t *inQ, int nbIn, int32_t *outI, int32_t *outQ)
+{
+    int nbOut = nbIn / 2;
+
+    for (int c = 0; c < 2; c++)
+    {
+        m_even[c].resize(m_historySize + nbOut);
+        m_odd[c].resize(m_historySize + nbOut);
+    }
+
+    int32_t *evenI = &m_even[0][m_historySize];
+    int32_t *evenQ = &m_even[1][m_historySize];
+    int32_t *oddI = &m_odd[0][m_historySize];
+    int32_t *oddQ = &m_odd[1][m_historySize];
+
+    // split in even and odd samples with the rotation of storeSample32 calls in myDecimateXxx
+    switch (mode)
+    {
+    case ModeLowerHalf:
+        for (int k = 0; k < nbOut; k += 2) // nbOut is even: rotation sequence has 4 input samples
+        {
+            evenI[k] = -inQ[2*k];        evenQ[k] = inI[2*k];
+            oddI[k] = -inI[2*k+1];       oddQ[k] = -inQ[2*k+1];
+            evenI[k+1] = inQ[2*k+2];     evenQ[k+1] = -inI[2*k+2];
+            oddI[k+1] = inI[2*k+3];      oddQ[k+1] = inQ[2*k+3];
+        }
+        break;
+    case ModeUpperHalf:
+        for (int k = 0; k < nbOut; k += 2)
+        {
+            evenI[k] = inQ[2*k];         evenQ[k] = -inI[2*k];
+            oddI[k] = -inI[2*k+1];       oddQ[k] = -inQ[2*k+1];
+            evenI[k+1] = -inQ[2*k+2];    evenQ[k+1] = inI[2*k+2];
+            oddI[k+1] = inI[2*k+3];      oddQ[k+1] = inQ[2*k+3];
+        }
+        break;
+    default:
+        for (int k = 0; k < nbOut; k++)
+        {
+            evenI[k] = inI[2*k];         evenQ[k] = inQ[2*k];
+            oddI[k] = inI[2*k+1];        oddQ[k] = inQ[2*k+1];
+        }
+        break;
+    }
+
+    FIRKernel fir = getKernel().m_fir;
+    fir(m_even[0].data(), m_odd[0].data(), nbOut, outI);
+    fir(m_even[1].data(), m_odd[1].data(), nbOut, outQ);
+
+    // keep the last samples for the next call
+    for (int c = 0; c < 2; c++)
+    {
+        std::copy(m_even[c].end() - m_historySize, m_even[c].end(), m_even[c].begin());
+        std::copy(m_odd[c].end() - m_historySize, m_odd[c].end(), m_odd[c].begin());
+    }
+
+    return nbOut;
+}
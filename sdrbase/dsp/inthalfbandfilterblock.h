@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_INTHALFBANDFILTERBLOCK_H_
+#define SDRBASE_DSP_INTHALFBANDFILTERBLOCK_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "dsp/hbfiltertraits.h"
+#include "export.h"
+
+#define INTHALFBANDFILTERBLOCK_ORDER 64
+
+/**
+ * Half band decimation by 2 of a whole buffer of I/Q samples. This is the filter of the Decimators
+ * (IntHalfbandFilterEO<qint32, qint32, 64> myDecimate, myDecimateInf and myDecimateSup) with the same
+ * 32 bit integer results. Samples are kept in planar even and odd arrays so that the FIR is computed for
+ * several consecutive output samples at once. The kernel is chosen at runtime from the CPU features:
+ * AVX2, SSE4.1 or plain C++ on x86 and NEON on ARM when compiled in.
+ */
+class SDRBASE_API IntHalfbandFilterBlock
+{
+public:
+    enum Mode {
+        ModeCenter,    //!< myDecimate
+        ModeLowerHalf, //!< myDecimateInf: input rotated by +1/4 before filtering
+        ModeUpperHalf  //!< myDecimateSup: input rotated by -1/4 before filtering
+    };
+
+    IntHalfbandFilterBlock();
+
+    /**
+     * Decimate nbIn samples given as planar I and Q arrays. nbIn must be even and a multiple of 4 in half modes
+     * since the rotation restarts at each call. Output may overwrite the input. Returns the number of output samples (nbIn/2).
+     */
+    int decimate(Mode mode, const int32_t *inI, const int32_t *inQ, int nbIn, int32_t *outI, int32_t *outQ);
+
+    static bool hasSIMD();              //!< a vectorized kernel faster than the sample by sample filter is available
+    static const char *getKernelName(); //!< name of the kernel in use
+
+private:
+    static const int m_historySize = HBFIRFilterTraits<INTHALFBANDFILTERBLOCK_ORDER>::hbOrder / 2 - 1; //!< samples kept per phase
+
+    std::vector<int32_t> m_even[2]; //!< I and Q of even samples, history first
+    std::vector<int32_t> m_odd[2];  //!< I and Q of odd samples, history first
+};
+
+#endif /* SDRBASE_DSP_INTHALFBANDFILTERBLOCK_H_ */
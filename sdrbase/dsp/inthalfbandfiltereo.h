@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include "dsp/dsptypes.h"
 #include "dsp/hbfiltertraits.h"
+#include "dsp/inthalfbandfiltereo1i.h"
 #include "export.h"
 
 template<typename EOStorageType, typename AccuType, uint32_t HBFilterOrder>
@@ -62,6 +63,36 @@ public:
         }
     }
 
+    /**
+     * Block variant of workDecimateCenter. Processes nbIn samples from in and writes the decimated
+     * samples to out that can be the same as in (in place). Returns the number of output samples.
+     */
+    int workDecimateCenterBlock(const Sample* in, int nbIn, Sample* out)
+    {
+        int i = 0;
+        int nbOut = 0;
+
+        for (; (i < nbIn) && (m_state != 0); i++) { // realign on first state
+            nbOut += decimateOne(&ThisType::workDecimateCenter, in[i], &out[nbOut]);
+        }
+
+        for (; i + 1 < nbIn; i += 2)
+        {
+            storeSample((FixReal) in[i].real(), (FixReal) in[i].imag());
+            advancePointer();
+
+            storeSample((FixReal) in[i+1].real(), (FixReal) in[i+1].imag());
+            doFIR(&out[nbOut++]);
+            advancePointer();
+        }
+
+        for (; i < nbIn; i++) { // remainder
+            nbOut += decimateOne(&ThisType::workDecimateCenter, in[i], &out[nbOut]);
+        }
+
+        return nbOut;
+    }
+
     // upsample by 2, return center part of original spectrum - double buffer variant
     bool workInterpolateCenterZeroStuffing(Sample* sampleIn, Sample *SampleOut)
     {
@@ -205,6 +236,43 @@ public:
         }
     }
 
+    /**
+     * Block variant of workDecimateLowerHalf. Processes nbIn samples from in and writes the decimated
+     * samples to out that can be the same as in (in place). Returns the number of output samples.
+     */
+    int workDecimateLowerHalfBlock(const Sample* in, int nbIn, Sample* out)
+    {
+        int i = 0;
+        int nbOut = 0;
+
+        for (; (i < nbIn) && (m_state != 0); i++) { // realign on first state
+            nbOut += decimateOne(&ThisType::workDecimateLowerHalf, in[i], &out[nbOut]);
+        }
+
+        for (; i + 3 < nbIn; i += 4)
+        {
+            storeSample((FixReal) -in[i].imag(), (FixReal) in[i].real());
+            advancePointer();
+
+            storeSample((FixReal) -in[i+1].real(), (FixReal) -in[i+1].imag());
+            doFIR(&out[nbOut++]);
+            advancePointer();
+
+            storeSample((FixReal) in[i+2].imag(), (FixReal) -in[i+2].real());
+            advancePointer();
+
+            storeSample((FixReal) in[i+3].real(), (FixReal) in[i+3].imag());
+            doFIR(&out[nbOut++]);
+            advancePointer();
+        }
+
+        for (; i < nbIn; i++) { // remainder
+            nbOut += decimateOne(&ThisType::workDecimateLowerHalf, in[i], &out[nbOut]);
+        }
+
+        return nbOut;
+    }
+
     // upsample by 2, from lower half of original spectrum - double buffer variant
     bool workInterpolateLowerHalfZeroStuffing(Sample* sampleIn, Sample *sampleOut)
     {
@@ -404,6 +472,43 @@ public:
         }
     }
 
+    /**
+     * Block variant of workDecimateUpperHalf. Processes nbIn samples from in and writes the decimated
+     * samples to out that can be the same as in (in place). Returns the number of output samples.
+     */
+    int workDecimateUpperHalfBlock(const Sample* in, int nbIn, Sample* out)
+    {
+        int i = 0;
+        int nbOut = 0;
+
+        for (; (i < nbIn) && (m_state != 0); i++) { // realign on first state
+            nbOut += decimateOne(&ThisType::workDecimateUpperHalf, in[i], &out[nbOut]);
+        }
+
+        for (; i + 3 < nbIn; i += 4)
+        {
+            storeSample((FixReal) in[i].imag(), (FixReal) -in[i].real());
+            advancePointer();
+
+            storeSample((FixReal) -in[i+1].real(), (FixReal) -in[i+1].imag());
+            doFIR(&out[nbOut++]);
+            advancePointer();
+
+            storeSample((FixReal) -in[i+2].imag(), (FixReal) in[i+2].real());
+            advancePointer();
+
+            storeSample((FixReal) in[i+3].real(), (FixReal) in[i+3].imag());
+            doFIR(&out[nbOut++]);
+            advancePointer();
+        }
+
+        for (; i < nbIn; i++) { // remainder
+            nbOut += decimateOne(&ThisType::workDecimateUpperHalf, in[i], &out[nbOut]);
+        }
+
+        return nbOut;
+    }
+
     // upsample by 2, move original spectrum to upper half - double buffer variant
     bool workInterpolateUpperHalfZeroStuffing(Sample* sampleIn, Sample *sampleOut)
     {
@@ -740,6 +845,8 @@ public:
     }
 
 protected:
+    typedef IntHalfbandFilterEO<EOStorageType, AccuType, HBFilterOrder> ThisType;
+
     EOStorageType m_even[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder];
     EOStorageType m_odd[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder];
     int32_t m_samples[HBFIRFilterTraits<HBFilterOrder>::hbOrder][2];
@@ -789,29 +896,63 @@ protected:
         m_ptr = m_ptr + 1 < 2*m_size ? m_ptr + 1: 0;
     }
 
+    /** Run one sample through a single sample work function. Returns 1 if a sample was output */
+    int decimateOne(bool (ThisType::*workFunction)(Sample*), const Sample& in, Sample* out)
+    {
+        Sample s(in);
+
+        if ((this->*workFunction)(&s))
+        {
+            *out = s;
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
     void doFIR(Sample* sample)
     {
         AccuType iAcc = 0;
         AccuType qAcc = 0;
 
-        int a = m_ptr/2 + m_size; // tip pointer
-        int b = m_ptr/2 + 1; // tail pointer
-
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
+#if defined(USE_SSE4_1) && !defined(NO_DSP_SIMD)
+        if ((sizeof(EOStorageType) == sizeof(int32_t)) && (sizeof(AccuType) == sizeof(int32_t)))
         {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += (m_even[0][a] + m_even[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += (m_even[1][a] + m_even[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
+            int32_t iAcc32, qAcc32;
+            IntHalfbandFilterEO1Intrisics<HBFilterOrder>::work(
+                    m_ptr,
+                    (int32_t (*)[HBFilterOrder]) m_even,
+                    (int32_t (*)[HBFilterOrder]) m_odd,
+                    iAcc32,
+                    qAcc32
+            );
+            iAcc = iAcc32;
+            qAcc = qAcc32;
+        }
+        else
+#endif
+        {
+            int a = m_ptr/2 + m_size; // tip pointer
+            int b = m_ptr/2 + 1; // tail pointer
+
+            for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
             {
-                iAcc += (m_odd[0][a] + m_odd[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += (m_odd[1][a] + m_odd[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                if ((m_ptr % 2) == 0)
+                {
+                    iAcc += (m_even[0][a] + m_even[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                    qAcc += (m_even[1][a] + m_even[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                }
+                else
+                {
+                    iAcc += (m_odd[0][a] + m_odd[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                    qAcc += (m_odd[1][a] + m_odd[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                }
+
+                a -= 1;
+                b += 1;
             }
-
-            a -= 1;
-            b += 1;
         }
 
         if ((m_ptr % 2) == 0)
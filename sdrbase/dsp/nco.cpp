@@ -19,6 +19,13 @@
 #include <stdio.h>
 #define _USE_MATH_DEFINES
 #include <math.h>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "dsp/nco.h"
 
 #undef M_PI
@@ -106,3 +113,78 @@ void NCO::getQI(Complex& c)
 	c.imag(m_table[m_phase]);
 	c.real(-m_table[(m_phase + TableSize / 4) % TableSize]);
 }
+
+void NCO::mix4(const Sample* in, const Real* u, const Real* v, Complex* out)
+{
+#if defined(USE_SSE2)
+#ifdef SDR_RX_SAMPLE_24BIT
+	__m128 a = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &in[0])); // r0 i0 r1 i1
+	__m128 b = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &in[2])); // r2 i2 r3 i3
+	__m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+	__m128 y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+#else
+	__m128i a = _mm_loadu_si128((const __m128i*) &in[0]); // r0 i0 r1 i1 r2 i2 r3 i3
+	__m128 x = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16));
+	__m128 y = _mm_cvtepi32_ps(_mm_srai_epi32(a, 16));
+#endif
+	__m128 uv = _mm_loadu_ps(u);
+	__m128 vv = _mm_loadu_ps(v);
+	__m128 re = _mm_sub_ps(_mm_mul_ps(x, uv), _mm_mul_ps(y, vv));
+	__m128 im = _mm_add_ps(_mm_mul_ps(x, vv), _mm_mul_ps(y, uv));
+	_mm_storeu_ps((float*) &out[0], _mm_unpacklo_ps(re, im));
+	_mm_storeu_ps((float*) &out[2], _mm_unpackhi_ps(re, im));
+#elif defined(USE_NEON)
+#ifdef SDR_RX_SAMPLE_24BIT
+	int32x4x2_t a = vld2q_s32((const int32_t*) &in[0]);
+	float32x4_t x = vcvtq_f32_s32(a.val[0]);
+	float32x4_t y = vcvtq_f32_s32(a.val[1]);
+#else
+	int16x4x2_t a = vld2_s16((const int16_t*) &in[0]);
+	float32x4_t x = vcvtq_f32_s32(vmovl_s16(a.val[0]));
+	float32x4_t y = vcvtq_f32_s32(vmovl_s16(a.val[1]));
+#endif
+	float32x4_t uv = vld1q_f32(u);
+	float32x4_t vv = vld1q_f32(v);
+	float32x4x2_t r;
+	r.val[0] = vsubq_f32(vmulq_f32(x, uv), vmulq_f32(y, vv));
+	r.val[1] = vaddq_f32(vmulq_f32(x, vv), vmulq_f32(y, uv));
+	vst2q_f32((float*) &out[0], r);
+#else
+	for (int k = 0; k < 4; k++)
+	{
+		Real x = in[k].real();
+		Real y = in[k].imag();
+		out[k] = Complex(x*u[k] - y*v[k], x*v[k] + y*u[k]);
+	}
+#endif
+}
+
+void NCO::mix(const Sample* in, Complex* out, int n)
+{
+	// NCO values are looked up in the table as in nextIQ() four at a time
+	// and the complex multiplication is done on four samples in parallel
+	Real u[4], v[4];
+	int i = 0;
+
+	for (; i + 4 <= n; i += 4)
+	{
+		for (int k = 0; k < 4; k++)
+		{
+			nextPhase();
+			u[k] = m_table[m_phase];
+			v[k] = -m_table[(m_phase + TableSize / 4) & (TableSize - 1)];
+		}
+
+		mix4(&in[i], u, v, &out[i]);
+	}
+
+	for (; i < n; i++)
+	{
+		nextPhase();
+		Real x = in[i].real();
+		Real y = in[i].imag();
+		Real u = m_table[m_phase];
+		Real v = -m_table[(m_phase + TableSize / 4) & (TableSize - 1)];
+		out[i] = Complex(x*u - y*v, x*v + y*u);
+	}
+}
@@ -42,11 +42,7 @@ public:
 
 	void nextPhase()        //!< Increment phase
 	{
-		m_phase += m_phaseIncrement;
-		while(m_phase >= TableSize)
-			m_phase -= TableSize;
-		while(m_phase < 0)
-			m_phase += TableSize;
+		m_phase = (m_phase + m_phaseIncrement) & (TableSize - 1); // same as wrapping into [0, TableSize[
 	}
 
 	Real next();            //!< Return next real sample
@@ -58,6 +54,18 @@ public:
 	void getIQ(Complex& c); //!< Sets to the current complex sample (no phase increment)
 	Complex getQI();        //!< Return current complex sample (no phase increment, reversed)
 	void getQI(Complex& c); //!< Sets to the current complex sample (no phase increment, reversed)
+
+	/** Complex multiply 4 samples by 4 NCO values: out[k] = in[k] * (u[k] + j v[k]). SIMD when available. */
+	static void mix4(const Sample* in, const Real* u, const Real* v, Complex* out);
+
+	/** Mix a block of samples with the NCO: out[i] = in[i] * nextIQ() */
+	void mix(const Sample* in, Complex* out, int n);
+	void mix(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, Complex* out)
+	{
+		if (end > begin) {
+			mix(&(*begin), out, end - begin);
+		}
+	}
 };
 
 #endif // INCLUDE_NCO_H
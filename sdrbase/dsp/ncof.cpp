@@ -19,6 +19,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include "dsp/ncof.h"
+#include "dsp/nco.h"
 
 #undef M_PI
 #define M_PI		3.14159265358979323846
@@ -105,3 +106,31 @@ void NCOF::getQI(Complex& c)
 	c.imag(m_table[(int) m_phase]);
 	c.real(-m_table[((int) m_phase + TableSize / 4) % TableSize]);
 }
+
+void NCOF::mix(const Sample* in, Complex* out, int n)
+{
+	Real u[4], v[4];
+	int i = 0;
+
+	for (; i + 4 <= n; i += 4)
+	{
+		for (int k = 0; k < 4; k++)
+		{
+			int phase = nextPhase();
+			u[k] = m_table[phase];
+			v[k] = -m_table[(phase + TableSize / 4) % TableSize];
+		}
+
+		NCO::mix4(&in[i], u, v, &out[i]);
+	}
+
+	for (; i < n; i++)
+	{
+		int phase = nextPhase();
+		Real x = in[i].real();
+		Real y = in[i].imag();
+		Real u = m_table[phase];
+		Real v = -m_table[(phase + TableSize / 4) % TableSize];
+		out[i] = Complex(x*u - y*v, x*v + y*u);
+	}
+}
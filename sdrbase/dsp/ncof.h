@@ -61,6 +61,15 @@ public:
 	void getIQ(Complex& c);             //!< Sets to the current complex sample (no phase increment)
 	Complex getQI();                    //!< Return current complex sample (no phase increment, reversed)
 	void getQI(Complex& c);             //!< Sets to the current complex sample (no phase increment, reversed)
+
+	/** Mix a block of samples with the NCO: out[i] = in[i] * nextIQ() */
+	void mix(const Sample* in, Complex* out, int n);
+	void mix(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, Complex* out)
+	{
+		if (end > begin) {
+			mix(&(*begin), out, end - begin);
+		}
+	}
 };
 
 #endif // INCLUDE_NCO_H
@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "dsp/fftengine.h"
+#include "dsp/wfir.h"
+#include "polyphasechannelizer.h"
+
+PolyphaseChannelizer::PolyphaseChannelizer() :
+    m_nbChannels(0),
+    m_nbTaps(0),
+    m_decimation(0),
+    m_historyIndex(0),
+    m_inputCount(0),
+    m_oddFrame(false),
+    m_fft(0)
+{
+}
+
+PolyphaseChannelizer::~PolyphaseChannelizer()
+{
+    delete m_fft;
+}
+
+void PolyphaseChannelizer::configure(int nbChannels, int tapsPerBranch)
+{
+    if ((nbChannels < 4) || (nbChannels % 2 != 0) || (tapsPerBranch < 1)) {
+        nbChannels = 0;
+    }
+
+    m_nbChannels = nbChannels;
+    m_nbTaps = nbChannels * tapsPerBranch;
+    m_decimation = nbChannels / 2;
+    m_historyIndex = 0;
+    m_inputCount = 0;
+    m_oddFrame = false;
+    m_activeBins.assign(nbChannels, false);
+    m_activeBinIndexes.clear();
+    m_binSamples.clear();
+    m_binSamples.resize(nbChannels);
+
+    if (nbChannels == 0)
+    {
+        m_taps.clear();
+        m_history.clear();
+        return;
+    }
+
+    // prototype low pass: cutoff at 0.6 channel spacing leaves the transition band
+    // within the 2x oversampled bin bandwidth
+    std::vector<double> taps(m_nbTaps);
+    WFIR::BasicFIR(taps.data(), m_nbTaps, WFIR::LPF, 1.2 / nbChannels, 0.0, WFIR::wtKAISER, 8.0);
+    double sum = 0.0;
+
+    for (int i = 0; i < m_nbTaps; i++) {
+        sum += taps[i];
+    }
+
+    m_taps.resize(m_nbTaps);
+
+    for (int i = 0; i < m_nbTaps; i++) {
+        m_taps[i] = taps[i] / sum;
+    }
+
+    m_history.assign(2 * m_nbTaps, Complex(0.0, 0.0));
+
+    if (m_fft == 0) {
+        m_fft = FFTEngine::create();
+    }
+
+    m_fft->configure(nbChannels, true);
+}
+
+void PolyphaseChannelizer::setBinActive(int bin, bool active)
+{
+    if ((bin < 0) || (bin >= m_nbChannels)) {
+        return;
+    }
+
+    m_activeBins[bin] = active;
+    m_activeBinIndexes.clear();
+
+    for (int i = 0; i < m_nbChannels; i++)
+    {
+        if (m_activeBins[i]) {
+            m_activeBinIndexes.push_back(i);
+        }
+    }
+}
+
+void PolyphaseChannelizer::clearActiveBins()
+{
+    std::fill(m_activeBins.begin(), m_activeBins.end(), false);
+    m_activeBinIndexes.clear();
+}
+
+void PolyphaseChannelizer::clearOutputs()
+{
+    for (std::vector<int>::const_iterator it = m_activeBinIndexes.begin(); it != m_activeBinIndexes.end(); ++it) {
+        m_binSamples[*it].clear();
+    }
+}
+
+void PolyphaseChannelizer::feed(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    if ((m_nbChannels == 0) || m_activeBinIndexes.empty()) {
+        return;
+    }
+
+    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    {
+        Complex c(it->real(), it->imag());
+        m_history[m_historyIndex] = c;
+        m_history[m_historyIndex + m_nbTaps] = c;
+        m_historyIndex = (m_historyIndex + 1) % m_nbTaps;
+
+        if (++m_inputCount == m_decimation)
+        {
+            m_inputCount = 0;
+            processFrame();
+        }
+    }
+}
+
+void PolyphaseChannelizer::processFrame()
+{
+    // window is m_history[m_historyIndex .. m_historyIndex + L - 1] newest last
+    // so x[n - l] = newest[-l] and u[m] = sum_p h[m + pM] x[n - m - pM]
+    const Complex *newest = &m_history[m_historyIndex + m_nbTaps - 1];
+    Complex *u = m_fft->in();
+
+    for (int m = 0; m < m_nbChannels; m++)
+    {
+        Complex acc(0.0, 0.0);
+
+        for (int l = m; l < m_nbTaps; l += m_nbChannels) {
+            acc += newest[-l] * m_taps[l];
+        }
+
+        u[m] = acc;
+    }
+
+    m_fft->transform();
+    const Complex *y = m_fft->out();
+
+    // the frame advances by M/2 samples so bin k rotates by (-1)^k every other frame
+    for (std::vector<int>::const_iterator it = m_activeBinIndexes.begin(); it != m_activeBinIndexes.end(); ++it)
+    {
+        int k = *it;
+        Real re = y[k].real();
+        Real im = y[k].imag();
+
+        if (m_oddFrame && (k % 2 != 0))
+        {
+            re = -re;
+            im = -im;
+        }
+
+        m_binSamples[k].push_back(Sample((FixReal) re, (FixReal) im));
+    }
+
+    m_oddFrame = !m_oddFrame;
+}
+
+int PolyphaseChannelizer::getBinIndex(qint64 frequencyOffset, int bandwidth, int sampleRate, int nbChannels)
+{
+    if ((nbChannels <= 0) || (sampleRate <= 0) || (sampleRate % nbChannels != 0)) {
+        return -1;
+    }
+
+    qint64 spacing = sampleRate / nbChannels;
+
+    if ((bandwidth > spacing) || (frequencyOffset % spacing != 0)) {
+        return -1;
+    }
+
+    qint64 k = frequencyOffset / spacing;
+
+    if ((k <= -nbChannels/2) || (k >= nbChannels/2)) {
+        return -1;
+    }
+
+    return k < 0 ? k + nbChannels : k;
+}
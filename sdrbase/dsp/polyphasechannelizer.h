@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_POLYPHASECHANNELIZER_H_
+#define SDRBASE_DSP_POLYPHASECHANNELIZER_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class FFTEngine;
+
+/**
+ * Uniform polyphase FFT filter bank. The input band is split into M channels spaced
+ * by fs/M using a single prototype low pass filter and one inverse FFT of size M per
+ * output frame. Frames are produced every M/2 input samples (2x oversampled bins) so
+ * the output rate of each bin is 2*fs/M and channel edges do not alias into the bin.
+ * Only the bins marked active are collected into their output sample vectors.
+ */
+class SDRBASE_API PolyphaseChannelizer
+{
+public:
+    PolyphaseChannelizer();
+    ~PolyphaseChannelizer();
+
+    /** Set the number of channels (even, >= 4) or 0 to disable. Resets the active bins. */
+    void configure(int nbChannels, int tapsPerBranch = 8);
+    int getNbChannels() const { return m_nbChannels; }
+    int getDecimation() const { return m_nbChannels / 2; }
+    bool isEnabled() const { return m_nbChannels > 0; }
+
+    void setBinActive(int bin, bool active);
+    void clearActiveBins();
+
+    void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+    const SampleVector& getBinSamples(int bin) const { return m_binSamples[bin]; }
+    void clearOutputs();
+
+    /**
+     * Bin index serving a channel at frequencyOffset with the given bandwidth or -1 if the
+     * channel is not centered on a bin or does not fit in the bin spacing.
+     */
+    static int getBinIndex(qint64 frequencyOffset, int bandwidth, int sampleRate, int nbChannels);
+
+private:
+    int m_nbChannels;     //!< M
+    int m_nbTaps;         //!< L = M * taps per branch
+    int m_decimation;     //!< M/2
+    std::vector<float> m_taps;
+    std::vector<Complex> m_history; //!< 2*L samples: each sample is stored twice so the window is always contiguous
+    int m_historyIndex;
+    int m_inputCount;
+    bool m_oddFrame;
+    FFTEngine *m_fft;
+    std::vector<bool> m_activeBins;
+    std::vector<int> m_activeBinIndexes;
+    std::vector<SampleVector> m_binSamples;
+
+    void processFrame();
+};
+
+#endif /* SDRBASE_DSP_POLYPHASECHANNELIZER_H_ */
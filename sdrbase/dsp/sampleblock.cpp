@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QGlobalStatic>
+
+#include "sampleblock.h"
+
+void SampleBlock::unref()
+{
+    if (!m_refCount.deref()) {
+        m_pool->recycle(this);
+    }
+}
+
+SampleBlockPool::SampleBlockPool(unsigned int maxFreeBlocks) :
+    m_maxFreeBlocks(maxFreeBlocks),
+    m_nbBlocksInUse(0)
+{
+    m_freeBlocks.reserve(maxFreeBlocks);
+}
+
+SampleBlockPool::~SampleBlockPool()
+{
+    for (std::vector<SampleBlock*>::iterator it = m_freeBlocks.begin(); it != m_freeBlocks.end(); ++it) {
+        delete *it;
+    }
+}
+
+Q_GLOBAL_STATIC(SampleBlockPool, sampleBlockPool)
+SampleBlockPool *SampleBlockPool::instance()
+{
+    return sampleBlockPool;
+}
+
+SampleBlock *SampleBlockPool::allocate(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    SampleBlock *block = 0;
+
+    m_mutex.lock();
+
+    if (m_freeBlocks.size() > 0)
+    {
+        block = m_freeBlocks.back();
+        m_freeBlocks.pop_back();
+    }
+
+    m_mutex.unlock();
+
+    if (block == 0) {
+        block = new SampleBlock(this);
+    }
+
+    block->m_samples.assign(begin, end); // keeps capacity of recycled blocks
+    block->m_refCount.storeRelease(1);
+    m_nbBlocksInUse.ref();
+
+    return block;
+}
+
+void SampleBlockPool::recycle(SampleBlock *block)
+{
+    m_nbBlocksInUse.deref();
+    m_mutex.lock();
+
+    if (m_freeBlocks.size() < m_maxFreeBlocks)
+    {
+        m_freeBlocks.push_back(block);
+        block = 0;
+    }
+
+    m_mutex.unlock();
+
+    delete block;
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLEBLOCK_H_
+#define SDRBASE_DSP_SAMPLEBLOCK_H_
+
+#include <vector>
+#include <QAtomicInt>
+#include <QMutex>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SampleBlockPool;
+
+/**
+ * Reference counted block of samples. A block is filled once by the producer when allocated
+ * from the pool and is then only read by its consumers so it can be shared between threads
+ * without copy. Each consumer holds a reference and calls unref() when done. The last
+ * unref() returns the block to its pool.
+ */
+class SDRBASE_API SampleBlock
+{
+public:
+    const SampleVector& samples() const { return m_samples; }
+    SampleVector::const_iterator begin() const { return m_samples.begin(); }
+    SampleVector::const_iterator end() const { return m_samples.end(); }
+    unsigned int size() const { return m_samples.size(); }
+
+    void ref() { m_refCount.ref(); }
+    void unref();
+
+private:
+    friend class SampleBlockPool;
+
+    SampleBlock(SampleBlockPool *pool) : m_refCount(0), m_pool(pool) {}
+    ~SampleBlock() {}
+
+    SampleVector m_samples;
+    QAtomicInt m_refCount;
+    SampleBlockPool *m_pool;
+};
+
+/**
+ * Recycles sample blocks so that their storage is not reallocated for every published block.
+ * Allocation happens on the producer thread and release on any consumer thread.
+ */
+class SDRBASE_API SampleBlockPool
+{
+public:
+    SampleBlockPool(unsigned int maxFreeBlocks = 64);
+    ~SampleBlockPool();
+
+    static SampleBlockPool *instance(); //!< pool shared by all device engines
+
+    /** Get a block filled with a copy of the samples. The caller owns one reference. */
+    SampleBlock *allocate(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+
+    int getNbBlocksInUse() const { return m_nbBlocksInUse.load(); }
+
+private:
+    friend class SampleBlock;
+
+    void recycle(SampleBlock *block);
+
+    QMutex m_mutex;
+    std::vector<SampleBlock*> m_freeBlocks;
+    unsigned int m_maxFreeBlocks;
+    QAtomicInt m_nbBlocksInUse;
+};
+
+#endif /* SDRBASE_DSP_SAMPLEBLOCK_H_ */
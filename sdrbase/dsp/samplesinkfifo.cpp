@@ -21,32 +21,51 @@
 
 void SampleSinkFifo::create(uint s)
 {
+	uint size = 0;
+
+	if (s > 0)
+	{
+		size = 1;
+
+		while (size < s) {
+			size <<= 1;
+		}
+	}
+
 	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_sizeMask = 0;
+	m_head.storeRelease(0);
+	m_tail.storeRelease(0);
+	m_dataReadySignaled.storeRelease(0);
 
-	m_data.resize(s);
-	m_size = m_data.size();
+	m_data.resize(2*size);
+	m_size = m_data.size() / 2;
 
-	if(m_size != s)
+	if(m_size != size) {
 		qCritical("SampleSinkFifo: out of memory");
+	} else if (m_size > 0) {
+		m_sizeMask = m_size - 1;
+	}
 }
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_head(0),
+	m_tail(0),
+	m_dataReadySignaled(0)
 {
 	m_suppressed = -1;
 	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_sizeMask = 0;
 }
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_head(0),
+	m_tail(0),
+	m_dataReadySignaled(0)
 {
 	m_suppressed = -1;
 
@@ -55,8 +74,6 @@ SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 
 SampleSinkFifo::~SampleSinkFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	m_size = 0;
 }
 
@@ -64,19 +81,15 @@ bool SampleSinkFifo::setSize(int size)
 {
 	create(size);
 
-	return m_data.size() == (uint)size;
+	return (m_size >= (uint) size) && (m_data.size() == 2*m_size);
 }
 
-uint SampleSinkFifo::write(const quint8* data, uint count)
+uint SampleSinkFifo::writeSamples(const Sample* begin, uint count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-	uint total;
-	uint remaining;
-	uint len;
-	const Sample* begin = (const Sample*)data;
-	count /= sizeof(Sample);
-
-	total = MIN(count, m_size - m_fill);
+	uint tail = (uint) m_tail.load(); // only modified by this (writer) thread
+	uint head = (uint) m_head.loadAcquire();
+	uint total = MIN(count, m_size - (tail - head));
+
 	if(total < count) {
 		if(m_suppressed < 0) {
 			m_suppressed = 0;
@@ -93,86 +106,69 @@ uint SampleSinkFifo::write(const quint8* data, uint count)
 		}
 	}
 
-	remaining = total;
-	while(remaining > 0) {
-		len = MIN(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
-		m_tail += len;
-		m_tail %= m_size;
-		m_fill += len;
-		begin += len;
-		remaining -= len;
+	if (total > 0)
+	{
+		uint index = tail & m_sizeMask;
+		uint len = MIN(total, m_size - index);
+
+		// write data and its mirror
+		std::copy(begin, begin + len, m_data.begin() + index);
+		std::copy(begin, begin + len, m_data.begin() + index + m_size);
+
+		if (len < total) // wrap around
+		{
+			std::copy(begin + len, begin + total, m_data.begin());
+			std::copy(begin + len, begin + total, m_data.begin() + m_size);
+		}
+
+		tail += total;
+		m_tail.storeRelease((int) tail);
 	}
 
-	if(m_fill > 0)
+	// signal only if the reader has already picked up the previous signal
+	if (((tail - head) > 0) && m_dataReadySignaled.testAndSetOrdered(0, 1)) {
 		emit dataReady();
+	}
 
 	return total;
 }
 
-uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+uint SampleSinkFifo::write(const quint8* data, uint count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-	uint count = end - begin;
-	uint total;
-	uint remaining;
-	uint len;
-
-	total = MIN(count, m_size - m_fill);
-	if(total < count) {
-		if(m_suppressed < 0) {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
-			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-		} else {
-			if(m_msgRateTimer.elapsed() > 2500) {
-				qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			} else {
-				m_suppressed++;
-			}
-		}
-	}
+	return writeSamples((const Sample*) data, count / sizeof(Sample));
+}
 
-	remaining = total;
-	while(remaining > 0) {
-		len = MIN(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
-		m_tail += len;
-		m_tail %= m_size;
-		m_fill += len;
-		begin += len;
-		remaining -= len;
+uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+	if (end <= begin) {
+		return 0;
 	}
 
-	if(m_fill > 0)
-		emit dataReady();
+	return writeSamples(&(*begin), end - begin);
+}
 
-	return total;
+void SampleSinkFifo::handleDataReady()
+{
+	// full barrier so that the tail is looked at after the flag is cleared
+	m_dataReadySignaled.fetchAndStoreOrdered(0);
 }
 
 uint SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	handleDataReady();
+
 	uint count = end - begin;
-	uint total;
-	uint remaining;
-	uint len;
+	uint head = (uint) m_head.load(); // only modified by this (reader) thread
+	uint total = MIN(count, (uint) m_tail.loadAcquire() - head);
 
-	total = MIN(count, m_fill);
 	if(total < count)
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
 
-	remaining = total;
-	while(remaining > 0) {
-		len = MIN(remaining, m_size - m_head);
-		std::copy(m_data.begin() + m_head, m_data.begin() + m_head + len, begin);
-		m_head += len;
-		m_head %= m_size;
-		m_fill -= len;
-		begin += len;
-		remaining -= len;
+	if (total > 0)
+	{
+		SampleVector::const_iterator start = m_data.begin() + (head & m_sizeMask);
+		std::copy(start, start + total, begin);
+		m_head.storeRelease((int) (head + total));
 	}
 
 	return total;
@@ -182,50 +178,47 @@ uint SampleSinkFifo::readBegin(uint count,
 	SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 	SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-	uint total;
-	uint remaining;
-	uint len;
-	uint head = m_head;
+	// acknowledge the signal before looking at the tail so that any sample written
+	// after this point is notified again
+	handleDataReady();
+
+	uint head = (uint) m_head.load(); // only modified by this (reader) thread
+	uint total = MIN(count, (uint) m_tail.loadAcquire() - head);
 
-	total = MIN(count, m_fill);
 	if(total < count)
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
 
-	remaining = total;
-	if(remaining > 0) {
-		len = MIN(remaining, m_size - head);
-		*part1Begin = m_data.begin() + head;
-		*part1End = m_data.begin() + head + len;
-		head += len;
-		head %= m_size;
-		remaining -= len;
-	} else {
+	if (total > 0)
+	{
+		// thanks to the mirror the whole block is always contiguous
+		*part1Begin = m_data.begin() + (head & m_sizeMask);
+		*part1End = *part1Begin + total;
+	}
+	else
+	{
 		*part1Begin = m_data.end();
 		*part1End = m_data.end();
 	}
-	if(remaining > 0) {
-		len = MIN(remaining, m_size - head);
-		*part2Begin = m_data.begin() + head;
-		*part2End = m_data.begin() + head + len;
-	} else {
-		*part2Begin = m_data.end();
-		*part2End = m_data.end();
-	}
+
+	*part2Begin = m_data.end();
+	*part2End = m_data.end();
 
 	return total;
 }
 
 uint SampleSinkFifo::readCommit(uint count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	handleDataReady();
 
-	if(count > m_fill) {
+	uint head = (uint) m_head.load(); // only modified by this (reader) thread
+	uint fill = (uint) m_tail.loadAcquire() - head;
+
+	if(count > fill) {
 		qCritical("SampleSinkFifo: cannot commit more than available samples");
-		count = m_fill;
+		count = fill;
 	}
-	m_head = (m_head + count) % m_size;
-	m_fill -= count;
+
+	m_head.storeRelease((int) (head + count));
 
 	return count;
 }
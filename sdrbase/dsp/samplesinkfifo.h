@@ -19,36 +19,50 @@
 #define INCLUDE_SAMPLEFIFO_H
 
 #include <QObject>
-#include <QMutex>
+#include <QAtomicInt>
 #include <QTime>
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+/**
+ * Single producer single consumer sample FIFO.
+ *
+ * The device thread is the only writer and the DSP engine (or channel) thread the only reader.
+ * Head and tail are free running atomic counters so that neither side ever takes a lock.
+ * The storage has a power of two size and is mirrored (every sample is written at index i
+ * and i + size) so that readBegin always returns one contiguous part. The second part is kept
+ * in the interface for compatibility and is always empty.
+ * dataReady() is emitted only when the reader has acknowledged the previous signal
+ * so that there is usually one pending wakeup in the reader event loop. The reader must call
+ * handleDataReady() as the first thing in its dataReady() slot, before any early return.
+ * read(), readBegin() and readCommit() acknowledge it as well.
+ */
 class SDRBASE_API SampleSinkFifo : public QObject {
 	Q_OBJECT
 
 private:
-	QMutex m_mutex;
 	QTime m_msgRateTimer;
 	int m_suppressed;
 
-	SampleVector m_data;
+	SampleVector m_data; //!< 2 * m_size samples: data and its mirror
 
-	uint m_size;
-	uint m_fill;
-	uint m_head;
-	uint m_tail;
+	uint m_size;        //!< FIFO capacity (power of two)
+	uint m_sizeMask;    //!< m_size - 1
+	QAtomicInt m_head;  //!< read counter (written by reader only)
+	QAtomicInt m_tail;  //!< write counter (written by writer only)
+	QAtomicInt m_dataReadySignaled; //!< dataReady() is pending in the reader event loop
 
 	void create(uint s);
+	uint writeSamples(const Sample* begin, uint count);
 
 public:
 	SampleSinkFifo(QObject* parent = NULL);
 	SampleSinkFifo(int size, QObject* parent = NULL);
 	~SampleSinkFifo();
 
-	bool setSize(int size);
+	bool setSize(int size); //!< actual size is rounded up to the next power of two. Not thread safe.
 	inline uint size() const { return m_size; }
-	inline uint fill() { QMutexLocker mutexLocker(&m_mutex); uint fill = m_fill; return fill; }
+	inline uint fill() const { return (uint) m_tail.loadAcquire() - (uint) m_head.loadAcquire(); }
 
 	uint write(const quint8* data, uint count);
 	uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
@@ -60,6 +74,8 @@ public:
 		SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
 	uint readCommit(uint count);
 
+	void handleDataReady(); //!< acknowledge dataReady() so that the next write signals again
+
 signals:
 	void dataReady();
 };
@@ -91,3 +91,25 @@ void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt)
 
     writeAt = m_data.begin() + m_iw;
 }
+
+void SampleSourceFifo::getWriteIterator(SampleVector::iterator& writeAt, unsigned int& nbSamples)
+{
+    writeAt = m_data.begin() + m_iw;
+
+    if (nbSamples > m_size - m_iw) {
+        nbSamples = m_size - m_iw;
+    }
+}
+
+void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt, unsigned int nbSamples)
+{
+    assert(m_iw + nbSamples <= m_size);
+    std::copy(m_data.begin() + m_iw, m_data.begin() + m_iw + nbSamples, m_data.begin() + m_iw + m_size);
+
+    {
+//        QMutexLocker mutexLocker(&m_mutex);
+        m_iw = (m_iw + nbSamples) % m_size;
+    }
+
+    writeAt = m_data.begin() + m_iw;
+}
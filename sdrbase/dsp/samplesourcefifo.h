@@ -40,6 +40,8 @@ public:
     void getReadIterator(SampleVector::iterator& readUntil); //!< get iterator past the last sample of a read advance operation (i.e. current read iterator)
     void getWriteIterator(SampleVector::iterator& writeAt);  //!< get iterator to current item for update - write phase 1
     void bumpIndex(SampleVector::iterator& writeAt);         //!< copy current item to second buffer and bump write index - write phase 2
+    void getWriteIterator(SampleVector::iterator& writeAt, unsigned int& nbSamples); //!< same as above and reduce nbSamples to what can be written contiguously - block write phase 1
+    void bumpIndex(SampleVector::iterator& writeAt, unsigned int nbSamples);         //!< copy nbSamples written items to second buffer and bump write index - block write phase 2
 
     void write(const Sample& sample);                        //!< write directly - phase 1 + phase 2
 
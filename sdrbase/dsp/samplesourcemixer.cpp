@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "dsp/samplesourcemixer.h"
+
+namespace {
+
+const qint32 txMax = (1<<(SDR_TX_SAMP_SZ-1)) - 1;
+const qint32 txMin = -(1<<(SDR_TX_SAMP_SZ-1));
+
+inline qint32 divide(qint32 v, unsigned int log2Divisor)
+{
+    return v >> log2Divisor;
+}
+
+inline FixReal saturate(qint32 v)
+{
+    return v > txMax ? txMax : v < txMin ? txMin : v;
+}
+
+#if defined(USE_SSE2)
+#ifdef SDR_RX_SAMPLE_24BIT
+inline __m128i divide(__m128i v, unsigned int log2Divisor)
+{
+    return _mm_sra_epi32(v, _mm_cvtsi32_si128(log2Divisor));
+}
+
+inline __m128i saturate(__m128i v)
+{
+    // pack with signed saturation to 16 bits then sign extend back to 32 bits
+    __m128i p = _mm_packs_epi32(v, v);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(p, p), 16);
+}
+#else
+inline __m128i divide(__m128i v, unsigned int log2Divisor)
+{
+    return _mm_sra_epi16(v, _mm_cvtsi32_si128(log2Divisor));
+}
+#endif
+#elif defined(USE_NEON)
+#ifdef SDR_RX_SAMPLE_24BIT
+inline int32x4_t divide(int32x4_t v, unsigned int log2Divisor)
+{
+    return vshlq_s32(v, vdupq_n_s32(-(int) log2Divisor));
+}
+#else
+inline int16x8_t divide(int16x8_t v, unsigned int log2Divisor)
+{
+    return vshlq_s16(v, vdupq_n_s16(-(int) log2Divisor));
+}
+#endif
+#endif
+
+}
+
+void SampleSourceMixer::copy(const Sample *in, Sample *out, unsigned int n, unsigned int log2Divisor)
+{
+    unsigned int i = 0;
+#if defined(USE_SSE2)
+#ifdef SDR_RX_SAMPLE_24BIT
+    // 2 samples of 2 x 32 bits at a time
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &in[i]);
+        _mm_storeu_si128((__m128i*) &out[i], divide(s, log2Divisor));
+    }
+#else
+    // 4 samples of 2 x 16 bits at a time
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &in[i]);
+        _mm_storeu_si128((__m128i*) &out[i], divide(s, log2Divisor));
+    }
+#endif
+#elif defined(USE_NEON)
+#ifdef SDR_RX_SAMPLE_24BIT
+    for (; i + 2 <= n; i += 2)
+    {
+        int32x4_t s = vld1q_s32((const int32_t*) &in[i]);
+        vst1q_s32((int32_t*) &out[i], divide(s, log2Divisor));
+    }
+#else
+    for (; i + 4 <= n; i += 4)
+    {
+        int16x8_t s = vld1q_s16((const int16_t*) &in[i]);
+        vst1q_s16((int16_t*) &out[i], divide(s, log2Divisor));
+    }
+#endif
+#endif
+    for (; i < n; i++)
+    {
+        out[i].m_real = divide(in[i].m_real, log2Divisor);
+        out[i].m_imag = divide(in[i].m_imag, log2Divisor);
+    }
+}
+
+void SampleSourceMixer::mix(const Sample *in, Sample *out, unsigned int n, unsigned int log2Divisor)
+{
+    unsigned int i = 0;
+#if defined(USE_SSE2)
+#ifdef SDR_RX_SAMPLE_24BIT
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &in[i]);
+        __m128i o = _mm_loadu_si128((const __m128i*) &out[i]);
+        _mm_storeu_si128((__m128i*) &out[i], saturate(_mm_add_epi32(o, divide(s, log2Divisor))));
+    }
+#else
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &in[i]);
+        __m128i o = _mm_loadu_si128((const __m128i*) &out[i]);
+        _mm_storeu_si128((__m128i*) &out[i], _mm_adds_epi16(o, divide(s, log2Divisor)));
+    }
+#endif
+#elif defined(USE_NEON)
+#ifdef SDR_RX_SAMPLE_24BIT
+    for (; i + 2 <= n; i += 2)
+    {
+        int32x4_t s = vld1q_s32((const int32_t*) &in[i]);
+        int32x4_t o = vld1q_s32((const int32_t*) &out[i]);
+        int32x4_t r = vaddq_s32(o, divide(s, log2Divisor));
+        vst1q_s32((int32_t*) &out[i], vmovl_s16(vqmovn_s32(r)));
+    }
+#else
+    for (; i + 4 <= n; i += 4)
+    {
+        int16x8_t s = vld1q_s16((const int16_t*) &in[i]);
+        int16x8_t o = vld1q_s16((const int16_t*) &out[i]);
+        vst1q_s16((int16_t*) &out[i], vqaddq_s16(o, divide(s, log2Divisor)));
+    }
+#endif
+#endif
+    for (; i < n; i++)
+    {
+        out[i].m_real = saturate(out[i].m_real + divide(in[i].m_real, log2Divisor));
+        out[i].m_imag = saturate(out[i].m_imag + divide(in[i].m_imag, log2Divisor));
+    }
+}
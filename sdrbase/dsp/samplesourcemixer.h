@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLESOURCEMIXER_H_
+#define SDRBASE_DSP_SAMPLESOURCEMIXER_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Block kernels used to merge the channel sources of a Tx device. Each source is divided
+ * by 2^log2Divisor with an arithmetic shift and sums saturate to the SDR_TX_SAMP_SZ range
+ * instead of wrapping. SSE2 or NEON is used when available.
+ */
+class SDRBASE_API SampleSourceMixer
+{
+public:
+    /** out = in / 2^log2Divisor */
+    static void copy(const Sample *in, Sample *out, unsigned int n, unsigned int log2Divisor);
+    /** out = out + in / 2^log2Divisor with saturation */
+    static void mix(const Sample *in, Sample *out, unsigned int n, unsigned int log2Divisor);
+};
+
+#endif /* SDRBASE_DSP_SAMPLESOURCEMIXER_H_ */
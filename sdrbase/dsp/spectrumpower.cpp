@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#include <float.h>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#elif defined(USE_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "dsp/spectrumpower.h"
+
+namespace {
+
+// 10*log10(2) so that 10*log10(v) = dBPerLog2 * log2(v)
+const float dBPerLog2 = 3.0102999566398120f;
+// 2/ln(2) for the atanh series of log2
+const float twoOverLn2 = 2.8853900817779268f;
+
+}
+
+void SpectrumPower::toComplex(const Sample *in, Complex *out, unsigned int n, Real scalef)
+{
+    Real f = 1.0f / scalef;
+    unsigned int i = 0;
+#if defined(USE_SSE2)
+    const __m128 vf = _mm_set1_ps(f);
+#ifdef SDR_RX_SAMPLE_24BIT
+    // 2 samples of 2 x 32 bits at a time
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &in[i]);
+        _mm_storeu_ps((float*) &out[i], _mm_mul_ps(_mm_cvtepi32_ps(s), vf));
+    }
+#else
+    // 4 samples of 2 x 16 bits at a time
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i*) &in[i]);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        _mm_storeu_ps((float*) &out[i], _mm_mul_ps(_mm_cvtepi32_ps(lo), vf));
+        _mm_storeu_ps((float*) &out[i+2], _mm_mul_ps(_mm_cvtepi32_ps(hi), vf));
+    }
+#endif
+#elif defined(USE_NEON)
+#ifdef SDR_RX_SAMPLE_24BIT
+    for (; i + 2 <= n; i += 2)
+    {
+        int32x4_t s = vld1q_s32((const int32_t*) &in[i]);
+        vst1q_f32((float*) &out[i], vmulq_n_f32(vcvtq_f32_s32(s), f));
+    }
+#else
+    for (; i + 4 <= n; i += 4)
+    {
+        int16x8_t s = vld1q_s16((const int16_t*) &in[i]);
+        vst1q_f32((float*) &out[i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), f));
+        vst1q_f32((float*) &out[i+2], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))), f));
+    }
+#endif
+#endif
+    for (; i < n; i++) {
+        out[i] = Complex(in[i].real() * f, in[i].imag() * f);
+    }
+}
+
+void SpectrumPower::magSq(const Complex *in, Real *out, unsigned int n)
+{
+    unsigned int i = 0;
+#if defined(USE_SSE2)
+    // 4 complex values (r0, i0, r1, i1) (r2, i2, r3, i3) at a time
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 a = _mm_loadu_ps((const float*) &in[i]);
+        __m128 b = _mm_loadu_ps((const float*) &in[i+2]);
+        a = _mm_mul_ps(a, a);
+        b = _mm_mul_ps(b, b);
+        __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(&out[i], _mm_add_ps(re, im));
+    }
+#elif defined(USE_NEON)
+    for (; i + 4 <= n; i += 4)
+    {
+        float32x4x2_t c = vld2q_f32((const float*) &in[i]); // de-interleaves real and imaginary parts
+        vst1q_f32(&out[i], vmlaq_f32(vmulq_f32(c.val[0], c.val[0]), c.val[1], c.val[1]));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = in[i].real() * in[i].real() + in[i].imag() * in[i].imag();
+    }
+}
+
+void SpectrumPower::toDB(Real *values, unsigned int n, Real ofs)
+{
+    unsigned int i = 0;
+    // log2(x) = e + log2(m) with x = m * 2^e and m in [1,2[
+    // log2(m) = 2/ln(2) * atanh(t) with t = (m-1)/(m+1) in [0,1/3[ computed with the first 5 terms of its series
+#if defined(USE_SSE2)
+    const __m128 vmin = _mm_set1_ps(FLT_MIN);
+    const __m128 vone = _mm_set1_ps(1.0f);
+    const __m128i vmantMask = _mm_set1_epi32(0x007fffff);
+    const __m128i vexp0 = _mm_set1_epi32(0x3f800000);
+    const __m128i vbias = _mm_set1_epi32(127);
+    const __m128 vdB = _mm_set1_ps(dBPerLog2);
+    const __m128 vofs = _mm_set1_ps(ofs);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i bits = _mm_castps_si128(_mm_max_ps(_mm_loadu_ps(&values[i]), vmin));
+        __m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), vbias));
+        __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, vmantMask), vexp0));
+        __m128 t = _mm_div_ps(_mm_sub_ps(m, vone), _mm_add_ps(m, vone));
+        __m128 t2 = _mm_mul_ps(t, t);
+        __m128 p = _mm_add_ps(_mm_mul_ps(t2, _mm_set1_ps(1.0f/9.0f)), _mm_set1_ps(1.0f/7.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f/5.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(1.0f/3.0f));
+        p = _mm_add_ps(_mm_mul_ps(p, t2), vone);
+        __m128 l = _mm_add_ps(e, _mm_mul_ps(_mm_mul_ps(p, t), _mm_set1_ps(twoOverLn2)));
+        _mm_storeu_ps(&values[i], _mm_add_ps(_mm_mul_ps(l, vdB), vofs));
+    }
+#elif defined(USE_NEON)
+    const float32x4_t vmin = vdupq_n_f32(FLT_MIN);
+    const float32x4_t vone = vdupq_n_f32(1.0f);
+    const uint32x4_t vmantMask = vdupq_n_u32(0x007fffff);
+    const uint32x4_t vexp0 = vdupq_n_u32(0x3f800000);
+    const int32x4_t vbias = vdupq_n_s32(127);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t bits = vreinterpretq_u32_f32(vmaxq_f32(vld1q_f32(&values[i]), vmin));
+        float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vbias));
+        float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vmantMask), vexp0));
+        float32x4_t d = vaddq_f32(m, vone);
+        float32x4_t r = vrecpeq_f32(d);
+        r = vmulq_f32(vrecpsq_f32(d, r), r); // two Newton-Raphson steps for full precision
+        r = vmulq_f32(vrecpsq_f32(d, r), r);
+        float32x4_t t = vmulq_f32(vsubq_f32(m, vone), r);
+        float32x4_t t2 = vmulq_f32(t, t);
+        float32x4_t p = vmlaq_n_f32(vdupq_n_f32(1.0f/7.0f), t2, 1.0f/9.0f);
+        p = vmlaq_f32(vdupq_n_f32(1.0f/5.0f), p, t2);
+        p = vmlaq_f32(vdupq_n_f32(1.0f/3.0f), p, t2);
+        p = vmlaq_f32(vone, p, t2);
+        float32x4_t l = vmlaq_n_f32(e, vmulq_f32(p, t), twoOverLn2);
+        vst1q_f32(&values[i], vmlaq_n_f32(vdupq_n_f32(ofs), l, dBPerLog2));
+    }
+#endif
+    for (; i < n; i++) {
+        values[i] = 10.0f * log10f(values[i] < FLT_MIN ? FLT_MIN : values[i]) + ofs;
+    }
+}
+
+void SpectrumPower::scale(Real *values, unsigned int n, Real factor)
+{
+    for (unsigned int i = 0; i < n; i++) {
+        values[i] *= factor;
+    }
+}
+
+void SpectrumPower::peakDecimate(const Real *in, Real *out, unsigned int nOut, unsigned int factor)
+{
+    for (unsigned int i = 0; i < nOut; i++)
+    {
+        const Real *group = in + i * factor;
+        Real peak = group[0];
+
+        for (unsigned int j = 1; j < factor; j++) {
+            peak = group[j] > peak ? group[j] : peak;
+        }
+
+        out[i] = peak;
+    }
+}
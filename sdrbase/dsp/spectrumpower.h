@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMPOWER_H_
+#define SDRBASE_DSP_SPECTRUMPOWER_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Block kernels used to turn FFT frames into power spectra. They process whole
+ * frames with SSE2 or NEON when available and plain loops otherwise.
+ */
+class SDRBASE_API SpectrumPower
+{
+public:
+    /** Convert n samples to complex dividing each component by scalef */
+    static void toComplex(const Sample *in, Complex *out, unsigned int n, Real scalef);
+    /** Magnitude squared of n complex values */
+    static void magSq(const Complex *in, Real *out, unsigned int n);
+    /** In place 10*log10(v) + ofs. Uses a fast log2 approximation (error < 1e-4 dB) with SIMD */
+    static void toDB(Real *values, unsigned int n, Real ofs);
+    /** In place multiplication by factor */
+    static void scale(Real *values, unsigned int n, Real factor);
+    /** nOut maxima of consecutive groups of factor values so that narrow peaks survive the reduction. In place allowed */
+    static void peakDecimate(const Real *in, Real *out, unsigned int nOut, unsigned int factor);
+};
+
+#endif /* SDRBASE_DSP_SPECTRUMPOWER_H_ */
@@ -3,63 +3,203 @@
 #include <QThread>
 #include <QDebug>
 #include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
+#include "dsp/sampleblock.h"
 #include "util/message.h"
 
-ThreadedBasebandSampleSinkFifo::ThreadedBasebandSampleSinkFifo(BasebandSampleSink *sampleSink, std::size_t size) :
-	m_sampleSink(sampleSink)
+ThreadedBasebandSampleSinkFifo::ThreadedBasebandSampleSinkFifo(BasebandSampleSink *sampleSink, DSPWorkerPool *workerPool, std::size_t size) :
+	m_sampleSink(sampleSink),
+	m_blocks(1024, 0),
+	m_blocksMask(1024 - 1),
+	m_maxLagSamples(size),
+	m_head(0),
+	m_tail(0),
+	m_lag(0),
+	m_maxLag(0),
+	m_overruns(0),
+	m_dataReadySignaled(0),
+	m_overrunning(false),
+	m_workerPool(workerPool),
+	m_stopped(workerPool ? 1 : 0)
 {
-	connect(&m_sampleFifo, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
-	m_sampleFifo.setSize(size);
+	if (m_workerPool)
+	{
+		// sink messages are handled by the task and not by the event loop of the sink thread
+		MessageQueue *messageQueue = m_sampleSink->getInputMessageQueue();
+		disconnect(messageQueue, SIGNAL(messageEnqueued()), m_sampleSink, SLOT(handleInputMessages()));
+		connect(messageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleSinkMessages()), Qt::DirectConnection);
+
+		if (!messageQueue->isEmpty()) {
+			schedule();
+		}
+	}
+	else
+	{
+		connect(this, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
+	}
 }
 
 ThreadedBasebandSampleSinkFifo::~ThreadedBasebandSampleSinkFifo()
 {
-	m_sampleFifo.readCommit(m_sampleFifo.fill());
+	uint tail = m_tail.loadAcquire();
+
+	for (uint head = m_head.load(); head != tail; head++) {
+		m_blocks[head & m_blocksMask]->unref();
+	}
 }
 
 void ThreadedBasebandSampleSinkFifo::writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end)
 {
-	m_sampleFifo.write(begin, end);
+	SampleBlock *block = SampleBlockPool::instance()->allocate(begin, end);
+	writeBlockToFifo(block);
+	block->unref();
 }
 
-void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it to the new threadable sink class
+void ThreadedBasebandSampleSinkFifo::writeBlockToFifo(SampleBlock *block)
 {
-	bool positiveOnly = false;
+	if (m_stopped.loadAcquire()) {
+		return;
+	}
+
+	uint tail = m_tail.load();
+	uint head = m_head.loadAcquire();
+	uint lag = m_lag.loadAcquire();
+
+	if ((tail - head > m_blocksMask) || (lag + block->size() > m_maxLagSamples))
+	{
+		m_overruns.ref();
+
+		if (!m_overrunning)
+		{
+			qWarning("ThreadedBasebandSampleSinkFifo::writeBlockToFifo: %s: overrun: lag: %u samples, %u blocks",
+				qPrintable(m_sampleSink->objectName()), lag, tail - head);
+			m_overrunning = true;
+		}
+
+		return;
+	}
+
+	m_overrunning = false;
+	block->ref();
+	m_blocks[tail & m_blocksMask] = block;
+	lag = m_lag.fetchAndAddOrdered(block->size()) + block->size();
+	m_tail.storeRelease(tail + 1);
+
+	if (lag > (uint) m_maxLag.load()) {
+		m_maxLag.store(lag);
+	}
 
-	while ((m_sampleFifo.fill() > 0) && (m_sampleSink->getInputMessageQueue()->size() == 0))
+	if (m_workerPool) {
+		schedule();
+	} else if (m_dataReadySignaled.testAndSetOrdered(0, 1)) {
+		emit dataReady();
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::schedule()
+{
+	if (m_dataReadySignaled.testAndSetOrdered(0, 1)) {
+		m_workerPool->submit(this);
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::handleSinkMessages()
+{
+	schedule();
+}
+
+void ThreadedBasebandSampleSinkFifo::setStopped(bool stopped)
+{
+	m_stopped.storeRelease(stopped ? 1 : 0);
+
+	if (stopped)
 	{
-		SampleVector::iterator part1begin;
-		SampleVector::iterator part1end;
-		SampleVector::iterator part2begin;
-		SampleVector::iterator part2end;
+		// the pending task drops the remaining blocks
+		QMutexLocker mutexLocker(&m_taskMutex);
 
-		std::size_t count = m_sampleFifo.readBegin(m_sampleFifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+		while (m_dataReadySignaled.loadAcquire() != 0) {
+			m_taskDone.wait(&m_taskMutex);
+		}
+	}
+}
 
-		// first part of FIFO data
+void ThreadedBasebandSampleSinkFifo::run()
+{
+	bool positiveOnly = false;
+	uint head = m_head.load();
 
-		if (count > 0)
+	MessageQueue *messageQueue = m_sampleSink->getInputMessageQueue();
+
+	while (true)
+	{
+		int nbBlocks = 0;
+		bool stopped = m_stopped.loadAcquire() != 0;
+
+		// pending messages (e.g. new settings) apply to the blocks that follow
+		m_sampleSink->handleInputMessages();
+
+		// process a limited number of blocks so that other channels get a chance on this worker
+		while ((head != (uint) m_tail.loadAcquire()) && (stopped || ((nbBlocks < 16) && messageQueue->isEmpty())))
 		{
-			// handle data
-			if(m_sampleSink != NULL)
-			{
-				m_sampleSink->feed(part1begin, part1end, positiveOnly);
+			SampleBlock *block = m_blocks[head & m_blocksMask];
+
+			if (!stopped) {
+				m_sampleSink->feed(block->begin(), block->end(), positiveOnly);
 			}
 
-			m_sampleFifo.readCommit(part1end - part1begin);
+			m_lag.fetchAndAddOrdered(-(int) block->size());
+			block->unref();
+			head++;
+			m_head.storeRelease(head);
+			nbBlocks++;
 		}
 
-		// second part of FIFO data (used when block wraps around)
+		if ((!stopped && (head != (uint) m_tail.loadAcquire())) || !messageQueue->isEmpty())
+		{
+			m_workerPool->submit(this); // still owning the flag
+			return;
+		}
+
+		m_dataReadySignaled.storeRelease(0);
 
-		if(part2begin != part2end)
 		{
-			// handle data
-			if(m_sampleSink != NULL)
-			{
-				m_sampleSink->feed(part2begin, part2end, positiveOnly);
-			}
+			QMutexLocker mutexLocker(&m_taskMutex);
+			m_taskDone.wakeAll();
+		}
+
+		// a block or a message may have arrived after the last check but before the flag was cleared
+		if (((head == (uint) m_tail.loadAcquire()) && messageQueue->isEmpty()) || !m_dataReadySignaled.testAndSetOrdered(0, 1)) {
+			return;
+		}
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::resetLagStats()
+{
+	m_maxLag.store(0);
+	m_overruns.store(0);
+}
+
+void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it to the new threadable sink class
+{
+	bool positiveOnly = false;
+	m_dataReadySignaled.fetchAndStoreOrdered(0); // blocks written from now on will signal again
+	uint head = m_head.load();
 
-			m_sampleFifo.readCommit(part2end - part2begin);
+	while ((head != (uint) m_tail.loadAcquire()) && m_sampleSink->getInputMessageQueue()->isEmpty())
+	{
+		SampleBlock *block = m_blocks[head & m_blocksMask];
+
+		// handle data
+		if (m_sampleSink != NULL)
+		{
+			m_sampleSink->feed(block->begin(), block->end(), positiveOnly);
 		}
+
+		m_lag.fetchAndAddOrdered(-(int) block->size());
+		block->unref();
+		head++;
+		m_head.storeRelease(head);
 	}
 }
 
@@ -71,12 +211,26 @@ ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampl
 
 	qDebug() << "ThreadedBasebandSampleSink::ThreadedBasebandSampleSink: " << name;
 
-	m_thread = new QThread(parent);
-	m_threadedBasebandSampleSinkFifo = new ThreadedBasebandSampleSinkFifo(m_basebandSampleSink);
-	//moveToThread(m_thread); // FIXME: Fixed? the intermediate FIFO should be handled within the sink. Define a new type of sink that is compatible with threading
-	m_basebandSampleSink->moveToThread(m_thread);
-	m_threadedBasebandSampleSinkFifo->moveToThread(m_thread);
-	BasebandSampleSink::MsgThreadedSink *msg = BasebandSampleSink::MsgThreadedSink::create(m_thread); // inform of the new thread
+	m_workerPool = DSPEngine::instance()->getChannelWorkerPool();
+
+	if (m_workerPool)
+	{
+		// samples and messages are processed by the pool task of the channel, timers run in the pool event thread
+		m_thread = 0;
+		m_threadedBasebandSampleSinkFifo = new ThreadedBasebandSampleSinkFifo(m_basebandSampleSink, m_workerPool);
+		m_basebandSampleSink->moveToThread(m_workerPool->getEventThread());
+		m_threadedBasebandSampleSinkFifo->moveToThread(m_workerPool->getEventThread());
+	}
+	else
+	{
+		m_thread = new QThread(parent);
+		m_threadedBasebandSampleSinkFifo = new ThreadedBasebandSampleSinkFifo(m_basebandSampleSink);
+		//moveToThread(m_thread); // FIXME: Fixed? the intermediate FIFO should be handled within the sink. Define a new type of sink that is compatible with threading
+		m_basebandSampleSink->moveToThread(m_thread);
+		m_threadedBasebandSampleSinkFifo->moveToThread(m_thread);
+	}
+
+	BasebandSampleSink::MsgThreadedSink *msg = BasebandSampleSink::MsgThreadedSink::create(m_thread ? m_thread : m_workerPool->getEventThread()); // inform of the new thread
 	m_basebandSampleSink->handleMessage(*msg);
 	delete msg;
 	//m_sampleFifo.moveToThread(m_thread);
@@ -88,7 +242,7 @@ ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampl
 
 ThreadedBasebandSampleSink::~ThreadedBasebandSampleSink()
 {
-    if (m_thread->isRunning()) {
+    if (m_thread ? m_thread->isRunning() : !m_threadedBasebandSampleSinkFifo->isStopped()) {
         stop();
     }
 
@@ -99,16 +253,30 @@ ThreadedBasebandSampleSink::~ThreadedBasebandSampleSink()
 void ThreadedBasebandSampleSink::start()
 {
 	qDebug() << "ThreadedBasebandSampleSink::start";
-	m_thread->start();
+
+	if (m_thread) {
+		m_thread->start();
+	} else {
+		m_threadedBasebandSampleSinkFifo->setStopped(false);
+	}
+
 	m_basebandSampleSink->start();
 }
 
 void ThreadedBasebandSampleSink::stop()
 {
 	qDebug() << "ThreadedBasebandSampleSink::stop";
-	m_basebandSampleSink->stop();
-	m_thread->exit();
-	m_thread->wait();
+	if (m_thread)
+	{
+		m_basebandSampleSink->stop();
+		m_thread->exit();
+		m_thread->wait();
+	}
+	else
+	{
+		m_threadedBasebandSampleSinkFifo->setStopped(true); // no more feed after this
+		m_basebandSampleSink->stop();
+	}
 }
 
 void ThreadedBasebandSampleSink::feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly __attribute__((unused)))
@@ -118,8 +286,28 @@ void ThreadedBasebandSampleSink::feed(SampleVector::const_iterator begin, Sample
 	m_threadedBasebandSampleSinkFifo->writeToFifo(begin, end);
 }
 
+void ThreadedBasebandSampleSink::feed(SampleBlock *block)
+{
+	m_threadedBasebandSampleSinkFifo->writeBlockToFifo(block);
+}
+
 bool ThreadedBasebandSampleSink::handleSinkMessage(const Message& cmd)
 {
+	if (m_workerPool)
+	{
+		// the engine notifications are queued so that they are handled by the pool task of the channel
+		if (DSPSignalNotification::match(cmd))
+		{
+			m_basebandSampleSink->getInputMessageQueue()->push(new DSPSignalNotification((const DSPSignalNotification&) cmd));
+			return true;
+		}
+		else if (DSPChannelizerBankNotification::match(cmd))
+		{
+			m_basebandSampleSink->getInputMessageQueue()->push(new DSPChannelizerBankNotification((const DSPChannelizerBankNotification&) cmd));
+			return true;
+		}
+	}
+
 	return m_basebandSampleSink->handleMessage(cmd);
 }
 
@@ -20,31 +20,76 @@
 
 #include <dsp/basebandsamplesink.h>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <vector>
 
-#include "samplesinkfifo.h"
+#include "dsp/dspworkerpool.h"
 #include "util/messagequeue.h"
 #include "export.h"
 
 class BasebandSampleSink;
+class SampleBlock;
 class QThread;
 
 /**
  * Because Qt is a piece of shit this class cannot be a nested protected class of ThreadedSampleSink
  * So let's make everything public
+ *
+ * Samples are not copied: the queue holds references to the immutable sample blocks published
+ * by the device engine to all its channels. The device engine thread is the only writer and
+ * the sink thread the only reader. The queue is bounded by a number of blocks and a number of
+ * samples (lag). A block that does not fit is dropped for this sink only and counted as overrun.
+ *
+ * With a worker pool the queue is a pool task instead of being processed in the sink thread
+ * event loop. The dataReady flag guarantees the task is queued or running at most once.
+ * The sink input messages are handled by the same task before the blocks are fed so that
+ * messages and samples of a channel are never processed at the same time.
  */
-class SDRBASE_API ThreadedBasebandSampleSinkFifo : public QObject {
+class SDRBASE_API ThreadedBasebandSampleSinkFifo : public QObject, public DSPWorkerPool::Task {
 	Q_OBJECT
 
 public:
-	ThreadedBasebandSampleSinkFifo(BasebandSampleSink* sampleSink, std::size_t size = 1<<18);
+	ThreadedBasebandSampleSinkFifo(BasebandSampleSink* sampleSink, DSPWorkerPool *workerPool = 0, std::size_t size = 1<<18);
 	~ThreadedBasebandSampleSinkFifo();
-	void writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end);
+	void writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end); //!< copies samples in a new block
+	void writeBlockToFifo(SampleBlock *block); //!< queues a reference to the block
+
+	uint getLag() const { return m_lag.load(); }         //!< samples queued and not yet processed by the sink
+	uint getMaxLag() const { return m_maxLag.load(); }   //!< highest lag seen
+	uint getOverruns() const { return m_overruns.load(); } //!< number of blocks dropped
+	void resetLagStats();
+
+	void setStopped(bool stopped); //!< worker pool only. Stop waits for the pending task. Call from writer thread.
+	bool isStopped() const { return m_stopped.load() != 0; }
+	virtual void run(); //!< worker pool task
 
 	BasebandSampleSink* m_sampleSink;
-	SampleSinkFifo m_sampleFifo;
+
+signals:
+	void dataReady();
 
 public slots:
 	void handleFifoData();
+	void handleSinkMessages(); //!< worker pool only: schedule the task to handle the sink messages
+
+private:
+	std::vector<SampleBlock*> m_blocks; //!< power of two ring of block references
+	uint m_blocksMask;
+	uint m_maxLagSamples;       //!< maximum number of samples queued
+	QAtomicInt m_head;          //!< read counter (written by reader only)
+	QAtomicInt m_tail;          //!< write counter (written by writer only)
+	QAtomicInt m_lag;
+	QAtomicInt m_maxLag;
+	QAtomicInt m_overruns;
+	QAtomicInt m_dataReadySignaled;
+	bool m_overrunning;         //!< writer side: in a sequence of dropped blocks
+	DSPWorkerPool *m_workerPool;
+	QAtomicInt m_stopped;
+	QMutex m_taskMutex;
+	QWaitCondition m_taskDone;  //!< the task has released the dataReady flag
+
+	void schedule();
 };
 
 /**
@@ -64,13 +109,19 @@ public:
 
 	bool handleSinkMessage(const Message& cmd); //!< Send message to sink synchronously
 	void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly); //!< Feed sink with samples
+	void feed(SampleBlock *block); //!< Feed sink with a shared block of samples (no copy)
+
+	uint getLag() const { return m_threadedBasebandSampleSinkFifo->getLag(); }
+	uint getMaxLag() const { return m_threadedBasebandSampleSinkFifo->getMaxLag(); }
+	uint getOverruns() const { return m_threadedBasebandSampleSinkFifo->getOverruns(); }
 
 	QString getSampleSinkObjectName() const;
     const QThread *getThread() const { return m_thread; }
 
 protected:
 
-	QThread *m_thread; //!< The thead object
+	QThread *m_thread; //!< The thead object (null with a worker pool)
+	DSPWorkerPool *m_workerPool;
 	ThreadedBasebandSampleSinkFifo *m_threadedBasebandSampleSinkFifo;
 	BasebandSampleSink* m_basebandSampleSink;
 };
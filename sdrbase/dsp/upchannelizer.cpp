@@ -102,6 +102,65 @@ void UpChannelizer::pull(Sample& sample)
     }
 }
 
+void UpChannelizer::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    if(m_sampleSource == 0) {
+        m_sampleBuffer.clear();
+        return;
+    }
+
+    if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+    {
+        m_sampleSource->pull(begin, nbSamples);
+        return;
+    }
+
+    if (nbSamples == 0) {
+        return;
+    }
+
+    m_mutex.lock();
+
+    // Same result as pulling samples one at a time but each stage processes its block in one go.
+    // Every other work call of a stage consumes an input so the number of calls of each stage is known
+    // beforehand and the modulator is pulled once for the whole block.
+    unsigned int nbStages = m_filterStages.size();
+    m_stageCounts[0] = nbSamples;
+
+    for (unsigned int i = 0; i < nbStages; i++)
+    {
+        m_stageCounts[i+1] = (m_stageCounts[i] + (m_filterStages[i]->m_inputPending ? 1 : 0)) / 2;
+        m_stageInputs[i].resize(m_stageCounts[i+1] + 1);
+        m_stageInputs[i][0] = i == nbStages - 1 ? m_sampleIn : m_stageSamples[i+1];
+    }
+
+    m_sampleSource->pull(m_stageInputs[nbStages-1].begin() + 1, m_stageCounts[nbStages]);
+
+    for (int i = nbStages - 1; i >= 0; i--)
+    {
+        FilterStage *stage = m_filterStages[i];
+        Sample *sampleIn = m_stageInputs[i].data();
+        Sample *sampleOut = i == 0 ? &(*begin) : m_stageInputs[i-1].data() + 1;
+
+        for (unsigned int is = 0; is < m_stageCounts[i]; is++)
+        {
+            if (stage->work(sampleIn, &sampleOut[is])) {
+                sampleIn++;
+            }
+        }
+
+        // input held for next block
+        if (i == (int) nbStages - 1) {
+            m_sampleIn = *sampleIn;
+        } else {
+            m_stageSamples[i+1] = *sampleIn;
+        }
+    }
+
+    m_stageSamples[0] = *(begin + (nbSamples - 1));
+    m_mutex.unlock();
+}
+
 void UpChannelizer::start()
 {
     if (m_sampleSource != 0)
@@ -189,6 +248,8 @@ void UpChannelizer::applyConfiguration()
     m_currentCenterFrequency = createFilterChain(
         m_outputSampleRate / -2, m_outputSampleRate / 2,
         m_requestedCenterFrequency - m_requestedInputSampleRate / 2, m_requestedCenterFrequency + m_requestedInputSampleRate / 2);
+    m_stageInputs.resize(m_filterStages.size());
+    m_stageCounts.resize(m_filterStages.size() + 1);
 
     m_mutex.unlock();
 
@@ -210,7 +271,8 @@ void UpChannelizer::applyConfiguration()
 #ifdef USE_SSE4_1
 UpChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0)
+    m_workFunction(0),
+    m_inputPending(false)
 {
     switch(mode) {
         case ModeCenter:
@@ -229,7 +291,8 @@ UpChannelizer::FilterStage::FilterStage(Mode mode) :
 #else
 UpChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0)
+    m_workFunction(0),
+    m_inputPending(false)
 {
     switch(mode) {
         case ModeCenter:
@@ -71,6 +71,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples) { if (m_sampleSource) m_sampleSource->pullAudio(nbSamples); }
 
     virtual bool handleMessage(const Message& cmd);
@@ -91,18 +92,23 @@ protected:
         IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #endif
         WorkFunction m_workFunction;
+        bool m_inputPending; //!< next work call consumes its input sample (calls alternate)
 
         FilterStage(Mode mode);
         ~FilterStage();
 
         bool work(Sample* sampleIn, Sample *sampleOut)
         {
-            return (m_filter->*m_workFunction)(sampleIn, sampleOut);
+            bool consumed = (m_filter->*m_workFunction)(sampleIn, sampleOut);
+            m_inputPending = !consumed;
+            return consumed;
         }
     };
     typedef std::vector<FilterStage*> FilterStages;
     FilterStages m_filterStages;
     std::vector<Sample> m_stageSamples;
+    std::vector<SampleVector> m_stageInputs;  //!< block mode input of each stage. First item is the input held from the previous block.
+    std::vector<unsigned int> m_stageCounts;  //!< block mode number of work calls of each stage and number of samples pulled from the modulator
     BasebandSampleSource* m_sampleSource; //!< Modulator
     int m_outputSampleRate;
     int m_requestedInputSampleRate;
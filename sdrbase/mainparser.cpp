@@ -18,6 +18,7 @@
 #include <QCommandLineOption>
 #include <QRegExpValidator>
 #include <QDebug>
+#include <QThread>
 
 #include "mainparser.h"
 
@@ -29,10 +30,36 @@ MainParser::MainParser() :
     m_serverPortOption(QStringList() << "p" << "api-port",
         "Web API server port.",
         "port",
-        "8091")
+        "8091"),
+    m_channelizerBankSpacingOption(QStringList() << "channel-spacing",
+        "Rx channelizer bank channel spacing in Hz. Channels centered on a multiple of the spacing share a single polyphase filter bank. 0 to disable.",
+        "spacing",
+        "0"),
+    m_dspThreadsOption(QStringList() << "dsp-threads",
+        "Number of worker threads shared by all channels. 0 to run each channel in its own thread. \"auto\" for one per core.",
+        "threads",
+        "0"),
+    m_spectrumFrameRateOption(QStringList() << "spectrum-fps",
+        "Maximum spectrum display refresh rate in frames per second. 0 for no limit.",
+        "fps",
+        "0"),
+    m_fftPreplanOption(QStringList() << "fft-preplan",
+        "Measure FFT plans for the spectrum sizes used by the presets in the background at startup (FFTW only)."),
+    m_recordDirectIOOption(QStringList() << "record-direct-io",
+        "Write I/Q recordings bypassing the page cache (Linux O_DIRECT)."),
+    m_recordPreallocationOption(QStringList() << "record-prealloc",
+        "Disk space in MB reserved up front for each I/Q recording (Linux only). 0 to disable.",
+        "megabytes",
+        "0")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
+    m_channelizerBankSpacing = 0;
+    m_dspThreads = 0;
+    m_spectrumFrameRate = 0;
+    m_fftPreplan = false;
+    m_recordDirectIO = false;
+    m_recordPreallocation = 0;
 
     m_parser.setApplicationDescription("Software Defined Radio application");
     m_parser.addHelpOption();
@@ -40,6 +67,12 @@ MainParser::MainParser() :
 
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
+    m_parser.addOption(m_channelizerBankSpacingOption);
+    m_parser.addOption(m_dspThreadsOption);
+    m_parser.addOption(m_spectrumFrameRateOption);
+    m_parser.addOption(m_fftPreplanOption);
+    m_parser.addOption(m_recordDirectIOOption);
+    m_parser.addOption(m_recordPreallocationOption);
 }
 
 MainParser::~MainParser()
@@ -79,4 +112,61 @@ void MainParser::parse(const QCoreApplication& app)
     } else {
         qWarning() << "MainParser::parse: server port invalid. Defaulting to " << m_serverPort;
     }
+
+    // channelizer bank spacing
+
+    QString channelizerBankSpacingStr = m_parser.value(m_channelizerBankSpacingOption);
+    int channelizerBankSpacing = channelizerBankSpacingStr.toInt(&ok);
+
+    if (ok && (channelizerBankSpacing >= 0)) {
+        m_channelizerBankSpacing = channelizerBankSpacing;
+    } else {
+        qWarning() << "MainParser::parse: channel spacing invalid. Defaulting to " << m_channelizerBankSpacing;
+    }
+
+    // DSP worker threads
+
+    QString dspThreadsStr = m_parser.value(m_dspThreadsOption);
+
+    if (dspThreadsStr == "auto")
+    {
+        m_dspThreads = QThread::idealThreadCount();
+    }
+    else
+    {
+        int dspThreads = dspThreadsStr.toInt(&ok);
+
+        if (ok && (dspThreads >= 0)) {
+            m_dspThreads = dspThreads;
+        } else {
+            qWarning() << "MainParser::parse: DSP threads invalid. Defaulting to " << m_dspThreads;
+        }
+    }
+
+    // spectrum frame rate
+
+    QString spectrumFrameRateStr = m_parser.value(m_spectrumFrameRateOption);
+    int spectrumFrameRate = spectrumFrameRateStr.toInt(&ok);
+
+    if (ok && (spectrumFrameRate >= 0)) {
+        m_spectrumFrameRate = spectrumFrameRate;
+    } else {
+        qWarning() << "MainParser::parse: spectrum frame rate invalid. Defaulting to " << m_spectrumFrameRate;
+    }
+
+    // FFT plans measurement
+
+    m_fftPreplan = m_parser.isSet(m_fftPreplanOption);
+
+    // I/Q recording
+
+    m_recordDirectIO = m_parser.isSet(m_recordDirectIOOption);
+    QString recordPreallocationStr = m_parser.value(m_recordPreallocationOption);
+    int recordPreallocation = recordPreallocationStr.toInt(&ok);
+
+    if (ok && (recordPreallocation >= 0)) {
+        m_recordPreallocation = recordPreallocation;
+    } else {
+        qWarning() << "MainParser::parse: record preallocation invalid. Defaulting to " << m_recordPreallocation;
+    }
 }
@@ -33,14 +33,32 @@ public:
 
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
+    int getChannelizerBankSpacing() const { return m_channelizerBankSpacing; }
+    int getDSPThreads() const { return m_dspThreads; }
+    int getSpectrumFrameRate() const { return m_spectrumFrameRate; }
+    bool getFFTPreplan() const { return m_fftPreplan; }
+    bool getRecordDirectIO() const { return m_recordDirectIO; }
+    int getRecordPreallocation() const { return m_recordPreallocation; }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
+    int      m_channelizerBankSpacing;
+    int      m_dspThreads;
+    int      m_spectrumFrameRate;
+    bool     m_fftPreplan;
+    bool     m_recordDirectIO;
+    int      m_recordPreallocation;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
+    QCommandLineOption m_channelizerBankSpacingOption;
+    QCommandLineOption m_dspThreadsOption;
+    QCommandLineOption m_spectrumFrameRateOption;
+    QCommandLineOption m_fftPreplanOption;
+    QCommandLineOption m_recordDirectIOOption;
+    QCommandLineOption m_recordPreallocationOption;
 };
 
 
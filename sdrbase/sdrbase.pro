@@ -54,7 +54,9 @@ SOURCES += audio/audiodevicemanager.cpp\
         audio/audiofifo.cpp\
         audio/audiooutput.cpp\
         audio/audioinput.cpp\
+        audio/audiomixer.cpp\
         audio/audionetsink.cpp\
+        audio/audiooutputheadless.cpp\
         channel/channelsinkapi.cpp\
         channel/channelsourceapi.cpp\
         commands/command.cpp\
@@ -72,6 +74,7 @@ SOURCES += audio/audiodevicemanager.cpp\
         dsp/decimatorsfi.cpp\
         dsp/dspcommands.cpp\
         dsp/dspengine.cpp\
+        dsp/dspworkerpool.cpp\
         dsp/dspdevicesourceengine.cpp\
         dsp/dspdevicesinkengine.cpp\
         dsp/fftengine.cpp\
@@ -82,18 +85,24 @@ SOURCES += audio/audiodevicemanager.cpp\
         dsp/filterrc.cpp\
         dsp/filtermbe.cpp\
         dsp/filerecord.cpp\
+        dsp/filerecordwriter.cpp\
         dsp/freqlockcomplex.cpp\
         dsp/interpolator.cpp\
         dsp/hbfiltertraits.cpp\
+        dsp/inthalfbandfilterblock.cpp\
         dsp/lowpass.cpp\
         dsp/nco.cpp\
         dsp/ncof.cpp\
         dsp/phaselock.cpp\
         dsp/phaselockcomplex.cpp\
+        dsp/polyphasechannelizer.cpp\
         dsp/projector.cpp\
         dsp/recursivefilters.cpp\
+        dsp/sampleblock.cpp\
         dsp/samplesinkfifo.cpp\
         dsp/samplesourcefifo.cpp\
+        dsp/samplesourcemixer.cpp\
+        dsp/spectrumpower.cpp\
         dsp/samplesinkfifodoublebuffered.cpp\
         dsp/basebandsamplesink.cpp\
         dsp/basebandsamplesource.cpp\
@@ -115,6 +124,7 @@ SOURCES += audio/audiodevicemanager.cpp\
         util/syncmessenger.cpp\
         util/samplesourceserializer.cpp\
         util/simpleserializer.cpp\
+        util/udpsinksender.cpp\
         util/uid.cpp\
         plugin/plugininterface.cpp\
         plugin/pluginapi.cpp\        
@@ -129,7 +139,9 @@ HEADERS  += audio/audiodevicemanager.h\
         audio/audiofifo.h\
         audio/audiooutput.h\
         audio/audioinput.h\
+        audio/audiomixer.h\
         audio/audionetsink.h\
+        audio/audiooutputheadless.h\
         channel/channelsinkapi.h\
         channel/channelsourceapi.h\ 
         commands/command.h\       
@@ -137,6 +149,7 @@ HEADERS  += audio/audiodevicemanager.h\
         device/devicesinkapi.h\
         device/deviceenumerator.h\
         dsp/afsquelch.h\
+        dsp/blockfloatingpoint.h\
         dsp/decimatorsfi.h\
         dsp/downchannelizer.h\
         dsp/upchannelizer.h\
@@ -148,6 +161,7 @@ HEADERS  += audio/audiodevicemanager.h\
         dsp/interpolators.h\
         dsp/dspcommands.h\
         dsp/dspengine.h\
+        dsp/dspworkerpool.h\
         dsp/dspdevicesourceengine.h\
         dsp/dspdevicesinkengine.h\
         dsp/dsptypes.h\
@@ -159,12 +173,14 @@ HEADERS  += audio/audiodevicemanager.h\
         dsp/filterrc.h\
         dsp/filtermbe.h\
         dsp/filerecord.h\
+        dsp/filerecordwriter.h\
         dsp/freqlockcomplex.h\
         dsp/gfft.h\
         dsp/hbfiltertraits.h\
         dsp/iirfilter.h\
         dsp/interpolator.h\
         dsp/inthalfbandfilter.h\
+        dsp/inthalfbandfilterblock.h\
         dsp/inthalfbandfilterdb.h\
         dsp/inthalfbandfiltereo1.h\
         dsp/inthalfbandfiltereo1i.h\
@@ -180,10 +196,14 @@ HEADERS  += audio/audiodevicemanager.h\
         dsp/phasediscri.h\
         dsp/phaselock.h\
         dsp/phaselockcomplex.h\
+        dsp/polyphasechannelizer.h\
         dsp/projector.h\
         dsp/recursivefilters.h\
+        dsp/sampleblock.h\
         dsp/samplesinkfifo.h\
         dsp/samplesourcefifo.h\
+        dsp/samplesourcemixer.h\
+        dsp/spectrumpower.h\
         dsp/samplesinkfifodoublebuffered.h\
         dsp/samplesinkfifodecimator.h\
         dsp/basebandsamplesink.h\
@@ -210,6 +230,7 @@ HEADERS  += audio/audiodevicemanager.h\
         util/syncmessenger.h\
         util/samplesourceserializer.h\
         util/simpleserializer.h\
+        util/udpsinksender.h\
         util/uid.h\
         webapi/webapiadapterinterface.h\
         webapi/webapirequestmapper.h\
@@ -1,8 +1,10 @@
 #include <QSettings>
 #include <QStringList>
+#include <algorithm>
 
 #include "settings/mainsettings.h"
 #include "commands/command.h"
+#include "util/simpleserializer.h"
 
 MainSettings::MainSettings() : m_audioDeviceManager(0)
 {
@@ -152,6 +154,29 @@ void MainSettings::sortPresets()
     qSort(m_presets.begin(), m_presets.end(), Preset::presetCompare);
 }
 
+void MainSettings::getSpectrumFFTSizes(std::vector<int>& fftSizes) const
+{
+    fftSizes.clear();
+    int nbPresets = getPresetCount();
+
+    for (int i = -1; i < nbPresets; i++)
+    {
+        const Preset *preset = i < 0 ? &m_workingPreset : getPreset(i);
+        SimpleDeserializer d(preset->getSpectrumConfig());
+        int fftSize;
+
+        if (!d.isValid() || (d.getVersion() != 1)) {
+            continue;
+        }
+
+        d.readS32(1, &fftSize, 1024);
+
+        if ((fftSize > 0) && (std::find(fftSizes.begin(), fftSizes.end(), fftSize) == fftSizes.end())) {
+            fftSizes.push_back(fftSize);
+        }
+    }
+}
+
 void MainSettings::renamePresetGroup(const QString& oldGroupName, const QString& newGroupName)
 {
     int nbPresets = getPresetCount();
@@ -3,6 +3,7 @@
 
 #include <audio/audiodevicemanager.h>
 #include <QString>
+#include <vector>
 #include "preferences.h"
 #include "preset.h"
 #include "export.h"
@@ -27,6 +28,7 @@ public:
 	void sortPresets();
 	void renamePresetGroup(const QString& oldGroupName, const QString& newGroupName);
 	void deletePresetGroup(const QString& groupName);
+	void getSpectrumFFTSizes(std::vector<int>& fftSizes) const; //!< distinct spectrum FFT sizes of working preset and presets
 
     void addCommand(Command *command);
     void deleteCommand(const Command* command);
@@ -72,6 +72,37 @@ public:
         }
     }
 
+    /**
+     * Block version of storeAndGetAvg for count consecutive indexes from start.
+     * When the average is available values are replaced by their averages and true is returned.
+     */
+    template<typename U>
+    bool storeAndGetAvg(U *values, unsigned int start, unsigned int count)
+    {
+        if (m_size <= 1) {
+            return true;
+        }
+
+        T *sum = &m_sum[start];
+
+        for (unsigned int i = 0; i < count; i++) {
+            sum[i] += values[i];
+        }
+
+        if (m_avgIndex == m_size - 1)
+        {
+            for (unsigned int i = 0; i < count; i++) {
+                values[i] = sum[i] / m_size;
+            }
+
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     bool storeAndGetSum(T& sum, T v, unsigned int index)
     {
         if (m_size <= 1)
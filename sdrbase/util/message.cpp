@@ -15,16 +15,220 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <new>
 #include <QWaitCondition>
 #include <QMutex>
+#include <QAtomicInteger>
 #include "util/message.h"
 #include "util/messagequeue.h"
 
+namespace {
+
+/**
+ * Lock-free freelists of message memory by size class (multiples of 16 bytes).
+ * Messages larger than the biggest class use the global heap.
+ *
+ * Each class is a Treiber stack of blocks carved out of slabs. Blocks are designated by
+ * their index in the class rather than by address so that the stack head holds the index
+ * in its lower 32 bits and a modification tag defeating ABA in its upper 32 bits, without
+ * relying on unused address bits (tagged pointers, 57 bit address spaces).
+ * Slab k of a class holds m_firstSlabBlocks << k blocks so that a few slabs cover any
+ * realistic number of messages alive at the same time. Slabs are never given back to the
+ * heap as a concurrent pop may still read the link of a block it lost the race for.
+ */
+class MessageAllocator
+{
+public:
+	static const size_t m_granularity = 16;
+	static const int m_nbSizeClasses = 32; //!< up to 512 bytes
+
+	void *allocate(size_t size)
+	{
+		int sizeClass = getSizeClass(size);
+
+		if (sizeClass < 0) {
+			return ::operator new(size);
+		}
+
+		QAtomicInteger<quint64>& head = m_freeLists[sizeClass];
+		quint64 oldHead = head.loadAcquire();
+
+		while (quint32 link = getLink(oldHead))
+		{
+			BlockHeader *block = getBlock(sizeClass, link - 1);
+			quint64 newHead = makeHead(block->m_next, getTag(oldHead) + 1);
+
+			if (head.testAndSetOrdered(oldHead, newHead, oldHead)) {
+				return block + 1;
+			}
+		}
+
+		return newBlock(sizeClass) + 1;
+	}
+
+	void deallocate(void *ptr, size_t size)
+	{
+		int sizeClass = getSizeClass(size);
+
+		if (sizeClass < 0)
+		{
+			::operator delete(ptr);
+			return;
+		}
+
+		BlockHeader *block = ((BlockHeader *) ptr) - 1;
+
+		if (block->m_index == m_noIndex) // class was full when allocated
+		{
+			::operator delete(block);
+			return;
+		}
+
+		QAtomicInteger<quint64>& head = m_freeLists[sizeClass];
+		quint64 oldHead = head.loadAcquire();
+
+		do {
+			block->m_next = getLink(oldHead);
+		} while (!head.testAndSetOrdered(oldHead, makeHead(block->m_index + 1, getTag(oldHead) + 1), oldHead));
+	}
+
+private:
+	/** Precedes the message memory. Its size keeps the message aligned as the heap would */
+	struct BlockHeader
+	{
+		quint32 m_index;   //!< index of the block in its class or m_noIndex
+		quint32 m_next;    //!< link to the next free block: index + 1 or 0 at the end
+		quint64 m_padding; //!< to m_granularity
+	};
+
+	static const quint32 m_noIndex = 0xFFFFFFFF;
+	static const int m_firstSlabBlocks = 64;
+	static const int m_nbSlabs = 24; //!< 64 * (2^24 - 1) blocks per class at most
+
+	QAtomicInteger<quint64> m_freeLists[m_nbSizeClasses]; //!< stack heads: tag << 32 | link (zero initialized)
+	QAtomicInteger<quint32> m_nbBlocks[m_nbSizeClasses];  //!< blocks ever carved in each class
+	QAtomicPointer<char> m_slabs[m_nbSizeClasses][m_nbSlabs];
+
+	static quint32 getLink(quint64 head) {
+		return (quint32) head;
+	}
+
+	static quint64 getTag(quint64 head) {
+		return head >> 32;
+	}
+
+	static quint64 makeHead(quint32 link, quint64 tag) {
+		return (tag << 32) | link;
+	}
+
+	static size_t getBlockSize(int sizeClass) {
+		return sizeof(BlockHeader) + (sizeClass + 1) * m_granularity;
+	}
+
+	static void getSlab(quint32 index, int& slab, quint32& slabIndex)
+	{
+		// slab k starts at block m_firstSlabBlocks * (2^k - 1)
+		quint32 q = index / m_firstSlabBlocks + 1;
+		slab = 0;
+
+		while (q >>= 1) {
+			slab++;
+		}
+
+		slabIndex = index - m_firstSlabBlocks * ((1U << slab) - 1);
+	}
+
+	BlockHeader *getBlock(int sizeClass, quint32 index)
+	{
+		int slab;
+		quint32 slabIndex;
+		getSlab(index, slab, slabIndex);
+		return (BlockHeader *) (m_slabs[sizeClass][slab].loadAcquire() + slabIndex * getBlockSize(sizeClass));
+	}
+
+	BlockHeader *newBlock(int sizeClass)
+	{
+		static const quint32 maxBlocks = m_firstSlabBlocks * ((1U << m_nbSlabs) - 1);
+		QAtomicInteger<quint32>& nbBlocks = m_nbBlocks[sizeClass];
+		quint32 index = nbBlocks.loadAcquire();
+
+		do
+		{
+			if (index >= maxBlocks)
+			{
+				BlockHeader *block = (BlockHeader *) ::operator new(getBlockSize(sizeClass));
+				block->m_index = m_noIndex;
+				return block;
+			}
+		} while (!nbBlocks.testAndSetOrdered(index, index + 1, index));
+
+		int slab;
+		quint32 slabIndex;
+		getSlab(index, slab, slabIndex);
+		QAtomicPointer<char>& slabPtr = m_slabs[sizeClass][slab];
+		char *slabData = slabPtr.loadAcquire();
+
+		if (!slabData)
+		{
+			char *newSlab = (char *) ::operator new((size_t) (m_firstSlabBlocks << slab) * getBlockSize(sizeClass));
+
+			if (slabPtr.testAndSetOrdered(0, newSlab, slabData)) { // another thread may carve the same slab
+				slabData = newSlab;
+			} else {
+				::operator delete(newSlab);
+			}
+		}
+
+		BlockHeader *block = (BlockHeader *) (slabData + slabIndex * getBlockSize(sizeClass));
+		block->m_index = index;
+		return block;
+	}
+
+	static int getSizeClass(size_t size)
+	{
+		int sizeClass = (size + m_granularity - 1) / m_granularity - 1;
+		return sizeClass < m_nbSizeClasses ? sizeClass : -1;
+	}
+};
+
+MessageAllocator& messageAllocator()
+{
+	static MessageAllocator *allocator = new MessageAllocator(); // never destroyed: messages may be deleted during static destruction
+	return *allocator;
+}
+
+}
+
 const char* Message::m_identifier = 0;
 
 Message::Message() :
-	m_destination(0)
+	m_destination(0),
+	m_queueNext(0)
+{
+}
+
+Message::Message(const Message& other) :
+	m_destination(other.m_destination),
+	m_queueNext(0)
+{
+}
+
+Message& Message::operator=(const Message& other)
+{
+	m_destination = other.m_destination; // queue link is not copied
+	return *this;
+}
+
+void* Message::operator new(size_t size)
+{
+	return messageAllocator().allocate(size);
+}
+
+void Message::operator delete(void* ptr, size_t size)
 {
+	if (ptr) {
+		messageAllocator().deallocate(ptr, size);
+	}
 }
 
 Message::~Message()
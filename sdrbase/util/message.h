@@ -19,12 +19,25 @@
 #define INCLUDE_MESSAGE_H
 
 #include <stdlib.h>
+#include <QAtomicPointer>
 #include "export.h"
 
+class MessageQueue;
+
+/**
+ * Messages are allocated from per size freelists so that creating and deleting the many small
+ * notification and settings messages does not go through the general purpose heap each time.
+ * This applies to all derived classes transparently via the class operator new and delete.
+ */
 class SDRBASE_API Message {
 public:
 	Message();
+	Message(const Message& other);
 	virtual ~Message();
+	Message& operator=(const Message& other);
+
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size);
 
 	virtual const char* getIdentifier() const;
 	virtual bool matchIdentifier(const char* identifier) const;
@@ -37,6 +50,10 @@ protected:
 	// addressing
 	static const char* m_identifier;
 	void* m_destination;
+
+private:
+	friend class MessageQueue;
+	QAtomicPointer<Message> m_queueNext; //!< link in the message queue
 };
 
 #define MESSAGE_CLASS_DECLARATION \
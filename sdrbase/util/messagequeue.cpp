@@ -16,14 +16,14 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QDebug>
-#include <QMutexLocker>
 #include "util/messagequeue.h"
 #include "util/message.h"
 
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0)
 {
 }
 
@@ -38,13 +38,19 @@ MessageQueue::~MessageQueue()
 	}
 }
 
+void MessageQueue::pushNode(Message* message)
+{
+	message->m_queueNext.store(0);
+	Message *previous = m_head.fetchAndStoreOrdered(message);
+	previous->m_queueNext.storeRelease(message);
+}
+
 void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		pushNode(message);
+		m_size.fetchAndAddOrdered(1);
 	}
 
 	if (emitSignal)
@@ -55,27 +61,46 @@ void MessageQueue::push(Message* message, bool emitSignal)
 
 Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	Message *tail = m_tail;
+	Message *next = tail->m_queueNext.loadAcquire();
 
-	if (m_queue.isEmpty())
+	if (tail == &m_stub)
 	{
-		return 0;
+		if (next == 0) {
+			return 0;
+		}
+
+		m_tail = next;
+		tail = next;
+		next = next->m_queueNext.loadAcquire();
 	}
-	else
+
+	if (next == 0)
 	{
-		return m_queue.takeFirst();
+		if (tail != m_head.loadAcquire()) {
+			return 0; // a producer is between its two steps: the message will be available after its signal
+		}
+
+		// tail is the last message: put the stub back behind it so that it can be unlinked
+		pushNode(&m_stub);
+		next = tail->m_queueNext.loadAcquire();
+
+		if (next == 0) {
+			return 0;
+		}
 	}
-}
 
-int MessageQueue::size()
-{
-	QMutexLocker locker(&m_lock);
+	m_tail = next;
+	m_size.fetchAndAddOrdered(-1);
 
-	return m_queue.size();
+	return tail;
 }
 
 void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
-	m_queue.clear();
+	Message* message;
+
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
@@ -21,10 +21,20 @@
 #include <QObject>
 #include <QQueue>
 #include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include "util/message.h"
 #include "export.h"
 
-class Message;
-
+/**
+ * Multiple producers single consumer lock-free message queue.
+ *
+ * Messages are linked through their own queue link (intrusive queue) so that pushing does not
+ * allocate. Any thread can push. Only the thread owning the queue (the one handling the
+ * messageEnqueued() signal) may pop or clear. Never pop from a slot connected with
+ * Qt::DirectConnection as it would run in each pushing thread.
+ * size() and isEmpty() are a single atomic load and can be polled from sample processing loops.
+ */
 class SDRBASE_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -35,15 +45,20 @@ public:
 	void push(Message* message, bool emitSignal = true);  //!< Push message onto queue
 	Message* pop(); //!< Pop message from queue
 
-	int size(); //!< Returns queue size
+	int size() const { return m_size.load(); } //!< Returns queue size
+	bool isEmpty() const { return m_size.load() == 0; }
 	void clear(); //!< Empty queue
 
 signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	QAtomicPointer<Message> m_head; //!< last pushed message (producers side)
+	Message *m_tail;                //!< next message to pop (consumer side)
+	Message m_stub;                 //!< keeps the list non empty
+	QAtomicInt m_size;
+
+	void pushNode(Message* message);
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
@@ -85,6 +85,26 @@ public:
         }
     }
 
+    /** Block version of storeAndGetAvg for count consecutive indexes from start. Values are replaced by their averages */
+    template<typename U>
+    void storeAndGetAvg(U *values, unsigned int start, unsigned int count)
+    {
+        if ((m_depth <= 1) || (start + count > m_width)) {
+            return;
+        }
+
+        T *data = &m_data[m_avgIndex*m_width+start];
+        T *sum = &m_sum[start];
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            T v = values[i];
+            sum[i] += (v - data[i]);
+            data[i] = v;
+            values[i] = sum[i] / m_depth;
+        }
+    }
+
     T storeAndGetSum(T v, unsigned int index)
     {
         if (m_depth == 1)
@@ -24,6 +24,10 @@
 #include <QHostAddress>
 
 #include <cassert>
+#include <string.h>
+#include <algorithm>
+
+#include "util/udpsinksender.h"
 
 template<typename T>
 class UDPSink
@@ -34,7 +38,8 @@ public:
 		m_udpSamples(udpSize/sizeof(T)),
 		m_address(QHostAddress::LocalHost),
 		m_port(9999),
-		m_sampleBufferIndex(0)
+		m_sampleBufferIndex(0),
+		m_sharedSender(false)
 	{
         assert(m_udpSamples > 0);
 		m_sampleBuffer = new T[m_udpSamples];
@@ -46,7 +51,8 @@ public:
         m_udpSamples(udpSize/sizeof(T)),
         m_address(QHostAddress::LocalHost),
         m_port(port),
-        m_sampleBufferIndex(0)
+        m_sampleBufferIndex(0),
+        m_sharedSender(false)
     {
         assert(m_udpSamples > 0);
         m_sampleBuffer = new T[m_udpSamples];
@@ -58,7 +64,8 @@ public:
         m_udpSamples(udpSize/sizeof(T)),
 		m_address(address),
 		m_port(port),
-		m_sampleBufferIndex(0)
+		m_sampleBufferIndex(0),
+		m_sharedSender(false)
 	{
 		assert(m_udpSamples > 0);
 		m_sampleBuffer = new T[m_udpSamples];
@@ -85,6 +92,12 @@ public:
 	    m_port = port;
 	}
 
+	/**
+	 * Send datagrams through the network sender thread shared by all UDP sinks instead of
+	 * writing to the socket from the calling (DSP) thread
+	 */
+	void setSharedSender(bool sharedSender) { m_sharedSender = sharedSender; }
+
 	/**
 	 * Write one sample
 	 */
@@ -97,36 +110,44 @@ public:
 		}
 		else
 		{
-			m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port);
+			sendDatagram(m_sampleBuffer);
 			m_sampleBuffer[0] = sample;
 			m_sampleBufferIndex = 1;
 		}
 	}
 
 	/**
-	 * Write a bunch of samples
+	 * Write a span of samples. Full datagrams are sent directly from the input.
 	 */
-	void write(T *samples, int nbSamples)
+	void write(const T *samples, int nbSamples)
 	{
 	    int samplesIndex = 0;
 
-	    if (m_sampleBufferIndex + nbSamples > m_udpSamples) // fill remainder of buffer and send it
+	    if (m_sampleBufferIndex > 0) // complete the pending datagram first
 	    {
-	        memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], (m_udpSamples - m_sampleBufferIndex)*sizeof(T)); // fill remainder of buffer
-	        m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port); // send buffer
-            samplesIndex += (m_udpSamples - m_sampleBufferIndex);
-            nbSamples -= (m_udpSamples - m_sampleBufferIndex);
+	        int count = std::min(nbSamples, m_udpSamples - m_sampleBufferIndex);
+	        memcpy(&m_sampleBuffer[m_sampleBufferIndex], samples, count*sizeof(T));
+	        m_sampleBufferIndex += count;
+	        samplesIndex += count;
+	        nbSamples -= count;
+
+	        if (nbSamples == 0) { // a full buffer is sent on the next write as with single samples
+	            return;
+	        }
+
+	        sendDatagram(m_sampleBuffer);
 	        m_sampleBufferIndex = 0;
 	    }
 
 	    while (nbSamples > m_udpSamples) // send directly from input without buffering
 	    {
-	        m_socket->writeDatagram((const char*)&samples[samplesIndex], (qint64 ) m_udpSize, m_address, m_port);
+	        sendDatagram(&samples[samplesIndex]);
 	        samplesIndex += m_udpSamples;
 	        nbSamples -= m_udpSamples;
 	    }
 
-	    memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], nbSamples*sizeof(T)); // copy remainder of input to buffer
+	    memcpy(m_sampleBuffer, &samples[samplesIndex], nbSamples*sizeof(T)); // copy remainder of input to buffer
+	    m_sampleBufferIndex = nbSamples;
 	}
 
 private:
@@ -137,6 +158,16 @@ private:
 	QUdpSocket *m_socket;
 	T *m_sampleBuffer;;
 	int m_sampleBufferIndex;
+	bool m_sharedSender;
+
+	void sendDatagram(const T *datagram)
+	{
+	    if (m_sharedSender) {
+	        UDPSinkSender::instance().push((const char*) datagram, m_udpSize, m_address, m_port);
+	    } else {
+	        m_socket->writeDatagram((const char*) datagram, (qint64 ) m_udpSize, m_address, m_port);
+	    }
+	}
 };
 
 
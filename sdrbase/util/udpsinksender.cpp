@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QUdpSocket>
+#include <QDebug>
+#include <string.h>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#include "udpsinksender.h"
+
+namespace {
+// heap allocated so that the thread is joined by shutdown() while the application is alive
+QAtomicPointer<UDPSinkSender> senderInstance;
+QMutex senderInstanceMutex;
+}
+
+UDPSinkSender& UDPSinkSender::instance()
+{
+    UDPSinkSender *sender = senderInstance.loadAcquire();
+
+    if (!sender) // constructed once on first use
+    {
+        QMutexLocker mutexLocker(&senderInstanceMutex);
+        sender = senderInstance.loadAcquire();
+
+        if (!sender)
+        {
+            sender = new UDPSinkSender();
+            senderInstance.storeRelease(sender);
+        }
+    }
+
+    return *sender;
+}
+
+void UDPSinkSender::shutdown()
+{
+    QMutexLocker mutexLocker(&senderInstanceMutex);
+    delete senderInstance.fetchAndStoreOrdered(0); // stops and joins the thread
+}
+
+UDPSinkSender::UDPSinkSender() :
+    m_queue(m_queueSize),
+    m_head(0),
+    m_count(0),
+    m_running(true),
+    m_nbDrops(0)
+{
+    start();
+}
+
+UDPSinkSender::~UDPSinkSender()
+{
+    m_mutex.lock();
+    m_running = false;
+    m_dataReady.wakeAll();
+    m_mutex.unlock();
+    wait();
+}
+
+bool UDPSinkSender::push(const char *data, int size, const QHostAddress& address, quint16 port)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_count == m_queueSize)
+    {
+        if (m_nbDrops % 1000 == 0) {
+            qDebug("UDPSinkSender::push: queue full: %llu datagrams dropped", m_nbDrops + 1);
+        }
+
+        m_nbDrops++;
+        return false;
+    }
+
+    // slots outside [m_head, m_head + m_count[ are not accessed by the sender thread
+    Datagram& datagram = m_queue[(m_head + m_count) % m_queueSize];
+
+    if ((int) datagram.m_data.size() < size) {
+        datagram.m_data.resize(size);
+    }
+
+    memcpy(datagram.m_data.data(), data, size);
+    datagram.m_size = size;
+    datagram.m_address = address;
+    datagram.m_port = port;
+    m_count++;
+
+    m_dataReady.wakeOne();
+    return true;
+}
+
+void UDPSinkSender::run()
+{
+    QUdpSocket udpSocket; // fallback and IPv6 destinations. Lives in this thread.
+#ifdef __linux__
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (fd < 0) {
+        qWarning("UDPSinkSender::run: cannot open socket: %s. Falling back to one datagram at a time", strerror(errno));
+    }
+#endif
+
+    qDebug("UDPSinkSender::run: started");
+    m_mutex.lock();
+
+    while (m_running)
+    {
+        if (m_count == 0)
+        {
+            m_dataReady.wait(&m_mutex);
+            continue;
+        }
+
+        // send the contiguous part of the ring outside of the lock
+        int index = m_head;
+        int nbDatagrams = std::min(std::min(m_count, m_queueSize - m_head), (int) m_maxBatch);
+        m_mutex.unlock();
+
+#ifdef __linux__
+        if (fd >= 0)
+        {
+            struct mmsghdr msgs[m_maxBatch];
+            struct iovec iovecs[m_maxBatch];
+            struct sockaddr_in addrs[m_maxBatch];
+            int nbMsgs = 0;
+
+            for (int i = 0; i < nbDatagrams; i++)
+            {
+                Datagram& datagram = m_queue[index + i];
+                bool ok;
+                quint32 ipv4 = datagram.m_address.toIPv4Address(&ok);
+
+                if (!ok) // not an IPv4 destination
+                {
+                    udpSocket.writeDatagram(datagram.m_data.data(), datagram.m_size, datagram.m_address, datagram.m_port);
+                    continue;
+                }
+
+                memset(&addrs[nbMsgs], 0, sizeof(struct sockaddr_in));
+                addrs[nbMsgs].sin_family = AF_INET;
+                addrs[nbMsgs].sin_addr.s_addr = htonl(ipv4);
+                addrs[nbMsgs].sin_port = htons(datagram.m_port);
+                iovecs[nbMsgs].iov_base = datagram.m_data.data();
+                iovecs[nbMsgs].iov_len = datagram.m_size;
+                memset(&msgs[nbMsgs], 0, sizeof(struct mmsghdr));
+                msgs[nbMsgs].msg_hdr.msg_name = &addrs[nbMsgs];
+                msgs[nbMsgs].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+                msgs[nbMsgs].msg_hdr.msg_iov = &iovecs[nbMsgs];
+                msgs[nbMsgs].msg_hdr.msg_iovlen = 1;
+                nbMsgs++;
+            }
+
+            for (int sent = 0; sent < nbMsgs;)
+            {
+                int ret = sendmmsg(fd, &msgs[sent], nbMsgs - sent, 0);
+
+                if (ret < 0)
+                {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+
+                    qDebug("UDPSinkSender::run: sendmmsg: %s", strerror(errno));
+                    sent++; // skip the failing datagram
+                }
+                else
+                {
+                    sent += ret;
+                }
+            }
+        }
+        else
+#endif
+        {
+            for (int i = 0; i < nbDatagrams; i++)
+            {
+                Datagram& datagram = m_queue[index + i];
+                udpSocket.writeDatagram(datagram.m_data.data(), datagram.m_size, datagram.m_address, datagram.m_port);
+            }
+        }
+
+        m_mutex.lock();
+        m_head = (m_head + nbDatagrams) % m_queueSize;
+        m_count -= nbDatagrams;
+    }
+
+    m_mutex.unlock();
+
+#ifdef __linux__
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+
+    qDebug("UDPSinkSender::run: stopped");
+}
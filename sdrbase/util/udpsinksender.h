@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_UDPSINKSENDER_H_
+#define SDRBASE_UTIL_UDPSINKSENDER_H_
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicPointer>
+#include <QHostAddress>
+#include <vector>
+#include <stdint.h>
+
+#include "export.h"
+
+/**
+ * Network sender thread shared by all UDP sinks. DSP threads queue their datagrams
+ * with push() which only copies the data so they never block on the socket. The thread
+ * sends the queued datagrams in batches (sendmmsg on Linux, one datagram at a time elsewhere).
+ * When the queue is full datagrams are dropped and counted.
+ */
+class SDRBASE_API UDPSinkSender : public QThread
+{
+public:
+    static UDPSinkSender& instance(); //!< the thread is started on first use
+    static void shutdown(); //!< stop and join the thread. Call at application exit once no sink is left
+
+    /** Queue a datagram for sending. Called from any thread. Returns false if dropped. */
+    bool push(const char *data, int size, const QHostAddress& address, quint16 port);
+    quint64 getNbDrops() const { QMutexLocker mutexLocker(&m_mutex); return m_nbDrops; }
+
+    static const int m_queueSize = 1024; //!< maximum number of datagrams waiting to be sent
+    static const int m_maxBatch = 64;    //!< maximum number of datagrams sent with one system call
+
+protected:
+    virtual void run();
+
+private:
+    struct Datagram
+    {
+        std::vector<char> m_data; //!< grows to the largest datagram size and is reused
+        int m_size;
+        QHostAddress m_address;
+        quint16 m_port;
+    };
+
+    std::vector<Datagram> m_queue; //!< ring of datagrams
+    int m_head;                    //!< next datagram to send
+    int m_count;                   //!< number of datagrams queued
+    mutable QMutex m_mutex;
+    QWaitCondition m_dataReady;
+    bool m_running;
+    quint64 m_nbDrops;
+
+    UDPSinkSender();
+    ~UDPSinkSender();
+};
+
+#endif /* SDRBASE_UTIL_UDPSINKSENDER_H_ */
@@ -2303,6 +2303,31 @@ bool WebAPIRequestMapper::validateAudioOutputDevice(
         audioOutputDevice.setUdpPort(jsonObject["udpPort"].toInt());
         audioOutputDeviceKeys.append("udpPort");
     }
+    if (jsonObject.contains("outputType"))
+    {
+        audioOutputDevice.setOutputType(jsonObject["outputType"].toInt());
+        audioOutputDeviceKeys.append("outputType");
+    }
+    if (jsonObject.contains("outputPath"))
+    {
+        audioOutputDevice.setOutputPath(new QString(jsonObject["outputPath"].toString()));
+        audioOutputDeviceKeys.append("outputPath");
+    }
+    if (jsonObject.contains("fifos") && jsonObject["fifos"].isArray())
+    {
+        QJsonArray fifosArray = jsonObject["fifos"].toArray();
+
+        for (int i = 0; i < fifosArray.size(); i++)
+        {
+            QJsonObject fifoObject = fifosArray.at(i).toObject();
+            SWGSDRangel::SWGAudioOutputFifo *fifo = new SWGSDRangel::SWGAudioOutputFifo();
+            fifo->setGain(fifoObject.contains("gain") ? fifoObject["gain"].toDouble() : 1.0f);
+            fifo->setPan(fifoObject.contains("pan") ? fifoObject["pan"].toDouble() : 0.0f);
+            audioOutputDevice.getFifos()->append(fifo);
+        }
+
+        audioOutputDeviceKeys.append("fifos");
+    }
     return true;
 }
 
@@ -2412,4 +2437,6 @@ void WebAPIRequestMapper::resetAudioOutputDevice(SWGSDRangel::SWGAudioOutputDevi
     audioOutputDevice.cleanup();
     audioOutputDevice.setName(0);
     audioOutputDevice.setUdpAddress(0);
+    audioOutputDevice.setOutputPath(0);
+    audioOutputDevice.setFifos(new QList<SWGSDRangel::SWGAudioOutputFifo*>()); // never reported here but serialized
 }
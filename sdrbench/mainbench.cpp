@@ -18,17 +18,62 @@
 
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <stdio.h>
+#include <math.h>
 
 #include "mainbench.h"
 
 MainBench *MainBench::m_instance = 0;
 
+namespace {
+
+typedef Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12> DecimatorsII;
+
+/** Decimate with the given decimators: mode 0 is center, 1 lower half (inf) and 2 upper half (sup) */
+void decimateIIMode(DecimatorsII& decimators, int log2Factor, int mode, const qint16* buf, int len, SampleVector::iterator it)
+{
+    switch (log2Factor)
+    {
+    case 0:
+        decimators.decimate1(&it, buf, len);
+        break;
+    case 1:
+        mode == 1 ? decimators.decimate2_inf(&it, buf, len) : mode == 2 ? decimators.decimate2_sup(&it, buf, len) : decimators.decimate2_cen(&it, buf, len);
+        break;
+    case 2:
+        mode == 1 ? decimators.decimate4_inf(&it, buf, len) : mode == 2 ? decimators.decimate4_sup(&it, buf, len) : decimators.decimate4_cen(&it, buf, len);
+        break;
+    case 3:
+        mode == 1 ? decimators.decimate8_inf(&it, buf, len) : mode == 2 ? decimators.decimate8_sup(&it, buf, len) : decimators.decimate8_cen(&it, buf, len);
+        break;
+    case 4:
+        mode == 1 ? decimators.decimate16_inf(&it, buf, len) : mode == 2 ? decimators.decimate16_sup(&it, buf, len) : decimators.decimate16_cen(&it, buf, len);
+        break;
+    case 5:
+        mode == 1 ? decimators.decimate32_inf(&it, buf, len) : mode == 2 ? decimators.decimate32_sup(&it, buf, len) : decimators.decimate32_cen(&it, buf, len);
+        break;
+    case 6:
+        mode == 1 ? decimators.decimate64_inf(&it, buf, len) : mode == 2 ? decimators.decimate64_sup(&it, buf, len) : decimators.decimate64_cen(&it, buf, len);
+        break;
+    default:
+        break;
+    }
+}
+
+}
+
 MainBench::MainBench(qtwebapp::LoggerWithFile *logger, const ParserBench& parser, QObject *parent) :
     QObject(parent),
     m_logger(logger),
     m_parser(parser),
     m_uniform_distribution_f(-1.0, 1.0),
-    m_uniform_distribution_s16(-2048, 2047)
+    m_uniform_distribution_s16(-2048, 2047),
+    m_interpolatorDistanceRemain(0)
 {
     qDebug() << "MainBench::MainBench: start";
     m_instance = this;
@@ -47,23 +92,73 @@ void MainBench::run()
         << " repet: " << m_parser.getRepetition()
         << " log2f: " << m_parser.getLog2Factor();
 
-    if (m_parser.getTestType() == ParserBench::TestDecimatorsII) {
+    if (m_parser.getTestType() == ParserBench::TestAll)
+    {
+        for (int testType = 0; testType < (int) ParserBench::TestAll; testType++) {
+            runTest((ParserBench::TestType) testType);
+        }
+    }
+    else
+    {
+        runTest(m_parser.getTestType());
+    }
+
+    writeResults();
+
+    emit finished();
+}
+
+void MainBench::runTest(ParserBench::TestType testType)
+{
+    if (testType == ParserBench::TestDecimatorsII) {
         testDecimateII();
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsInfII) {
+    } else if (testType == ParserBench::TestDecimatorsInfII) {
         testDecimateII(ParserBench::TestDecimatorsInfII);
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsSupII) {
+    } else if (testType == ParserBench::TestDecimatorsSupII) {
         testDecimateII(ParserBench::TestDecimatorsSupII);
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsIF) {
+    } else if (testType == ParserBench::TestDecimatorsBlockII) {
+        testDecimateBlockII();
+    } else if (testType == ParserBench::TestDecimatorsIF) {
         testDecimateIF();
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsFI) {
+    } else if (testType == ParserBench::TestDecimatorsFI) {
         testDecimateFI();
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsFF) {
+    } else if (testType == ParserBench::TestDecimatorsFF) {
         testDecimateFF();
+    } else if (testType == ParserBench::TestResamplerSample) {
+        testResampler(ParserBench::TestResamplerSample);
+    } else if (testType == ParserBench::TestResamplerBlock) {
+        testResampler(ParserBench::TestResamplerBlock);
+    } else if (testType == ParserBench::TestChannelizer) {
+        testChannelizer();
+    } else if (testType == ParserBench::TestNCO) {
+        testNCO();
+    } else if (testType == ParserBench::TestFFTFilt) {
+        testFFTFilt();
+    } else if (testType == ParserBench::TestFFT) {
+        testFFT();
+    } else if (testType == ParserBench::TestSampleFifo) {
+        testSampleFifo();
+    } else if (testType == ParserBench::TestPhaseDiscri) {
+        testPhaseDiscri();
+    } else if (testType == ParserBench::TestAGC) {
+        testAGC();
+    } else if (testType == ParserBench::TestDemodNFM) {
+        testDemodNFM();
+    } else if (testType == ParserBench::TestDemodWFM) {
+        testDemodWFM();
+    } else if (testType == ParserBench::TestDemodSSB) {
+        testDemodSSB();
+    } else if (testType == ParserBench::TestSDRdaemonFEC) {
+#ifdef USE_CM256CC
+        testSDRdaemonFEC();
+#else
+        qWarning() << "MainBench::runTest: sdrdaemonfec: built without CM256cc";
+#endif
+    } else if (testType == ParserBench::TestDATVFEC) {
+        testDATVFEC();
     } else {
-        qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
+        qDebug() << "MainBench::runTest: unknown test type: " << testType;
     }
-
-    emit finished();
 }
 
 void MainBench::testDecimateII(ParserBench::TestType testType)
@@ -103,12 +198,96 @@ void MainBench::testDecimateII(ParserBench::TestType testType)
         }
     }
 
-    printResults("MainBench::testDecimateII", nsecs);
+    printResults(testType == ParserBench::TestDecimatorsInfII ? "decimateinfii" :
+        testType == ParserBench::TestDecimatorsSupII ? "decimatesupii" : "decimateii", nsecs);
 
     qDebug() << "MainBench::testDecimateII: cleanup test data";
     delete[] buf;
 }
 
+void MainBench::testDecimateBlockII()
+{
+    QElapsedTimer timer;
+
+    qDebug() << "MainBench::testDecimateBlockII: create test data";
+
+    qint16 *buf = new qint16[m_parser.getNbSamples()*2];
+    m_convertBuffer.resize(m_parser.getNbSamples()/(1<<m_parser.getLog2Factor()));
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+    std::generate(buf, buf + m_parser.getNbSamples()*2 - 1, my_rand);
+
+    qDebug() << "MainBench::testDecimateBlockII: run test with block kernel" << IntHalfbandFilterBlock::getKernelName();
+    bool blockDecimation = m_decimatorsII.getBlockDecimation();
+
+    // sample by sample then block decimation of the same data for center, lower and upper half
+    for (int block = 0; block < 2; block++)
+    {
+        m_decimatorsII.setBlockDecimation(block == 1);
+        QString suffix = block == 1 ? QString(" block %1").arg(IntHalfbandFilterBlock::getKernelName()) : QString(" sample");
+        qint64 nsecs[3] = {0, 0, 0};
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+            decimateII(buf, m_parser.getNbSamples()*2);
+            nsecs[0] += timer.nsecsElapsed();
+            timer.start();
+            decimateInfII(buf, m_parser.getNbSamples()*2);
+            nsecs[1] += timer.nsecsElapsed();
+            timer.start();
+            decimateSupII(buf, m_parser.getNbSamples()*2);
+            nsecs[2] += timer.nsecsElapsed();
+        }
+
+        printResults("decimateii" + suffix, nsecs[0]);
+        printResults("decimateinfii" + suffix, nsecs[1]);
+        printResults("decimatesupii" + suffix, nsecs[2]);
+    }
+
+    m_decimatorsII.setBlockDecimation(blockDecimation);
+
+    // fresh sample by sample and block decimators must give the same output on the same input
+    // (two calls so that the history carried between calls is checked too)
+    const char *modeNames[3] = {"cen", "inf", "sup"};
+    int nbOut = m_parser.getNbSamples() >> m_parser.getLog2Factor();
+    SampleVector sampleOut(2*nbOut);
+    SampleVector blockOut(2*nbOut);
+
+    for (int mode = 0; mode < 3; mode++)
+    {
+        DecimatorsII *sampleDecimators = new DecimatorsII();
+        DecimatorsII *blockDecimators = new DecimatorsII();
+        sampleDecimators->setBlockDecimation(false);
+        blockDecimators->setBlockDecimation(true);
+
+        for (int call = 0; call < 2; call++)
+        {
+            decimateIIMode(*sampleDecimators, m_parser.getLog2Factor(), mode, buf, m_parser.getNbSamples()*2, sampleOut.begin() + call*nbOut);
+            decimateIIMode(*blockDecimators, m_parser.getLog2Factor(), mode, buf, m_parser.getNbSamples()*2, blockOut.begin() + call*nbOut);
+        }
+
+        int nbMismatches = 0;
+
+        for (int i = 0; i < 2*nbOut; i++) {
+            nbMismatches += (sampleOut[i].real() != blockOut[i].real()) || (sampleOut[i].imag() != blockOut[i].imag()) ? 1 : 0;
+        }
+
+        if (nbMismatches > 0) {
+            qWarning("MainBench::testDecimateBlockII: decimate%d_%s: %d of %d block outputs differ from sample by sample",
+                1<<m_parser.getLog2Factor(), modeNames[mode], nbMismatches, 2*nbOut);
+        } else {
+            qInfo("MainBench::testDecimateBlockII: decimate%d_%s: %d block outputs match sample by sample",
+                1<<m_parser.getLog2Factor(), modeNames[mode], 2*nbOut);
+        }
+
+        delete sampleDecimators;
+        delete blockDecimators;
+    }
+
+    qDebug() << "MainBench::testDecimateBlockII: cleanup test data";
+    delete[] buf;
+}
+
 void MainBench::testDecimateIF()
 {
     QElapsedTimer timer;
@@ -130,7 +309,7 @@ void MainBench::testDecimateIF()
         nsecs += timer.nsecsElapsed();
     }
 
-    printResults("MainBench::testDecimateIF", nsecs);
+    printResults("decimateif", nsecs);
 
     qDebug() << "MainBench::testDecimateIF: cleanup test data";
     delete[] buf;
@@ -157,7 +336,7 @@ void MainBench::testDecimateFI()
         nsecs += timer.nsecsElapsed();
     }
 
-    printResults("MainBench::testDecimateFI", nsecs);
+    printResults("decimatefi", nsecs);
 
     qDebug() << "MainBench::testDecimateFI: cleanup test data";
     delete[] buf;
@@ -184,12 +363,62 @@ void MainBench::testDecimateFF()
         nsecs += timer.nsecsElapsed();
     }
 
-    printResults("MainBench::testDecimateFF", nsecs);
+    printResults("decimateff", nsecs);
 
     qDebug() << "MainBench::testDecimateFF: cleanup test data";
     delete[] buf;
 }
 
+void MainBench::testResampler(ParserBench::TestType testType)
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    // channel rate of 50 kS/s times the log2 factor resampled to 48 kS/s audio rate
+    // this gives a 25/24 * 2^log2 ratio that exercises all polyphase branches
+    Real inputSampleRate = 50000.0 * (1<<m_parser.getLog2Factor());
+    Real outputSampleRate = 48000.0;
+    Real distance = inputSampleRate / outputSampleRate;
+
+    qDebug() << "MainBench::testResampler: create test data";
+
+    Complex *buf = new Complex[m_parser.getNbSamples()];
+    m_resampleBuffer.resize(Interpolator::getMaxOutputs(m_parser.getNbSamples(), distance));
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (uint32_t i = 0; i < m_parser.getNbSamples(); i++) {
+        buf[i] = Complex(my_rand(), my_rand());
+    }
+
+    m_interpolator.create(16, inputSampleRate, 3000.0);
+    m_interpolatorDistanceRemain = 0;
+
+    qDebug() << "MainBench::testResampler: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        switch (testType)
+        {
+        case ParserBench::TestResamplerBlock:
+            timer.start();
+            resampleBlock(buf, m_parser.getNbSamples(), distance);
+            nsecs += timer.nsecsElapsed();
+            break;
+        case ParserBench::TestResamplerSample:
+        default:
+            timer.start();
+            resampleSample(buf, m_parser.getNbSamples(), distance);
+            nsecs += timer.nsecsElapsed();
+            break;
+        }
+    }
+
+    printResults(testType == ParserBench::TestResamplerBlock ? "resamplerblock" : "resamplersample", nsecs);
+
+    qDebug() << "MainBench::testResampler: cleanup test data";
+    delete[] buf;
+}
+
 void MainBench::decimateII(const qint16* buf, int len)
 {
     SampleVector::iterator it = m_convertBuffer.begin();
@@ -382,10 +611,119 @@ void MainBench::decimateFF(const float *buf, int len)
     }
 }
 
-void MainBench::printResults(const QString& prefix, qint64 nsecs)
+void MainBench::resampleSample(const Complex *buf, int len, Real distance)
+{
+    Complex *out = m_resampleBuffer.data();
+    Complex ci;
+
+    for (int i = 0; i < len; i++)
+    {
+        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, buf[i], &ci))
+        {
+            *out++ = ci;
+            m_interpolatorDistanceRemain += distance;
+        }
+    }
+}
+
+void MainBench::resampleBlock(const Complex *buf, int len, Real distance)
+{
+    m_interpolator.decimate(&m_interpolatorDistanceRemain, distance, buf, len, m_resampleBuffer.data());
+}
+
+void MainBench::createSignal(SampleVector& samples, Real sampleRate, Real frequency, Real fmDeviation)
 {
-    double ratekSs = (m_parser.getNbSamples()*m_parser.getRepetition() / (double) nsecs) * 1e6;
+    // carrier at frequency modulated in FM by a 1 kHz tone plus some noise
+    samples.resize(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+    double modPhase = 0.0;
+    double phase = 0.0;
+
+    for (uint32_t i = 0; i < m_parser.getNbSamples(); i++)
+    {
+        modPhase += (2.0 * M_PI * 1000.0) / sampleRate;
+        phase += (2.0 * M_PI * (frequency + fmDeviation * sin(modPhase))) / sampleRate;
+        modPhase = modPhase > M_PI ? modPhase - 2.0 * M_PI : modPhase;
+        phase = phase > M_PI ? phase - 2.0 * M_PI : phase < -M_PI ? phase + 2.0 * M_PI : phase;
+        samples[i].setReal((FixReal) ((0.5 * cos(phase) + 0.01 * my_rand()) * SDR_RX_SCALEF));
+        samples[i].setImag((FixReal) ((0.5 * sin(phase) + 0.01 * my_rand()) * SDR_RX_SCALEF));
+    }
+}
+
+void MainBench::printResults(const QString& name, qint64 nsecs, quint64 nbSamples)
+{
+    if (nbSamples == 0) {
+        nbSamples = (quint64) m_parser.getNbSamples() * m_parser.getRepetition();
+    }
+
+    m_results.push_back(BenchResult(name, nbSamples, nsecs));
+    double rateMSs = (nbSamples / (double) nsecs) * 1e3;
+    double nsPerSample = nsecs / (double) nbSamples;
     QDebug info = qInfo();
     info.noquote();
-    info << tr("%1: ran test in %L2 ns - sample rate: %3 kS/s").arg(prefix).arg(nsecs).arg(ratekSs);
+    info << tr("MainBench: %1: ran test in %L2 ns - sample rate: %3 MS/s - %4 ns/sample")
+        .arg(name).arg(nsecs).arg(rateMSs).arg(nsPerSample);
+}
+
+void MainBench::writeResults()
+{
+    QByteArray output;
+
+    if (m_parser.getOutputFormat() == ParserBench::OutputJSON)
+    {
+        QJsonArray results;
+
+        for (std::vector<BenchResult>::const_iterator it = m_results.begin(); it != m_results.end(); ++it)
+        {
+            QJsonObject result;
+            result.insert("test", it->m_name);
+            result.insert("samples", (double) it->m_nbSamples);
+            result.insert("nsecs", (double) it->m_nsecs);
+            result.insert("msps", (it->m_nbSamples / (double) it->m_nsecs) * 1e3);
+            result.insert("nsPerSample", it->m_nsecs / (double) it->m_nbSamples);
+            results.append(result);
+        }
+
+        QJsonObject root;
+        root.insert("nbSamples", (double) m_parser.getNbSamples());
+        root.insert("repetition", (double) m_parser.getRepetition());
+        root.insert("log2Factor", (double) m_parser.getLog2Factor());
+        root.insert("rxSampleSize", SDR_RX_SAMP_SZ);
+        root.insert("results", results);
+        output = QJsonDocument(root).toJson();
+    }
+    else if (m_parser.getOutputFormat() == ParserBench::OutputCSV)
+    {
+        output.append("test,samples,nsecs,msps,ns_per_sample\n");
+
+        for (std::vector<BenchResult>::const_iterator it = m_results.begin(); it != m_results.end(); ++it)
+        {
+            output.append(QString("%1,%2,%3,%4,%5\n")
+                .arg(it->m_name)
+                .arg(it->m_nbSamples)
+                .arg(it->m_nsecs)
+                .arg((it->m_nbSamples / (double) it->m_nsecs) * 1e3)
+                .arg(it->m_nsecs / (double) it->m_nbSamples).toUtf8());
+        }
+    }
+    else
+    {
+        return; // text results are already printed by printResults
+    }
+
+    if (m_parser.getOutputFile().isEmpty())
+    {
+        fwrite(output.constData(), 1, output.size(), stdout);
+        fflush(stdout);
+    }
+    else
+    {
+        QFile file(m_parser.getOutputFile());
+
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(output);
+        } else {
+            qWarning() << "MainBench::writeResults: cannot open " << m_parser.getOutputFile();
+        }
+    }
 }
@@ -22,11 +22,13 @@
 #include <QObject>
 #include <random>
 #include <functional>
+#include <vector>
 
 #include "dsp/decimators.h"
 #include "dsp/decimatorsif.h"
 #include "dsp/decimatorsfi.h"
 #include "dsp/decimatorsff.h"
+#include "dsp/interpolator.h"
 #include "parserbench.h"
 
 namespace qtwebapp {
@@ -47,17 +49,49 @@ signals:
     void finished();
 
 private:
+    struct BenchResult
+    {
+        QString m_name;
+        quint64 m_nbSamples;
+        qint64 m_nsecs;
+
+        BenchResult(const QString& name, quint64 nbSamples, qint64 nsecs) :
+            m_name(name),
+            m_nbSamples(nbSamples),
+            m_nsecs(nsecs)
+        {}
+    };
+
+    void runTest(ParserBench::TestType testType);
     void testDecimateII(ParserBench::TestType testType = ParserBench::TestDecimatorsII);
+    void testDecimateBlockII();
     void testDecimateIF();
     void testDecimateFI();
     void testDecimateFF();
+    void testResampler(ParserBench::TestType testType);
+    void testChannelizer();
+    void testNCO();
+    void testFFTFilt();
+    void testFFT();
+    void testSampleFifo();
+    void testPhaseDiscri();
+    void testAGC();
+    void testDemodNFM();
+    void testDemodWFM();
+    void testDemodSSB();
+    void testSDRdaemonFEC();
+    void testDATVFEC();
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
     void decimateIF(const qint16 *buf, int len);
     void decimateFI(const float *buf, int len);
     void decimateFF(const float *buf, int len);
-    void printResults(const QString& prefix, qint64 nsecs);
+    void resampleSample(const Complex *buf, int len, Real distance);
+    void resampleBlock(const Complex *buf, int len, Real distance);
+    void createSignal(SampleVector& samples, Real sampleRate, Real frequency, Real fmDeviation);
+    void printResults(const QString& name, qint64 nsecs, quint64 nbSamples = 0);
+    void writeResults();
 
     static MainBench *m_instance;
     qtwebapp::LoggerWithFile *m_logger;
@@ -70,9 +104,13 @@ private:
 	DecimatorsIF<qint16, 12> m_decimatorsIF;
 	DecimatorsFI m_decimatorsFI;
     DecimatorsFF m_decimatorsFF;
+    Interpolator m_interpolator;
+    Real m_interpolatorDistanceRemain;
 
     SampleVector m_convertBuffer;
     FSampleVector m_convertBufferF;
+    std::vector<Complex> m_resampleBuffer;
+    std::vector<BenchResult> m_results;
 };
 
 #endif // SDRBENCH_MAINBENCH_H_
@@ -37,12 +37,21 @@ ParserBench::ParserBench() :
     m_log2FactorOption(QStringList() << "l" << "log2-factor",
         "Log2 factor for rate conversion.",
         "log2",
-        "2")
+        "2"),
+    m_outputFormatOption(QStringList() << "f" << "format",
+        "Results output format: text, json or csv.",
+        "format",
+        "text"),
+    m_outputFileOption(QStringList() << "o" << "output",
+        "Write json or csv results to this file instead of the standard output.",
+        "file",
+        "")
 {
     m_testStr = "decimateii";
     m_nbSamples = 1048576;
     m_repetition = 1;
     m_log2Factor = 4;
+    m_outputFormat = OutputText;
 
     m_parser.setApplicationDescription("Software Defined Radio application benchmarks");
     m_parser.addHelpOption();
@@ -52,6 +61,8 @@ ParserBench::ParserBench() :
     m_parser.addOption(m_nbSamplesOption);
     m_parser.addOption(m_repetitionOption);
     m_parser.addOption(m_log2FactorOption);
+    m_parser.addOption(m_outputFormatOption);
+    m_parser.addOption(m_outputFileOption);
 }
 
 ParserBench::~ParserBench()
@@ -110,6 +121,24 @@ void ParserBench::parse(const QCoreApplication& app)
     } else {
         qWarning() << "ParserBench::parse: repetilog2 factortion invalid. Defaulting to " << m_log2Factor;
     }
+
+    // output format
+
+    QString outputFormat = m_parser.value(m_outputFormatOption);
+
+    if (outputFormat == "text") {
+        m_outputFormat = OutputText;
+    } else if (outputFormat == "json") {
+        m_outputFormat = OutputJSON;
+    } else if (outputFormat == "csv") {
+        m_outputFormat = OutputCSV;
+    } else {
+        qWarning() << "ParserBench::parse: output format invalid. Defaulting to text";
+    }
+
+    // output file
+
+    m_outputFile = m_parser.value(m_outputFileOption);
 }
 
 ParserBench::TestType ParserBench::getTestType() const
@@ -124,6 +153,38 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsInfII;
     } else if (m_testStr == "decimatesupii") {
         return TestDecimatorsSupII;
+    } else if (m_testStr == "decimateblockii") {
+        return TestDecimatorsBlockII;
+    } else if (m_testStr == "resamplersample") {
+        return TestResamplerSample;
+    } else if (m_testStr == "resamplerblock") {
+        return TestResamplerBlock;
+    } else if (m_testStr == "channelizer") {
+        return TestChannelizer;
+    } else if (m_testStr == "nco") {
+        return TestNCO;
+    } else if (m_testStr == "fftfilt") {
+        return TestFFTFilt;
+    } else if (m_testStr == "fft") {
+        return TestFFT;
+    } else if (m_testStr == "samplefifo") {
+        return TestSampleFifo;
+    } else if (m_testStr == "phasediscri") {
+        return TestPhaseDiscri;
+    } else if (m_testStr == "agc") {
+        return TestAGC;
+    } else if (m_testStr == "demodnfm") {
+        return TestDemodNFM;
+    } else if (m_testStr == "demodwfm") {
+        return TestDemodWFM;
+    } else if (m_testStr == "demodssb") {
+        return TestDemodSSB;
+    } else if (m_testStr == "sdrdaemonfec") {
+        return TestSDRdaemonFEC;
+    } else if (m_testStr == "datvfec") {
+        return TestDATVFEC;
+    } else if (m_testStr == "all") {
+        return TestAll;
     } else {
         return TestDecimatorsII;
     }
@@ -31,9 +31,32 @@ public:
         TestDecimatorsFI,
         TestDecimatorsFF,
         TestDecimatorsInfII,
-        TestDecimatorsSupII
+        TestDecimatorsSupII,
+        TestDecimatorsBlockII,
+        TestResamplerSample,
+        TestResamplerBlock,
+        TestChannelizer,
+        TestNCO,
+        TestFFTFilt,
+        TestFFT,
+        TestSampleFifo,
+        TestPhaseDiscri,
+        TestAGC,
+        TestDemodNFM,
+        TestDemodWFM,
+        TestDemodSSB,
+        TestSDRdaemonFEC,
+        TestDATVFEC,
+        TestAll
     } TestType;
 
+    typedef enum
+    {
+        OutputText,
+        OutputJSON,
+        OutputCSV
+    } OutputFormat;
+
     ParserBench();
     ~ParserBench();
 
@@ -44,18 +67,24 @@ public:
     uint32_t getNbSamples() const { return m_nbSamples; }
     uint32_t getRepetition() const { return m_repetition; }
     uint32_t getLog2Factor() const { return m_log2Factor; }
+    OutputFormat getOutputFormat() const { return m_outputFormat; }
+    const QString& getOutputFile() const { return m_outputFile; }
 
 private:
     QString  m_testStr;
     uint32_t m_nbSamples;
     uint32_t m_repetition;
     uint32_t m_log2Factor;
+    OutputFormat m_outputFormat;
+    QString  m_outputFile;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_testOption;
     QCommandLineOption m_nbSamplesOption;
     QCommandLineOption m_repetitionOption;
     QCommandLineOption m_log2FactorOption;
+    QCommandLineOption m_outputFormatOption;
+    QCommandLineOption m_outputFileOption;
 };
 
 
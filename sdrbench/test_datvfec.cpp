@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <string.h>
+#include <algorithm>
+
+#include "leansdr/framework.h"
+#include "leansdr/generic.h"
+#include "leansdr/dsp.h"
+#include "leansdr/sdr.h"
+#include "leansdr/dvb.h"
+
+#include "mainbench.h"
+
+namespace {
+
+typedef leansdr::viterbi_sync VS;
+
+/** Time nbUpdates Viterbi updates with random branch metrics with the reference decoder and with each
+ * add-compare-select kernel supported by the CPU. Returns the number of mismatches with the reference per kernel. */
+template<typename TRELLIS, typename REFDEC, typename SIMDDEC, int NCS>
+void benchViterbi(leansdr::code_rate cr, unsigned int nbUpdates, unsigned int repetition, std::mt19937& generator,
+        const leansdr::viterbi_acs_kernel_info *kernels, int nbKernels,
+        qint64& nsecsRef, qint64 *nsecsKernels, int *nbMismatches)
+{
+    TRELLIS trellis;
+    trellis.init_convolutional(leansdr::fec_specs[cr].polys);
+    typename SIMDDEC::tables_type tables(&trellis);
+    std::uniform_int_distribution<int> csDistribution(0, NCS - 1);
+    std::uniform_int_distribution<int> costDistribution(0, 300);
+    std::vector<VS::TCS> cs(nbUpdates);
+    std::vector<VS::TBM> costs(nbUpdates);
+    std::vector<VS::TUS> refOut(nbUpdates);
+    std::vector<VS::TUS> simdOut(nbUpdates);
+    QElapsedTimer timer;
+
+    for (unsigned int i = 0; i < nbUpdates; i++)
+    {
+        cs[i] = csDistribution(generator);
+        costs[i] = -costDistribution(generator);
+    }
+
+    REFDEC refDec(&trellis);
+    nsecsRef = 0;
+
+    for (unsigned int r = 0; r < repetition; r++)
+    {
+        timer.start();
+
+        for (unsigned int i = 0; i < nbUpdates; i++) {
+            refOut[i] = refDec.update(cs[i], costs[i]);
+        }
+
+        nsecsRef += timer.nsecsElapsed();
+    }
+
+    for (int ik = 0; ik < nbKernels; ik++)
+    {
+        SIMDDEC simdDec(&trellis, &tables, kernels[ik].acs);
+        nsecsKernels[ik] = 0;
+
+        for (unsigned int r = 0; r < repetition; r++)
+        {
+            timer.start();
+
+            for (unsigned int i = 0; i < nbUpdates; i++) {
+                simdOut[i] = simdDec.update(cs[i], costs[i]);
+            }
+
+            nsecsKernels[ik] += timer.nsecsElapsed();
+        }
+
+        nbMismatches[ik] = 0;
+
+        for (unsigned int i = 0; i < nbUpdates; i++) { // both decoders went through the same repetitions
+            nbMismatches[ik] += refOut[i] != simdOut[i] ? 1 : 0;
+        }
+    }
+}
+
+}
+
+/** DATV FEC decoders: reference and SIMD Viterbi (1/2 and 3/4) with every supported kernel, direct and table driven RS(204,188) */
+void MainBench::testDATVFEC()
+{
+    unsigned int nbSamples = m_parser.getNbSamples();
+    unsigned int repetition = m_parser.getRepetition();
+    leansdr::viterbi_acs_kernel_info kernels[3];
+    int nbKernels = leansdr::viterbi_acs_kernels(kernels);
+    qint64 nsecsRef, nsecsSIMD, nsecsKernels[3];
+    int nbMismatches[3];
+
+    qDebug() << "MainBench::testDATVFEC: Viterbi 1/2";
+    benchViterbi<VS::trellis_12,
+        leansdr::viterbi_dec<VS::TS, 64, VS::TUS, 2, VS::TCS, 4, VS::TBM, VS::TPM, VS::path_12>,
+        VS::dvb_dec_12, 4>(leansdr::FEC12, nbSamples, repetition, m_generator, kernels, nbKernels, nsecsRef, nsecsKernels, nbMismatches);
+    printResults("datvviterbiref12", nsecsRef);
+
+    for (int ik = 0; ik < nbKernels; ik++)
+    {
+        printResults(QString("datvviterbi12 %1").arg(kernels[ik].name), nsecsKernels[ik]);
+        qInfo("MainBench::testDATVFEC: Viterbi 1/2: %.1f Mbit/s reference %.1f Mbit/s %s",
+            (1.0 * nbSamples * repetition * 1e3) / nsecsRef, (1.0 * nbSamples * repetition * 1e3) / nsecsKernels[ik], kernels[ik].name);
+
+        if (nbMismatches[ik] > 0) {
+            qWarning() << "MainBench::testDATVFEC: Viterbi 1/2:" << kernels[ik].name << "kernel differs from reference: " << nbMismatches[ik];
+        }
+    }
+
+    qDebug() << "MainBench::testDATVFEC: Viterbi 3/4";
+    benchViterbi<VS::trellis_34,
+        leansdr::viterbi_dec<VS::TS, 64, VS::TUS, 8, VS::TCS, 16, VS::TBM, VS::TPM, VS::path_34>,
+        VS::dvb_dec_34, 16>(leansdr::FEC34, nbSamples, repetition, m_generator, kernels, nbKernels, nsecsRef, nsecsKernels, nbMismatches);
+    printResults("datvviterbiref34", nsecsRef);
+
+    for (int ik = 0; ik < nbKernels; ik++)
+    {
+        printResults(QString("datvviterbi34 %1").arg(kernels[ik].name), nsecsKernels[ik]);
+        qInfo("MainBench::testDATVFEC: Viterbi 3/4: %.1f Mbit/s reference %.1f Mbit/s %s",
+            (3.0 * nbSamples * repetition * 1e3) / nsecsRef, (3.0 * nbSamples * repetition * 1e3) / nsecsKernels[ik], kernels[ik].name);
+
+        if (nbMismatches[ik] > 0) {
+            qWarning() << "MainBench::testDATVFEC: Viterbi 3/4:" << kernels[ik].name << "kernel differs from reference: " << nbMismatches[ik];
+        }
+    }
+
+    // RS: one MPEG packet per 188 samples with 0 to 8 byte errors
+    qDebug() << "MainBench::testDATVFEC: RS(204,188)";
+    leansdr::rs_engine rs;
+    unsigned int nbPackets = std::max(1U, nbSamples / 188);
+    std::vector<leansdr::u8> packets(nbPackets * 204);
+    std::vector<leansdr::u8> work(nbPackets * 204);
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+    int nbFailures = 0;
+    QElapsedTimer timer;
+
+    for (unsigned int ip = 0; ip < nbPackets; ip++)
+    {
+        leansdr::u8 *packet = &packets[ip*204];
+
+        for (int i = 0; i < 188; i++) {
+            packet[i] = my_rand() & 0xff;
+        }
+
+        rs.encode(packet);
+
+        for (unsigned int ie = 0; ie < ip % 9; ie++) {
+            packet[(my_rand() & 0x7fff) % 204] ^= 1 + (my_rand() & 0x7fff) % 255;
+        }
+    }
+
+    nsecsRef = 0;
+    nsecsSIMD = 0;
+
+    for (unsigned int r = 0; r < repetition; r++)
+    {
+        for (int pass = 0; pass < 2; pass++)
+        {
+            std::copy(packets.begin(), packets.end(), work.begin());
+            timer.start();
+
+            for (unsigned int ip = 0; ip < nbPackets; ip++)
+            {
+                leansdr::u8 *pin = &work[ip*204];
+                leansdr::u8 synd[16], pout[188];
+                bool corrupted = pass == 0 ? rs.syndromes_horner(pin, synd) : rs.syndromes(pin, synd);
+
+                if (corrupted)
+                {
+                    memcpy(pout, pin, 188);
+                    rs.correct(synd, pout); // Berlekamp-Massey, Chien search and Forney
+                }
+            }
+
+            (pass == 0 ? nsecsRef : nsecsSIMD) += timer.nsecsElapsed();
+        }
+    }
+
+    for (unsigned int ip = 0; ip < nbPackets; ip++)
+    {
+        leansdr::u8 synd[16], synd2[16];
+
+        if ((rs.syndromes_horner(&packets[ip*204], synd) != rs.syndromes(&packets[ip*204], synd2)) || memcmp(synd, synd2, 16)) {
+            nbFailures++;
+        }
+    }
+
+    printResults("datvrsref", nsecsRef, (quint64) nbPackets * 188 * repetition);
+    printResults("datvrstable", nsecsSIMD, (quint64) nbPackets * 188 * repetition);
+    qInfo("MainBench::testDATVFEC: RS(204,188): %.1f Mbit/s reference %.1f Mbit/s table driven",
+        (8.0 * 188 * nbPackets * repetition * 1e3) / nsecsRef, (8.0 * 188 * nbPackets * repetition * 1e3) / nsecsSIMD);
+
+    if (nbFailures > 0) {
+        qWarning() << "MainBench::testDATVFEC: RS syndromes differ: " << nbFailures;
+    }
+}
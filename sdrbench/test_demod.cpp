@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server adapter interface                                              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "dsp/nco.h"
+#include "dsp/interpolator.h"
+#include "dsp/phasediscri.h"
+#include "dsp/lowpass.h"
+#include "dsp/bandpass.h"
+#include "dsp/fftfilt.h"
+#include "dsp/agc.h"
+#include "mainbench.h"
+
+// The demodulator chains below are models of the per block processing of the NFM, WFM and SSB
+// channel plugins built with the same sdrbase building blocks and settings. They do not run
+// the plugins feed() code (squelch, CTCSS, AGC details, audio FIFO, locking) so results are
+// labelled as models and only track the cost of the building blocks they share with them.
+// They are fed with a synthetic signal at the channel sample rate and produce 48 kS/s audio.
+
+void MainBench::testDemodNFM()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    Real inputSampleRate = 96000.0;
+    Real audioSampleRate = 48000.0;
+    Real rfBandwidth = 12500.0;
+    qint64 sum = 0;
+
+    qDebug() << "MainBench::testDemodNFM: create test data";
+
+    SampleVector samples;
+    createSignal(samples, inputSampleRate, 1000.0, 2500.0);
+    std::vector<Complex> mixed(samples.size());
+    std::vector<Complex> decimated(samples.size());
+    std::vector<qint16> audio(samples.size());
+
+    NCO nco;
+    nco.setFreq(-1000.0, inputSampleRate);
+    Interpolator interpolator;
+    interpolator.create(16, inputSampleRate, rfBandwidth / 2.2f);
+    Real interpolatorDistance = inputSampleRate / audioSampleRate;
+    Real interpolatorDistanceRemain = interpolatorDistance;
+    PhaseDiscriminators phaseDiscri;
+    phaseDiscri.setFMScaling(audioSampleRate / 2500.0f);
+    Lowpass<Real> ctcssLowpass;
+    ctcssLowpass.create(301, audioSampleRate, 250.0);
+    Bandpass<Real> audioBandpass;
+    audioBandpass.create(301, audioSampleRate, 300.0, 3000.0);
+
+    qDebug() << "MainBench::testDemodNFM: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        nco.mix(samples.begin(), samples.end(), mixed.data());
+        int nbDecimated = interpolator.decimate(&interpolatorDistanceRemain, interpolatorDistance,
+            mixed.data(), mixed.size(), decimated.data());
+
+        for (int j = 0; j < nbDecimated; j++)
+        {
+            double magsq;
+            Real deviation;
+            Real demod = phaseDiscri.phaseDiscriminatorDelta(decimated[j], magsq, deviation);
+            sum += (qint64) ctcssLowpass.filter(demod);
+            audio[j] = (qint16) (audioBandpass.filter(demod) * 3276.8f);
+        }
+
+        nsecs += timer.nsecsElapsed();
+        sum += audio[0];
+    }
+
+    printResults("demodnfm model", nsecs);
+    qDebug() << "MainBench::testDemodNFM: checksum: " << sum;
+}
+
+void MainBench::testDemodWFM()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    Real inputSampleRate = 384000.0;
+    Real audioSampleRate = 48000.0;
+    Real rfBandwidth = 200000.0;
+    Real afBandwidth = 15000.0;
+    qint64 sum = 0;
+
+    qDebug() << "MainBench::testDemodWFM: create test data";
+
+    SampleVector samples;
+    createSignal(samples, inputSampleRate, 10000.0, 75000.0);
+    std::vector<Complex> mixed(samples.size());
+    std::vector<qint16> audio(samples.size());
+    fftfilt::cmplx *rf;
+
+    NCO nco;
+    nco.setFreq(-10000.0, inputSampleRate);
+    fftfilt rfFilter(-(rfBandwidth / 2.0f) / inputSampleRate, (rfBandwidth / 2.0f) / inputSampleRate, 1024);
+    Interpolator interpolator;
+    interpolator.create(16, inputSampleRate, afBandwidth);
+    Real interpolatorDistance = inputSampleRate / audioSampleRate;
+    Real interpolatorDistanceRemain = interpolatorDistance;
+    PhaseDiscriminators phaseDiscri;
+    phaseDiscri.setFMScaling(inputSampleRate / 75000.0f);
+
+    qDebug() << "MainBench::testDemodWFM: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        unsigned int audioFill = 0;
+        timer.start();
+
+        nco.mix(samples.begin(), samples.end(), mixed.data());
+
+        for (std::vector<Complex>::const_iterator it = mixed.begin(); it != mixed.end(); ++it)
+        {
+            int rf_out = rfFilter.runFilt(*it, &rf);
+
+            for (int j = 0 ; j < rf_out; j++)
+            {
+                double magsq;
+                Real fmDev;
+                Complex ci;
+                Complex e(phaseDiscri.phaseDiscriminatorDelta(rf[j], magsq, fmDev), 0);
+
+                if (interpolator.decimate(&interpolatorDistanceRemain, e, &ci))
+                {
+                    audio[audioFill++] = (qint16) (ci.real() * 3276.8f);
+                    interpolatorDistanceRemain += interpolatorDistance;
+                }
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+        sum += audio[0];
+    }
+
+    printResults("demodwfm model", nsecs);
+    qDebug() << "MainBench::testDemodWFM: checksum: " << sum;
+}
+
+void MainBench::testDemodSSB()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    Real inputSampleRate = 96000.0;
+    Real audioSampleRate = 48000.0;
+    Real bandwidth = 3000.0;
+    Real lowCutoff = 300.0;
+    qint64 sum = 0;
+
+    qDebug() << "MainBench::testDemodSSB: create test data";
+
+    SampleVector samples;
+    createSignal(samples, inputSampleRate, 1000.0, 0.0);
+    std::vector<Complex> mixed(samples.size());
+    std::vector<Complex> decimated(samples.size());
+    std::vector<qint16> audio(samples.size());
+    fftfilt::cmplx *sideband;
+
+    NCO nco;
+    nco.setFreq(-500.0, inputSampleRate);
+    Interpolator interpolator;
+    interpolator.create(16, inputSampleRate, bandwidth * 1.5f, 2.0f);
+    Real interpolatorDistance = inputSampleRate / audioSampleRate;
+    Real interpolatorDistanceRemain = interpolatorDistance;
+    fftfilt ssbFilter(lowCutoff / audioSampleRate, bandwidth / audioSampleRate, 1024);
+    MagAGC agc(12000, 3276.8, 1e-2);
+
+    qDebug() << "MainBench::testDemodSSB: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        unsigned int audioFill = 0;
+        timer.start();
+
+        nco.mix(samples.begin(), samples.end(), mixed.data());
+        int nbDecimated = interpolator.decimate(&interpolatorDistanceRemain, interpolatorDistance,
+            mixed.data(), mixed.size(), decimated.data());
+
+        for (int j = 0; j < nbDecimated; j++)
+        {
+            int n_out = ssbFilter.runSSB(decimated[j], &sideband, true);
+
+            for (int k = 0; k < n_out; k++)
+            {
+                float agcVal = agc.feedAndGetValue(sideband[k]);
+                audio[audioFill++] = (qint16) (sideband[k].real() * agcVal);
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+        sum += audio[0];
+    }
+
+    printResults("demodssb model", nsecs);
+    qDebug() << "MainBench::testDemodSSB: checksum: " << sum;
+}
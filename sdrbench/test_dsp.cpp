@@ -0,0 +1,315 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server adapter interface                                              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "dsp/downchannelizer.h"
+#include "dsp/nullsink.h"
+#include "dsp/dspcommands.h"
+#include "dsp/nco.h"
+#include "dsp/fftfilt.h"
+#include "dsp/fftengine.h"
+#include "dsp/kissfft.h"
+#include "dsp/phasediscri.h"
+#include "dsp/agc.h"
+#include "mainbench.h"
+
+void MainBench::testChannelizer()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    // 3072 kS/s device rate decimated by the log2 factor around an offset of 1/8th of the device rate
+    int inputSampleRate = 3072000;
+    int outputSampleRate = inputSampleRate / (1<<m_parser.getLog2Factor());
+    unsigned int blockSize = 16384; // typical device engine block
+
+    qDebug() << "MainBench::testChannelizer: create test data";
+
+    SampleVector samples;
+    createSignal(samples, inputSampleRate, inputSampleRate / 8, 5000.0);
+    NullSink sink;
+    DownChannelizer channelizer(&sink);
+    channelizer.handleMessage(DSPConfigureChannelizer(outputSampleRate, inputSampleRate / 8));
+    channelizer.handleMessage(DSPSignalNotification(inputSampleRate, 0));
+
+    qDebug() << "MainBench::testChannelizer: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (unsigned int offset = 0; offset < samples.size(); offset += blockSize)
+        {
+            unsigned int end = std::min((unsigned int) samples.size(), offset + blockSize);
+            channelizer.feed(samples.begin() + offset, samples.begin() + end, false);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("channelizer", nsecs);
+}
+
+void MainBench::testNCO()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    qDebug() << "MainBench::testNCO: create test data";
+
+    SampleVector samples;
+    createSignal(samples, 48000.0, 1000.0, 0.0);
+    std::vector<Complex> mixed(samples.size());
+    NCO nco;
+    nco.setFreq(-1234.5, 48000.0);
+
+    qDebug() << "MainBench::testNCO: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+        std::vector<Complex>::iterator out = mixed.begin();
+
+        for (SampleVector::const_iterator it = samples.begin(); it != samples.end(); ++it) {
+            *out++ = Complex(it->real(), it->imag()) * nco.nextIQ();
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("nco.nextiq", nsecs);
+    nsecs = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+        nco.mix(samples.begin(), samples.end(), mixed.data());
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("nco.mix", nsecs);
+}
+
+void MainBench::testFFTFilt()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    fftfilt::cmplx *rf;
+    Real sum = 0;
+
+    qDebug() << "MainBench::testFFTFilt: create test data";
+
+    SampleVector samples;
+    createSignal(samples, 48000.0, 1000.0, 0.0);
+    std::vector<Complex> in(samples.size());
+
+    for (unsigned int i = 0; i < samples.size(); i++) {
+        in[i] = Complex(samples[i].real(), samples[i].imag());
+    }
+
+    fftfilt bandFilter(-0.1f, 0.1f, 1024);          // as the WFM RF filter
+    fftfilt ssbFilter(300.0f / 48000.0f, 3000.0f / 48000.0f, 1024); // as the SSB demod filter
+
+    qDebug() << "MainBench::testFFTFilt: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (std::vector<Complex>::const_iterator it = in.begin(); it != in.end(); ++it)
+        {
+            int n_out = bandFilter.runFilt(*it, &rf);
+
+            for (int j = 0; j < n_out; j++) {
+                sum += rf[j].real();
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("fftfilt.runfilt", nsecs);
+    nsecs = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (std::vector<Complex>::const_iterator it = in.begin(); it != in.end(); ++it)
+        {
+            int n_out = ssbFilter.runSSB(*it, &rf, true);
+
+            for (int j = 0; j < n_out; j++) {
+                sum += rf[j].real();
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("fftfilt.runssb", nsecs);
+    qDebug() << "MainBench::testFFTFilt: checksum: " << sum; // keeps the output alive
+}
+
+void MainBench::testFFT()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    // FFT size from 256 (log2 factor 0) to 16k (log2 factor 6)
+    int fftSize = 1 << (m_parser.getLog2Factor() + 8);
+    int nbFFTs = m_parser.getNbSamples() / fftSize;
+    nbFFTs = nbFFTs == 0 ? 1 : nbFFTs;
+
+    qDebug() << "MainBench::testFFT: create test data: size: " << fftSize;
+
+    std::vector<Complex> in(fftSize);
+    std::vector<Complex> out(fftSize);
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (int i = 0; i < fftSize; i++) {
+        in[i] = Complex(my_rand(), my_rand());
+    }
+
+    FFTEngine *fft = FFTEngine::create();
+
+    if (fft)
+    {
+        fft->configure(fftSize, false);
+        std::copy(in.begin(), in.end(), fft->in());
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+
+            for (int j = 0; j < nbFFTs; j++) {
+                fft->transform();
+            }
+
+            nsecs += timer.nsecsElapsed();
+        }
+
+        printResults("fft.engine", nsecs, (quint64) nbFFTs * fftSize * m_parser.getRepetition());
+        delete fft;
+    }
+
+    kissfft<Real, Complex> kiss;
+    kiss.configure(fftSize, false);
+    nsecs = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (int j = 0; j < nbFFTs; j++) {
+            kiss.transform(in.data(), out.data());
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("fft.kissfft", nsecs, (quint64) nbFFTs * fftSize * m_parser.getRepetition());
+}
+
+void MainBench::testPhaseDiscri()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    Real sum = 0;
+
+    qDebug() << "MainBench::testPhaseDiscri: create test data";
+
+    SampleVector samples;
+    createSignal(samples, 48000.0, 0.0, 2500.0);
+    std::vector<Complex> in(samples.size());
+
+    for (unsigned int i = 0; i < samples.size(); i++) {
+        in[i] = Complex(samples[i].real(), samples[i].imag());
+    }
+
+    PhaseDiscriminators phaseDiscri;
+    phaseDiscri.setFMScaling(48000.0f / 2500.0f);
+
+    qDebug() << "MainBench::testPhaseDiscri: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (std::vector<Complex>::const_iterator it = in.begin(); it != in.end(); ++it) {
+            sum += phaseDiscri.phaseDiscriminator(*it);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("phasediscri.discri", nsecs);
+    nsecs = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        double magsq;
+        Real fmDev;
+        timer.start();
+
+        for (std::vector<Complex>::const_iterator it = in.begin(); it != in.end(); ++it) {
+            sum += phaseDiscri.phaseDiscriminatorDelta(*it, magsq, fmDev);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("phasediscri.delta", nsecs);
+    qDebug() << "MainBench::testPhaseDiscri: checksum: " << sum;
+}
+
+void MainBench::testAGC()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    double sum = 0;
+
+    qDebug() << "MainBench::testAGC: create test data";
+
+    SampleVector samples;
+    createSignal(samples, 48000.0, 1000.0, 0.0);
+    std::vector<Complex> in(samples.size());
+
+    for (unsigned int i = 0; i < samples.size(); i++) {
+        in[i] = Complex(samples[i].real(), samples[i].imag());
+    }
+
+    MagAGC agc(12000, 3276.8, 1e-2); // as in SSB demod
+
+    qDebug() << "MainBench::testAGC: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (std::vector<Complex>::const_iterator it = in.begin(); it != in.end(); ++it) {
+            sum += agc.feedAndGetValue(*it);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("agc.mag", nsecs);
+    qDebug() << "MainBench::testAGC: checksum: " << sum;
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server adapter interface                                              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include "dsp/samplesinkfifo.h"
+#include "mainbench.h"
+
+namespace {
+
+/** Writes the samples in chunks to the FIFO as fast as the reader frees space */
+class SampleFifoProducer : public QThread
+{
+public:
+    SampleFifoProducer(SampleSinkFifo& fifo, const SampleVector& samples, unsigned int chunkSize) :
+        m_fifo(fifo),
+        m_samples(samples),
+        m_chunkSize(chunkSize)
+    {}
+
+protected:
+    virtual void run()
+    {
+        unsigned int offset = 0;
+
+        while (offset < m_samples.size())
+        {
+            unsigned int count = std::min(m_chunkSize, (unsigned int) m_samples.size() - offset);
+
+            if (m_fifo.size() - m_fifo.fill() < count)
+            {
+                QThread::yieldCurrentThread();
+                continue;
+            }
+
+            offset += m_fifo.write(m_samples.begin() + offset, m_samples.begin() + offset + count);
+        }
+    }
+
+private:
+    SampleSinkFifo& m_fifo;
+    const SampleVector& m_samples;
+    unsigned int m_chunkSize;
+};
+
+}
+
+void MainBench::testSampleFifo()
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    unsigned int chunkSize = 4096;
+    qint64 sum = 0;
+
+    qDebug() << "MainBench::testSampleFifo: create test data";
+
+    SampleVector samples;
+    createSignal(samples, 48000.0, 1000.0, 0.0);
+    SampleSinkFifo fifo(1<<18);
+
+    qDebug() << "MainBench::testSampleFifo: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        SampleFifoProducer producer(fifo, samples, chunkSize);
+        unsigned int nbRead = 0;
+        timer.start();
+        producer.start();
+
+        // consume like the device engine does
+        while (nbRead < samples.size())
+        {
+            unsigned int count = std::min(fifo.fill(), chunkSize);
+
+            if (count == 0)
+            {
+                QThread::yieldCurrentThread();
+                continue;
+            }
+
+            SampleVector::iterator part1begin, part1end, part2begin, part2end;
+            fifo.readBegin(count, &part1begin, &part1end, &part2begin, &part2end);
+            sum += part1begin->real() + (part2begin != part2end ? part2begin->real() : 0);
+            fifo.readCommit(count);
+            nbRead += count;
+        }
+
+        producer.wait();
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("samplefifo", nsecs);
+    qDebug() << "MainBench::testSampleFifo: checksum: " << sum;
+}
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server adapter interface                                              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <string.h>
+#include <algorithm>
+
+#include "cm256.h"
+#include "mainbench.h"
+
+namespace {
+
+const int nbOriginalBlocks = 128; //!< SDRdaemon frame: block zero with meta data and 127 blocks of samples
+const int nbRecoveryBlocks = 8;   //!< FEC blocks per frame. The receiver loses as many blocks.
+const int headerSize = 4;         //!< frame index, block index and filler
+const int sampleBytes = 4;        //!< 16 bit I/Q as on the wire
+
+}
+
+/** SDRdaemon transport cost at each UDP block size: packetize, FEC encode, recover lost blocks and FEC decode */
+void MainBench::testSDRdaemonFEC()
+{
+    static const int blockSizes[] = {512, 1024, 2048, 4096, 8192, 8972};
+    QElapsedTimer timer;
+    CM256 cm256;
+
+    if (!cm256.isInitialized())
+    {
+        qWarning() << "MainBench::testSDRdaemonFEC: cannot initialize CM256 library";
+        return;
+    }
+
+    qDebug() << "MainBench::testSDRdaemonFEC: create test data";
+
+    std::vector<qint16> samples(m_parser.getNbSamples()*2);
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+    std::generate(samples.begin(), samples.end(), my_rand);
+
+    for (unsigned int k = 0; k < sizeof(blockSizes)/sizeof(blockSizes[0]); k++)
+    {
+        int blockSize = blockSizes[k];
+        int protectedBlockSize = blockSize - headerSize;
+        int samplesPerBlock = protectedBlockSize / sampleBytes;
+        int samplesPerFrame = (nbOriginalBlocks - 1) * samplesPerBlock;
+        std::vector<uint8_t> txBlocks(nbOriginalBlocks * blockSize, 0);
+        std::vector<uint8_t> fecBlocks(nbRecoveryBlocks * protectedBlockSize);
+        std::vector<uint8_t> rxBlocks(nbOriginalBlocks * protectedBlockSize);
+        CM256::cm256_block txDescriptors[nbOriginalBlocks];
+        CM256::cm256_block rxDescriptors[nbOriginalBlocks];
+        CM256::cm256_encoder_params params;
+        params.BlockBytes = protectedBlockSize;
+        params.OriginalCount = nbOriginalBlocks;
+        params.RecoveryCount = nbRecoveryBlocks;
+        uint16_t frameIndex = 0;
+        int nbFailures = 0;
+        qint64 nsecs = 0;
+
+        qDebug() << "MainBench::testSDRdaemonFEC: run test with block size" << blockSize;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+
+            for (unsigned int is = 0; is < m_parser.getNbSamples(); is += samplesPerFrame, frameIndex++)
+            {
+                int nbFrameSamples = std::min(samplesPerFrame, (int) (m_parser.getNbSamples() - is));
+
+                // Tx side: build the frame blocks then encode FEC
+                for (int ib = 0; ib < nbOriginalBlocks; ib++)
+                {
+                    uint8_t *block = &txBlocks[ib*blockSize];
+                    memcpy(block, &frameIndex, sizeof(uint16_t));
+                    block[2] = ib;
+
+                    if (ib > 0)
+                    {
+                        int offset = (ib - 1) * samplesPerBlock;
+                        int count = std::max(0, std::min(samplesPerBlock, nbFrameSamples - offset));
+                        memcpy(&block[headerSize], &samples[2*(is + offset)], count * sampleBytes);
+                    }
+
+                    txDescriptors[ib].Block = (void *) &block[headerSize];
+                    txDescriptors[ib].Index = ib;
+                }
+
+                if (cm256.cm256_encode(params, txDescriptors, fecBlocks.data())) {
+                    nbFailures++;
+                }
+
+                // Rx side: the first data blocks are lost and replaced by the FEC blocks then decoded
+                for (int ib = 0; ib < nbOriginalBlocks; ib++)
+                {
+                    uint8_t *rxBlock = &rxBlocks[ib*protectedBlockSize];
+
+                    if ((ib > 0) && (ib <= nbRecoveryBlocks))
+                    {
+                        memcpy(rxBlock, &fecBlocks[(ib - 1)*protectedBlockSize], protectedBlockSize);
+                        rxDescriptors[ib].Index = nbOriginalBlocks + ib - 1;
+                    }
+                    else
+                    {
+                        memcpy(rxBlock, &txBlocks[ib*blockSize + headerSize], protectedBlockSize);
+                        rxDescriptors[ib].Index = ib;
+                    }
+
+                    rxDescriptors[ib].Block = (void *) rxBlock;
+                }
+
+                if (cm256.cm256_decode(params, rxDescriptors)) {
+                    nbFailures++;
+                }
+            }
+
+            nsecs += timer.nsecsElapsed();
+        }
+
+        printResults(QString("sdrdaemonfec%1").arg(blockSize), nsecs);
+
+        if (nbFailures > 0) {
+            qWarning() << "MainBench::testSDRdaemonFEC: CM256 failures: " << nbFailures;
+        }
+    }
+}
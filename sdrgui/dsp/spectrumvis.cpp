@@ -1,26 +1,20 @@
 #include "dsp/spectrumvis.h"
 #include "gui/glspectrum.h"
 #include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
+#include "dsp/spectrumpower.h"
 #include "util/messagequeue.h"
 
-#define MAX_FFT_SIZE 4096
-
-#ifndef LINUX
-inline double log2f(double n)
-{
-	return log(n) / log(2.0);
-}
-#endif
+#define MAX_FFT_SIZE 65536
+#define MAX_DISPLAY_SIZE 4096 // larger spectra are reduced to this number of bins keeping the peaks
+#define MAX_MOVING_AVERAGE_SIZE (4096*1000) // history of the moving average (bins * depth) as with 4k FFT and 1k averaging
 
 MESSAGE_CLASS_DEFINITION(SpectrumVis::MsgConfigureSpectrumVis, Message)
-
-const Real SpectrumVis::m_mult = (10.0f / log2f(10.0f));
+MESSAGE_CLASS_DEFINITION(SpectrumVis::MsgConfigureFrameRate, Message)
 
 SpectrumVis::SpectrumVis(Real scalef, GLSpectrum* glSpectrum) :
 	BasebandSampleSink(),
 	m_fft(FFTEngine::create()),
-	m_fftBuffer(MAX_FFT_SIZE),
-	m_powerSpectrum(MAX_FFT_SIZE),
 	m_fftBufferFill(0),
 	m_needMoreSamples(false),
 	m_scalef(scalef),
@@ -30,14 +24,37 @@ SpectrumVis::SpectrumVis(Real scalef, GLSpectrum* glSpectrum) :
 	m_linear(false),
 	m_ofs(0),
     m_powFFTDiv(1.0),
+    m_framePeriodNs(0),
+    m_frameReady(false),
+    m_framePositiveOnly(false),
+    m_frameGeneration(0),
+    m_workerStop(false),
+    m_worker(0),
 	m_mutex(QMutex::Recursive)
 {
 	setObjectName("SpectrumVis");
 	handleConfigure(1024, 0, 0, AvgModeNone, FFTWindow::BlackmanHarris, false);
+	handleConfigureFrameRate(DSPEngine::instance()->getSpectrumFrameRate());
+
+	if (m_glSpectrum)
+	{
+		m_worker = new FFTWorker(this);
+		m_worker->start();
+	}
 }
 
 SpectrumVis::~SpectrumVis()
 {
+	if (m_worker)
+	{
+		m_frameMutex.lock();
+		m_workerStop = true;
+		m_frameCondition.wakeOne();
+		m_frameMutex.unlock();
+		m_worker->wait();
+		delete m_worker;
+	}
+
 	delete m_fft;
 }
 
@@ -53,6 +70,12 @@ void SpectrumVis::configure(MessageQueue* msgQueue,
 	msgQueue->push(cmd);
 }
 
+void SpectrumVis::configureFrameRate(MessageQueue* msgQueue, int frameRate)
+{
+	MsgConfigureFrameRate* cmd = new MsgConfigureFrameRate(frameRate);
+	msgQueue->push(cmd);
+}
+
 void SpectrumVis::feedTriggered(const SampleVector::const_iterator& triggerPoint, const SampleVector::const_iterator& end, bool positiveOnly)
 {
 	feed(triggerPoint, end, positiveOnly); // normal feed from trigger point
@@ -84,156 +107,37 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	}
 
 	SampleVector::const_iterator begin(cbegin);
+	QMutexLocker mutexLocker(&m_mutex);
 
 	while (begin < end)
 	{
 		std::size_t todo = end - begin;
-		std::size_t samplesNeeded = m_refillSize - m_fftBufferFill;
+		std::size_t samplesNeeded = m_fftSize - m_fftBufferFill;
 
 		if (todo >= samplesNeeded)
 		{
-			QMutexLocker mutexLocker(&m_mutex);
-
 			// fill up the buffer
-			std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill;
-
-			for (std::size_t i = 0; i < samplesNeeded; ++i, ++begin)
-			{
-				*it++ = Complex(begin->real() / m_scalef, begin->imag() / m_scalef);
-			}
-
-			// apply fft window (and copy from m_fftBuffer to m_fftIn)
-			m_window.apply(&m_fftBuffer[0], m_fft->in());
-
-			// calculate FFT
-			m_fft->transform();
+			SpectrumPower::toComplex(&(*begin), &m_fftBuffer[m_fftBufferFill], samplesNeeded, m_scalef);
+			begin += samplesNeeded;
 
-			// extract power spectrum and reorder buckets
-			const Complex* fftOut = m_fft->out();
-			Complex c;
-			Real v;
-			std::size_t halfSize = m_fftSize / 2;
-
-			if (m_averagingMode == AvgModeNone)
-			{
-                if ( positiveOnly )
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-                        v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-                        m_powerSpectrum[i * 2] = v;
-                        m_powerSpectrum[i * 2 + 1] = v;
-                    }
-                }
-                else
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i + halfSize];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-                        v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-                        m_powerSpectrum[i] = v;
-
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-                        v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-                        m_powerSpectrum[i + halfSize] = v;
-                    }
-                }
-
-                // send new data to visualisation
-                m_glSpectrum->newSpectrum(m_powerSpectrum, m_fftSize);
-			}
-			else if (m_averagingMode == AvgModeMoving)
+			// hand the frame over to the FFT worker unless the frame rate limit is reached
+			// or the worker is still busy with the previous frame in which case the frame is skipped
+			if ((m_framePeriodNs == 0) || !m_frameTimer.isValid() || (m_frameTimer.nsecsElapsed() >= m_framePeriodNs))
 			{
-	            if ( positiveOnly )
-	            {
-	                for (std::size_t i = 0; i < halfSize; i++)
-	                {
-	                    c = fftOut[i];
-	                    v = c.real() * c.real() + c.imag() * c.imag();
-	                    v = m_movingAverage.storeAndGetAvg(v, i);
-	                    v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-	                    m_powerSpectrum[i * 2] = v;
-	                    m_powerSpectrum[i * 2 + 1] = v;
-	                }
-	            }
-	            else
-	            {
-	                for (std::size_t i = 0; i < halfSize; i++)
-	                {
-	                    c = fftOut[i + halfSize];
-	                    v = c.real() * c.real() + c.imag() * c.imag();
-	                    v = m_movingAverage.storeAndGetAvg(v, i+halfSize);
-	                    v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-	                    m_powerSpectrum[i] = v;
-
-	                    c = fftOut[i];
-	                    v = c.real() * c.real() + c.imag() * c.imag();
-	                    v = m_movingAverage.storeAndGetAvg(v, i);
-	                    v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
-	                    m_powerSpectrum[i + halfSize] = v;
-	                }
-	            }
-
-	            // send new data to visualisation
-	            m_glSpectrum->newSpectrum(m_powerSpectrum, m_fftSize);
-	            m_movingAverage.nextAverage();
-			}
-			else if (m_averagingMode == AvgModeFixed)
-			{
-			    double avg;
-
-                if ( positiveOnly )
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        if (m_fixedAverage.storeAndGetAvg(avg, v, i))
-                        {
-                            avg = m_linear ? v/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
-                            m_powerSpectrum[i * 2] = avg;
-                            m_powerSpectrum[i * 2 + 1] = avg;
-                        }
-                    }
-                }
-                else
-                {
-                    for (std::size_t i = 0; i < halfSize; i++)
-                    {
-                        c = fftOut[i + halfSize];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        if (m_fixedAverage.storeAndGetAvg(avg, v, i+halfSize))
-                        { // result available
-                            avg = m_linear ? v/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
-                            m_powerSpectrum[i] = avg;
-                        }
-
-                        c = fftOut[i];
-                        v = c.real() * c.real() + c.imag() * c.imag();
-
-                        if (m_fixedAverage.storeAndGetAvg(avg, v, i))
-                        { // result available
-                            avg = m_linear ? v/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
-                            m_powerSpectrum[i + halfSize] = avg;
-                        }
-                    }
-                }
-
-                if (m_fixedAverage.nextAverage())
-                { // result available
-                    // send new data to visualisation
-                    m_glSpectrum->newSpectrum(m_powerSpectrum, m_fftSize);
-                }
+				QMutexLocker frameLocker(&m_frameMutex);
+
+				if (!m_frameReady)
+				{
+					std::copy(m_fftBuffer.begin(), m_fftBuffer.begin() + m_fftSize, m_frame.begin());
+					m_framePositiveOnly = positiveOnly;
+					m_frameReady = true;
+					m_frameCondition.wakeOne();
+					m_frameTimer.start();
+				}
 			}
 
 			// advance buffer respecting the fft overlap factor
-			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.end(), m_fftBuffer.begin());
+			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.begin() + m_fftSize, m_fftBuffer.begin());
 
 			// start over
 			m_fftBufferFill = m_overlapSize;
@@ -242,17 +146,115 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 		else
 		{
 			// not enough samples for FFT - just fill in new data and return
-			for(std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill; begin < end; ++begin)
-			{
-				*it++ = Complex(begin->real() / m_scalef, begin->imag() / m_scalef);
-			}
-
+			SpectrumPower::toComplex(&(*begin), &m_fftBuffer[m_fftBufferFill], todo, m_scalef);
+			begin = end;
 			m_fftBufferFill += todo;
 			m_needMoreSamples = true;
 		}
 	}
 }
 
+void SpectrumVis::processFrames()
+{
+	m_frameMutex.lock();
+
+	while (true)
+	{
+		while (!m_frameReady && !m_workerStop) {
+			m_frameCondition.wait(&m_frameMutex);
+		}
+
+		if (m_workerStop) {
+			break;
+		}
+
+		unsigned int generation = m_frameGeneration;
+		bool positiveOnly = m_framePositiveOnly;
+		m_frameMutex.unlock();
+
+		// the frame is not touched by feed until it is released below
+		m_processMutex.lock();
+
+		if (generation == m_frameGeneration) // else configuration has changed in between and the frame is stale
+		{
+			// apply fft window (and copy from m_frame to m_fftIn)
+			m_window.apply(&m_frame[0], m_fft->in());
+			processFrame(positiveOnly);
+		}
+
+		m_processMutex.unlock();
+
+		m_frameMutex.lock();
+
+		if (generation == m_frameGeneration) {
+			m_frameReady = false;
+		}
+	}
+
+	m_frameMutex.unlock();
+}
+
+void SpectrumVis::processFrame(bool positiveOnly)
+{
+	// calculate FFT
+	m_fft->transform();
+
+	// extract power spectrum in FFT bins order, only the lower half is used for positive only spectra
+	std::size_t halfSize = m_fftSize / 2;
+	std::size_t nbBins = positiveOnly ? halfSize : m_fftSize;
+	Real *power = &m_powerBuffer[0];
+
+	SpectrumPower::magSq(m_fft->out(), power, nbBins);
+
+	if (m_averagingMode == AvgModeMoving)
+	{
+		m_movingAverage.storeAndGetAvg(power, 0, nbBins);
+		m_movingAverage.nextAverage();
+	}
+	else if (m_averagingMode == AvgModeFixed)
+	{
+		m_fixedAverage.storeAndGetAvg(power, 0, nbBins);
+
+		if (!m_fixedAverage.nextAverage()) { // result not available yet
+			return;
+		}
+	}
+
+	if (m_linear) {
+		SpectrumPower::scale(power, nbBins, 1.0 / m_powFFTDiv);
+	} else {
+		SpectrumPower::toDB(power, nbBins, m_ofs);
+	}
+
+	// reorder buckets
+	if (positiveOnly)
+	{
+		for (std::size_t i = 0; i < halfSize; i++)
+		{
+			m_powerSpectrum[i * 2] = power[i];
+			m_powerSpectrum[i * 2 + 1] = power[i];
+		}
+	}
+	else
+	{
+		std::copy(power + halfSize, power + m_fftSize, m_powerSpectrum.begin());
+		std::copy(power, power + halfSize, m_powerSpectrum.begin() + halfSize);
+	}
+
+	// send new data to visualisation
+	if (m_fftSize > MAX_DISPLAY_SIZE)
+	{
+		std::size_t factor = (m_fftSize + MAX_DISPLAY_SIZE - 1) / MAX_DISPLAY_SIZE;
+		std::size_t nbDisplayBins = m_fftSize / factor;
+		SpectrumPower::peakDecimate(&m_powerSpectrum[0], &m_powerSpectrum[0], nbDisplayBins, factor);
+		m_glSpectrum->newSpectrum(m_powerSpectrum, nbDisplayBins, m_fftSize);
+	}
+	else
+	{
+		m_glSpectrum->newSpectrum(m_powerSpectrum, m_fftSize, m_fftSize);
+	}
+}
+
 void SpectrumVis::start()
 {
 }
@@ -274,6 +276,12 @@ bool SpectrumVis::handleMessage(const Message& message)
 		        conf.getLinear());
 		return true;
 	}
+	else if (MsgConfigureFrameRate::match(message))
+	{
+		MsgConfigureFrameRate& conf = (MsgConfigureFrameRate&) message;
+		handleConfigureFrameRate(conf.getFrameRate());
+		return true;
+	}
 	else
 	{
 		return false;
@@ -288,6 +296,8 @@ void SpectrumVis::handleConfigure(int fftSize,
         bool linear)
 {
 	QMutexLocker mutexLocker(&m_mutex);
+	QMutexLocker frameLocker(&m_frameMutex);
+	QMutexLocker processLocker(&m_processMutex);
 
 	if (fftSize > MAX_FFT_SIZE)
 	{
@@ -312,16 +322,29 @@ void SpectrumVis::handleConfigure(int fftSize,
 	}
 
 	m_fftSize = fftSize;
+	m_fftBuffer.resize(m_fftSize);
+	m_powerBuffer.resize(m_fftSize);
+	m_powerSpectrum.resize(m_fftSize);
+	m_frame.resize(m_fftSize);
 	m_fft->configure(m_fftSize, false);
 	m_window.create(window, m_fftSize);
 	m_overlapSize = (m_fftSize * m_overlapPercent) / 100;
+	m_overlapSize = m_overlapSize < m_fftSize ? m_overlapSize : m_fftSize - 1; // at least one new sample per FFT
 	m_refillSize = m_fftSize - m_overlapSize;
 	m_fftBufferFill = m_overlapSize;
-	m_movingAverage.resize(fftSize, averageNb);
+	m_movingAverage.resize(fftSize, fftSize * averageNb > MAX_MOVING_AVERAGE_SIZE ? MAX_MOVING_AVERAGE_SIZE / fftSize : averageNb);
 	m_fixedAverage.resize(fftSize, averageNb);
 	m_averageNb = averageNb;
 	m_averagingMode = averagingMode;
 	m_linear = linear;
 	m_ofs = 20.0f * log10f(1.0f / m_fftSize);
 	m_powFFTDiv = m_fftSize*m_fftSize;
+	m_frameReady = false;
+	m_frameGeneration++;
+}
+
+void SpectrumVis::handleConfigureFrameRate(int frameRate)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_framePeriodNs = frameRate > 0 ? 1000000000LL / frameRate : 0;
 }
@@ -3,6 +3,9 @@
 
 #include <dsp/basebandsamplesink.h>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+#include <QElapsedTimer>
 #include "dsp/fftengine.h"
 #include "dsp/fftwindow.h"
 #include "export.h"
@@ -60,6 +63,21 @@ public:
 		bool m_linear;
 	};
 
+	class MsgConfigureFrameRate : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		MsgConfigureFrameRate(int frameRate) :
+			Message(),
+			m_frameRate(frameRate)
+		{ }
+
+		int getFrameRate() const { return m_frameRate; }
+
+	private:
+		int m_frameRate;
+	};
+
 	SpectrumVis(Real scalef, GLSpectrum* glSpectrum = 0);
 	virtual ~SpectrumVis();
 
@@ -70,6 +88,7 @@ public:
 	        int averagingMode,
 	        FFTWindow::Function window,
 	        bool m_linear);
+	void configureFrameRate(MessageQueue* msgQueue, int frameRate); //!< maximum number of spectrum frames per second or 0 for no limit
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
 	void feedTriggered(const SampleVector::const_iterator& triggerPoint, const SampleVector::const_iterator& end, bool positiveOnly);
@@ -78,11 +97,22 @@ public:
 	virtual bool handleMessage(const Message& message);
 
 private:
+	/** Runs the FFT and power spectrum computation of the frames handed over by feed */
+	class FFTWorker : public QThread {
+	public:
+		FFTWorker(SpectrumVis *spectrumVis) : m_spectrumVis(spectrumVis) {}
+	protected:
+		virtual void run() { m_spectrumVis->processFrames(); }
+	private:
+		SpectrumVis *m_spectrumVis;
+	};
+
 	FFTEngine* m_fft;
 	FFTWindow m_window;
 
 	std::vector<Complex> m_fftBuffer;
-	std::vector<Real> m_powerSpectrum;
+	std::vector<Real> m_powerBuffer;   //!< power of current FFT in FFT bins order
+	std::vector<Real> m_powerSpectrum; //!< power of current FFT in display order
 
 	std::size_t m_fftSize;
 	std::size_t m_overlapPercent;
@@ -101,9 +131,20 @@ private:
 
 	Real m_ofs;
 	Real m_powFFTDiv;
-	static const Real m_mult;
 
-	QMutex m_mutex;
+	qint64 m_framePeriodNs;  //!< minimum time between two FFT frames or 0 for no limit
+	QElapsedTimer m_frameTimer;
+	std::vector<Complex> m_frame; //!< frame handed over to the FFT worker
+	bool m_frameReady;
+	bool m_framePositiveOnly;
+	unsigned int m_frameGeneration; //!< incremented on configuration changes to discard frames in flight
+	bool m_workerStop;
+	FFTWorker *m_worker;
+
+	QMutex m_mutex;        //!< input side: sample buffering (feed) and configuration
+	QMutex m_frameMutex;   //!< frame hand over
+	QWaitCondition m_frameCondition;
+	QMutex m_processMutex; //!< processing side: FFT, averaging and output (FFT worker) and configuration
 
 	void handleConfigure(int fftSize,
 	        int overlapPercent,
@@ -111,6 +152,9 @@ private:
 	        AveragingMode averagingMode,
 	        FFTWindow::Function window,
 	        bool linear);
+	void handleConfigureFrameRate(int frameRate);
+	void processFrames();
+	void processFrame(bool positiveOnly);
 };
 
 #endif // INCLUDE_SPECTRUMVIS_H
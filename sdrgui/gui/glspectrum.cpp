@@ -44,6 +44,7 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_sampleRate(500000),
 	m_timingRate(1),
 	m_fftSize(512),
+	m_fftSamples(512),
 	m_displayGrid(true),
 	m_displayGridIntensity(5),
 	m_displayTraceIntensity(50),
@@ -327,19 +328,21 @@ void GLSpectrum::removeChannelMarker(ChannelMarker* channelMarker)
 	}
 }
 
-void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
+void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int nbBins, int fftSize)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
 	m_displayChanged = true;
 
 	if(m_changesPending) {
-		m_fftSize = fftSize;
+		m_fftSize = nbBins;
+		m_fftSamples = fftSize;
 		return;
 	}
 
-	if(fftSize != m_fftSize) {
-		m_fftSize = fftSize;
+	if((nbBins != m_fftSize) || (fftSize != m_fftSamples)) {
+		m_fftSize = nbBins;
+		m_fftSamples = fftSize;
 		m_changesPending = true;
 		return;
 	}
@@ -1070,11 +1073,11 @@ void GLSpectrum::applyChanges()
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSamples) / scaleDiv, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSamples) / scaleDiv);
 			}
 		}
 		else
@@ -1174,11 +1177,11 @@ void GLSpectrum::applyChanges()
 
 			if(!m_invertedWaterfall)
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSize) / scaleDiv, 0);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (waterfallHeight * m_fftSamples) / scaleDiv, 0);
 			}
 			else
 			{
-				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSize) / scaleDiv);
+				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, 0, (waterfallHeight * m_fftSamples) / scaleDiv);
 			}
 		}
 		else
@@ -88,7 +88,7 @@ public:
 	void removeChannelMarker(ChannelMarker* channelMarker);
 	void setMessageQueueToGUI(MessageQueue* messageQueue) { m_messageQueueToGUI = messageQueue; }
 
-	void newSpectrum(const std::vector<Real>& spectrum, int fftSize);
+	void newSpectrum(const std::vector<Real>& spectrum, int nbBins, int fftSize); //!< large FFTs are displayed with less bins than the FFT size
 	void clearSpectrumHistogram();
 
 	Real getWaterfallShare() const { return m_waterfallShare; }
@@ -136,7 +136,8 @@ private:
 	quint32 m_sampleRate;
 	quint32 m_timingRate;
 
-	int m_fftSize;
+	int m_fftSize;    //!< number of bins displayed
+	int m_fftSamples; //!< FFT size giving the time span of a waterfall line
 
 	bool m_displayGrid;
 	int m_displayGridIntensity;
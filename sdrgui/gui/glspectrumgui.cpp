@@ -159,7 +159,7 @@ bool GLSpectrumGUI::deserialize(const QByteArray& data)
 void GLSpectrumGUI::applySettings()
 {
 	ui->fftWindow->setCurrentIndex(m_fftWindow);
-	for(int i = 0; i < 6; i++) {
+	for(int i = 0; i < ui->fftSize->count(); i++) {
 		if(m_fftSize == (1 << (i + 7))) {
 			ui->fftSize->setCurrentIndex(i);
 			break;
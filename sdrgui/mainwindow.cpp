@@ -50,7 +50,9 @@
 #include "gui/samplingdevicecontrol.h"
 #include "gui/mypositiondialog.h"
 #include "dsp/dspengine.h"
+#include "dsp/fftengine.h"
 #include "dsp/spectrumvis.h"
+#include "util/udpsinksender.h"
 #include "dsp/dspcommands.h"
 #include "dsp/devicesamplesource.h"
 #include "dsp/devicesamplesink.h"
@@ -101,6 +103,11 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 
     m_instance = this;
 	m_settings.setAudioDeviceManager(m_dspEngine->getAudioDeviceManager());
+	m_dspEngine->setChannelizerBankSpacing(parser.getChannelizerBankSpacing());
+	m_dspEngine->setChannelWorkerPoolSize(parser.getDSPThreads());
+	m_dspEngine->setRecordDirectIO(parser.getRecordDirectIO());
+	m_dspEngine->setRecordPreallocation((quint64) parser.getRecordPreallocation() * 1024 * 1024);
+	m_dspEngine->setSpectrumFrameRate(parser.getSpectrumFrameRate());
 
     QFontDatabase::addApplicationFont(":/LiberationSans-Regular.ttf");
     QFontDatabase::addApplicationFont(":/LiberationMono-Regular.ttf");
@@ -167,6 +174,14 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     qDebug() << "MainWindow::MainWindow: load settings...";
 
 	loadSettings();
+	FFTEngine::loadWisdom();
+
+	if (parser.getFFTPreplan())
+	{
+		std::vector<int> fftSizes;
+		m_settings.getSpectrumFFTSizes(fftSizes);
+		FFTEngine::preplan(fftSizes);
+	}
 
     qDebug() << "MainWindow::MainWindow: load plugins...";
 
@@ -225,6 +240,8 @@ MainWindow::~MainWindow()
     delete m_apiAdapter;
 
     delete m_pluginManager;
+    UDPSinkSender::shutdown();
+    FFTEngine::saveWisdom();
 	delete m_dateTimeWidget;
 	delete m_showSystemWidget;
 
@@ -24,6 +24,8 @@
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/fftengine.h"
+#include "util/udpsinksender.h"
 #include "device/devicesourceapi.h"
 #include "device/devicesinkapi.h"
 #include "device/deviceset.h"
@@ -60,6 +62,10 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
 
     m_instance = this;
     m_settings.setAudioDeviceManager(m_dspEngine->getAudioDeviceManager());
+    m_dspEngine->setChannelizerBankSpacing(parser.getChannelizerBankSpacing());
+    m_dspEngine->setChannelWorkerPoolSize(parser.getDSPThreads());
+    m_dspEngine->setRecordDirectIO(parser.getRecordDirectIO());
+    m_dspEngine->setRecordPreallocation((quint64) parser.getRecordPreallocation() * 1024 * 1024);
 
     m_pluginManager = new PluginManager(this);
     m_pluginManager->loadPlugins(QString("pluginssrv"));
@@ -68,6 +74,7 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_masterTimer.start(50);
 
 	loadSettings();
+    FFTEngine::loadWisdom();
 
     QString applicationDirPath = QCoreApplication::instance()->applicationDirPath();
 
@@ -99,6 +106,8 @@ MainCore::~MainCore()
     delete m_apiAdapter;
 
     delete m_pluginManager;
+    UDPSinkSender::shutdown();
+    FFTEngine::saveWisdom();
 
     qDebug() << "MainCore::~MainCore: end";
     delete m_logger;
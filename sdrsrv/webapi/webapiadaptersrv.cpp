@@ -43,6 +43,7 @@
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
+#include "SWGFileRecordReport.h"
 
 #include "maincore.h"
 #include "loggerwithfile.h"
@@ -52,6 +53,7 @@
 #include "device/deviceenumerator.h"
 #include "dsp/devicesamplesink.h"
 #include "dsp/devicesamplesource.h"
+#include "dsp/filerecord.h"
 #include "dsp/dspengine.h"
 #include "channel/channelsourceapi.h"
 #include "channel/channelsinkapi.h"
@@ -282,6 +284,9 @@ int WebAPIAdapterSrv::instanceAudioGet(
     outputDevices->back()->setUdpChannelMode((int) outputDeviceInfo.udpChannelMode);
     *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
     outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
+    outputDevices->back()->setOutputType((int) outputDeviceInfo.outputType);
+    *outputDevices->back()->getOutputPath() = outputDeviceInfo.outputPath;
+    getAudioOutputFifos(outputDevices->back(), -1);
 
     // real output devices
     for (int i = 0; i < nbOutputDevices; i++)
@@ -300,6 +305,9 @@ int WebAPIAdapterSrv::instanceAudioGet(
         outputDevices->back()->setUdpChannelMode((int) outputDeviceInfo.udpChannelMode);
         *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
         outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
+        outputDevices->back()->setOutputType((int) outputDeviceInfo.outputType);
+        *outputDevices->back()->getOutputPath() = outputDeviceInfo.outputPath;
+        getAudioOutputFifos(outputDevices->back(), i);
     }
 
     return 200;
@@ -376,6 +384,12 @@ int WebAPIAdapterSrv::instanceAudioOutputPatch(
     if (audioOutputKeys.contains("udpPort")) {
         outputDeviceInfo.udpPort = response.getUdpPort() % (1<<16);
     }
+    if (audioOutputKeys.contains("outputType")) {
+        outputDeviceInfo.outputType = static_cast<AudioOutput::OutputType>(response.getOutputType() % 4);
+    }
+    if (audioOutputKeys.contains("outputPath")) {
+        outputDeviceInfo.outputPath = *response.getOutputPath();
+    }
 
     m_mainCore.m_dspEngine->getAudioDeviceManager()->setOutputDeviceInfo(deviceIndex, outputDeviceInfo);
     m_mainCore.m_dspEngine->getAudioDeviceManager()->getOutputDeviceInfo(deviceName, outputDeviceInfo);
@@ -392,6 +406,26 @@ int WebAPIAdapterSrv::instanceAudioOutputPatch(
     }
 
     response.setUdpPort(outputDeviceInfo.udpPort % (1<<16));
+    response.setOutputType((int) outputDeviceInfo.outputType);
+
+    if (response.getOutputPath()) {
+        *response.getOutputPath() = outputDeviceInfo.outputPath;
+    } else {
+        response.setOutputPath(new QString(outputDeviceInfo.outputPath));
+    }
+
+    if (audioOutputKeys.contains("fifos"))
+    {
+        QList<SWGSDRangel::SWGAudioOutputFifo*> *fifos = response.getFifos();
+
+        for (int i = 0; i < fifos->size(); i++) {
+            m_mainCore.m_dspEngine->getAudioDeviceManager()->setOutputFifoGainPan(deviceIndex, i, fifos->at(i)->getGain(), fifos->at(i)->getPan());
+        }
+
+        qDeleteAll(*fifos);
+        fifos->clear();
+        getAudioOutputFifos(&response, deviceIndex);
+    }
 
     return 200;
 }
@@ -450,6 +484,13 @@ int WebAPIAdapterSrv::instanceAudioOutputDelete(
     }
 
     response.setUdpPort(outputDeviceInfo.udpPort % (1<<16));
+    response.setOutputType((int) outputDeviceInfo.outputType);
+
+    if (response.getOutputPath()) {
+        *response.getOutputPath() = outputDeviceInfo.outputPath;
+    } else {
+        response.setOutputPath(new QString(outputDeviceInfo.outputPath));
+    }
 
     return 200;
 }
@@ -1315,7 +1356,19 @@ int WebAPIAdapterSrv::devicesetDeviceReportGet(
             response.setDeviceHwType(new QString(deviceSet->m_deviceSourceAPI->getHardwareId()));
             response.setTx(0);
             DeviceSampleSource *source = deviceSet->m_deviceSourceAPI->getSampleSource();
-            return source->webapiReportGet(response, *error.getMessage());
+            int httpRC = source->webapiReportGet(response, *error.getMessage());
+            FileRecord *fileRecord = source->getFileRecord();
+
+            if (fileRecord && ((httpRC == 200) || (httpRC == 501))) // recorder status is available even if the device has no report
+            {
+                response.setFileRecordReport(new SWGSDRangel::SWGFileRecordReport());
+                response.getFileRecordReport()->init();
+                fileRecord->webapiFormatReport(*response.getFileRecordReport());
+                *error.getMessage() = "";
+                httpRC = 200;
+            }
+
+            return httpRC;
         }
         else if (deviceSet->m_deviceSinkEngine) // Tx
         {
@@ -1717,6 +1770,26 @@ int WebAPIAdapterSrv::devicesetChannelSettingsPutPatch(
     }
 }
 
+void WebAPIAdapterSrv::getAudioOutputFifos(SWGSDRangel::SWGAudioOutputDevice *audioOutputDevice, int outputDeviceIndex)
+{
+    std::vector<AudioOutput::FifoReport> fifoReports;
+    m_mainCore.m_dspEngine->getAudioDeviceManager()->getOutputFifoReports(outputDeviceIndex, fifoReports);
+    std::vector<AudioOutput::FifoReport>::const_iterator it = fifoReports.begin();
+
+    for (; it != fifoReports.end(); ++it)
+    {
+        audioOutputDevice->getFifos()->append(new SWGSDRangel::SWGAudioOutputFifo);
+        audioOutputDevice->getFifos()->back()->init();
+        audioOutputDevice->getFifos()->back()->setFill(it->m_fill);
+        audioOutputDevice->getFifos()->back()->setSize(it->m_size);
+        audioOutputDevice->getFifos()->back()->setUnderrunCount(it->m_underrunCount);
+        audioOutputDevice->getFifos()->back()->setOverrunCount(it->m_overrunCount);
+        audioOutputDevice->getFifos()->back()->setLatencyMs(it->m_latencyMs);
+        audioOutputDevice->getFifos()->back()->setGain(it->m_gain);
+        audioOutputDevice->getFifos()->back()->setPan(it->m_pan);
+    }
+}
+
 void WebAPIAdapterSrv::getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList)
 {
     deviceSetList->init();
@@ -48,6 +48,12 @@ SWGAudioOutputDevice::SWGAudioOutputDevice() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    output_type = 0;
+    m_output_type_isSet = false;
+    output_path = nullptr;
+    m_output_path_isSet = false;
+    fifos = nullptr;
+    m_fifos_isSet = false;
 }
 
 SWGAudioOutputDevice::~SWGAudioOutputDevice() {
@@ -76,6 +82,12 @@ SWGAudioOutputDevice::init() {
     m_udp_address_isSet = false;
     udp_port = 0;
     m_udp_port_isSet = false;
+    output_type = 0;
+    m_output_type_isSet = false;
+    output_path = new QString("");
+    m_output_path_isSet = false;
+    fifos = new QList<SWGAudioOutputFifo*>();
+    m_fifos_isSet = false;
 }
 
 void
@@ -94,6 +106,17 @@ SWGAudioOutputDevice::cleanup() {
         delete udp_address;
     }
 
+
+    if(output_path != nullptr) { 
+        delete output_path;
+    }
+    if(fifos != nullptr) { 
+        auto arr = fifos;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete fifos;
+    }
 }
 
 SWGAudioOutputDevice*
@@ -127,6 +150,12 @@ SWGAudioOutputDevice::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&udp_port, pJson["udpPort"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&output_type, pJson["outputType"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&output_path, pJson["outputPath"], "QString", "QString");
+    
+    
+    ::SWGSDRangel::setValue(&fifos, pJson["fifos"], "QList", "SWGAudioOutputFifo");
 }
 
 QString
@@ -173,6 +202,15 @@ SWGAudioOutputDevice::asJsonObject() {
     if(m_udp_port_isSet){
         obj->insert("udpPort", QJsonValue(udp_port));
     }
+    if(m_output_type_isSet){
+        obj->insert("outputType", QJsonValue(output_type));
+    }
+    if(output_path != nullptr && *output_path != QString("")){
+        toJsonValue(QString("outputPath"), output_path, obj, QString("QString"));
+    }
+    if(fifos->size() > 0){
+        toJsonArray((QList<void*>*)fifos, obj, "fifos", "SWGAudioOutputFifo");
+    }
 
     return obj;
 }
@@ -277,6 +315,36 @@ SWGAudioOutputDevice::setUdpPort(qint32 udp_port) {
     this->m_udp_port_isSet = true;
 }
 
+qint32
+SWGAudioOutputDevice::getOutputType() {
+    return output_type;
+}
+void
+SWGAudioOutputDevice::setOutputType(qint32 output_type) {
+    this->output_type = output_type;
+    this->m_output_type_isSet = true;
+}
+
+QString*
+SWGAudioOutputDevice::getOutputPath() {
+    return output_path;
+}
+void
+SWGAudioOutputDevice::setOutputPath(QString* output_path) {
+    this->output_path = output_path;
+    this->m_output_path_isSet = true;
+}
+
+QList<SWGAudioOutputFifo*>*
+SWGAudioOutputDevice::getFifos() {
+    return fifos;
+}
+void
+SWGAudioOutputDevice::setFifos(QList<SWGAudioOutputFifo*>* fifos) {
+    this->fifos = fifos;
+    this->m_fifos_isSet = true;
+}
+
 
 bool
 SWGAudioOutputDevice::isSet(){
@@ -292,6 +360,9 @@ SWGAudioOutputDevice::isSet(){
         if(m_udp_channel_mode_isSet){ isObjectUpdated = true; break;}
         if(udp_address != nullptr && *udp_address != QString("")){ isObjectUpdated = true; break;}
         if(m_udp_port_isSet){ isObjectUpdated = true; break;}
+        if(m_output_type_isSet){ isObjectUpdated = true; break;}
+        if(output_path != nullptr && *output_path != QString("")){ isObjectUpdated = true; break;}
+        if(fifos->size() > 0){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -22,6 +22,8 @@
 #include <QJsonObject>
 
 
+#include "SWGAudioOutputFifo.h"
+#include <QList>
 #include <QString>
 
 #include "SWGObject.h"
@@ -72,6 +74,15 @@ public:
     qint32 getUdpPort();
     void setUdpPort(qint32 udp_port);
 
+    qint32 getOutputType();
+    void setOutputType(qint32 output_type);
+
+    QString* getOutputPath();
+    void setOutputPath(QString* output_path);
+
+    QList<SWGAudioOutputFifo*>* getFifos();
+    void setFifos(QList<SWGAudioOutputFifo*>* fifos);
+
 
     virtual bool isSet() override;
 
@@ -106,6 +117,15 @@ private:
     qint32 udp_port;
     bool m_udp_port_isSet;
 
+    qint32 output_type;
+    bool m_output_type_isSet;
+
+    QString* output_path;
+    bool m_output_path_isSet;
+
+    QList<SWGAudioOutputFifo*>* fifos;
+    bool m_fifos_isSet;
+
 };
 
 }
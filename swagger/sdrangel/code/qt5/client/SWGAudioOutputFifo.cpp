@@ -0,0 +1,229 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube     ---   Limitations and specifcities:       * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.0.7
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGAudioOutputFifo.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGAudioOutputFifo::SWGAudioOutputFifo(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGAudioOutputFifo::SWGAudioOutputFifo() {
+    fill = 0;
+    m_fill_isSet = false;
+    size = 0;
+    m_size_isSet = false;
+    underrun_count = 0;
+    m_underrun_count_isSet = false;
+    overrun_count = 0;
+    m_overrun_count_isSet = false;
+    latency_ms = 0.0f;
+    m_latency_ms_isSet = false;
+    gain = 0.0f;
+    m_gain_isSet = false;
+    pan = 0.0f;
+    m_pan_isSet = false;
+}
+
+SWGAudioOutputFifo::~SWGAudioOutputFifo() {
+    this->cleanup();
+}
+
+void
+SWGAudioOutputFifo::init() {
+    fill = 0;
+    m_fill_isSet = false;
+    size = 0;
+    m_size_isSet = false;
+    underrun_count = 0;
+    m_underrun_count_isSet = false;
+    overrun_count = 0;
+    m_overrun_count_isSet = false;
+    latency_ms = 0.0f;
+    m_latency_ms_isSet = false;
+    gain = 0.0f;
+    m_gain_isSet = false;
+    pan = 0.0f;
+    m_pan_isSet = false;
+}
+
+void
+SWGAudioOutputFifo::cleanup() {
+
+
+
+
+}
+
+SWGAudioOutputFifo*
+SWGAudioOutputFifo::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGAudioOutputFifo::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&fill, pJson["fill"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&size, pJson["size"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&underrun_count, pJson["underrunCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&overrun_count, pJson["overrunCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&latency_ms, pJson["latencyMs"], "float", "");
+    
+    ::SWGSDRangel::setValue(&gain, pJson["gain"], "float", "");
+    
+    ::SWGSDRangel::setValue(&pan, pJson["pan"], "float", "");
+    
+}
+
+QString
+SWGAudioOutputFifo::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGAudioOutputFifo::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_fill_isSet){
+        obj->insert("fill", QJsonValue(fill));
+    }
+    if(m_size_isSet){
+        obj->insert("size", QJsonValue(size));
+    }
+    if(m_underrun_count_isSet){
+        obj->insert("underrunCount", QJsonValue(underrun_count));
+    }
+    if(m_overrun_count_isSet){
+        obj->insert("overrunCount", QJsonValue(overrun_count));
+    }
+    if(m_latency_ms_isSet){
+        obj->insert("latencyMs", QJsonValue(latency_ms));
+    }
+    if(m_gain_isSet){
+        obj->insert("gain", QJsonValue(gain));
+    }
+    if(m_pan_isSet){
+        obj->insert("pan", QJsonValue(pan));
+    }
+
+    return obj;
+}
+
+qint32
+SWGAudioOutputFifo::getFill() {
+    return fill;
+}
+void
+SWGAudioOutputFifo::setFill(qint32 fill) {
+    this->fill = fill;
+    this->m_fill_isSet = true;
+}
+
+qint32
+SWGAudioOutputFifo::getSize() {
+    return size;
+}
+void
+SWGAudioOutputFifo::setSize(qint32 size) {
+    this->size = size;
+    this->m_size_isSet = true;
+}
+
+qint32
+SWGAudioOutputFifo::getUnderrunCount() {
+    return underrun_count;
+}
+void
+SWGAudioOutputFifo::setUnderrunCount(qint32 underrun_count) {
+    this->underrun_count = underrun_count;
+    this->m_underrun_count_isSet = true;
+}
+
+qint32
+SWGAudioOutputFifo::getOverrunCount() {
+    return overrun_count;
+}
+void
+SWGAudioOutputFifo::setOverrunCount(qint32 overrun_count) {
+    this->overrun_count = overrun_count;
+    this->m_overrun_count_isSet = true;
+}
+
+float
+SWGAudioOutputFifo::getLatencyMs() {
+    return latency_ms;
+}
+void
+SWGAudioOutputFifo::setLatencyMs(float latency_ms) {
+    this->latency_ms = latency_ms;
+    this->m_latency_ms_isSet = true;
+}
+
+float
+SWGAudioOutputFifo::getGain() {
+    return gain;
+}
+void
+SWGAudioOutputFifo::setGain(float gain) {
+    this->gain = gain;
+    this->m_gain_isSet = true;
+}
+
+float
+SWGAudioOutputFifo::getPan() {
+    return pan;
+}
+void
+SWGAudioOutputFifo::setPan(float pan) {
+    this->pan = pan;
+    this->m_pan_isSet = true;
+}
+
+
+bool
+SWGAudioOutputFifo::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_fill_isSet){ isObjectUpdated = true; break;}
+        if(m_size_isSet){ isObjectUpdated = true; break;}
+        if(m_underrun_count_isSet){ isObjectUpdated = true; break;}
+        if(m_overrun_count_isSet){ isObjectUpdated = true; break;}
+        if(m_latency_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_gain_isSet){ isObjectUpdated = true; break;}
+        if(m_pan_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -32,6 +32,8 @@ SWGDeviceReport::SWGDeviceReport() {
     m_device_hw_type_isSet = false;
     tx = 0;
     m_tx_isSet = false;
+    file_record_report = nullptr;
+    m_file_record_report_isSet = false;
     airspy_report = nullptr;
     m_airspy_report_isSet = false;
     airspy_hf_report = nullptr;
@@ -68,6 +70,8 @@ SWGDeviceReport::init() {
     m_device_hw_type_isSet = false;
     tx = 0;
     m_tx_isSet = false;
+    file_record_report = new SWGFileRecordReport();
+    m_file_record_report_isSet = false;
     airspy_report = new SWGAirspyReport();
     m_airspy_report_isSet = false;
     airspy_hf_report = new SWGAirspyHFReport();
@@ -100,6 +104,9 @@ SWGDeviceReport::cleanup() {
         delete device_hw_type;
     }
 
+    if(file_record_report != nullptr) { 
+        delete file_record_report;
+    }
     if(airspy_report != nullptr) { 
         delete airspy_report;
     }
@@ -153,6 +160,8 @@ SWGDeviceReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&tx, pJson["tx"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&file_record_report, pJson["fileRecordReport"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
     ::SWGSDRangel::setValue(&airspy_report, pJson["airspyReport"], "SWGAirspyReport", "SWGAirspyReport");
     
     ::SWGSDRangel::setValue(&airspy_hf_report, pJson["airspyHFReport"], "SWGAirspyHFReport", "SWGAirspyHFReport");
@@ -199,6 +208,9 @@ SWGDeviceReport::asJsonObject() {
     if(m_tx_isSet){
         obj->insert("tx", QJsonValue(tx));
     }
+    if((file_record_report != nullptr) && (file_record_report->isSet())){
+        toJsonValue(QString("fileRecordReport"), file_record_report, obj, QString("SWGFileRecordReport"));
+    }
     if((airspy_report != nullptr) && (airspy_report->isSet())){
         toJsonValue(QString("airspyReport"), airspy_report, obj, QString("SWGAirspyReport"));
     }
@@ -259,6 +271,16 @@ SWGDeviceReport::setTx(qint32 tx) {
     this->m_tx_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGDeviceReport::getFileRecordReport() {
+    return file_record_report;
+}
+void
+SWGDeviceReport::setFileRecordReport(SWGFileRecordReport* file_record_report) {
+    this->file_record_report = file_record_report;
+    this->m_file_record_report_isSet = true;
+}
+
 SWGAirspyReport*
 SWGDeviceReport::getAirspyReport() {
     return airspy_report;
@@ -386,6 +408,7 @@ SWGDeviceReport::isSet(){
     do{
         if(device_hw_type != nullptr && *device_hw_type != QString("")){ isObjectUpdated = true; break;}
         if(m_tx_isSet){ isObjectUpdated = true; break;}
+        if(file_record_report != nullptr && file_record_report->isSet()){ isObjectUpdated = true; break;}
         if(airspy_report != nullptr && airspy_report->isSet()){ isObjectUpdated = true; break;}
         if(airspy_hf_report != nullptr && airspy_hf_report->isSet()){ isObjectUpdated = true; break;}
         if(file_source_report != nullptr && file_source_report->isSet()){ isObjectUpdated = true; break;}
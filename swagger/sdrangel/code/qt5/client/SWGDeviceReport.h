@@ -24,6 +24,7 @@
 
 #include "SWGAirspyHFReport.h"
 #include "SWGAirspyReport.h"
+#include "SWGFileRecordReport.h"
 #include "SWGFileSourceReport.h"
 #include "SWGLimeSdrInputReport.h"
 #include "SWGLimeSdrOutputReport.h"
@@ -60,6 +61,9 @@ public:
     qint32 getTx();
     void setTx(qint32 tx);
 
+    SWGFileRecordReport* getFileRecordReport();
+    void setFileRecordReport(SWGFileRecordReport* file_record_report);
+
     SWGAirspyReport* getAirspyReport();
     void setAirspyReport(SWGAirspyReport* airspy_report);
 
@@ -106,6 +110,9 @@ private:
     qint32 tx;
     bool m_tx_isSet;
 
+    SWGFileRecordReport* file_record_report;
+    bool m_file_record_report_isSet;
+
     SWGAirspyReport* airspy_report;
     bool m_airspy_report_isSet;
 
@@ -0,0 +1,234 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube     ---   Limitations and specifcities:       * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.0.7
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGFileRecordReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFileRecordReport::SWGFileRecordReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFileRecordReport::SWGFileRecordReport() {
+    file_name = nullptr;
+    m_file_name_isSet = false;
+    recording = 0;
+    m_recording_isSet = false;
+    direct_io = 0;
+    m_direct_io_isSet = false;
+    byte_count = 0L;
+    m_byte_count_isSet = false;
+    written_bytes = 0L;
+    m_written_bytes_isSet = false;
+    backlog_bytes = 0L;
+    m_backlog_bytes_isSet = false;
+    dropped_bytes = 0L;
+    m_dropped_bytes_isSet = false;
+}
+
+SWGFileRecordReport::~SWGFileRecordReport() {
+    this->cleanup();
+}
+
+void
+SWGFileRecordReport::init() {
+    file_name = new QString("");
+    m_file_name_isSet = false;
+    recording = 0;
+    m_recording_isSet = false;
+    direct_io = 0;
+    m_direct_io_isSet = false;
+    byte_count = 0L;
+    m_byte_count_isSet = false;
+    written_bytes = 0L;
+    m_written_bytes_isSet = false;
+    backlog_bytes = 0L;
+    m_backlog_bytes_isSet = false;
+    dropped_bytes = 0L;
+    m_dropped_bytes_isSet = false;
+}
+
+void
+SWGFileRecordReport::cleanup() {
+    if(file_name != nullptr) { 
+        delete file_name;
+    }
+
+
+
+
+
+
+}
+
+SWGFileRecordReport*
+SWGFileRecordReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFileRecordReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&file_name, pJson["fileName"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&recording, pJson["recording"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&direct_io, pJson["directIO"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&byte_count, pJson["byteCount"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&written_bytes, pJson["writtenBytes"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&backlog_bytes, pJson["backlogBytes"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&dropped_bytes, pJson["droppedBytes"], "qint64", "");
+    
+}
+
+QString
+SWGFileRecordReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFileRecordReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(file_name != nullptr && *file_name != QString("")){
+        toJsonValue(QString("fileName"), file_name, obj, QString("QString"));
+    }
+    if(m_recording_isSet){
+        obj->insert("recording", QJsonValue(recording));
+    }
+    if(m_direct_io_isSet){
+        obj->insert("directIO", QJsonValue(direct_io));
+    }
+    if(m_byte_count_isSet){
+        obj->insert("byteCount", QJsonValue(byte_count));
+    }
+    if(m_written_bytes_isSet){
+        obj->insert("writtenBytes", QJsonValue(written_bytes));
+    }
+    if(m_backlog_bytes_isSet){
+        obj->insert("backlogBytes", QJsonValue(backlog_bytes));
+    }
+    if(m_dropped_bytes_isSet){
+        obj->insert("droppedBytes", QJsonValue(dropped_bytes));
+    }
+
+    return obj;
+}
+
+QString*
+SWGFileRecordReport::getFileName() {
+    return file_name;
+}
+void
+SWGFileRecordReport::setFileName(QString* file_name) {
+    this->file_name = file_name;
+    this->m_file_name_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getRecording() {
+    return recording;
+}
+void
+SWGFileRecordReport::setRecording(qint32 recording) {
+    this->recording = recording;
+    this->m_recording_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getDirectIo() {
+    return direct_io;
+}
+void
+SWGFileRecordReport::setDirectIo(qint32 direct_io) {
+    this->direct_io = direct_io;
+    this->m_direct_io_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getByteCount() {
+    return byte_count;
+}
+void
+SWGFileRecordReport::setByteCount(qint64 byte_count) {
+    this->byte_count = byte_count;
+    this->m_byte_count_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getWrittenBytes() {
+    return written_bytes;
+}
+void
+SWGFileRecordReport::setWrittenBytes(qint64 written_bytes) {
+    this->written_bytes = written_bytes;
+    this->m_written_bytes_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getBacklogBytes() {
+    return backlog_bytes;
+}
+void
+SWGFileRecordReport::setBacklogBytes(qint64 backlog_bytes) {
+    this->backlog_bytes = backlog_bytes;
+    this->m_backlog_bytes_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getDroppedBytes() {
+    return dropped_bytes;
+}
+void
+SWGFileRecordReport::setDroppedBytes(qint64 dropped_bytes) {
+    this->dropped_bytes = dropped_bytes;
+    this->m_dropped_bytes_isSet = true;
+}
+
+
+bool
+SWGFileRecordReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(file_name != nullptr && *file_name != QString("")){ isObjectUpdated = true; break;}
+        if(m_recording_isSet){ isObjectUpdated = true; break;}
+        if(m_direct_io_isSet){ isObjectUpdated = true; break;}
+        if(m_byte_count_isSet){ isObjectUpdated = true; break;}
+        if(m_written_bytes_isSet){ isObjectUpdated = true; break;}
+        if(m_backlog_bytes_isSet){ isObjectUpdated = true; break;}
+        if(m_dropped_bytes_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
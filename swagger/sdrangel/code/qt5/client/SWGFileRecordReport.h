@@ -0,0 +1,95 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube     ---   Limitations and specifcities:       * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.0.7
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGFileRecordReport.h
+ *
+ * I/Q recorder status
+ */
+
+#ifndef SWGFileRecordReport_H_
+#define SWGFileRecordReport_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGFileRecordReport: public SWGObject {
+public:
+    SWGFileRecordReport();
+    SWGFileRecordReport(QString* json);
+    virtual ~SWGFileRecordReport();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGFileRecordReport* fromJson(QString &jsonString) override;
+
+    QString* getFileName();
+    void setFileName(QString* file_name);
+
+    qint32 getRecording();
+    void setRecording(qint32 recording);
+
+    qint32 getDirectIo();
+    void setDirectIo(qint32 direct_io);
+
+    qint64 getByteCount();
+    void setByteCount(qint64 byte_count);
+
+    qint64 getWrittenBytes();
+    void setWrittenBytes(qint64 written_bytes);
+
+    qint64 getBacklogBytes();
+    void setBacklogBytes(qint64 backlog_bytes);
+
+    qint64 getDroppedBytes();
+    void setDroppedBytes(qint64 dropped_bytes);
+
+
+    virtual bool isSet() override;
+
+private:
+    QString* file_name;
+    bool m_file_name_isSet;
+
+    qint32 recording;
+    bool m_recording_isSet;
+
+    qint32 direct_io;
+    bool m_direct_io_isSet;
+
+    qint64 byte_count;
+    bool m_byte_count_isSet;
+
+    qint64 written_bytes;
+    bool m_written_bytes_isSet;
+
+    qint64 backlog_bytes;
+    bool m_backlog_bytes_isSet;
+
+    qint64 dropped_bytes;
+    bool m_dropped_bytes_isSet;
+
+};
+
+}
+
+#endif /* SWGFileRecordReport_H_ */
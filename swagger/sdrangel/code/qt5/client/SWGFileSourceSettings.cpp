@@ -30,6 +30,14 @@ SWGFileSourceSettings::SWGFileSourceSettings(QString* json) {
 SWGFileSourceSettings::SWGFileSourceSettings() {
     file_name = nullptr;
     m_file_name_isSet = false;
+    loop = 0;
+    m_loop_isSet = false;
+    loop_start_ms = 0;
+    m_loop_start_ms_isSet = false;
+    loop_end_ms = 0;
+    m_loop_end_ms_isSet = false;
+    unthrottled = 0;
+    m_unthrottled_isSet = false;
 }
 
 SWGFileSourceSettings::~SWGFileSourceSettings() {
@@ -40,6 +48,14 @@ void
 SWGFileSourceSettings::init() {
     file_name = new QString("");
     m_file_name_isSet = false;
+    loop = 0;
+    m_loop_isSet = false;
+    loop_start_ms = 0;
+    m_loop_start_ms_isSet = false;
+    loop_end_ms = 0;
+    m_loop_end_ms_isSet = false;
+    unthrottled = 0;
+    m_unthrottled_isSet = false;
 }
 
 void
@@ -47,6 +63,10 @@ SWGFileSourceSettings::cleanup() {
     if(file_name != nullptr) { 
         delete file_name;
     }
+
+
+
+
 }
 
 SWGFileSourceSettings*
@@ -62,6 +82,14 @@ void
 SWGFileSourceSettings::fromJsonObject(QJsonObject &pJson) {
     ::SWGSDRangel::setValue(&file_name, pJson["fileName"], "QString", "QString");
     
+    ::SWGSDRangel::setValue(&loop, pJson["loop"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&loop_start_ms, pJson["loopStartMs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&loop_end_ms, pJson["loopEndMs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&unthrottled, pJson["unthrottled"], "qint32", "");
+    
 }
 
 QString
@@ -81,6 +109,18 @@ SWGFileSourceSettings::asJsonObject() {
     if(file_name != nullptr && *file_name != QString("")){
         toJsonValue(QString("fileName"), file_name, obj, QString("QString"));
     }
+    if(m_loop_isSet){
+        obj->insert("loop", QJsonValue(loop));
+    }
+    if(m_loop_start_ms_isSet){
+        obj->insert("loopStartMs", QJsonValue(loop_start_ms));
+    }
+    if(m_loop_end_ms_isSet){
+        obj->insert("loopEndMs", QJsonValue(loop_end_ms));
+    }
+    if(m_unthrottled_isSet){
+        obj->insert("unthrottled", QJsonValue(unthrottled));
+    }
 
     return obj;
 }
@@ -95,12 +135,56 @@ SWGFileSourceSettings::setFileName(QString* file_name) {
     this->m_file_name_isSet = true;
 }
 
+qint32
+SWGFileSourceSettings::getLoop() {
+    return loop;
+}
+void
+SWGFileSourceSettings::setLoop(qint32 loop) {
+    this->loop = loop;
+    this->m_loop_isSet = true;
+}
+
+qint32
+SWGFileSourceSettings::getLoopStartMs() {
+    return loop_start_ms;
+}
+void
+SWGFileSourceSettings::setLoopStartMs(qint32 loop_start_ms) {
+    this->loop_start_ms = loop_start_ms;
+    this->m_loop_start_ms_isSet = true;
+}
+
+qint32
+SWGFileSourceSettings::getLoopEndMs() {
+    return loop_end_ms;
+}
+void
+SWGFileSourceSettings::setLoopEndMs(qint32 loop_end_ms) {
+    this->loop_end_ms = loop_end_ms;
+    this->m_loop_end_ms_isSet = true;
+}
+
+qint32
+SWGFileSourceSettings::getUnthrottled() {
+    return unthrottled;
+}
+void
+SWGFileSourceSettings::setUnthrottled(qint32 unthrottled) {
+    this->unthrottled = unthrottled;
+    this->m_unthrottled_isSet = true;
+}
+
 
 bool
 SWGFileSourceSettings::isSet(){
     bool isObjectUpdated = false;
     do{
         if(file_name != nullptr && *file_name != QString("")){ isObjectUpdated = true; break;}
+        if(m_loop_isSet){ isObjectUpdated = true; break;}
+        if(m_loop_start_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_loop_end_ms_isSet){ isObjectUpdated = true; break;}
+        if(m_unthrottled_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -45,6 +45,18 @@ public:
     QString* getFileName();
     void setFileName(QString* file_name);
 
+    qint32 getLoop();
+    void setLoop(qint32 loop);
+
+    qint32 getLoopStartMs();
+    void setLoopStartMs(qint32 loop_start_ms);
+
+    qint32 getLoopEndMs();
+    void setLoopEndMs(qint32 loop_end_ms);
+
+    qint32 getUnthrottled();
+    void setUnthrottled(qint32 unthrottled);
+
 
     virtual bool isSet() override;
 
@@ -52,6 +64,18 @@ private:
     QString* file_name;
     bool m_file_name_isSet;
 
+    qint32 loop;
+    bool m_loop_isSet;
+
+    qint32 loop_start_ms;
+    bool m_loop_start_ms_isSet;
+
+    qint32 loop_end_ms;
+    bool m_loop_end_ms_isSet;
+
+    qint32 unthrottled;
+    bool m_unthrottled_isSet;
+
 };
 
 }
@@ -32,6 +32,10 @@ SWGSDRdaemonSinkReport::SWGSDRdaemonSinkReport() {
     m_buffer_rw_balance_isSet = false;
     sample_count = 0;
     m_sample_count_isSet = false;
+    compression_ratio = 0.0f;
+    m_compression_ratio_isSet = false;
+    throughput = 0;
+    m_throughput_isSet = false;
 }
 
 SWGSDRdaemonSinkReport::~SWGSDRdaemonSinkReport() {
@@ -44,12 +48,18 @@ SWGSDRdaemonSinkReport::init() {
     m_buffer_rw_balance_isSet = false;
     sample_count = 0;
     m_sample_count_isSet = false;
+    compression_ratio = 0.0f;
+    m_compression_ratio_isSet = false;
+    throughput = 0;
+    m_throughput_isSet = false;
 }
 
 void
 SWGSDRdaemonSinkReport::cleanup() {
 
 
+
+
 }
 
 SWGSDRdaemonSinkReport*
@@ -67,6 +77,10 @@ SWGSDRdaemonSinkReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&sample_count, pJson["sampleCount"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&compression_ratio, pJson["compressionRatio"], "float", "");
+    
+    ::SWGSDRangel::setValue(&throughput, pJson["throughput"], "qint32", "");
+    
 }
 
 QString
@@ -89,6 +103,12 @@ SWGSDRdaemonSinkReport::asJsonObject() {
     if(m_sample_count_isSet){
         obj->insert("sampleCount", QJsonValue(sample_count));
     }
+    if(m_compression_ratio_isSet){
+        obj->insert("compressionRatio", QJsonValue(compression_ratio));
+    }
+    if(m_throughput_isSet){
+        obj->insert("throughput", QJsonValue(throughput));
+    }
 
     return obj;
 }
@@ -113,6 +133,26 @@ SWGSDRdaemonSinkReport::setSampleCount(qint32 sample_count) {
     this->m_sample_count_isSet = true;
 }
 
+float
+SWGSDRdaemonSinkReport::getCompressionRatio() {
+    return compression_ratio;
+}
+void
+SWGSDRdaemonSinkReport::setCompressionRatio(float compression_ratio) {
+    this->compression_ratio = compression_ratio;
+    this->m_compression_ratio_isSet = true;
+}
+
+qint32
+SWGSDRdaemonSinkReport::getThroughput() {
+    return throughput;
+}
+void
+SWGSDRdaemonSinkReport::setThroughput(qint32 throughput) {
+    this->throughput = throughput;
+    this->m_throughput_isSet = true;
+}
+
 
 bool
 SWGSDRdaemonSinkReport::isSet(){
@@ -120,6 +160,8 @@ SWGSDRdaemonSinkReport::isSet(){
     do{
         if(m_buffer_rw_balance_isSet){ isObjectUpdated = true; break;}
         if(m_sample_count_isSet){ isObjectUpdated = true; break;}
+        if(m_compression_ratio_isSet){ isObjectUpdated = true; break;}
+        if(m_throughput_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -47,6 +47,12 @@ public:
     qint32 getSampleCount();
     void setSampleCount(qint32 sample_count);
 
+    float getCompressionRatio();
+    void setCompressionRatio(float compression_ratio);
+
+    qint32 getThroughput();
+    void setThroughput(qint32 throughput);
+
 
     virtual bool isSet() override;
 
@@ -57,6 +63,12 @@ private:
     qint32 sample_count;
     bool m_sample_count_isSet;
 
+    float compression_ratio;
+    bool m_compression_ratio_isSet;
+
+    qint32 throughput;
+    bool m_throughput_isSet;
+
 };
 
 }
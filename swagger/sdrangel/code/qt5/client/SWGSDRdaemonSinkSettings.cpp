@@ -38,6 +38,10 @@ SWGSDRdaemonSinkSettings::SWGSDRdaemonSinkSettings() {
     m_tx_delay_isSet = false;
     nb_fec_blocks = 0;
     m_nb_fec_blocks_isSet = false;
+    udp_block_size = 0;
+    m_udp_block_size_isSet = false;
+    compression_bits = 0;
+    m_compression_bits_isSet = false;
     address = nullptr;
     m_address_isSet = false;
     data_port = 0;
@@ -64,6 +68,10 @@ SWGSDRdaemonSinkSettings::init() {
     m_tx_delay_isSet = false;
     nb_fec_blocks = 0;
     m_nb_fec_blocks_isSet = false;
+    udp_block_size = 0;
+    m_udp_block_size_isSet = false;
+    compression_bits = 0;
+    m_compression_bits_isSet = false;
     address = new QString("");
     m_address_isSet = false;
     data_port = 0;
@@ -81,6 +89,8 @@ SWGSDRdaemonSinkSettings::cleanup() {
 
 
 
+
+
     if(address != nullptr) { 
         delete address;
     }
@@ -112,6 +122,10 @@ SWGSDRdaemonSinkSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&nb_fec_blocks, pJson["nbFECBlocks"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&udp_block_size, pJson["udpBlockSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&compression_bits, pJson["compressionBits"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&address, pJson["address"], "QString", "QString");
     
     ::SWGSDRangel::setValue(&data_port, pJson["dataPort"], "qint32", "");
@@ -151,6 +165,12 @@ SWGSDRdaemonSinkSettings::asJsonObject() {
     if(m_nb_fec_blocks_isSet){
         obj->insert("nbFECBlocks", QJsonValue(nb_fec_blocks));
     }
+    if(m_udp_block_size_isSet){
+        obj->insert("udpBlockSize", QJsonValue(udp_block_size));
+    }
+    if(m_compression_bits_isSet){
+        obj->insert("compressionBits", QJsonValue(compression_bits));
+    }
     if(address != nullptr && *address != QString("")){
         toJsonValue(QString("address"), address, obj, QString("QString"));
     }
@@ -217,6 +237,26 @@ SWGSDRdaemonSinkSettings::setNbFecBlocks(qint32 nb_fec_blocks) {
     this->m_nb_fec_blocks_isSet = true;
 }
 
+qint32
+SWGSDRdaemonSinkSettings::getUdpBlockSize() {
+    return udp_block_size;
+}
+void
+SWGSDRdaemonSinkSettings::setUdpBlockSize(qint32 udp_block_size) {
+    this->udp_block_size = udp_block_size;
+    this->m_udp_block_size_isSet = true;
+}
+
+qint32
+SWGSDRdaemonSinkSettings::getCompressionBits() {
+    return compression_bits;
+}
+void
+SWGSDRdaemonSinkSettings::setCompressionBits(qint32 compression_bits) {
+    this->compression_bits = compression_bits;
+    this->m_compression_bits_isSet = true;
+}
+
 QString*
 SWGSDRdaemonSinkSettings::getAddress() {
     return address;
@@ -267,6 +307,8 @@ SWGSDRdaemonSinkSettings::isSet(){
         if(m_log2_interp_isSet){ isObjectUpdated = true; break;}
         if(m_tx_delay_isSet){ isObjectUpdated = true; break;}
         if(m_nb_fec_blocks_isSet){ isObjectUpdated = true; break;}
+        if(m_udp_block_size_isSet){ isObjectUpdated = true; break;}
+        if(m_compression_bits_isSet){ isObjectUpdated = true; break;}
         if(address != nullptr && *address != QString("")){ isObjectUpdated = true; break;}
         if(m_data_port_isSet){ isObjectUpdated = true; break;}
         if(m_control_port_isSet){ isObjectUpdated = true; break;}
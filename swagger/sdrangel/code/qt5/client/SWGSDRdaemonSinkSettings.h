@@ -57,6 +57,12 @@ public:
     qint32 getNbFecBlocks();
     void setNbFecBlocks(qint32 nb_fec_blocks);
 
+    qint32 getUdpBlockSize();
+    void setUdpBlockSize(qint32 udp_block_size);
+
+    qint32 getCompressionBits();
+    void setCompressionBits(qint32 compression_bits);
+
     QString* getAddress();
     void setAddress(QString* address);
 
@@ -88,6 +94,12 @@ private:
     qint32 nb_fec_blocks;
     bool m_nb_fec_blocks_isSet;
 
+    qint32 udp_block_size;
+    bool m_udp_block_size_isSet;
+
+    qint32 compression_bits;
+    bool m_compression_bits_isSet;
+
     QString* address;
     bool m_address_isSet;
 
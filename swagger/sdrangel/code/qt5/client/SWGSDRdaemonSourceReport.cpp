@@ -40,6 +40,20 @@ SWGSDRdaemonSourceReport::SWGSDRdaemonSourceReport() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    packet_rate = 0;
+    m_packet_rate_isSet = false;
+    nb_packets = 0L;
+    m_nb_packets_isSet = false;
+    nb_socket_drops = 0L;
+    m_nb_socket_drops_isSet = false;
+    nb_lost_blocks = 0L;
+    m_nb_lost_blocks_isSet = false;
+    nb_unrecoverable_frames = 0L;
+    m_nb_unrecoverable_frames_isSet = false;
+    compression_ratio = 0.0f;
+    m_compression_ratio_isSet = false;
+    throughput = 0;
+    m_throughput_isSet = false;
 }
 
 SWGSDRdaemonSourceReport::~SWGSDRdaemonSourceReport() {
@@ -60,6 +74,20 @@ SWGSDRdaemonSourceReport::init() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    packet_rate = 0;
+    m_packet_rate_isSet = false;
+    nb_packets = 0L;
+    m_nb_packets_isSet = false;
+    nb_socket_drops = 0L;
+    m_nb_socket_drops_isSet = false;
+    nb_lost_blocks = 0L;
+    m_nb_lost_blocks_isSet = false;
+    nb_unrecoverable_frames = 0L;
+    m_nb_unrecoverable_frames_isSet = false;
+    compression_ratio = 0.0f;
+    m_compression_ratio_isSet = false;
+    throughput = 0;
+    m_throughput_isSet = false;
 }
 
 void
@@ -72,6 +100,13 @@ SWGSDRdaemonSourceReport::cleanup() {
     }
 
 
+
+
+
+
+
+
+
 }
 
 SWGSDRdaemonSourceReport*
@@ -97,6 +132,20 @@ SWGSDRdaemonSourceReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&max_nb_recovery, pJson["maxNbRecovery"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&packet_rate, pJson["packetRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nb_packets, pJson["nbPackets"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_socket_drops, pJson["nbSocketDrops"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_lost_blocks, pJson["nbLostBlocks"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&nb_unrecoverable_frames, pJson["nbUnrecoverableFrames"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&compression_ratio, pJson["compressionRatio"], "float", "");
+    
+    ::SWGSDRangel::setValue(&throughput, pJson["throughput"], "qint32", "");
+    
 }
 
 QString
@@ -131,6 +180,27 @@ SWGSDRdaemonSourceReport::asJsonObject() {
     if(m_max_nb_recovery_isSet){
         obj->insert("maxNbRecovery", QJsonValue(max_nb_recovery));
     }
+    if(m_packet_rate_isSet){
+        obj->insert("packetRate", QJsonValue(packet_rate));
+    }
+    if(m_nb_packets_isSet){
+        obj->insert("nbPackets", QJsonValue(nb_packets));
+    }
+    if(m_nb_socket_drops_isSet){
+        obj->insert("nbSocketDrops", QJsonValue(nb_socket_drops));
+    }
+    if(m_nb_lost_blocks_isSet){
+        obj->insert("nbLostBlocks", QJsonValue(nb_lost_blocks));
+    }
+    if(m_nb_unrecoverable_frames_isSet){
+        obj->insert("nbUnrecoverableFrames", QJsonValue(nb_unrecoverable_frames));
+    }
+    if(m_compression_ratio_isSet){
+        obj->insert("compressionRatio", QJsonValue(compression_ratio));
+    }
+    if(m_throughput_isSet){
+        obj->insert("throughput", QJsonValue(throughput));
+    }
 
     return obj;
 }
@@ -195,6 +265,76 @@ SWGSDRdaemonSourceReport::setMaxNbRecovery(qint32 max_nb_recovery) {
     this->m_max_nb_recovery_isSet = true;
 }
 
+qint32
+SWGSDRdaemonSourceReport::getPacketRate() {
+    return packet_rate;
+}
+void
+SWGSDRdaemonSourceReport::setPacketRate(qint32 packet_rate) {
+    this->packet_rate = packet_rate;
+    this->m_packet_rate_isSet = true;
+}
+
+qint64
+SWGSDRdaemonSourceReport::getNbPackets() {
+    return nb_packets;
+}
+void
+SWGSDRdaemonSourceReport::setNbPackets(qint64 nb_packets) {
+    this->nb_packets = nb_packets;
+    this->m_nb_packets_isSet = true;
+}
+
+qint64
+SWGSDRdaemonSourceReport::getNbSocketDrops() {
+    return nb_socket_drops;
+}
+void
+SWGSDRdaemonSourceReport::setNbSocketDrops(qint64 nb_socket_drops) {
+    this->nb_socket_drops = nb_socket_drops;
+    this->m_nb_socket_drops_isSet = true;
+}
+
+qint64
+SWGSDRdaemonSourceReport::getNbLostBlocks() {
+    return nb_lost_blocks;
+}
+void
+SWGSDRdaemonSourceReport::setNbLostBlocks(qint64 nb_lost_blocks) {
+    this->nb_lost_blocks = nb_lost_blocks;
+    this->m_nb_lost_blocks_isSet = true;
+}
+
+qint64
+SWGSDRdaemonSourceReport::getNbUnrecoverableFrames() {
+    return nb_unrecoverable_frames;
+}
+void
+SWGSDRdaemonSourceReport::setNbUnrecoverableFrames(qint64 nb_unrecoverable_frames) {
+    this->nb_unrecoverable_frames = nb_unrecoverable_frames;
+    this->m_nb_unrecoverable_frames_isSet = true;
+}
+
+float
+SWGSDRdaemonSourceReport::getCompressionRatio() {
+    return compression_ratio;
+}
+void
+SWGSDRdaemonSourceReport::setCompressionRatio(float compression_ratio) {
+    this->compression_ratio = compression_ratio;
+    this->m_compression_ratio_isSet = true;
+}
+
+qint32
+SWGSDRdaemonSourceReport::getThroughput() {
+    return throughput;
+}
+void
+SWGSDRdaemonSourceReport::setThroughput(qint32 throughput) {
+    this->throughput = throughput;
+    this->m_throughput_isSet = true;
+}
+
 
 bool
 SWGSDRdaemonSourceReport::isSet(){
@@ -206,6 +346,13 @@ SWGSDRdaemonSourceReport::isSet(){
         if(daemon_timestamp != nullptr && *daemon_timestamp != QString("")){ isObjectUpdated = true; break;}
         if(m_min_nb_blocks_isSet){ isObjectUpdated = true; break;}
         if(m_max_nb_recovery_isSet){ isObjectUpdated = true; break;}
+        if(m_packet_rate_isSet){ isObjectUpdated = true; break;}
+        if(m_nb_packets_isSet){ isObjectUpdated = true; break;}
+        if(m_nb_socket_drops_isSet){ isObjectUpdated = true; break;}
+        if(m_nb_lost_blocks_isSet){ isObjectUpdated = true; break;}
+        if(m_nb_unrecoverable_frames_isSet){ isObjectUpdated = true; break;}
+        if(m_compression_ratio_isSet){ isObjectUpdated = true; break;}
+        if(m_throughput_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
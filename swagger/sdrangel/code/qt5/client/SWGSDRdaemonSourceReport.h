@@ -60,6 +60,27 @@ public:
     qint32 getMaxNbRecovery();
     void setMaxNbRecovery(qint32 max_nb_recovery);
 
+    qint32 getPacketRate();
+    void setPacketRate(qint32 packet_rate);
+
+    qint64 getNbPackets();
+    void setNbPackets(qint64 nb_packets);
+
+    qint64 getNbSocketDrops();
+    void setNbSocketDrops(qint64 nb_socket_drops);
+
+    qint64 getNbLostBlocks();
+    void setNbLostBlocks(qint64 nb_lost_blocks);
+
+    qint64 getNbUnrecoverableFrames();
+    void setNbUnrecoverableFrames(qint64 nb_unrecoverable_frames);
+
+    float getCompressionRatio();
+    void setCompressionRatio(float compression_ratio);
+
+    qint32 getThroughput();
+    void setThroughput(qint32 throughput);
+
 
     virtual bool isSet() override;
 
@@ -82,6 +103,27 @@ private:
     qint32 max_nb_recovery;
     bool m_max_nb_recovery_isSet;
 
+    qint32 packet_rate;
+    bool m_packet_rate_isSet;
+
+    qint64 nb_packets;
+    bool m_nb_packets_isSet;
+
+    qint64 nb_socket_drops;
+    bool m_nb_socket_drops_isSet;
+
+    qint64 nb_lost_blocks;
+    bool m_nb_lost_blocks_isSet;
+
+    qint64 nb_unrecoverable_frames;
+    bool m_nb_unrecoverable_frames_isSet;
+
+    float compression_ratio;
+    bool m_compression_ratio_isSet;
+
+    qint32 throughput;
+    bool m_throughput_isSet;
+
 };
 
 }
@@ -54,6 +54,8 @@ SWGSDRdaemonSourceSettings::SWGSDRdaemonSourceSettings() {
     m_fc_pos_isSet = false;
     file_record_name = nullptr;
     m_file_record_name_isSet = false;
+    compression_bits = 0;
+    m_compression_bits_isSet = false;
 }
 
 SWGSDRdaemonSourceSettings::~SWGSDRdaemonSourceSettings() {
@@ -88,6 +90,8 @@ SWGSDRdaemonSourceSettings::init() {
     m_fc_pos_isSet = false;
     file_record_name = new QString("");
     m_file_record_name_isSet = false;
+    compression_bits = 0;
+    m_compression_bits_isSet = false;
 }
 
 void
@@ -111,6 +115,7 @@ SWGSDRdaemonSourceSettings::cleanup() {
     if(file_record_name != nullptr) { 
         delete file_record_name;
     }
+
 }
 
 SWGSDRdaemonSourceSettings*
@@ -150,6 +155,8 @@ SWGSDRdaemonSourceSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&file_record_name, pJson["fileRecordName"], "QString", "QString");
     
+    ::SWGSDRangel::setValue(&compression_bits, pJson["compressionBits"], "qint32", "");
+    
 }
 
 QString
@@ -205,6 +212,9 @@ SWGSDRdaemonSourceSettings::asJsonObject() {
     if(file_record_name != nullptr && *file_record_name != QString("")){
         toJsonValue(QString("fileRecordName"), file_record_name, obj, QString("QString"));
     }
+    if(m_compression_bits_isSet){
+        obj->insert("compressionBits", QJsonValue(compression_bits));
+    }
 
     return obj;
 }
@@ -339,6 +349,16 @@ SWGSDRdaemonSourceSettings::setFileRecordName(QString* file_record_name) {
     this->m_file_record_name_isSet = true;
 }
 
+qint32
+SWGSDRdaemonSourceSettings::getCompressionBits() {
+    return compression_bits;
+}
+void
+SWGSDRdaemonSourceSettings::setCompressionBits(qint32 compression_bits) {
+    this->compression_bits = compression_bits;
+    this->m_compression_bits_isSet = true;
+}
+
 
 bool
 SWGSDRdaemonSourceSettings::isSet(){
@@ -357,6 +377,7 @@ SWGSDRdaemonSourceSettings::isSet(){
         if(m_iq_correction_isSet){ isObjectUpdated = true; break;}
         if(m_fc_pos_isSet){ isObjectUpdated = true; break;}
         if(file_record_name != nullptr && *file_record_name != QString("")){ isObjectUpdated = true; break;}
+        if(m_compression_bits_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
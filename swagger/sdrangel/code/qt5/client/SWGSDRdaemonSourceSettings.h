@@ -81,6 +81,9 @@ public:
     QString* getFileRecordName();
     void setFileRecordName(QString* file_record_name);
 
+    qint32 getCompressionBits();
+    void setCompressionBits(qint32 compression_bits);
+
 
     virtual bool isSet() override;
 
@@ -124,6 +127,9 @@ private:
     QString* file_record_name;
     bool m_file_record_name_isSet;
 
+    qint32 compression_bits;
+    bool m_compression_bits_isSet;
+
 };
 
 }
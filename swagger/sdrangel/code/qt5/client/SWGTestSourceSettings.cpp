@@ -60,6 +60,10 @@ SWGTestSourceSettings::SWGTestSourceSettings() {
     m_q_factor_isSet = false;
     phase_imbalance = 0.0f;
     m_phase_imbalance_isSet = false;
+    scenario = nullptr;
+    m_scenario_isSet = false;
+    unthrottled = 0;
+    m_unthrottled_isSet = false;
     file_record_name = nullptr;
     m_file_record_name_isSet = false;
 }
@@ -102,6 +106,10 @@ SWGTestSourceSettings::init() {
     m_q_factor_isSet = false;
     phase_imbalance = 0.0f;
     m_phase_imbalance_isSet = false;
+    scenario = new QString("");
+    m_scenario_isSet = false;
+    unthrottled = 0;
+    m_unthrottled_isSet = false;
     file_record_name = new QString("");
     m_file_record_name_isSet = false;
 }
@@ -124,6 +132,10 @@ SWGTestSourceSettings::cleanup() {
 
 
 
+    if(scenario != nullptr) { 
+        delete scenario;
+    }
+
     if(file_record_name != nullptr) { 
         delete file_record_name;
     }
@@ -172,6 +184,10 @@ SWGTestSourceSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&phase_imbalance, pJson["phaseImbalance"], "float", "");
     
+    ::SWGSDRangel::setValue(&scenario, pJson["scenario"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&unthrottled, pJson["unthrottled"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&file_record_name, pJson["fileRecordName"], "QString", "QString");
     
 }
@@ -238,6 +254,12 @@ SWGTestSourceSettings::asJsonObject() {
     if(m_phase_imbalance_isSet){
         obj->insert("phaseImbalance", QJsonValue(phase_imbalance));
     }
+    if(scenario != nullptr && *scenario != QString("")){
+        toJsonValue(QString("scenario"), scenario, obj, QString("QString"));
+    }
+    if(m_unthrottled_isSet){
+        obj->insert("unthrottled", QJsonValue(unthrottled));
+    }
     if(file_record_name != nullptr && *file_record_name != QString("")){
         toJsonValue(QString("fileRecordName"), file_record_name, obj, QString("QString"));
     }
@@ -405,6 +427,26 @@ SWGTestSourceSettings::setPhaseImbalance(float phase_imbalance) {
     this->m_phase_imbalance_isSet = true;
 }
 
+QString*
+SWGTestSourceSettings::getScenario() {
+    return scenario;
+}
+void
+SWGTestSourceSettings::setScenario(QString* scenario) {
+    this->scenario = scenario;
+    this->m_scenario_isSet = true;
+}
+
+qint32
+SWGTestSourceSettings::getUnthrottled() {
+    return unthrottled;
+}
+void
+SWGTestSourceSettings::setUnthrottled(qint32 unthrottled) {
+    this->unthrottled = unthrottled;
+    this->m_unthrottled_isSet = true;
+}
+
 QString*
 SWGTestSourceSettings::getFileRecordName() {
     return file_record_name;
@@ -436,6 +478,8 @@ SWGTestSourceSettings::isSet(){
         if(m_i_factor_isSet){ isObjectUpdated = true; break;}
         if(m_q_factor_isSet){ isObjectUpdated = true; break;}
         if(m_phase_imbalance_isSet){ isObjectUpdated = true; break;}
+        if(scenario != nullptr && *scenario != QString("")){ isObjectUpdated = true; break;}
+        if(m_unthrottled_isSet){ isObjectUpdated = true; break;}
         if(file_record_name != nullptr && *file_record_name != QString("")){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
@@ -90,6 +90,12 @@ public:
     float getPhaseImbalance();
     void setPhaseImbalance(float phase_imbalance);
 
+    QString* getScenario();
+    void setScenario(QString* scenario);
+
+    qint32 getUnthrottled();
+    void setUnthrottled(qint32 unthrottled);
+
     QString* getFileRecordName();
     void setFileRecordName(QString* file_record_name);
 
@@ -145,6 +151,12 @@ private:
     float phase_imbalance;
     bool m_phase_imbalance_isSet;
 
+    QString* scenario;
+    bool m_scenario_isSet;
+
+    qint32 unthrottled;
+    bool m_unthrottled_isSet;
+
     QString* file_record_name;
     bool m_file_record_name_isSet;
 